@@ -166,6 +166,8 @@ struct Settings {
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
   bool enable_serial_gc = false;
+  // Preroll and diff large layer trees on the concurrent worker threads.
+  bool enable_concurrent_layer_traversal = false;
 
   // Whether embedder only allows secure connections.
   bool may_insecurely_connect_to_all_domains = true;
@@ -314,6 +316,9 @@ struct Settings {
   // calls in this callback will cause applications to jank.
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
+  // Render software frames in tiles on the concurrent worker threads. Only
+  // supported by the software renderer of the embedder API.
+  bool enable_software_tiled_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
@@ -353,6 +358,16 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // Max bytes of images held by the raster cache, or 0 for unlimited. Unused
+  // images of lower value are evicted to make room for new ones.
+  size_t raster_cache_max_bytes = 0;
+
+  // The number of consecutive frames in which a raster cache image may go
+  // unused before it is evicted. Content that scrolls out of view and back,
+  // or that is briefly covered, then keeps its image instead of being
+  // rasterized again.
+  size_t raster_cache_max_unused_frames = 0;
+
   /// Enable embedder api on the embedder.
   ///
   /// This is currently only used by iOS.
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder_pool.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
 
@@ -200,6 +201,41 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+// Records |pictures_per_frame| pictures per iteration the way the framework
+// re-records a frame, keeping the previous frame's DisplayLists alive until
+// the next frame is complete as the raster thread would. Reports how many
+// storage blocks had to come from malloc rather than the storage pool.
+static void BM_DisplayListBuilderFrame(benchmark::State& state,
+                                       bool use_builder_pool) {
+  const size_t pictures_per_frame = state.range(0);
+  auto& storage_pool = DlStoragePool::GetInstance();
+  auto& builder_pool = DisplayListBuilderPool::GetInstance();
+  std::vector<sk_sp<DisplayList>> previous_frame;
+  std::vector<sk_sp<DisplayList>> current_frame;
+  const auto stats_before = storage_pool.GetStats();
+  while (state.KeepRunning()) {
+    current_frame.clear();
+    for (size_t i = 0; i < pictures_per_frame; i++) {
+      sk_sp<DisplayListBuilder> builder =
+          use_builder_pool
+              ? builder_pool.Acquire(DisplayListBuilder::kMaxCullRect, true)
+              : sk_make_sp<DisplayListBuilder>(true);
+      InvokeAllRenderingOps(*builder);
+      current_frame.push_back(builder->Build());
+      if (use_builder_pool) {
+        builder_pool.Recycle(std::move(builder));
+      }
+    }
+    std::swap(previous_frame, current_frame);
+  }
+  const auto stats_after = storage_pool.GetStats();
+  const double frames = state.iterations();
+  state.counters["storage_allocs_per_frame"] =
+      (stats_after.allocation_count - stats_before.allocation_count) / frames;
+  state.counters["storage_reuses_per_frame"] =
+      (stats_after.reuse_count - stats_before.reuse_count) / frames;
+}
+
 class DlOpReceiverIgnore : public IgnoreAttributeDispatchHelper,
                            public IgnoreTransformDispatchHelper,
                            public IgnoreClipDispatchHelper,
@@ -310,6 +346,17 @@ static void BM_DisplayListDispatchByVectorCull(
   }
 }
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderFrame, kNewBuilders, false)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderFrame, kPooledBuilders, true)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(500)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -5,6 +5,7 @@
 #include "flutter/benchmarking/benchmarking.h"
 
 #include "flutter/display_list/geometry/dl_region.h"
+#include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkRegion.h"
 
@@ -253,6 +254,55 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+// The bounds of the ops recorded for a scrolling list of |item_count|
+// items, each of which draws a background and a few overlapping children.
+std::vector<SkRect> GenerateListRects(int item_count) {
+  std::vector<SkRect> rects;
+  for (int i = 0; i < item_count; ++i) {
+    float y = i * 50.0f;
+    rects.push_back(SkRect::MakeXYWH(0, y, 400, 50));
+    rects.push_back(SkRect::MakeXYWH(10, y + 5, 40, 40));
+    rects.push_back(SkRect::MakeXYWH(60, y + 10, 300, 15));
+    rects.push_back(SkRect::MakeXYWH(60, y + 25, 200, 15));
+  }
+  return rects;
+}
+
+void RunRTreeBuildBenchmark(benchmark::State& state, int item_count) {
+  auto rects = GenerateListRects(item_count);
+  while (state.KeepRunning()) {
+    flutter::DlRTree rtree(rects.data(), static_cast<int>(rects.size()));
+    benchmark::DoNotOptimize(rtree.node_count());
+  }
+}
+
+// Queries a viewport-sized rect at every position of the list, either
+// into a vector or into a reused buffer.
+void RunRTreeSearchBenchmark(benchmark::State& state,
+                             int item_count,
+                             bool use_buffer) {
+  auto rects = GenerateListRects(item_count);
+  flutter::DlRTree rtree(rects.data(), static_cast<int>(rects.size()));
+  std::vector<SkRect> queries;
+  for (int i = 0; i < item_count; i += 5) {
+    queries.push_back(SkRect::MakeXYWH(0, i * 50.0f, 400, 800));
+  }
+  std::vector<int> results;
+  std::vector<int> buffer(rects.size());
+  while (state.KeepRunning()) {
+    for (const auto& query : queries) {
+      if (use_buffer) {
+        benchmark::DoNotOptimize(
+            rtree.search(query, buffer.data(), buffer.size()));
+      } else {
+        results.clear();
+        rtree.search(query, &results);
+        benchmark::DoNotOptimize(results.data());
+      }
+    }
+  }
+}
+
 }  // namespace
 
 namespace flutter {
@@ -313,6 +363,19 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
   RunIntersectsSingleRectBenchmark<SkRegionAdapter>(state, maxSize);
 }
 
+static void BM_DlRTree_Build(benchmark::State& state, int item_count) {
+  RunRTreeBuildBenchmark(state, item_count);
+}
+
+static void BM_DlRTree_Search(benchmark::State& state, int item_count) {
+  RunRTreeSearchBenchmark(state, item_count, false);
+}
+
+static void BM_DlRTree_SearchIntoBuffer(benchmark::State& state,
+                                        int item_count) {
+  RunRTreeSearchBenchmark(state, item_count, true);
+}
+
 const double kSizeFactorSmall = 0.3;
 
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
@@ -709,4 +772,18 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DlRTree_Build, Small, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Build, Large, 5000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Small, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_SearchIntoBuffer, Small, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_Search, Large, 5000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRTree_SearchIntoBuffer, Large, 5000)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
\ No newline at end of file
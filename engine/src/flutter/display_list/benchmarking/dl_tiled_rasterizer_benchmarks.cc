@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+#include <random>
+
+namespace flutter {
+
+namespace {
+
+constexpr int kFrameWidth = 1920;
+constexpr int kFrameHeight = 1080;
+
+// A frame full of overlapping antialiased shapes, in the spirit of a busy
+// application screen.
+sk_sp<DisplayList> MakeFrame() {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> x(0, kFrameWidth - 200);
+  std::uniform_real_distribution<float> y(0, kFrameHeight - 200);
+  std::uniform_real_distribution<float> size(20, 200);
+  std::uniform_int_distribution<uint32_t> color(0, 0xFFFFFF);
+
+  DisplayListBuilder builder(SkRect::MakeWH(kFrameWidth, kFrameHeight),
+                             /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  DlPaint paint;
+  paint.setAntiAlias(true);
+  for (int i = 0; i < 2000; i++) {
+    paint.setColor(DlColor(0xC0000000 | color(rng)));
+    SkRect rect = SkRect::MakeXYWH(x(rng), y(rng), size(rng), size(rng));
+    switch (i % 3) {
+      case 0:
+        builder.DrawRect(rect, paint);
+        break;
+      case 1:
+        builder.DrawOval(rect, paint);
+        break;
+      case 2:
+        builder.DrawRRect(SkRRect::MakeRectXY(rect, 12, 12), paint);
+        break;
+    }
+  }
+  return builder.Build();
+}
+
+// Renders frames on the calling thread and |state.range(0)| worker threads,
+// and reports the number of frames per second.
+void RenderFrames(benchmark::State& state, const SkIRect& dirty_rect) {
+  const size_t worker_count = state.range(0);
+  std::shared_ptr<fml::ConcurrentMessageLoop> loop;
+  std::shared_ptr<fml::BasicTaskRunner> task_runner;
+  if (worker_count > 0) {
+    loop = fml::ConcurrentMessageLoop::Create(worker_count);
+    task_runner = loop->GetTaskRunner();
+  }
+  DlSkTiledRasterizer rasterizer(task_runner, worker_count);
+
+  sk_sp<DisplayList> display_list = MakeFrame();
+  sk_sp<SkSurface> surface = SkSurfaces::Raster(
+      SkImageInfo::MakeN32Premul(kFrameWidth, kFrameHeight));
+  SkPixmap pixmap;
+  FML_CHECK(surface->peekPixels(&pixmap));
+
+  for (auto _ : state) {
+    rasterizer.Render(display_list, pixmap, dirty_rect);
+  }
+  state.counters["FPS"] =
+      benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+static void BM_RenderFullFrame(benchmark::State& state) {
+  RenderFrames(state, SkIRect::MakeWH(kFrameWidth, kFrameHeight));
+}
+
+// Only a button-sized area of the frame is damaged.
+static void BM_RenderDamagedFrame(benchmark::State& state) {
+  RenderFrames(state, SkIRect::MakeXYWH(800, 500, 300, 100));
+}
+
+BENCHMARK(BM_RenderFullFrame)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RenderDamagedFrame)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -10,6 +10,7 @@
 
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_sampling_options.h"
+#include "flutter/display_list/dl_storage.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
@@ -263,28 +264,6 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
-class DisplayListStorage {
- public:
-  DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
-
-  uint8_t* get() { return ptr_.get(); }
-
-  const uint8_t* get() const { return ptr_.get(); }
-
-  void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
-  }
-
- private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
-};
-
 using DlIndex = uint32_t;
 
 // The base class that contains a sequence of rendering operations
@@ -355,6 +334,15 @@ class DisplayList : public SkRefCnt {
   /// be required for the backdrop filter to do its work.
   bool root_has_backdrop_filter() const { return root_has_backdrop_filter_; }
 
+  /// @brief    Indicates if there are any saveLayer operations at any depth
+  ///           of the DisplayList, including in nested DisplayLists, that
+  ///           use a backdrop filter.
+  ///
+  /// Unlike |root_has_backdrop_filter|, this also covers backdrop filters
+  /// inside other layers, which still read the pixels rendered before them
+  /// outside of their own layer's content.
+  bool has_backdrop_filter() const { return has_backdrop_filter_; }
+
   /// @brief    Indicates if a rendering operation at the root level of the
   ///           DisplayList had an unbounded result, not otherwise limited by
   ///           a clip operation.
@@ -541,6 +529,7 @@ class DisplayList : public SkRefCnt {
               bool modifies_transparent_black,
               DlBlendMode max_root_blend_mode,
               bool root_has_backdrop_filter,
+              bool has_backdrop_filter,
               bool root_is_unbounded,
               sk_sp<const DlRTree> rtree);
 
@@ -565,6 +554,7 @@ class DisplayList : public SkRefCnt {
   const bool is_ui_thread_safe_;
   const bool modifies_transparent_black_;
   const bool root_has_backdrop_filter_;
+  const bool has_backdrop_filter_;
   const bool root_is_unbounded_;
   const DlBlendMode max_root_blend_mode_;
 
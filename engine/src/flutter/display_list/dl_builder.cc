@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
@@ -15,8 +17,6 @@
 
 namespace flutter {
 
-#define DL_BUILDER_PAGE 4096
-
 // CopyV(dst, src,n, src,n, ...) copies any number of typed srcs into dst.
 static void CopyV(void* dst) {}
 
@@ -35,26 +35,22 @@ static void CopyV(void* dst, const S* src, int n, Rest&&... rest) {
   CopyV(dst, std::forward<Rest>(rest)...);
 }
 
-static constexpr inline bool is_power_of_two(int value) {
-  return (value & (value - 1)) == 0;
-}
-
 template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, Args&&... args) {
   size_t size = SkAlignPtr(sizeof(T) + pod);
   FML_CHECK(size < (1 << 24));
-  if (used_ + size > allocated_) {
-    static_assert(is_power_of_two(DL_BUILDER_PAGE),
-                  "This math needs updating for non-pow2.");
-    // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
-    FML_CHECK(storage_.get());
-    memset(storage_.get() + used_, 0, allocated_ - used_);
-  }
-  FML_CHECK(used_ + size <= allocated_);
+  if (used_ + size > storage_.capacity()) {
+    // The first block is sized to what the previous Build() needed so that
+    // a builder recording similar content again does not have to grow.
+    storage_.reserve(used_, std::max(used_ + size, storage_size_hint_));
+  }
+  FML_CHECK(used_ + size <= storage_.capacity());
   auto op = reinterpret_cast<T*>(storage_.get() + used_);
   used_ += size;
+  // Storage blocks are recycled and may contain stale bytes. The record,
+  // including any padding, must be zeroed since DisplayList::Equals
+  // compares records with memcmp.
+  memset(op, 0, size);
   new (op) T{std::forward<Args>(args)...};
   op->type = T::kType;
   op->size = size;
@@ -78,6 +74,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   bool is_safe = is_ui_thread_safe_;
   bool affects_transparency = current_layer().affects_transparent_layer;
   bool root_has_backdrop_filter = current_layer().contains_backdrop_filter;
+  bool has_backdrop_filter = has_backdrop_filter_;
   bool root_is_unbounded = current_layer().is_unbounded;
   DlBlendMode max_root_blend_mode = current_layer().max_blend_mode;
 
@@ -97,10 +94,12 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
     bounds = current_layer().global_space_accumulator.bounds();
   }
 
-  used_ = allocated_ = render_op_count_ = op_index_ = 0;
+  storage_size_hint_ = bytes;
+  used_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   depth_ = 0;
   is_ui_thread_safe_ = true;
+  has_backdrop_filter_ = false;
   current_opacity_compatibility_ = true;
   render_op_depth_cost_ = 1u;
   current_ = DlPaint();
@@ -108,12 +107,17 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   save_stack_.pop_back();
   Init(rtree != nullptr);
 
-  storage_.realloc(bytes);
+  // Pooled storage is handed off as is. Its unused tail is at most the
+  // difference to the next size class and goes back to the pool along
+  // with the rest of the block when the DisplayList is freed. Larger
+  // blocks were grown geometrically and are trimmed so that a retained
+  // DisplayList does not hold on to up to twice its size.
+  storage_.shrink_to_fit(bytes);
   return sk_sp<DisplayList>(new DisplayList(
       std::move(storage_), bytes, count, nested_bytes, nested_count,
       total_depth, bounds, opacity_compatible, is_safe, affects_transparency,
-      max_root_blend_mode, root_has_backdrop_filter, root_is_unbounded,
-      std::move(rtree)));
+      max_root_blend_mode, root_has_backdrop_filter, has_backdrop_filter,
+      root_is_unbounded, std::move(rtree)));
 }
 
 static constexpr DlRect kEmpty = DlRect();
@@ -140,6 +144,15 @@ void DisplayListBuilder::Init(bool prepare_rtree) {
   }
 }
 
+void DisplayListBuilder::Reset(const SkRect& cull_rect, bool prepare_rtree) {
+  FML_DCHECK(used_ == 0u);
+  FML_DCHECK(save_stack_.size() == 1u);
+  save_stack_.clear();
+  rtree_data_.reset();
+  original_cull_rect_ = ProtectEmpty(cull_rect);
+  Init(prepare_rtree);
+}
+
 DisplayListBuilder::~DisplayListBuilder() {
   uint8_t* ptr = storage_.get();
   if (ptr) {
@@ -429,6 +442,7 @@ void DisplayListBuilder::saveLayer(const DlRect& bounds,
 
   if (backdrop != nullptr) {
     current_layer().contains_backdrop_filter = true;
+    has_backdrop_filter_ = true;
   }
 
   // Snapshot these values before we do any work as we need the values
@@ -1652,6 +1666,9 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
   if (display_list->root_has_backdrop_filter()) {
     current_layer().contains_backdrop_filter = true;
   }
+  if (display_list->has_backdrop_filter()) {
+    has_backdrop_filter_ = true;
+  }
 }
 void DisplayListBuilder::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                       DlScalar x,
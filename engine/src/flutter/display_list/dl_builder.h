@@ -274,6 +274,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
  private:
   void Init(bool prepare_rtree);
 
+  // Prepares a builder whose last recording was built for reuse with a new
+  // cull rect. Only used by |DisplayListBuilderPool|.
+  void Reset(const SkRect& cull_rect, bool prepare_rtree);
+
+  friend class DisplayListBuilderPool;
+
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
   // is obsolete and forbidden in every other case and is only shared to a
@@ -520,7 +526,9 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   DisplayListStorage storage_;
   size_t used_ = 0u;
-  size_t allocated_ = 0u;
+  // The size of the last DisplayList built, used to size the first storage
+  // block of the next one.
+  size_t storage_size_hint_ = 0u;
   uint32_t render_op_count_ = 0u;
   uint32_t depth_ = 0u;
   // Most rendering ops will use 1 depth value, but some attributes may
@@ -533,6 +541,9 @@ class DisplayListBuilder final : public virtual DlCanvas,
   uint32_t nested_op_count_ = 0;
 
   bool is_ui_thread_safe_ = true;
+  // Whether a saveLayer at any depth, including in nested DisplayLists, has
+  // a backdrop filter.
+  bool has_backdrop_filter_ = false;
 
   template <typename T, typename... Args>
   void* Push(size_t extra, Args&&... args);
@@ -653,7 +664,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
     void TransferBoundsToParent(const SaveInfo& parent);
   };
 
-  const DlRect original_cull_rect_;
+  DlRect original_cull_rect_;
   std::vector<SaveInfo> save_stack_;
   std::optional<RTreeData> rtree_data_;
 
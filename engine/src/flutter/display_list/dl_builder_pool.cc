@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_builder_pool.h"
+
+namespace flutter {
+
+DisplayListBuilderPool& DisplayListBuilderPool::GetInstance() {
+  static DisplayListBuilderPool* pool = new DisplayListBuilderPool();
+  return *pool;
+}
+
+DisplayListBuilderPool::DisplayListBuilderPool() = default;
+
+DisplayListBuilderPool::~DisplayListBuilderPool() = default;
+
+sk_sp<DisplayListBuilder> DisplayListBuilderPool::Acquire(
+    const SkRect& cull_rect,
+    bool prepare_rtree) {
+  sk_sp<DisplayListBuilder> builder;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!builders_.empty()) {
+      builder = std::move(builders_.back());
+      builders_.pop_back();
+    }
+  }
+
+  if (!builder) {
+    return sk_make_sp<DisplayListBuilder>(cull_rect, prepare_rtree);
+  }
+  builder->Reset(cull_rect, prepare_rtree);
+  return builder;
+}
+
+void DisplayListBuilderPool::Recycle(sk_sp<DisplayListBuilder> builder) {
+  if (!builder || !builder->unique() || builder->used_ > 0u ||
+      builder->save_stack_.size() != 1u) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  if (builders_.size() < kMaxCachedBuilders) {
+    builders_.push_back(std::move(builder));
+  }
+}
+
+size_t DisplayListBuilderPool::GetCachedBuilderCount() const {
+  std::scoped_lock lock(mutex_);
+  return builders_.size();
+}
+
+void DisplayListBuilderPool::Trim() {
+  std::scoped_lock lock(mutex_);
+  builders_.clear();
+}
+
+}  // namespace flutter
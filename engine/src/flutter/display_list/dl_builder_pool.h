@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_BUILDER_POOL_H_
+#define FLUTTER_DISPLAY_LIST_DL_BUILDER_POOL_H_
+
+#include <mutex>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A cache of DisplayListBuilders that have finished recording.
+//
+// A recycled builder keeps the storage size hint of the last DisplayList it
+// built, so a recording of a similar size does not have to grow its storage
+// op by op. The most recently recycled builder is handed out first.
+class DisplayListBuilderPool {
+ public:
+  static constexpr size_t kMaxCachedBuilders = 16u;
+
+  static DisplayListBuilderPool& GetInstance();
+
+  DisplayListBuilderPool();
+
+  ~DisplayListBuilderPool();
+
+  // Returns a recycled builder, reset to the given cull rect, or a new one
+  // if none is available.
+  sk_sp<DisplayListBuilder> Acquire(const SkRect& cull_rect,
+                                    bool prepare_rtree);
+
+  // Returns a builder to the pool. Builders that are still referenced
+  // elsewhere or that have recorded ops which were never built are
+  // dropped.
+  void Recycle(sk_sp<DisplayListBuilder> builder);
+
+  size_t GetCachedBuilderCount() const;
+
+  void Trim();
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<sk_sp<DisplayListBuilder>> builders_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListBuilderPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_BUILDER_POOL_H_
@@ -0,0 +1,1864 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/display_list/effects/dl_color_filter.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+
+namespace flutter {
+
+namespace {
+
+// The op codes written to the stream. These are part of the format and
+// must never be renumbered. New ops are added at the end and require a
+// new |DlSerialization::kVersion|.
+enum class SerializedOp : uint32_t {
+  kSetAntiAlias = 1,
+  kSetDrawStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetMaskFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+
+  kClipRect,
+  kClipOval,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawDashedLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawTextFrame,
+  kDrawShadow,
+};
+
+// Attributes are written as a tag that is 0 for a null attribute and
+// otherwise 1 plus the value of the attribute's type enum.
+constexpr uint32_t kNullAttribute = 0u;
+
+// Image filters and runtime effect samplers are trees. Malformed data
+// could otherwise nest them deep enough to overflow the stack.
+constexpr int kMaxAttributeDepth = 32;
+
+// Nested DisplayLists are stored as complete serialized DisplayLists in a
+// side table and are decoded recursively.
+constexpr int kMaxDisplayListDepth = 64;
+
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+
+constexpr uint32_t kHasRTreeFlag = 1u << 0;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t flags;
+  uint32_t record_count;
+  uint32_t records_offset;
+  uint32_t records_length;
+  // Each table is |count| pairs of (offset, length) words followed by
+  // the 4 byte aligned contents of the entries.
+  uint32_t paths_offset;
+  uint32_t path_count;
+  uint32_t display_lists_offset;
+  uint32_t display_list_count;
+};
+
+static_assert(sizeof(Header) % 4 == 0);
+
+// Values that are read in place must not need more than the 4 byte
+// alignment that the format guarantees.
+static_assert(sizeof(DlColor) == 5 * sizeof(uint32_t));
+static_assert(alignof(DlColor) <= 4);
+
+constexpr size_t Align4(size_t size) {
+  return (size + 3u) & ~static_cast<size_t>(3u);
+}
+
+// Counts, lengths and offsets are stored as 32 bit values.
+uint32_t ToU32(size_t value) {
+  FML_DCHECK(value <= std::numeric_limits<uint32_t>::max());
+  return static_cast<uint32_t>(value);
+}
+
+class ByteWriter {
+ public:
+  size_t size() const { return bytes_.size(); }
+
+  void WriteU32(uint32_t value) { WritePod(value); }
+  void WriteBool(bool value) { WriteU32(value ? 1u : 0u); }
+  void WriteF32(float value) { WritePod(value); }
+
+  template <typename T>
+  void WriteEnum(T value) {
+    WriteU32(static_cast<uint32_t>(value));
+  }
+
+  template <typename T>
+  void WritePod(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) % 4 == 0);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteArray(const T* values, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(values, count * sizeof(T));
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    WritePod(rrect.rect());
+    for (int i = 0; i < 4; i++) {
+      WritePod(rrect.radii(static_cast<SkRRect::Corner>(i)));
+    }
+  }
+
+  void WriteMatrix(const SkMatrix& matrix) {
+    float values[9];
+    matrix.get9(values);
+    WriteArray(values, 9);
+  }
+
+  // Writes the bytes and pads them to a multiple of 4.
+  void WriteBytes(const void* data, size_t length) {
+    if (length == 0u) {
+      return;
+    }
+    const size_t offset = bytes_.size();
+    bytes_.resize(offset + Align4(length), 0u);
+    memcpy(bytes_.data() + offset, data, length);
+  }
+
+  void PatchU32(size_t offset, uint32_t value) {
+    FML_DCHECK(offset + sizeof(value) <= bytes_.size());
+    memcpy(bytes_.data() + offset, &value, sizeof(value));
+  }
+
+  void Append(const ByteWriter& other) {
+    bytes_.insert(bytes_.end(), other.bytes_.begin(), other.bytes_.end());
+  }
+
+  std::vector<uint8_t> Take() { return std::move(bytes_); }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+class ByteReader {
+ public:
+  ByteReader(const uint8_t* data, size_t length)
+      : data_(data), length_(length) {}
+
+  bool ok() const { return ok_; }
+  bool at_end() const { return position_ == length_; }
+
+  uint32_t ReadU32() { return ReadPod<uint32_t>(); }
+  bool ReadBool() { return ReadU32() != 0u; }
+  float ReadF32() { return ReadPod<float>(); }
+
+  // Reads an enum value and fails if it is greater than |last|.
+  template <typename T>
+  T ReadEnum(T last) {
+    uint32_t value = ReadU32();
+    if (value > static_cast<uint32_t>(last)) {
+      ok_ = false;
+      return static_cast<T>(0);
+    }
+    return static_cast<T>(value);
+  }
+
+  template <typename T>
+  T ReadPod() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (const uint8_t* bytes = Consume(sizeof(T))) {
+      memcpy(&value, bytes, sizeof(T));
+    }
+    return value;
+  }
+
+  // Returns a pointer to |count| values within the source bytes, or null
+  // if there are not enough bytes left.
+  template <typename T>
+  const T* ReadArray(size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(alignof(T) <= 4);
+    if (count > length_ / sizeof(T)) {
+      ok_ = false;
+      return nullptr;
+    }
+    return reinterpret_cast<const T*>(Consume(count * sizeof(T)));
+  }
+
+  const uint8_t* ReadBytes(size_t length) { return Consume(length); }
+
+  DlColor ReadColor() {
+    DlColor color = ReadPod<DlColor>();
+    if (static_cast<uint32_t>(color.getColorSpace()) >
+        static_cast<uint32_t>(DlColorSpace::kDisplayP3)) {
+      ok_ = false;
+    }
+    return color;
+  }
+
+  SkRRect ReadRRect() {
+    SkRect rect = ReadPod<SkRect>();
+    SkVector radii[4];
+    for (auto& radius : radii) {
+      radius = ReadPod<SkVector>();
+    }
+    SkRRect rrect;
+    rrect.setRectRadii(rect, radii);
+    return rrect;
+  }
+
+  SkMatrix ReadMatrix() {
+    SkMatrix matrix;
+    if (const float* values = ReadArray<float>(9)) {
+      matrix.set9(values);
+    }
+    return matrix;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t length_;
+  size_t position_ = 0u;
+  bool ok_ = true;
+
+  const uint8_t* Consume(size_t length) {
+    if (!ok_ || length > length_ - position_) {
+      ok_ = false;
+      return nullptr;
+    }
+    const uint8_t* bytes = data_ + position_;
+    position_ += Align4(length) <= length_ - position_ ? Align4(length)
+                                                       : length_ - position_;
+    return bytes;
+  }
+};
+
+// Assigns each distinct object an index in a resource table.
+template <typename T>
+class ResourceTable {
+ public:
+  explicit ResourceTable(std::vector<T>* objects) : objects_(objects) {}
+
+  uint32_t IndexOf(const T& object) {
+    auto [it, inserted] =
+        indices_.try_emplace(object.get(), ToU32(objects_->size()));
+    if (inserted) {
+      objects_->push_back(object);
+    }
+    return it->second;
+  }
+
+ private:
+  std::vector<T>* objects_;
+  std::unordered_map<const void*, uint32_t> indices_;
+};
+
+bool SerializeDisplayList(const DisplayList& display_list,
+                          DlSerializationResources* resources,
+                          ByteWriter& output);
+
+// Records the ops dispatched from a DisplayList.
+class SerializingReceiver final : public DlOpReceiver {
+ public:
+  explicit SerializingReceiver(DlSerializationResources* resources)
+      : resources_(resources),
+        images_(resources ? &resources->images : nullptr),
+        text_blobs_(resources ? &resources->text_blobs : nullptr),
+        text_frames_(resources ? &resources->text_frames : nullptr),
+        runtime_effects_(resources ? &resources->runtime_effects : nullptr) {}
+
+  bool is_valid() const { return valid_; }
+  uint32_t record_count() const { return record_count_; }
+  const ByteWriter& records() const { return records_; }
+  const std::vector<DlPath>& paths() const { return paths_; }
+  const std::vector<sk_sp<DisplayList>>& display_lists() const {
+    return display_lists_;
+  }
+
+  // |DlOpReceiver|
+  void setAntiAlias(bool aa) override {
+    AddRecord(SerializedOp::kSetAntiAlias, [&] { records_.WriteBool(aa); });
+  }
+
+  // |DlOpReceiver|
+  void setDrawStyle(DlDrawStyle style) override {
+    AddRecord(SerializedOp::kSetDrawStyle,
+              [&] { records_.WriteEnum(style); });
+  }
+
+  // |DlOpReceiver|
+  void setColor(DlColor color) override {
+    AddRecord(SerializedOp::kSetColor, [&] { records_.WritePod(color); });
+  }
+
+  // |DlOpReceiver|
+  void setStrokeWidth(float width) override {
+    AddRecord(SerializedOp::kSetStrokeWidth,
+              [&] { records_.WriteF32(width); });
+  }
+
+  // |DlOpReceiver|
+  void setStrokeMiter(float limit) override {
+    AddRecord(SerializedOp::kSetStrokeMiter,
+              [&] { records_.WriteF32(limit); });
+  }
+
+  // |DlOpReceiver|
+  void setStrokeCap(DlStrokeCap cap) override {
+    AddRecord(SerializedOp::kSetStrokeCap, [&] { records_.WriteEnum(cap); });
+  }
+
+  // |DlOpReceiver|
+  void setStrokeJoin(DlStrokeJoin join) override {
+    AddRecord(SerializedOp::kSetStrokeJoin,
+              [&] { records_.WriteEnum(join); });
+  }
+
+  // |DlOpReceiver|
+  void setColorSource(const DlColorSource* source) override {
+    AddRecord(SerializedOp::kSetColorSource,
+              [&] { WriteColorSource(source); });
+  }
+
+  // |DlOpReceiver|
+  void setColorFilter(const DlColorFilter* filter) override {
+    AddRecord(SerializedOp::kSetColorFilter,
+              [&] { WriteColorFilter(filter); });
+  }
+
+  // |DlOpReceiver|
+  void setInvertColors(bool invert) override {
+    AddRecord(SerializedOp::kSetInvertColors,
+              [&] { records_.WriteBool(invert); });
+  }
+
+  // |DlOpReceiver|
+  void setBlendMode(DlBlendMode mode) override {
+    AddRecord(SerializedOp::kSetBlendMode, [&] { records_.WriteEnum(mode); });
+  }
+
+  // |DlOpReceiver|
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    AddRecord(SerializedOp::kSetMaskFilter, [&] { WriteMaskFilter(filter); });
+  }
+
+  // |DlOpReceiver|
+  void setImageFilter(const DlImageFilter* filter) override {
+    AddRecord(SerializedOp::kSetImageFilter,
+              [&] { WriteImageFilter(filter); });
+  }
+
+  // |DlOpReceiver|
+  void save() override {
+    AddRecord(SerializedOp::kSave, [] {});
+  }
+
+  // |DlOpReceiver|
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    // The remaining options are optimizations that the builder computes
+    // again when the DisplayList is loaded.
+    AddRecord(SerializedOp::kSaveLayer, [&] {
+      records_.WritePod(bounds);
+      records_.WriteBool(options.renders_with_attributes());
+      records_.WriteBool(options.bounds_from_caller());
+      WriteImageFilter(backdrop);
+    });
+  }
+
+  // |DlOpReceiver|
+  void restore() override {
+    AddRecord(SerializedOp::kRestore, [] {});
+  }
+
+  // |DlOpReceiver|
+  void translate(DlScalar tx, DlScalar ty) override {
+    AddRecord(SerializedOp::kTranslate, [&] {
+      records_.WriteF32(tx);
+      records_.WriteF32(ty);
+    });
+  }
+
+  // |DlOpReceiver|
+  void scale(DlScalar sx, DlScalar sy) override {
+    AddRecord(SerializedOp::kScale, [&] {
+      records_.WriteF32(sx);
+      records_.WriteF32(sy);
+    });
+  }
+
+  // |DlOpReceiver|
+  void rotate(DlScalar degrees) override {
+    AddRecord(SerializedOp::kRotate, [&] { records_.WriteF32(degrees); });
+  }
+
+  // |DlOpReceiver|
+  void skew(DlScalar sx, DlScalar sy) override {
+    AddRecord(SerializedOp::kSkew, [&] {
+      records_.WriteF32(sx);
+      records_.WriteF32(sy);
+    });
+  }
+
+  // clang-format off
+  // |DlOpReceiver|
+  void transform2DAffine(DlScalar mxx, DlScalar mxy, DlScalar mxt,
+                         DlScalar myx, DlScalar myy, DlScalar myt) override {
+    const DlScalar values[] = {mxx, mxy, mxt,
+                               myx, myy, myt};
+    AddRecord(SerializedOp::kTransform2DAffine,
+              [&] { records_.WriteArray(values, 6); });
+  }
+
+  // |DlOpReceiver|
+  void transformFullPerspective(
+      DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+      DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+      DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+      DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) override {
+    const DlScalar values[] = {mxx, mxy, mxz, mxt,
+                               myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt,
+                               mwx, mwy, mwz, mwt};
+    AddRecord(SerializedOp::kTransformFullPerspective,
+              [&] { records_.WriteArray(values, 16); });
+  }
+  // clang-format on
+
+  // |DlOpReceiver|
+  void transformReset() override {
+    AddRecord(SerializedOp::kTransformReset, [] {});
+  }
+
+  // |DlOpReceiver|
+  void clipRect(const DlRect& rect, ClipOp clip_op, bool is_aa) override {
+    AddRecord(SerializedOp::kClipRect, [&] {
+      records_.WritePod(rect);
+      records_.WriteEnum(clip_op);
+      records_.WriteBool(is_aa);
+    });
+  }
+
+  // |DlOpReceiver|
+  void clipOval(const DlRect& bounds, ClipOp clip_op, bool is_aa) override {
+    AddRecord(SerializedOp::kClipOval, [&] {
+      records_.WritePod(bounds);
+      records_.WriteEnum(clip_op);
+      records_.WriteBool(is_aa);
+    });
+  }
+
+  // |DlOpReceiver|
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    AddRecord(SerializedOp::kClipRRect, [&] {
+      records_.WriteRRect(rrect);
+      records_.WriteEnum(clip_op);
+      records_.WriteBool(is_aa);
+    });
+  }
+
+  // |DlOpReceiver|
+  void clipPath(const DlPath& path, ClipOp clip_op, bool is_aa) override {
+    AddRecord(SerializedOp::kClipPath, [&] {
+      records_.WriteU32(PathIndex(path));
+      records_.WriteEnum(clip_op);
+      records_.WriteBool(is_aa);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    AddRecord(SerializedOp::kDrawColor, [&] {
+      records_.WritePod(color);
+      records_.WriteEnum(mode);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawPaint() override {
+    AddRecord(SerializedOp::kDrawPaint, [] {});
+  }
+
+  // |DlOpReceiver|
+  void drawLine(const DlPoint& p0, const DlPoint& p1) override {
+    AddRecord(SerializedOp::kDrawLine, [&] {
+      records_.WritePod(p0);
+      records_.WritePod(p1);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override {
+    AddRecord(SerializedOp::kDrawDashedLine, [&] {
+      records_.WritePod(p0);
+      records_.WritePod(p1);
+      records_.WriteF32(on_length);
+      records_.WriteF32(off_length);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawRect(const DlRect& rect) override {
+    AddRecord(SerializedOp::kDrawRect, [&] { records_.WritePod(rect); });
+  }
+
+  // |DlOpReceiver|
+  void drawOval(const DlRect& bounds) override {
+    AddRecord(SerializedOp::kDrawOval, [&] { records_.WritePod(bounds); });
+  }
+
+  // |DlOpReceiver|
+  void drawCircle(const DlPoint& center, DlScalar radius) override {
+    AddRecord(SerializedOp::kDrawCircle, [&] {
+      records_.WritePod(center);
+      records_.WriteF32(radius);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawRRect(const SkRRect& rrect) override {
+    AddRecord(SerializedOp::kDrawRRect, [&] { records_.WriteRRect(rrect); });
+  }
+
+  // |DlOpReceiver|
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    AddRecord(SerializedOp::kDrawDRRect, [&] {
+      records_.WriteRRect(outer);
+      records_.WriteRRect(inner);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawPath(const DlPath& path) override {
+    AddRecord(SerializedOp::kDrawPath,
+              [&] { records_.WriteU32(PathIndex(path)); });
+  }
+
+  // |DlOpReceiver|
+  void drawArc(const DlRect& oval_bounds,
+               DlScalar start_degrees,
+               DlScalar sweep_degrees,
+               bool use_center) override {
+    AddRecord(SerializedOp::kDrawArc, [&] {
+      records_.WritePod(oval_bounds);
+      records_.WriteF32(start_degrees);
+      records_.WriteF32(sweep_degrees);
+      records_.WriteBool(use_center);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const DlPoint points[]) override {
+    AddRecord(SerializedOp::kDrawPoints, [&] {
+      records_.WriteEnum(mode);
+      records_.WriteU32(count);
+      records_.WriteArray(points, count);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawVertices(const std::shared_ptr<DlVertices>& vertices,
+                    DlBlendMode mode) override {
+    AddRecord(SerializedOp::kDrawVertices, [&] {
+      const int count = vertices->vertex_count();
+      records_.WriteEnum(mode);
+      records_.WriteEnum(vertices->mode());
+      records_.WriteU32(count);
+      records_.WriteBool(vertices->texture_coordinates() != nullptr);
+      records_.WriteBool(vertices->colors() != nullptr);
+      records_.WriteU32(vertices->index_count());
+      records_.WriteArray(vertices->vertices(), count);
+      if (vertices->texture_coordinates()) {
+        records_.WriteArray(vertices->texture_coordinates(), count);
+      }
+      if (vertices->colors()) {
+        records_.WriteArray(vertices->colors(), count);
+      }
+      if (vertices->index_count() > 0) {
+        records_.WriteArray(vertices->indices(), vertices->index_count());
+      }
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawImage(const sk_sp<DlImage> image,
+                 const DlPoint& point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    AddRecord(SerializedOp::kDrawImage, [&] {
+      records_.WriteU32(ImageIndex(image));
+      records_.WritePod(point);
+      records_.WriteEnum(sampling);
+      records_.WriteBool(render_with_attributes);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const DlRect& src,
+                     const DlRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    AddRecord(SerializedOp::kDrawImageRect, [&] {
+      records_.WriteU32(ImageIndex(image));
+      records_.WritePod(src);
+      records_.WritePod(dst);
+      records_.WriteEnum(sampling);
+      records_.WriteBool(render_with_attributes);
+      records_.WriteEnum(constraint);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const DlIRect& center,
+                     const DlRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    AddRecord(SerializedOp::kDrawImageNine, [&] {
+      records_.WriteU32(ImageIndex(image));
+      records_.WritePod(center);
+      records_.WritePod(dst);
+      records_.WriteEnum(filter);
+      records_.WriteBool(render_with_attributes);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const DlRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const DlRect* cull_rect,
+                 bool render_with_attributes) override {
+    AddRecord(SerializedOp::kDrawAtlas, [&] {
+      records_.WriteU32(ImageIndex(atlas));
+      records_.WriteU32(count);
+      records_.WriteEnum(mode);
+      records_.WriteEnum(sampling);
+      records_.WriteBool(render_with_attributes);
+      records_.WriteBool(colors != nullptr);
+      records_.WriteBool(cull_rect != nullptr);
+      if (cull_rect) {
+        records_.WritePod(*cull_rect);
+      }
+      records_.WriteArray(xform, count);
+      records_.WriteArray(tex, count);
+      if (colors) {
+        records_.WriteArray(colors, count);
+      }
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity) override {
+    AddRecord(SerializedOp::kDrawDisplayList, [&] {
+      auto [it, inserted] = display_list_indices_.try_emplace(
+          display_list.get(), ToU32(display_lists_.size()));
+      if (inserted) {
+        display_lists_.push_back(display_list);
+      }
+      records_.WriteU32(it->second);
+      records_.WriteF32(opacity);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    DlScalar x,
+                    DlScalar y) override {
+    AddRecord(SerializedOp::kDrawTextBlob, [&] {
+      records_.WriteU32(ResourceIndex(text_blobs_, blob));
+      records_.WriteF32(x);
+      records_.WriteF32(y);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     DlScalar x,
+                     DlScalar y) override {
+    AddRecord(SerializedOp::kDrawTextFrame, [&] {
+      records_.WriteU32(ResourceIndex(text_frames_, text_frame));
+      records_.WriteF32(x);
+      records_.WriteF32(y);
+    });
+  }
+
+  // |DlOpReceiver|
+  void drawShadow(const DlPath& path,
+                  const DlColor color,
+                  const DlScalar elevation,
+                  bool transparent_occluder,
+                  DlScalar dpr) override {
+    AddRecord(SerializedOp::kDrawShadow, [&] {
+      records_.WriteU32(PathIndex(path));
+      records_.WritePod(color);
+      records_.WriteF32(elevation);
+      records_.WriteBool(transparent_occluder);
+      records_.WriteF32(dpr);
+    });
+  }
+
+ private:
+  DlSerializationResources* resources_;
+  ResourceTable<sk_sp<DlImage>> images_;
+  ResourceTable<sk_sp<SkTextBlob>> text_blobs_;
+  ResourceTable<std::shared_ptr<impeller::TextFrame>> text_frames_;
+  ResourceTable<sk_sp<DlRuntimeEffect>> runtime_effects_;
+
+  ByteWriter records_;
+  uint32_t record_count_ = 0u;
+  bool valid_ = true;
+
+  // Paths are shared by generation ID and fill type so that a path drawn
+  // many times is only stored and decoded once.
+  std::vector<DlPath> paths_;
+  std::unordered_map<uint64_t, uint32_t> path_indices_;
+
+  std::vector<sk_sp<DisplayList>> display_lists_;
+  std::unordered_map<const DisplayList*, uint32_t> display_list_indices_;
+
+  template <typename PayloadWriter>
+  void AddRecord(SerializedOp op, const PayloadWriter& write_payload) {
+    records_.WriteEnum(op);
+    const size_t length_offset = records_.size();
+    records_.WriteU32(0u);
+    write_payload();
+    const size_t length = records_.size() - length_offset - sizeof(uint32_t);
+    records_.PatchU32(length_offset, ToU32(length));
+    record_count_++;
+  }
+
+  template <typename T>
+  uint32_t ResourceIndex(ResourceTable<T>& table, const T& object) {
+    if (!resources_) {
+      valid_ = false;
+      return 0u;
+    }
+    return table.IndexOf(object);
+  }
+
+  uint32_t ImageIndex(const sk_sp<const DlImage>& image) {
+    return ResourceIndex(images_,
+                         sk_ref_sp(const_cast<DlImage*>(image.get())));
+  }
+
+  uint32_t PathIndex(const DlPath& path) {
+    const SkPath& sk_path = path.GetSkPath();
+    const uint64_t key =
+        (static_cast<uint64_t>(sk_path.getGenerationID()) << 8) |
+        static_cast<uint64_t>(sk_path.getFillType());
+    auto [it, inserted] = path_indices_.try_emplace(key, ToU32(paths_.size()));
+    if (inserted) {
+      paths_.push_back(path);
+    }
+    return it->second;
+  }
+
+  void WriteGradient(const DlGradientColorSourceBase* gradient) {
+    records_.WriteU32(gradient->stop_count());
+    records_.WriteArray(gradient->colors(), gradient->stop_count());
+    records_.WriteArray(gradient->stops(), gradient->stop_count());
+    records_.WriteEnum(gradient->tile_mode());
+    records_.WriteMatrix(gradient->matrix());
+  }
+
+  void WriteColorSource(const DlColorSource* source) {
+    if (!source) {
+      records_.WriteU32(kNullAttribute);
+      return;
+    }
+    records_.WriteU32(static_cast<uint32_t>(source->type()) + 1u);
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+        records_.WritePod(source->asColor()->color());
+        break;
+      case DlColorSourceType::kImage: {
+        const DlImageColorSource* image_source = source->asImage();
+        records_.WriteU32(ImageIndex(image_source->image()));
+        records_.WriteEnum(image_source->horizontal_tile_mode());
+        records_.WriteEnum(image_source->vertical_tile_mode());
+        records_.WriteEnum(image_source->sampling());
+        records_.WriteMatrix(image_source->matrix());
+        break;
+      }
+      case DlColorSourceType::kLinearGradient: {
+        const DlLinearGradientColorSource* linear = source->asLinearGradient();
+        records_.WritePod(linear->start_point());
+        records_.WritePod(linear->end_point());
+        WriteGradient(linear);
+        break;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        const DlRadialGradientColorSource* radial = source->asRadialGradient();
+        records_.WritePod(radial->center());
+        records_.WriteF32(radial->radius());
+        WriteGradient(radial);
+        break;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        const DlConicalGradientColorSource* conical =
+            source->asConicalGradient();
+        records_.WritePod(conical->start_center());
+        records_.WriteF32(conical->start_radius());
+        records_.WritePod(conical->end_center());
+        records_.WriteF32(conical->end_radius());
+        WriteGradient(conical);
+        break;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        const DlSweepGradientColorSource* sweep = source->asSweepGradient();
+        records_.WritePod(sweep->center());
+        records_.WriteF32(sweep->start());
+        records_.WriteF32(sweep->end());
+        WriteGradient(sweep);
+        break;
+      }
+      case DlColorSourceType::kRuntimeEffect: {
+        const DlRuntimeEffectColorSource* effect = source->asRuntimeEffect();
+        records_.WriteU32(
+            ResourceIndex(runtime_effects_, effect->runtime_effect()));
+        const auto samplers = effect->samplers();
+        records_.WriteU32(ToU32(samplers.size()));
+        for (const auto& sampler : samplers) {
+          WriteColorSource(sampler.get());
+        }
+        const auto uniform_data = effect->uniform_data();
+        const size_t uniform_size = uniform_data ? uniform_data->size() : 0u;
+        records_.WriteU32(ToU32(uniform_size));
+        if (uniform_size > 0u) {
+          records_.WriteBytes(uniform_data->data(), uniform_size);
+        }
+        break;
+      }
+    }
+  }
+
+  void WriteColorFilter(const DlColorFilter* filter) {
+    if (!filter) {
+      records_.WriteU32(kNullAttribute);
+      return;
+    }
+    records_.WriteU32(static_cast<uint32_t>(filter->type()) + 1u);
+    switch (filter->type()) {
+      case DlColorFilterType::kBlend:
+        records_.WritePod(filter->asBlend()->color());
+        records_.WriteEnum(filter->asBlend()->mode());
+        break;
+      case DlColorFilterType::kMatrix: {
+        float matrix[20];
+        filter->asMatrix()->get_matrix(matrix);
+        records_.WriteArray(matrix, 20);
+        break;
+      }
+      case DlColorFilterType::kSrgbToLinearGamma:
+      case DlColorFilterType::kLinearToSrgbGamma:
+        break;
+    }
+  }
+
+  void WriteMaskFilter(const DlMaskFilter* filter) {
+    if (!filter) {
+      records_.WriteU32(kNullAttribute);
+      return;
+    }
+    records_.WriteU32(static_cast<uint32_t>(filter->type()) + 1u);
+    switch (filter->type()) {
+      case DlMaskFilterType::kBlur:
+        records_.WriteEnum(filter->asBlur()->style());
+        records_.WriteF32(filter->asBlur()->sigma());
+        records_.WriteBool(filter->asBlur()->respectCTM());
+        break;
+    }
+  }
+
+  void WriteImageFilter(const DlImageFilter* filter) {
+    if (!filter) {
+      records_.WriteU32(kNullAttribute);
+      return;
+    }
+    records_.WriteU32(static_cast<uint32_t>(filter->type()) + 1u);
+    switch (filter->type()) {
+      case DlImageFilterType::kBlur:
+        records_.WriteF32(filter->asBlur()->sigma_x());
+        records_.WriteF32(filter->asBlur()->sigma_y());
+        records_.WriteEnum(filter->asBlur()->tile_mode());
+        break;
+      case DlImageFilterType::kDilate:
+        records_.WriteF32(filter->asDilate()->radius_x());
+        records_.WriteF32(filter->asDilate()->radius_y());
+        break;
+      case DlImageFilterType::kErode:
+        records_.WriteF32(filter->asErode()->radius_x());
+        records_.WriteF32(filter->asErode()->radius_y());
+        break;
+      case DlImageFilterType::kMatrix:
+        records_.WriteMatrix(filter->asMatrix()->matrix());
+        records_.WriteEnum(filter->asMatrix()->sampling());
+        break;
+      case DlImageFilterType::kCompose:
+        WriteImageFilter(filter->asCompose()->outer().get());
+        WriteImageFilter(filter->asCompose()->inner().get());
+        break;
+      case DlImageFilterType::kColorFilter:
+        WriteColorFilter(filter->asColorFilter()->color_filter().get());
+        break;
+      case DlImageFilterType::kLocalMatrix:
+        records_.WriteMatrix(filter->asLocalMatrix()->matrix());
+        WriteImageFilter(filter->asLocalMatrix()->image_filter().get());
+        break;
+    }
+  }
+};
+
+// Writes a table of (offset, length) pairs followed by the entries. The
+// offsets are relative to the start of the serialized DisplayList, which
+// begins at |base| in |output|.
+template <typename EntryWriter>
+uint32_t WriteTable(ByteWriter& output,
+                    size_t base,
+                    size_t count,
+                    const EntryWriter& write_entry) {
+  const uint32_t table_offset = ToU32(output.size() - base);
+  const size_t entries_offset = output.size();
+  for (size_t i = 0; i < count; i++) {
+    output.WriteU32(0u);
+    output.WriteU32(0u);
+  }
+  for (size_t i = 0; i < count; i++) {
+    const size_t start = output.size();
+    if (!write_entry(i)) {
+      return 0u;
+    }
+    output.PatchU32(entries_offset + i * 8u, ToU32(start - base));
+    output.PatchU32(entries_offset + i * 8u + 4u,
+                    ToU32(output.size() - start));
+  }
+  return table_offset;
+}
+
+bool SerializeDisplayList(const DisplayList& display_list,
+                          DlSerializationResources* resources,
+                          ByteWriter& output) {
+  SerializingReceiver receiver(resources);
+  display_list.Dispatch(receiver);
+  if (!receiver.is_valid()) {
+    return false;
+  }
+
+  const size_t base = output.size();
+  Header header = {};
+  header.magic = DlSerialization::kMagic;
+  header.version = DlSerialization::kVersion;
+  header.byte_order = kByteOrderMark;
+  header.flags = display_list.has_rtree() ? kHasRTreeFlag : 0u;
+  header.record_count = receiver.record_count();
+  output.WritePod(header);
+
+  header.records_offset = ToU32(output.size() - base);
+  header.records_length = ToU32(receiver.records().size());
+  output.Append(receiver.records());
+
+  const auto& paths = receiver.paths();
+  header.path_count = ToU32(paths.size());
+  header.paths_offset = WriteTable(output, base, paths.size(), [&](size_t i) {
+    const SkPath& path = paths[i].GetSkPath();
+    std::vector<uint8_t> bytes(path.writeToMemory(nullptr));
+    path.writeToMemory(bytes.data());
+    output.WriteBytes(bytes.data(), bytes.size());
+    return true;
+  });
+
+  const auto& display_lists = receiver.display_lists();
+  header.display_list_count = ToU32(display_lists.size());
+  header.display_lists_offset =
+      WriteTable(output, base, display_lists.size(), [&](size_t i) {
+        return SerializeDisplayList(*display_lists[i], resources, output);
+      });
+  if (display_lists.size() > 0u && header.display_lists_offset == 0u) {
+    return false;
+  }
+
+  output.PatchU32(base + offsetof(Header, records_offset),
+                  header.records_offset);
+  output.PatchU32(base + offsetof(Header, records_length),
+                  header.records_length);
+  output.PatchU32(base + offsetof(Header, paths_offset), header.paths_offset);
+  output.PatchU32(base + offsetof(Header, path_count), header.path_count);
+  output.PatchU32(base + offsetof(Header, display_lists_offset),
+                  header.display_lists_offset);
+  output.PatchU32(base + offsetof(Header, display_list_count),
+                  header.display_list_count);
+  return true;
+}
+
+sk_sp<DisplayList> DeserializeDisplayList(
+    const uint8_t* data,
+    size_t length,
+    const DlSerializationResources& resources,
+    int depth);
+
+// Replays the records of one serialized DisplayList onto a canvas, tracking
+// the attributes they set in a paint that is passed to the draw calls.
+class RecordReader {
+ public:
+  RecordReader(const uint8_t* data,
+               size_t length,
+               const DlSerializationResources& resources,
+               int depth)
+      : data_(data), length_(length), resources_(resources), depth_(depth) {}
+
+  bool ReadHeader() {
+    ByteReader reader(data_, length_);
+    header_ = reader.ReadPod<Header>();
+    if (!reader.ok() || header_.magic != DlSerialization::kMagic ||
+        header_.version != DlSerialization::kVersion ||
+        header_.byte_order != kByteOrderMark) {
+      return false;
+    }
+    return ReadTable(header_.paths_offset, header_.path_count, path_entries_) &&
+           ReadTable(header_.display_lists_offset, header_.display_list_count,
+                     display_list_entries_) &&
+           Slice(header_.records_offset, header_.records_length) != nullptr;
+  }
+
+  bool has_rtree() const { return (header_.flags & kHasRTreeFlag) != 0u; }
+
+  bool Replay(DlCanvas& canvas) {
+    paths_.resize(path_entries_.size());
+    display_lists_.resize(display_list_entries_.size());
+    ByteReader records(data_ + header_.records_offset,
+                       header_.records_length);
+    for (uint32_t i = 0; i < header_.record_count; i++) {
+      const uint32_t op = records.ReadU32();
+      const uint32_t length = records.ReadU32();
+      const uint8_t* payload = records.ReadBytes(length);
+      if (!records.ok()) {
+        return false;
+      }
+      ByteReader reader(payload, length);
+      if (!ReplayRecord(static_cast<SerializedOp>(op), reader, canvas) ||
+          !reader.ok()) {
+        return false;
+      }
+    }
+    return records.at_end();
+  }
+
+ private:
+  struct Entry {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  const uint8_t* data_;
+  size_t length_;
+  const DlSerializationResources& resources_;
+  const int depth_;
+  Header header_ = {};
+  DlPaint paint_;
+
+  std::vector<Entry> path_entries_;
+  std::vector<std::optional<DlPath>> paths_;
+  std::vector<Entry> display_list_entries_;
+  std::vector<sk_sp<DisplayList>> display_lists_;
+
+  const uint8_t* Slice(uint32_t offset, uint32_t length) const {
+    if (offset % 4u != 0u || offset > length_ || length > length_ - offset) {
+      return nullptr;
+    }
+    return data_ + offset;
+  }
+
+  bool ReadTable(uint32_t offset, uint32_t count, std::vector<Entry>& entries) {
+    if (count == 0u) {
+      return true;
+    }
+    ByteReader reader(data_, length_);
+    if (!Slice(offset, 0u) || !reader.ReadBytes(offset)) {
+      return false;
+    }
+    const Entry* table = reader.ReadArray<Entry>(count);
+    if (!table) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      if (!Slice(table[i].offset, table[i].length)) {
+        return false;
+      }
+    }
+    entries.assign(table, table + count);
+    return true;
+  }
+
+  const DlPath* GetPath(uint32_t index) {
+    if (index >= paths_.size()) {
+      return nullptr;
+    }
+    if (!paths_[index].has_value()) {
+      const Entry& entry = path_entries_[index];
+      SkPath path;
+      if (path.readFromMemory(data_ + entry.offset, entry.length) == 0u) {
+        return nullptr;
+      }
+      paths_[index].emplace(path);
+    }
+    return &paths_[index].value();
+  }
+
+  sk_sp<DisplayList> GetDisplayList(uint32_t index) {
+    if (index >= display_lists_.size()) {
+      return nullptr;
+    }
+    if (!display_lists_[index]) {
+      const Entry& entry = display_list_entries_[index];
+      display_lists_[index] = DeserializeDisplayList(
+          data_ + entry.offset, entry.length, resources_, depth_ + 1);
+    }
+    return display_lists_[index];
+  }
+
+  template <typename T>
+  static const T* GetResource(const std::vector<T>& table, uint32_t index) {
+    if (index >= table.size() || !table[index]) {
+      return nullptr;
+    }
+    return &table[index];
+  }
+
+  bool ReadGradient(ByteReader& reader,
+                    uint32_t* stop_count,
+                    const DlColor** colors,
+                    const float** stops,
+                    DlTileMode* tile_mode,
+                    SkMatrix* matrix) {
+    *stop_count = reader.ReadU32();
+    *colors = reader.ReadArray<DlColor>(*stop_count);
+    *stops = reader.ReadArray<float>(*stop_count);
+    *tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+    *matrix = reader.ReadMatrix();
+    return reader.ok();
+  }
+
+  static const SkMatrix* MatrixPtr(const SkMatrix& matrix) {
+    return matrix.isIdentity() ? nullptr : &matrix;
+  }
+
+  // Reads a color source. A null result is either a null attribute or a
+  // failure, which is reported through |ok|.
+  std::shared_ptr<DlColorSource> ReadColorSource(ByteReader& reader,
+                                                 int depth,
+                                                 bool* ok) {
+    const uint32_t tag = reader.ReadU32();
+    if (!reader.ok() || depth > kMaxAttributeDepth ||
+        tag > static_cast<uint32_t>(DlColorSourceType::kRuntimeEffect) + 1u) {
+      *ok = false;
+      return nullptr;
+    }
+    if (tag == kNullAttribute) {
+      return nullptr;
+    }
+    uint32_t stop_count;
+    const DlColor* colors;
+    const float* stops;
+    DlTileMode tile_mode;
+    SkMatrix matrix;
+    switch (static_cast<DlColorSourceType>(tag - 1u)) {
+      case DlColorSourceType::kColor:
+        return std::make_shared<DlColorColorSource>(reader.ReadColor());
+      case DlColorSourceType::kImage: {
+        const auto* image = GetResource(resources_.images, reader.ReadU32());
+        const auto h_tile = reader.ReadEnum(DlTileMode::kDecal);
+        const auto v_tile = reader.ReadEnum(DlTileMode::kDecal);
+        const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        matrix = reader.ReadMatrix();
+        if (!image || !reader.ok()) {
+          *ok = false;
+          return nullptr;
+        }
+        return std::make_shared<DlImageColorSource>(
+            *image, h_tile, v_tile, sampling, MatrixPtr(matrix));
+      }
+      case DlColorSourceType::kLinearGradient: {
+        const auto start = reader.ReadPod<SkPoint>();
+        const auto end = reader.ReadPod<SkPoint>();
+        if (!ReadGradient(reader, &stop_count, &colors, &stops, &tile_mode,
+                          &matrix)) {
+          break;
+        }
+        return DlColorSource::MakeLinear(start, end, stop_count, colors, stops,
+                                         tile_mode, MatrixPtr(matrix));
+      }
+      case DlColorSourceType::kRadialGradient: {
+        const auto center = reader.ReadPod<SkPoint>();
+        const auto radius = reader.ReadF32();
+        if (!ReadGradient(reader, &stop_count, &colors, &stops, &tile_mode,
+                          &matrix)) {
+          break;
+        }
+        return DlColorSource::MakeRadial(center, radius, stop_count, colors,
+                                         stops, tile_mode, MatrixPtr(matrix));
+      }
+      case DlColorSourceType::kConicalGradient: {
+        const auto start_center = reader.ReadPod<SkPoint>();
+        const auto start_radius = reader.ReadF32();
+        const auto end_center = reader.ReadPod<SkPoint>();
+        const auto end_radius = reader.ReadF32();
+        if (!ReadGradient(reader, &stop_count, &colors, &stops, &tile_mode,
+                          &matrix)) {
+          break;
+        }
+        return DlColorSource::MakeConical(start_center, start_radius,
+                                          end_center, end_radius, stop_count,
+                                          colors, stops, tile_mode,
+                                          MatrixPtr(matrix));
+      }
+      case DlColorSourceType::kSweepGradient: {
+        const auto center = reader.ReadPod<SkPoint>();
+        const auto start = reader.ReadF32();
+        const auto end = reader.ReadF32();
+        if (!ReadGradient(reader, &stop_count, &colors, &stops, &tile_mode,
+                          &matrix)) {
+          break;
+        }
+        return DlColorSource::MakeSweep(center, start, end, stop_count, colors,
+                                        stops, tile_mode, MatrixPtr(matrix));
+      }
+      case DlColorSourceType::kRuntimeEffect: {
+        const auto* effect =
+            GetResource(resources_.runtime_effects, reader.ReadU32());
+        const uint32_t sampler_count = reader.ReadU32();
+        if (!effect || !reader.ok() || sampler_count > length_) {
+          break;
+        }
+        std::vector<std::shared_ptr<DlColorSource>> samplers;
+        samplers.reserve(sampler_count);
+        for (uint32_t i = 0; i < sampler_count; i++) {
+          samplers.push_back(ReadColorSource(reader, depth + 1, ok));
+          if (!*ok) {
+            return nullptr;
+          }
+        }
+        const uint32_t uniform_size = reader.ReadU32();
+        const uint8_t* uniform_bytes = reader.ReadBytes(uniform_size);
+        if (!reader.ok()) {
+          break;
+        }
+        return DlColorSource::MakeRuntimeEffect(
+            *effect, std::move(samplers),
+            std::make_shared<std::vector<uint8_t>>(
+                uniform_bytes, uniform_bytes + uniform_size));
+      }
+    }
+    *ok = false;
+    return nullptr;
+  }
+
+  std::shared_ptr<DlColorFilter> ReadColorFilter(ByteReader& reader,
+                                                 bool* ok) {
+    const uint32_t tag = reader.ReadU32();
+    if (!reader.ok() ||
+        tag > static_cast<uint32_t>(DlColorFilterType::kLinearToSrgbGamma) +
+                  1u) {
+      *ok = false;
+      return nullptr;
+    }
+    if (tag == kNullAttribute) {
+      return nullptr;
+    }
+    switch (static_cast<DlColorFilterType>(tag - 1u)) {
+      case DlColorFilterType::kBlend: {
+        const DlColor color = reader.ReadColor();
+        const DlBlendMode mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        return std::make_shared<DlBlendColorFilter>(color, mode);
+      }
+      case DlColorFilterType::kMatrix:
+        if (const float* matrix = reader.ReadArray<float>(20)) {
+          return std::make_shared<DlMatrixColorFilter>(matrix);
+        }
+        break;
+      case DlColorFilterType::kSrgbToLinearGamma:
+        return DlSrgbToLinearGammaColorFilter::kInstance;
+      case DlColorFilterType::kLinearToSrgbGamma:
+        return DlLinearToSrgbGammaColorFilter::kInstance;
+    }
+    *ok = false;
+    return nullptr;
+  }
+
+  std::shared_ptr<DlMaskFilter> ReadMaskFilter(ByteReader& reader, bool* ok) {
+    const uint32_t tag = reader.ReadU32();
+    if (!reader.ok() ||
+        tag > static_cast<uint32_t>(DlMaskFilterType::kBlur) + 1u) {
+      *ok = false;
+      return nullptr;
+    }
+    if (tag == kNullAttribute) {
+      return nullptr;
+    }
+    const DlBlurStyle style = reader.ReadEnum(DlBlurStyle::kInner);
+    const SkScalar sigma = reader.ReadF32();
+    const bool respect_ctm = reader.ReadBool();
+    return std::make_shared<DlBlurMaskFilter>(style, sigma, respect_ctm);
+  }
+
+  // The concrete filter types are constructed directly rather than through
+  // their |Make| factories so that no filter is simplified away and the
+  // loaded DisplayList compares equal to the original.
+  std::shared_ptr<DlImageFilter> ReadImageFilter(ByteReader& reader,
+                                                 int depth,
+                                                 bool* ok) {
+    const uint32_t tag = reader.ReadU32();
+    if (!reader.ok() || depth > kMaxAttributeDepth ||
+        tag > static_cast<uint32_t>(DlImageFilterType::kLocalMatrix) + 1u) {
+      *ok = false;
+      return nullptr;
+    }
+    if (tag == kNullAttribute) {
+      return nullptr;
+    }
+    switch (static_cast<DlImageFilterType>(tag - 1u)) {
+      case DlImageFilterType::kBlur: {
+        const SkScalar sigma_x = reader.ReadF32();
+        const SkScalar sigma_y = reader.ReadF32();
+        const DlTileMode tile_mode = reader.ReadEnum(DlTileMode::kDecal);
+        return std::make_shared<DlBlurImageFilter>(sigma_x, sigma_y,
+                                                   tile_mode);
+      }
+      case DlImageFilterType::kDilate: {
+        const SkScalar radius_x = reader.ReadF32();
+        const SkScalar radius_y = reader.ReadF32();
+        return std::make_shared<DlDilateImageFilter>(radius_x, radius_y);
+      }
+      case DlImageFilterType::kErode: {
+        const SkScalar radius_x = reader.ReadF32();
+        const SkScalar radius_y = reader.ReadF32();
+        return std::make_shared<DlErodeImageFilter>(radius_x, radius_y);
+      }
+      case DlImageFilterType::kMatrix: {
+        const SkMatrix matrix = reader.ReadMatrix();
+        const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        return std::make_shared<DlMatrixImageFilter>(matrix, sampling);
+      }
+      case DlImageFilterType::kCompose: {
+        auto outer = ReadImageFilter(reader, depth + 1, ok);
+        auto inner = ReadImageFilter(reader, depth + 1, ok);
+        if (!outer || !inner) {
+          break;
+        }
+        return std::make_shared<DlComposeImageFilter>(std::move(outer),
+                                                      std::move(inner));
+      }
+      case DlImageFilterType::kColorFilter:
+        if (auto color_filter = ReadColorFilter(reader, ok)) {
+          return std::make_shared<DlColorFilterImageFilter>(
+              std::move(color_filter));
+        }
+        break;
+      case DlImageFilterType::kLocalMatrix: {
+        const SkMatrix matrix = reader.ReadMatrix();
+        return std::make_shared<DlLocalMatrixImageFilter>(
+            matrix, ReadImageFilter(reader, depth + 1, ok));
+      }
+    }
+    *ok = false;
+    return nullptr;
+  }
+
+  bool ReplayRecord(SerializedOp op,
+                    ByteReader& reader,
+                    DlCanvas& canvas) {
+    using ClipOp = DlCanvas::ClipOp;
+    using PointMode = DlCanvas::PointMode;
+    using SrcRectConstraint = DlCanvas::SrcRectConstraint;
+
+    // Values are read into locals before they are passed on so that the
+    // order of the reads does not depend on the order in which the
+    // compiler evaluates arguments.
+    switch (op) {
+      case SerializedOp::kSetAntiAlias:
+        paint_.setAntiAlias(reader.ReadBool());
+        return true;
+      case SerializedOp::kSetDrawStyle:
+        paint_.setDrawStyle(reader.ReadEnum(DlDrawStyle::kLastStyle));
+        return true;
+      case SerializedOp::kSetColor:
+        paint_.setColor(reader.ReadColor());
+        return true;
+      case SerializedOp::kSetStrokeWidth:
+        paint_.setStrokeWidth(reader.ReadF32());
+        return true;
+      case SerializedOp::kSetStrokeMiter:
+        paint_.setStrokeMiter(reader.ReadF32());
+        return true;
+      case SerializedOp::kSetStrokeCap:
+        paint_.setStrokeCap(reader.ReadEnum(DlStrokeCap::kLastCap));
+        return true;
+      case SerializedOp::kSetStrokeJoin:
+        paint_.setStrokeJoin(reader.ReadEnum(DlStrokeJoin::kLastJoin));
+        return true;
+      case SerializedOp::kSetColorSource: {
+        bool ok = true;
+        auto source = ReadColorSource(reader, 0, &ok);
+        paint_.setColorSource(std::move(source));
+        return ok;
+      }
+      case SerializedOp::kSetColorFilter: {
+        bool ok = true;
+        auto filter = ReadColorFilter(reader, &ok);
+        paint_.setColorFilter(filter);
+        return ok;
+      }
+      case SerializedOp::kSetInvertColors:
+        paint_.setInvertColors(reader.ReadBool());
+        return true;
+      case SerializedOp::kSetBlendMode:
+        paint_.setBlendMode(reader.ReadEnum(DlBlendMode::kLastMode));
+        return true;
+      case SerializedOp::kSetMaskFilter: {
+        bool ok = true;
+        auto filter = ReadMaskFilter(reader, &ok);
+        paint_.setMaskFilter(filter);
+        return ok;
+      }
+      case SerializedOp::kSetImageFilter: {
+        bool ok = true;
+        auto filter = ReadImageFilter(reader, 0, &ok);
+        paint_.setImageFilter(filter);
+        return ok;
+      }
+
+      case SerializedOp::kSave:
+        canvas.Save();
+        return true;
+      case SerializedOp::kSaveLayer: {
+        const auto bounds = reader.ReadPod<DlRect>();
+        const bool render_with_attributes = reader.ReadBool();
+        const bool bounds_from_caller = reader.ReadBool();
+        bool ok = true;
+        auto backdrop = ReadImageFilter(reader, 0, &ok);
+        if (!ok || !reader.ok()) {
+          return false;
+        }
+        // Bounds that were computed by the builder are computed again.
+        canvas.SaveLayer(bounds_from_caller ? &ToSkRect(bounds) : nullptr,
+                         render_with_attributes ? &paint_ : nullptr,
+                         backdrop.get());
+        return true;
+      }
+      case SerializedOp::kRestore:
+        canvas.Restore();
+        return true;
+
+      case SerializedOp::kTranslate: {
+        const DlScalar tx = reader.ReadF32();
+        const DlScalar ty = reader.ReadF32();
+        canvas.Translate(tx, ty);
+        return true;
+      }
+      case SerializedOp::kScale: {
+        const DlScalar sx = reader.ReadF32();
+        const DlScalar sy = reader.ReadF32();
+        canvas.Scale(sx, sy);
+        return true;
+      }
+      case SerializedOp::kRotate:
+        canvas.Rotate(reader.ReadF32());
+        return true;
+      case SerializedOp::kSkew: {
+        const DlScalar sx = reader.ReadF32();
+        const DlScalar sy = reader.ReadF32();
+        canvas.Skew(sx, sy);
+        return true;
+      }
+      case SerializedOp::kTransform2DAffine: {
+        const DlScalar* m = reader.ReadArray<DlScalar>(6);
+        if (!m) {
+          return false;
+        }
+        canvas.Transform2DAffine(m[0], m[1], m[2],  //
+                                 m[3], m[4], m[5]);
+        return true;
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        const DlScalar* m = reader.ReadArray<DlScalar>(16);
+        if (!m) {
+          return false;
+        }
+        canvas.TransformFullPerspective(m[0], m[1], m[2], m[3],    //
+                                        m[4], m[5], m[6], m[7],    //
+                                        m[8], m[9], m[10], m[11],  //
+                                        m[12], m[13], m[14], m[15]);
+        return true;
+      }
+      case SerializedOp::kTransformReset:
+        canvas.TransformReset();
+        return true;
+
+      case SerializedOp::kClipRect:
+      case SerializedOp::kClipOval: {
+        const auto rect = reader.ReadPod<DlRect>();
+        const auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+        const bool is_aa = reader.ReadBool();
+        if (op == SerializedOp::kClipRect) {
+          canvas.ClipRect(ToSkRect(rect), clip_op, is_aa);
+        } else {
+          canvas.ClipOval(ToSkRect(rect), clip_op, is_aa);
+        }
+        return true;
+      }
+      case SerializedOp::kClipRRect: {
+        const SkRRect rrect = reader.ReadRRect();
+        const auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+        const bool is_aa = reader.ReadBool();
+        canvas.ClipRRect(rrect, clip_op, is_aa);
+        return true;
+      }
+      case SerializedOp::kClipPath: {
+        const DlPath* path = GetPath(reader.ReadU32());
+        const auto clip_op = reader.ReadEnum(ClipOp::kIntersect);
+        const bool is_aa = reader.ReadBool();
+        if (!path || !reader.ok()) {
+          return false;
+        }
+        canvas.ClipPath(*path, clip_op, is_aa);
+        return true;
+      }
+
+      case SerializedOp::kDrawColor: {
+        const DlColor color = reader.ReadColor();
+        const auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        canvas.DrawColor(color, mode);
+        return true;
+      }
+      case SerializedOp::kDrawPaint:
+        canvas.DrawPaint(paint_);
+        return true;
+      case SerializedOp::kDrawLine: {
+        const auto p0 = reader.ReadPod<DlPoint>();
+        const auto p1 = reader.ReadPod<DlPoint>();
+        canvas.DrawLine(ToSkPoint(p0), ToSkPoint(p1), paint_);
+        return true;
+      }
+      case SerializedOp::kDrawDashedLine: {
+        const auto p0 = reader.ReadPod<DlPoint>();
+        const auto p1 = reader.ReadPod<DlPoint>();
+        const DlScalar on_length = reader.ReadF32();
+        const DlScalar off_length = reader.ReadF32();
+        canvas.DrawDashedLine(p0, p1, on_length, off_length, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawRect:
+        canvas.DrawRect(ToSkRect(reader.ReadPod<DlRect>()), paint_);
+        return true;
+      case SerializedOp::kDrawOval:
+        canvas.DrawOval(ToSkRect(reader.ReadPod<DlRect>()), paint_);
+        return true;
+      case SerializedOp::kDrawCircle: {
+        const auto center = reader.ReadPod<DlPoint>();
+        const DlScalar radius = reader.ReadF32();
+        canvas.DrawCircle(ToSkPoint(center), radius, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawRRect:
+        canvas.DrawRRect(reader.ReadRRect(), paint_);
+        return true;
+      case SerializedOp::kDrawDRRect: {
+        const SkRRect outer = reader.ReadRRect();
+        const SkRRect inner = reader.ReadRRect();
+        canvas.DrawDRRect(outer, inner, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawPath: {
+        const DlPath* path = GetPath(reader.ReadU32());
+        if (!path) {
+          return false;
+        }
+        canvas.DrawPath(*path, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawArc: {
+        const auto bounds = reader.ReadPod<DlRect>();
+        const DlScalar start = reader.ReadF32();
+        const DlScalar sweep = reader.ReadF32();
+        const bool use_center = reader.ReadBool();
+        canvas.DrawArc(ToSkRect(bounds), start, sweep, use_center, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawPoints: {
+        const auto mode = reader.ReadEnum(PointMode::kPolygon);
+        const uint32_t count = reader.ReadU32();
+        const DlPoint* points = reader.ReadArray<DlPoint>(count);
+        if (!points || count > DlOpReceiver::kMaxDrawPointsCount) {
+          return false;
+        }
+        canvas.DrawPoints(mode, count, ToSkPoints(points), paint_);
+        return true;
+      }
+      case SerializedOp::kDrawVertices: {
+        const auto blend_mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        const auto mode = reader.ReadEnum(DlVertexMode::kTriangleFan);
+        const uint32_t count = reader.ReadU32();
+        const bool has_texture_coordinates = reader.ReadBool();
+        const bool has_colors = reader.ReadBool();
+        const uint32_t index_count = reader.ReadU32();
+        if (count > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+            index_count >
+                static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+          return false;
+        }
+        const SkPoint* vertices = reader.ReadArray<SkPoint>(count);
+        const SkPoint* texture_coordinates =
+            has_texture_coordinates ? reader.ReadArray<SkPoint>(count)
+                                    : nullptr;
+        const DlColor* colors =
+            has_colors ? reader.ReadArray<DlColor>(count) : nullptr;
+        const uint16_t* indices = reader.ReadArray<uint16_t>(index_count);
+        if (!reader.ok()) {
+          return false;
+        }
+        canvas.DrawVertices(
+            DlVertices::Make(mode, count, vertices, texture_coordinates,
+                             colors, index_count,
+                             index_count > 0u ? indices : nullptr),
+            blend_mode, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawImage: {
+        const auto* image = GetResource(resources_.images, reader.ReadU32());
+        const auto point = reader.ReadPod<DlPoint>();
+        const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        const bool render_with_attributes = reader.ReadBool();
+        if (!image || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawImage(*image, ToSkPoint(point), sampling,
+                         render_with_attributes ? &paint_ : nullptr);
+        return true;
+      }
+      case SerializedOp::kDrawImageRect: {
+        const auto* image = GetResource(resources_.images, reader.ReadU32());
+        const auto src = reader.ReadPod<DlRect>();
+        const auto dst = reader.ReadPod<DlRect>();
+        const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        const bool render_with_attributes = reader.ReadBool();
+        const auto constraint = reader.ReadEnum(SrcRectConstraint::kFast);
+        if (!image || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawImageRect(*image, ToSkRect(src), ToSkRect(dst), sampling,
+                             render_with_attributes ? &paint_ : nullptr,
+                             constraint);
+        return true;
+      }
+      case SerializedOp::kDrawImageNine: {
+        const auto* image = GetResource(resources_.images, reader.ReadU32());
+        const auto center = reader.ReadPod<DlIRect>();
+        const auto dst = reader.ReadPod<DlRect>();
+        const auto filter = reader.ReadEnum(DlFilterMode::kLast);
+        const bool render_with_attributes = reader.ReadBool();
+        if (!image || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawImageNine(*image, ToSkIRect(center), ToSkRect(dst), filter,
+                             render_with_attributes ? &paint_ : nullptr);
+        return true;
+      }
+      case SerializedOp::kDrawAtlas: {
+        const auto* atlas = GetResource(resources_.images, reader.ReadU32());
+        const uint32_t count = reader.ReadU32();
+        const auto mode = reader.ReadEnum(DlBlendMode::kLastMode);
+        const auto sampling = reader.ReadEnum(DlImageSampling::kCubic);
+        const bool render_with_attributes = reader.ReadBool();
+        const bool has_colors = reader.ReadBool();
+        const bool has_cull_rect = reader.ReadBool();
+        const auto cull_rect = has_cull_rect ? reader.ReadPod<DlRect>()
+                                             : DlRect();
+        if (count > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+          return false;
+        }
+        const SkRSXform* xforms = reader.ReadArray<SkRSXform>(count);
+        const DlRect* tex = reader.ReadArray<DlRect>(count);
+        const DlColor* colors =
+            has_colors ? reader.ReadArray<DlColor>(count) : nullptr;
+        if (!atlas || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawAtlas(*atlas, xforms, ToSkRects(tex), colors, count, mode,
+                         sampling,
+                         has_cull_rect ? &ToSkRect(cull_rect) : nullptr,
+                         render_with_attributes ? &paint_ : nullptr);
+        return true;
+      }
+      case SerializedOp::kDrawDisplayList: {
+        auto display_list = GetDisplayList(reader.ReadU32());
+        const DlScalar opacity = reader.ReadF32();
+        if (!display_list || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawDisplayList(display_list, opacity);
+        return true;
+      }
+      case SerializedOp::kDrawTextBlob: {
+        const auto* blob = GetResource(resources_.text_blobs, reader.ReadU32());
+        const DlScalar x = reader.ReadF32();
+        const DlScalar y = reader.ReadF32();
+        if (!blob || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawTextBlob(*blob, x, y, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawTextFrame: {
+        const auto* text_frame =
+            GetResource(resources_.text_frames, reader.ReadU32());
+        const DlScalar x = reader.ReadF32();
+        const DlScalar y = reader.ReadF32();
+        if (!text_frame || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawTextFrame(*text_frame, x, y, paint_);
+        return true;
+      }
+      case SerializedOp::kDrawShadow: {
+        const DlPath* path = GetPath(reader.ReadU32());
+        const DlColor color = reader.ReadColor();
+        const DlScalar elevation = reader.ReadF32();
+        const bool transparent_occluder = reader.ReadBool();
+        const DlScalar dpr = reader.ReadF32();
+        if (!path || !reader.ok()) {
+          return false;
+        }
+        canvas.DrawShadow(*path, color, elevation, transparent_occluder, dpr);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+sk_sp<DisplayList> DeserializeDisplayList(
+    const uint8_t* data,
+    size_t length,
+    const DlSerializationResources& resources,
+    int depth) {
+  if (depth > kMaxDisplayListDepth) {
+    return nullptr;
+  }
+  RecordReader reader(data, length, resources, depth);
+  if (!reader.ReadHeader()) {
+    return nullptr;
+  }
+  DisplayListBuilder builder(reader.has_rtree());
+  if (!reader.Replay(builder)) {
+    return nullptr;
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+std::unique_ptr<fml::Mapping> DlSerialization::Serialize(
+    const DisplayList& display_list,
+    DlSerializationResources* resources) {
+  ByteWriter output;
+  if (!SerializeDisplayList(display_list, resources, output)) {
+    return nullptr;
+  }
+  return std::make_unique<fml::DataMapping>(output.Take());
+}
+
+sk_sp<DisplayList> DlSerialization::Deserialize(
+    const fml::Mapping& data,
+    const DlSerializationResources& resources) {
+  return Deserialize(data.GetMapping(), data.GetSize(), resources);
+}
+
+sk_sp<DisplayList> DlSerialization::Deserialize(
+    const uint8_t* data,
+    size_t length,
+    const DlSerializationResources& resources) {
+  if (!data) {
+    return nullptr;
+  }
+  // Arrays are read in place, which needs the alignment the writer
+  // guarantees. Copy the rare misaligned input once rather than copying
+  // every array.
+  if (reinterpret_cast<uintptr_t>(data) % 4u != 0u) {
+    std::vector<uint32_t> aligned((length + 3u) / 4u);
+    memcpy(aligned.data(), data, length);
+    return DeserializeDisplayList(
+        reinterpret_cast<const uint8_t*>(aligned.data()), length, resources, 0);
+  }
+  return DeserializeDisplayList(data, length, resources, 0);
+}
+
+}  // namespace flutter
@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/effects/dl_runtime_effect.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/impeller/typographer/text_frame.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+// Objects referenced by a serialized DisplayList that are not encoded into
+// the serialized bytes themselves.
+//
+// Images, text and runtime effects are owned by the GPU context or by the
+// text and shader pipelines and cannot be recreated from bytes alone. The
+// serialized stream refers to them by their index in these side tables.
+// When serializing, referenced objects are appended to the tables (each
+// distinct object once). When deserializing, the tables must hold the
+// objects to substitute for each index, for example the same tables that
+// were filled in by |Serialize| or tables rebuilt by an offline harness.
+struct DlSerializationResources {
+  std::vector<sk_sp<DlImage>> images;
+  std::vector<sk_sp<SkTextBlob>> text_blobs;
+  std::vector<std::shared_ptr<impeller::TextFrame>> text_frames;
+  std::vector<sk_sp<DlRuntimeEffect>> runtime_effects;
+};
+
+// Converts DisplayLists to and from a versioned, position-independent
+// binary format.
+//
+// The format is a fixed header followed by a stream of op records and side
+// tables for shared paths and nested DisplayLists. Every reference within
+// the bytes is an offset from the start of the serialized data or an index
+// into a side table, so the bytes can be written to disk and loaded back
+// at any address. All values are stored in host byte order and 4 byte
+// aligned. The header records the byte order and readers reject data
+// written with a different one.
+//
+// Attributes such as color sources, color filters, image filters and mask
+// filters are encoded inline in the records that set them.
+//
+// Deserialization records the DisplayList again. Every record is validated
+// and then replayed through the public API of a DisplayListBuilder, which
+// copies the ops into storage of its own and recomputes bounds and, if the
+// original had one, the RTree.
+class DlSerialization {
+ public:
+  // 'DLSF' in little endian byte order.
+  static constexpr uint32_t kMagic = 0x46534C44;
+  static constexpr uint32_t kVersion = 1u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes the DisplayList.
+  ///
+  /// @param[in]  display_list  The DisplayList to serialize.
+  /// @param[in]  resources     The side tables that images, text and runtime
+  ///                           effects are added to. May be null if the
+  ///                           DisplayList is known not to reference any.
+  ///
+  /// @return     The serialized bytes or null if the DisplayList references
+  ///             an object that needs a side table and |resources| is null.
+  ///
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const DisplayList& display_list,
+      DlSerializationResources* resources);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a DisplayList from serialized bytes.
+  ///
+  /// @param[in]  data       The serialized bytes. They must stay alive for
+  ///                        the duration of the call only.
+  /// @param[in]  resources  The side tables referenced by the data.
+  ///
+  /// @return     The DisplayList or null if the data is malformed, was
+  ///             written by an incompatible version, or references a side
+  ///             table entry that does not exist.
+  ///
+  static sk_sp<DisplayList> Deserialize(
+      const fml::Mapping& data,
+      const DlSerializationResources& resources = {});
+
+  static sk_sp<DisplayList> Deserialize(
+      const uint8_t* data,
+      size_t length,
+      const DlSerializationResources& resources = {});
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
@@ -0,0 +1,199 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstring>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+
+// Defined in display_list_unittests.cc.
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+namespace {
+
+sk_sp<DisplayList> MakeSceneDisplayList(bool prepare_rtree) {
+  DisplayListBuilder nested_builder;
+  nested_builder.DrawCircle(SkPoint::Make(5, 5), 5, DlPaint());
+  auto nested = nested_builder.Build();
+
+  const SkPath path = SkPath().addOval(SkRect::MakeLTRB(0, 0, 30, 20));
+  const DlColor colors[] = {DlColor::kRed(), DlColor::kBlue()};
+  const float stops[] = {0.0f, 1.0f};
+
+  DisplayListBuilder builder(prepare_rtree);
+  DlPaint paint;
+  paint.setColorSource(DlColorSource::MakeLinear(
+      {0, 0}, {100, 100}, 2, colors, stops, DlTileMode::kMirror));
+  paint.setImageFilter(
+      std::make_shared<DlBlurImageFilter>(2, 3, DlTileMode::kClamp));
+  builder.SaveLayer(nullptr, &paint);
+  builder.DrawPath(path, DlPaint(DlColor::kGreen()));
+  builder.Translate(40, 0);
+  builder.DrawPath(path, DlPaint(DlColor::kGreen()));
+  builder.DrawImage(TestImage1, SkPoint::Make(10, 10),
+                    DlImageSampling::kNearestNeighbor);
+  builder.DrawDisplayList(nested);
+  builder.DrawDisplayList(nested, 0.5f);
+  builder.Restore();
+  return builder.Build();
+}
+
+}  // namespace
+
+TEST(DisplayListSerialization, EveryOpRoundTrips) {
+  for (auto& group : CreateAllGroups()) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      DisplayListBuilder builder;
+      group.variants[i].Invoke(DisplayListBuilderTestingAccessor(builder));
+      auto display_list = builder.Build();
+
+      DlSerializationResources resources;
+      auto data = DlSerialization::Serialize(*display_list, &resources);
+      ASSERT_NE(data, nullptr) << group.op_name << " variant " << i;
+      auto loaded = DlSerialization::Deserialize(*data, resources);
+      ASSERT_NE(loaded, nullptr) << group.op_name << " variant " << i;
+      // The variants invoke ops directly, while loading records them again
+      // through the canvas API, which only records the attributes that
+      // affect a draw. The loaded DisplayList draws the same, and loads to
+      // an equal DisplayList itself.
+      EXPECT_EQ(loaded->bounds(), display_list->bounds())
+          << group.op_name << " variant " << i;
+      EXPECT_EQ(loaded->total_depth(), display_list->total_depth())
+          << group.op_name << " variant " << i;
+      auto reloaded_data = DlSerialization::Serialize(*loaded, &resources);
+      ASSERT_NE(reloaded_data, nullptr) << group.op_name << " variant " << i;
+      auto reloaded = DlSerialization::Deserialize(*reloaded_data, resources);
+      ASSERT_NE(reloaded, nullptr) << group.op_name << " variant " << i;
+      EXPECT_TRUE(reloaded->Equals(loaded))
+          << group.op_name << " variant " << i;
+    }
+  }
+}
+
+TEST(DisplayListSerialization, SharedObjectsAreStoredOnce) {
+  auto display_list = MakeSceneDisplayList(false);
+  DlSerializationResources resources;
+  auto data = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(resources.images.size(), 1u);
+  EXPECT_TRUE(resources.text_blobs.empty());
+
+  auto loaded = DlSerialization::Deserialize(*data, resources);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(loaded->Equals(display_list));
+  EXPECT_FALSE(loaded->has_rtree());
+
+  // Serializing the same DisplayList again with the same tables does not
+  // add any more entries.
+  auto again = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(again, nullptr);
+  EXPECT_EQ(resources.images.size(), 1u);
+}
+
+TEST(DisplayListSerialization, RTreeIsRebuilt) {
+  auto display_list = MakeSceneDisplayList(true);
+  DlSerializationResources resources;
+  auto data = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(data, nullptr);
+  auto loaded = DlSerialization::Deserialize(*data, resources);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(loaded->has_rtree());
+  EXPECT_EQ(loaded->rtree()->bounds(), display_list->rtree()->bounds());
+}
+
+TEST(DisplayListSerialization, LoadsFromFileMapping) {
+  auto display_list = MakeSceneDisplayList(false);
+  DlSerializationResources resources;
+  auto data = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(data, nullptr);
+
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "scene.dl", *data));
+  auto mapping = fml::FileMapping::CreateReadOnly(temp_dir.fd(), "scene.dl");
+  ASSERT_NE(mapping, nullptr);
+
+  auto loaded = DlSerialization::Deserialize(*mapping, resources);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(loaded->Equals(display_list));
+}
+
+TEST(DisplayListSerialization, LoadsFromMisalignedBytes) {
+  auto display_list = MakeSceneDisplayList(false);
+  DlSerializationResources resources;
+  auto data = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(data, nullptr);
+
+  std::vector<uint8_t> bytes(data->GetSize() + 1);
+  memcpy(bytes.data() + 1, data->GetMapping(), data->GetSize());
+  auto loaded = DlSerialization::Deserialize(bytes.data() + 1, data->GetSize(),
+                                             resources);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(loaded->Equals(display_list));
+}
+
+TEST(DisplayListSerialization, MissingResourcesAreRejected) {
+  auto display_list = MakeSceneDisplayList(false);
+  EXPECT_EQ(DlSerialization::Serialize(*display_list, nullptr), nullptr);
+
+  DlSerializationResources resources;
+  auto data = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(DlSerialization::Deserialize(*data), nullptr);
+
+  resources.images[0] = nullptr;
+  EXPECT_EQ(DlSerialization::Deserialize(*data, resources), nullptr);
+}
+
+TEST(DisplayListSerialization, DisplayListWithoutResourcesNeedsNoTables) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto display_list = builder.Build();
+
+  auto data = DlSerialization::Serialize(*display_list, nullptr);
+  ASSERT_NE(data, nullptr);
+  auto loaded = DlSerialization::Deserialize(*data);
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_TRUE(loaded->Equals(display_list));
+}
+
+TEST(DisplayListSerialization, TruncatedDataIsRejected) {
+  auto display_list = MakeSceneDisplayList(false);
+  DlSerializationResources resources;
+  auto data = DlSerialization::Serialize(*display_list, &resources);
+  ASSERT_NE(data, nullptr);
+
+  for (size_t length = 0; length < data->GetSize(); length++) {
+    EXPECT_EQ(
+        DlSerialization::Deserialize(data->GetMapping(), length, resources),
+        nullptr)
+        << "length " << length;
+  }
+}
+
+TEST(DisplayListSerialization, IncompatibleVersionIsRejected) {
+  DisplayListBuilder builder;
+  builder.DrawPaint(DlPaint());
+  auto data = DlSerialization::Serialize(*builder.Build(), nullptr);
+  ASSERT_NE(data, nullptr);
+
+  std::vector<uint8_t> bytes(data->GetMapping(),
+                             data->GetMapping() + data->GetSize());
+  ASSERT_NE(DlSerialization::Deserialize(bytes.data(), bytes.size()), nullptr);
+
+  const uint32_t version = DlSerialization::kVersion + 1;
+  memcpy(bytes.data() + sizeof(uint32_t), &version, sizeof(version));
+  EXPECT_EQ(DlSerialization::Deserialize(bytes.data(), bytes.size()), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,174 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_storage.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+DlStoragePool& DlStoragePool::GetInstance() {
+  // Intentionally leaked so that DisplayLists released during static
+  // destruction can still return their blocks.
+  static DlStoragePool* pool = new DlStoragePool();
+  return *pool;
+}
+
+DlStoragePool::DlStoragePool() = default;
+
+DlStoragePool::~DlStoragePool() {
+  Trim();
+}
+
+size_t DlStoragePool::RoundUpToSizeClass(size_t size) {
+  if (size > kMaxPooledBlockSize) {
+    return size;
+  }
+  size_t capacity = kMinBlockSize;
+  while (capacity < size) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+size_t DlStoragePool::SizeClassIndex(size_t capacity) {
+  size_t index = 0u;
+  size_t size = kMinBlockSize;
+  while (size < capacity) {
+    size <<= 1;
+    index++;
+  }
+  return index;
+}
+
+uint8_t* DlStoragePool::Acquire(size_t size, size_t* capacity) {
+  *capacity = RoundUpToSizeClass(size);
+  if (*capacity <= kMaxPooledBlockSize) {
+    std::scoped_lock lock(mutex_);
+    auto& free_list = free_lists_[SizeClassIndex(*capacity)];
+    if (!free_list.empty()) {
+      uint8_t* block = free_list.back();
+      free_list.pop_back();
+      stats_.cached_bytes -= *capacity;
+      stats_.reuse_count++;
+      return block;
+    }
+    stats_.allocation_count++;
+  }
+  auto block = static_cast<uint8_t*>(std::malloc(*capacity));
+  FML_CHECK(block);
+  return block;
+}
+
+void DlStoragePool::Release(uint8_t* block, size_t capacity) {
+  if (!block) {
+    return;
+  }
+  if (capacity <= kMaxPooledBlockSize) {
+    FML_DCHECK(RoundUpToSizeClass(capacity) == capacity);
+    std::scoped_lock lock(mutex_);
+    if (stats_.cached_bytes + capacity <= max_cached_bytes_) {
+      free_lists_[SizeClassIndex(capacity)].push_back(block);
+      stats_.cached_bytes += capacity;
+      return;
+    }
+  }
+  std::free(block);
+}
+
+void DlStoragePool::Trim() {
+  std::scoped_lock lock(mutex_);
+  TrimLocked(0u);
+}
+
+void DlStoragePool::SetMaxCachedBytes(size_t max_cached_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_cached_bytes_ = max_cached_bytes;
+  TrimLocked(max_cached_bytes);
+}
+
+DlStoragePool::Stats DlStoragePool::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void DlStoragePool::TrimLocked(size_t max_cached_bytes) {
+  // Largest blocks go first as they are the least likely to be reused.
+  for (size_t i = kSizeClassCount; i > 0; i--) {
+    if (stats_.cached_bytes <= max_cached_bytes) {
+      return;
+    }
+    auto& free_list = free_lists_[i - 1];
+    const size_t capacity = kMinBlockSize << (i - 1);
+    while (!free_list.empty() && stats_.cached_bytes > max_cached_bytes) {
+      std::free(free_list.back());
+      free_list.pop_back();
+      stats_.cached_bytes -= capacity;
+    }
+  }
+}
+
+DisplayListStorage::DisplayListStorage(DisplayListStorage&& other)
+    : ptr_(std::exchange(other.ptr_, nullptr)),
+      capacity_(std::exchange(other.capacity_, 0u)) {}
+
+DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& other) {
+  if (this != &other) {
+    reset();
+    ptr_ = std::exchange(other.ptr_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0u);
+  }
+  return *this;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  reset();
+}
+
+void DisplayListStorage::reserve(size_t used, size_t count) {
+  FML_DCHECK(used <= capacity_);
+  if (count <= capacity_) {
+    return;
+  }
+  auto& pool = DlStoragePool::GetInstance();
+  // Size classes double up to the largest pooled block, beyond which
+  // blocks have the exact requested size and are grown geometrically here.
+  size_t capacity;
+  uint8_t* ptr = pool.Acquire(std::max(count, capacity_ * 2), &capacity);
+  if (used > 0u) {
+    memcpy(ptr, ptr_, used);
+  }
+  pool.Release(ptr_, capacity_);
+  ptr_ = ptr;
+  capacity_ = capacity;
+}
+
+void DisplayListStorage::shrink_to_fit(size_t used) {
+  FML_DCHECK(used <= capacity_);
+  if (capacity_ <= DlStoragePool::kMaxPooledBlockSize) {
+    return;
+  }
+  // Blocks are released with free, so a block reallocated down into the
+  // pooled range can be pooled like any other once it has a size class.
+  const size_t capacity = DlStoragePool::RoundUpToSizeClass(used);
+  if (capacity >= capacity_) {
+    return;
+  }
+  ptr_ = static_cast<uint8_t*>(std::realloc(ptr_, capacity));
+  FML_CHECK(ptr_);
+  capacity_ = capacity;
+}
+
+void DisplayListStorage::reset() {
+  DlStoragePool::GetInstance().Release(ptr_, capacity_);
+  ptr_ = nullptr;
+  capacity_ = 0u;
+}
+
+}  // namespace flutter
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
+#define FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A process-wide cache of the blocks of memory that hold DisplayList op
+// records.
+//
+// Blocks are handed out in power-of-two size classes starting at
+// |kMinBlockSize|. When a DisplayList (or a DisplayListBuilder that never
+// built one) is destroyed its block goes back into the free list for its
+// size class rather than back to malloc, so an app that records roughly
+// the same pictures every frame recycles last frame's storage instead of
+// growing new storage from scratch.
+//
+// The pool is thread-safe since DisplayLists are typically recorded on the
+// UI thread and released on the raster thread.
+class DlStoragePool {
+ public:
+  static constexpr size_t kMinBlockSize = 4096u;
+  static constexpr size_t kSizeClassCount = 13u;
+  // Blocks larger than this are allocated and freed directly.
+  static constexpr size_t kMaxPooledBlockSize = kMinBlockSize
+                                                << (kSizeClassCount - 1);
+  static constexpr size_t kDefaultMaxCachedBytes = 16u * 1024u * 1024u;
+
+  struct Stats {
+    // Blocks that had to be allocated from the system.
+    size_t allocation_count = 0u;
+    // Blocks that were satisfied from a free list.
+    size_t reuse_count = 0u;
+    // Bytes currently held in free lists.
+    size_t cached_bytes = 0u;
+  };
+
+  static DlStoragePool& GetInstance();
+
+  DlStoragePool();
+
+  ~DlStoragePool();
+
+  // Returns a block of at least |size| bytes and stores its actual size,
+  // which is always a size class for pooled blocks, in |capacity|. The
+  // contents of the block are undefined.
+  uint8_t* Acquire(size_t size, size_t* capacity);
+
+  // Returns a block obtained from |Acquire| to the pool.
+  void Release(uint8_t* block, size_t capacity);
+
+  // Frees all cached blocks.
+  void Trim();
+
+  // Limits the bytes held in free lists. Blocks released while the pool is
+  // at its limit are freed instead.
+  void SetMaxCachedBytes(size_t max_cached_bytes);
+
+  Stats GetStats() const;
+
+  // Rounds |size| up to the block size that |Acquire| would return.
+  static size_t RoundUpToSizeClass(size_t size);
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kSizeClassCount> free_lists_;
+  size_t max_cached_bytes_ = kDefaultMaxCachedBytes;
+  Stats stats_;
+
+  static size_t SizeClassIndex(size_t capacity);
+
+  void TrimLocked(size_t max_cached_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlStoragePool);
+};
+
+// Manages a block of op record memory obtained from the |DlStoragePool|.
+class DisplayListStorage {
+ public:
+  DisplayListStorage() = default;
+  DisplayListStorage(DisplayListStorage&& other);
+  DisplayListStorage& operator=(DisplayListStorage&& other);
+
+  ~DisplayListStorage();
+
+  uint8_t* get() { return ptr_; }
+
+  const uint8_t* get() const { return ptr_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // Ensures that the storage can hold at least |count| bytes while
+  // preserving the first |used| bytes. The bytes beyond |used| are
+  // undefined. The capacity at least doubles when the storage grows, so
+  // pushing records one by one takes amortized constant time, including
+  // past the largest pooled size class.
+  void reserve(size_t used, size_t count);
+
+  // Releases the capacity beyond the first |used| bytes of a block that is
+  // too large to be pooled. Pooled blocks keep their size class, which is
+  // at most twice |used|, so that they can go back to their free list.
+  void shrink_to_fit(size_t used);
+
+  // Returns the block to the pool.
+  void reset();
+
+ private:
+  uint8_t* ptr_ = nullptr;
+  size_t capacity_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
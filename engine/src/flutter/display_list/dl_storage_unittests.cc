@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_storage.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_builder_pool.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DisplayListStorage, SizeClassesArePowersOfTwo) {
+  EXPECT_EQ(DlStoragePool::RoundUpToSizeClass(0u),
+            DlStoragePool::kMinBlockSize);
+  EXPECT_EQ(DlStoragePool::RoundUpToSizeClass(1u),
+            DlStoragePool::kMinBlockSize);
+  EXPECT_EQ(DlStoragePool::RoundUpToSizeClass(DlStoragePool::kMinBlockSize),
+            DlStoragePool::kMinBlockSize);
+  EXPECT_EQ(
+      DlStoragePool::RoundUpToSizeClass(DlStoragePool::kMinBlockSize + 1),
+      DlStoragePool::kMinBlockSize * 2);
+  const size_t huge = DlStoragePool::kMaxPooledBlockSize + 1;
+  EXPECT_EQ(DlStoragePool::RoundUpToSizeClass(huge), huge);
+}
+
+TEST(DisplayListStorage, PoolReusesReleasedBlocks) {
+  DlStoragePool pool;
+  size_t capacity;
+  uint8_t* block = pool.Acquire(100u, &capacity);
+  EXPECT_EQ(capacity, DlStoragePool::kMinBlockSize);
+  EXPECT_EQ(pool.GetStats().allocation_count, 1u);
+
+  pool.Release(block, capacity);
+  EXPECT_EQ(pool.GetStats().cached_bytes, capacity);
+
+  size_t reused_capacity;
+  uint8_t* reused = pool.Acquire(capacity, &reused_capacity);
+  EXPECT_EQ(reused, block);
+  EXPECT_EQ(reused_capacity, capacity);
+  EXPECT_EQ(pool.GetStats().allocation_count, 1u);
+  EXPECT_EQ(pool.GetStats().reuse_count, 1u);
+  EXPECT_EQ(pool.GetStats().cached_bytes, 0u);
+  pool.Release(reused, reused_capacity);
+}
+
+TEST(DisplayListStorage, PoolRespectsMaxCachedBytes) {
+  DlStoragePool pool;
+  size_t capacity_a;
+  size_t capacity_b;
+  uint8_t* a = pool.Acquire(DlStoragePool::kMinBlockSize, &capacity_a);
+  uint8_t* b = pool.Acquire(DlStoragePool::kMinBlockSize, &capacity_b);
+  pool.SetMaxCachedBytes(DlStoragePool::kMinBlockSize);
+  pool.Release(a, capacity_a);
+  pool.Release(b, capacity_b);
+  EXPECT_EQ(pool.GetStats().cached_bytes, DlStoragePool::kMinBlockSize);
+
+  pool.Trim();
+  EXPECT_EQ(pool.GetStats().cached_bytes, 0u);
+}
+
+TEST(DisplayListStorage, ReservePreservesUsedBytes) {
+  DisplayListStorage storage;
+  EXPECT_EQ(storage.get(), nullptr);
+  EXPECT_EQ(storage.capacity(), 0u);
+
+  storage.reserve(0u, 16u);
+  ASSERT_NE(storage.get(), nullptr);
+  EXPECT_GE(storage.capacity(), 16u);
+  memset(storage.get(), 0xA5, 16u);
+
+  storage.reserve(16u, storage.capacity() + 1u);
+  EXPECT_GT(storage.capacity(), DlStoragePool::kMinBlockSize);
+  for (size_t i = 0; i < 16u; i++) {
+    EXPECT_EQ(storage.get()[i], 0xA5) << "index: " << i;
+  }
+
+  DisplayListStorage moved = std::move(storage);
+  EXPECT_EQ(storage.get(), nullptr);
+  EXPECT_EQ(storage.capacity(), 0u);
+  EXPECT_NE(moved.get(), nullptr);
+}
+
+TEST(DisplayListStorage, ReserveGrowsLargeBlocksGeometrically) {
+  DisplayListStorage storage;
+  const size_t huge = DlStoragePool::kMaxPooledBlockSize + 1;
+  storage.reserve(0u, huge);
+  EXPECT_EQ(storage.capacity(), huge);
+  memset(storage.get(), 0xA5, huge);
+
+  storage.reserve(huge, huge + 1);
+  EXPECT_EQ(storage.capacity(), huge * 2);
+  EXPECT_EQ(storage.get()[huge - 1], 0xA5);
+}
+
+TEST(DisplayListStorage, ShrinkToFitTrimsOnlyUnpooledBlocks) {
+  DisplayListStorage pooled;
+  pooled.reserve(0u, DlStoragePool::kMinBlockSize * 4);
+  pooled.shrink_to_fit(1u);
+  EXPECT_EQ(pooled.capacity(), DlStoragePool::kMinBlockSize * 4);
+
+  DisplayListStorage large;
+  const size_t huge = DlStoragePool::kMaxPooledBlockSize * 2;
+  large.reserve(0u, huge);
+  memset(large.get(), 0xA5, huge);
+  large.shrink_to_fit(huge - 1);
+  EXPECT_EQ(large.capacity(), huge - 1);
+  EXPECT_EQ(large.get()[huge - 2], 0xA5);
+
+  // A block trimmed down into the pooled range gets a size class so that it
+  // can be released to the pool.
+  large.shrink_to_fit(100u);
+  EXPECT_EQ(large.capacity(), DlStoragePool::kMinBlockSize);
+  EXPECT_EQ(large.get()[99], 0xA5);
+}
+
+TEST(DisplayListStorage, BuildDoesNotShrinkStorage) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 1000; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i, i, 10, 10), DlPaint());
+  }
+  auto display_list = builder.Build();
+  const size_t byte_count = display_list->bytes(false) - sizeof(DisplayList);
+  EXPECT_EQ(display_list->GetStorage().capacity(),
+            DlStoragePool::RoundUpToSizeClass(byte_count));
+}
+
+TEST(DisplayListStorage, RecycledStorageProducesEqualDisplayLists) {
+  auto record = [](DisplayListBuilder& builder, int seed) {
+    for (int i = 0; i < 100; i++) {
+      builder.DrawRect(SkRect::MakeXYWH(i, seed, 10, 10),
+                       DlPaint(DlColor(0xFF000000 | (seed + i))));
+    }
+  };
+
+  DisplayListBuilder builder_a;
+  record(builder_a, 1);
+  auto display_list_a = builder_a.Build();
+
+  // Dirty a block and return it to the pool so that the next builder is
+  // likely to be handed stale bytes.
+  {
+    DisplayListStorage storage;
+    storage.reserve(0u, display_list_a->GetStorage().capacity());
+    memset(storage.get(), 0xFF, storage.capacity());
+  }
+
+  DisplayListBuilder builder_b;
+  record(builder_b, 1);
+  auto display_list_b = builder_b.Build();
+  EXPECT_TRUE(display_list_a->Equals(display_list_b));
+}
+
+TEST(DisplayListBuilderPool, RecyclesBuiltBuilders) {
+  DisplayListBuilderPool pool;
+  auto builder = pool.Acquire(SkRect::MakeWH(100, 100), true);
+  auto* raw_builder = builder.get();
+  builder->DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  auto display_list = builder->Build();
+  pool.Recycle(std::move(builder));
+  EXPECT_EQ(pool.GetCachedBuilderCount(), 1u);
+
+  auto reused = pool.Acquire(SkRect::MakeWH(50, 50), false);
+  EXPECT_EQ(reused.get(), raw_builder);
+  EXPECT_EQ(pool.GetCachedBuilderCount(), 0u);
+  EXPECT_EQ(reused->GetBaseLayerSize(), SkISize::Make(50, 50));
+  reused->DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  auto reused_display_list = reused->Build();
+  EXPECT_FALSE(reused_display_list->has_rtree());
+  EXPECT_TRUE(display_list->Equals(reused_display_list));
+}
+
+TEST(DisplayListBuilderPool, KeepsAtMostMaxCachedBuilders) {
+  DisplayListBuilderPool pool;
+  std::vector<sk_sp<DisplayListBuilder>> builders;
+  for (size_t i = 0; i <= DisplayListBuilderPool::kMaxCachedBuilders; i++) {
+    builders.push_back(pool.Acquire(SkRect::MakeWH(100, 100), false));
+  }
+  std::vector<sk_sp<DisplayList>> display_lists;
+  for (auto& builder : builders) {
+    display_lists.push_back(builder->Build());
+    pool.Recycle(std::move(builder));
+  }
+  EXPECT_EQ(pool.GetCachedBuilderCount(),
+            DisplayListBuilderPool::kMaxCachedBuilders);
+
+  pool.Trim();
+  EXPECT_EQ(pool.GetCachedBuilderCount(), 0u);
+}
+
+TEST(DisplayListBuilderPool, DoesNotRecycleSharedOrUnbuiltBuilders) {
+  DisplayListBuilderPool pool;
+
+  auto shared = pool.Acquire(SkRect::MakeWH(100, 100), false);
+  auto other_ref = shared;
+  pool.Recycle(std::move(shared));
+  EXPECT_EQ(pool.GetCachedBuilderCount(), 0u);
+
+  auto unbuilt = pool.Acquire(SkRect::MakeWH(100, 100), false);
+  unbuilt->DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  pool.Recycle(std::move(unbuilt));
+  EXPECT_EQ(pool.GetCachedBuilderCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,10 +5,60 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "flutter/fml/logging.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DL_RTREE_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DL_RTREE_USE_NEON 1
+#endif
+
 namespace flutter {
 
+namespace {
+
+struct Entry {
+  SkRect bounds;
+  uint32_t index;
+};
+
+// Orders |entries| so that each consecutive run of |branch_factor| entries
+// forms a compact group, using the Sort-Tile-Recursive algorithm.
+//
+// The entries are sorted by the x coordinate of their centers and cut into
+// roughly sqrt(P) vertical slices, where P is the number of groups that
+// will be formed. Each slice is then sorted by the y coordinate of the
+// centers and cut into groups. The slice size is a multiple of the branch
+// factor so no group straddles two slices.
+void SortTileRecursive(std::vector<Entry>& entries, size_t branch_factor) {
+  const size_t count = entries.size();
+  const size_t group_count = (count + branch_factor - 1) / branch_factor;
+  const size_t slice_count =
+      static_cast<size_t>(std::ceil(std::sqrt(group_count)));
+  const size_t slice_size = slice_count * branch_factor;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.bounds.centerX() < b.bounds.centerX();
+            });
+  for (size_t start = 0; start < count; start += slice_size) {
+    const size_t end = std::min(start + slice_size, count);
+    std::sort(entries.begin() + start, entries.begin() + end,
+              [](const Entry& a, const Entry& b) {
+                return a.bounds.centerY() < b.bounds.centerY();
+              });
+  }
+}
+
+}  // namespace
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -33,110 +83,177 @@ DlRTree::DlRTree(const SkRect rects[],
     }
   }
   leaf_count_ = leaf_count;
-
-  // Count the total number of nodes (leaf and internal) up front
-  // so we can resize the vector just once.
-  uint32_t total_node_count = leaf_count;
-  uint32_t gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    total_node_count += family_count;
-    gen_count = family_count;
+  if (leaf_count == 0) {
+    return;
   }
 
-  nodes_.resize(total_node_count);
-
-  // Now place only the tracked rectangles into the nodes array
-  // in the first leaf_count_ entries.
-  int leaf_index = 0;
+  // Now place only the tracked rectangles into the leaf arrays in the
+  // order in which they were presented so that leaf indices preserve
+  // that order.
+  leaf_bounds_.reserve(leaf_count);
+  leaf_ids_.reserve(leaf_count);
+  std::vector<Entry> entries;
+  entries.reserve(leaf_count);
   int id = invalid_id;
   for (int i = 0; i < N; i++) {
     if (!rects[i].isEmpty()) {
       if (ids == nullptr || p(id = ids[i])) {
-        Node& node = nodes_[leaf_index++];
-        node.bounds = rects[i];
-        node.id = id;
+        entries.push_back({rects[i], static_cast<uint32_t>(entries.size())});
+        leaf_bounds_.push_back(rects[i]);
+        leaf_ids_.push_back(id);
+        bounds_.join(rects[i]);
       }
     }
   }
-  FML_DCHECK(leaf_index == leaf_count);
+  FML_DCHECK(static_cast<int>(entries.size()) == leaf_count);
 
   // --- Implementation note ---
-  // Many R-Tree algorithms attempt to consolidate nearby rectangles
-  // into branches of the tree in order to maximize the benefit of
-  // bounds testing against whole sub-trees. The Skia code from which
-  // this was based, though, indicated that empirical tests against a
-  // browser client showed little gains in rendering performance while
-  // costing 17% performance in bulk loading the rects into the R-Tree:
-  // https://github.com/google/skia/blob/12b6bd042f7cdffb9012c90c3b4885601fc7be95/src/core/SkRTree.cpp#L96
+  // An earlier version of this class grouped the rectangles in the order
+  // in which they were recorded, on the theory that apps lay out their
+  // content top to bottom so the rectangles arrive nearly sorted. That
+  // breaks down for scrolling lists with many items and for content
+  // that overlaps, where siblings with distant bounds end up under the
+  // same parent and the parent bounds grow to cover most of the list.
+  // Sort-Tile-Recursive loading costs a few sorts at build time, but it
+  // produces tightly packed parents and so far fewer nodes are visited
+  // per query.
   //
-  // Given that this class will most often be used to track rendering
-  // operations that were drawn in an app that performs a type of
-  // "page layout" with rendering proceeding in a linear fashion from
-  // top to bottom (and left to right or right to left), the rectangles
-  // are likely nearly sorted when they are delivered to this constructor
-  // so leaving them in their original order should show similar results
-  // to what Skia found in their empirical browser tests.
+  // The leaf indices still reflect the recording order. Only the grouping
+  // of the leaves under their parents is spatial, and the query methods
+  // sort their results back into recording order.
   // ---
 
-  // Continually process the previous level (generation) of nodes,
-  // combining them into a new generation of parent groups each grouping
-  // at most |kMaxChildren| children and joining their bounds into its
-  // parent bounds.
-  // Each generation will end up reduced by a factor of up to kMaxChildren
-  // until there is just one node left, which is the root node of
-  // the R-Tree.
-  uint32_t gen_start = 0;
-  gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t gen_end = gen_start + gen_count;
-
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    FML_DCHECK(gen_end + family_count <= total_node_count);
-
-    // D here is similar to the variable in a Bresenham line algorithm where
-    // we want to slowly move |family_count| steps along the minor axis as
-    // we move |gen_count| steps along the major axis.
-    //
-    // Each inner loop increments D by family_count.
-    // The inner loop executes a total of gen_count times.
-    // Every time D exceeds 0 we subtract gen_count and move to a new parent.
-    // All told we will increment D by family_count a total of gen_count times.
-    // All told we will decrement D by gen_count a total of family_count times.
-    // This leaves D back at its starting value.
-    //
-    // We could bias/balance where the extra children are placed by varying
-    // the initial count of D from 0 to (1 - family_count), but we aren't
-    // looking at this process aesthetically so we just use 0 as an initial
-    // value. Using 0 provides a "greedy" allocation of the extra children.
-    // Bresenham also uses double the size of the steps we use here also to
-    // have better rounding of when the minor axis steps occur, but again we
-    // don't care about the distribution of the extra children.
-    int D = 0;
-
-    uint32_t sibling_index = gen_start;
-    uint32_t parent_index = gen_end;
-    Node* parent = nullptr;
-    while (sibling_index < gen_end) {
-      if ((D += family_count) > 0) {
-        D -= gen_count;
-        FML_DCHECK(parent_index < gen_end + family_count);
-        parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
-        parent->child.index = sibling_index;
-        parent->child.count = 0;
+  // Continually process the previous level of entries, grouping them into
+  // branches of at most |kBranchFactor| children until the level consists
+  // of a single branch, which is the root of the R-Tree.
+  std::vector<Entry> parents;
+  while (true) {
+    SortTileRecursive(entries, kBranchFactor);
+
+    const size_t count = entries.size();
+    const size_t branch_count = (count + kBranchFactor - 1) / kBranchFactor;
+    const size_t first_branch = branches_.size();
+    branches_.resize(first_branch + branch_count);
+    parents.resize(branch_count);
+    for (size_t b = 0; b < branch_count; b++) {
+      Branch& branch = branches_[first_branch + b];
+      SkRect joined = SkRect::MakeEmpty();
+      for (int lane = 0; lane < kBranchFactor; lane++) {
+        const size_t e = b * kBranchFactor + lane;
+        if (e < count) {
+          const SkRect& child = entries[e].bounds;
+          branch.left[lane] = child.fLeft;
+          branch.top[lane] = child.fTop;
+          branch.right[lane] = child.fRight;
+          branch.bottom[lane] = child.fBottom;
+          branch.child[lane] = entries[e].index;
+          joined.join(child);
+        } else {
+          // Inverted infinite bounds never intersect any query.
+          constexpr float kInf = std::numeric_limits<float>::infinity();
+          branch.left[lane] = kInf;
+          branch.top[lane] = kInf;
+          branch.right[lane] = -kInf;
+          branch.bottom[lane] = -kInf;
+          branch.child[lane] = 0u;
+        }
+      }
+      parents[b] = {joined, static_cast<uint32_t>(first_branch + b)};
+    }
+    if (height_++ == 0) {
+      leaf_branch_count_ = static_cast<uint32_t>(branch_count);
+    }
+    if (branch_count == 1) {
+      break;
+    }
+    entries.swap(parents);
+  }
+}
+
+uint32_t DlRTree::IntersectingChildren(const Branch& branch,
+                                       const SkRect& query) {
+  // Two rectangles intersect if each one starts before the other ends on
+  // both axes. The comparisons are strict, matching SkRect::intersects.
+  uint32_t mask = 0u;
+#if defined(DL_RTREE_USE_SSE2)
+  const __m128 query_left = _mm_set1_ps(query.fLeft);
+  const __m128 query_top = _mm_set1_ps(query.fTop);
+  const __m128 query_right = _mm_set1_ps(query.fRight);
+  const __m128 query_bottom = _mm_set1_ps(query.fBottom);
+  for (int i = 0; i < kBranchFactor; i += 4) {
+    const __m128 x_hit = _mm_and_ps(
+        _mm_cmplt_ps(_mm_load_ps(branch.left + i), query_right),
+        _mm_cmplt_ps(query_left, _mm_load_ps(branch.right + i)));
+    const __m128 y_hit = _mm_and_ps(
+        _mm_cmplt_ps(_mm_load_ps(branch.top + i), query_bottom),
+        _mm_cmplt_ps(query_top, _mm_load_ps(branch.bottom + i)));
+    mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(x_hit, y_hit)))
+            << i;
+  }
+#elif defined(DL_RTREE_USE_NEON)
+  const float32x4_t query_left = vdupq_n_f32(query.fLeft);
+  const float32x4_t query_top = vdupq_n_f32(query.fTop);
+  const float32x4_t query_right = vdupq_n_f32(query.fRight);
+  const float32x4_t query_bottom = vdupq_n_f32(query.fBottom);
+  const uint32x4_t lane_bits = {1u, 2u, 4u, 8u};
+  for (int i = 0; i < kBranchFactor; i += 4) {
+    const uint32x4_t x_hit =
+        vandq_u32(vcltq_f32(vld1q_f32(branch.left + i), query_right),
+                  vcltq_f32(query_left, vld1q_f32(branch.right + i)));
+    const uint32x4_t y_hit =
+        vandq_u32(vcltq_f32(vld1q_f32(branch.top + i), query_bottom),
+                  vcltq_f32(query_top, vld1q_f32(branch.bottom + i)));
+    mask |= vaddvq_u32(vandq_u32(vandq_u32(x_hit, y_hit), lane_bits)) << i;
+  }
+#else
+  for (int i = 0; i < kBranchFactor; i++) {
+    if (branch.left[i] < query.fRight && query.fLeft < branch.right[i] &&
+        branch.top[i] < query.fBottom && query.fTop < branch.bottom[i]) {
+      mask |= 1u << i;
+    }
+  }
+#endif
+  return mask;
+}
+
+template <typename Visitor>
+void DlRTree::VisitIntersectingLeaves(const SkRect& query,
+                                      Visitor&& visit) const {
+  FML_DCHECK(!query.isEmpty());
+  if (branches_.empty() || !bounds_.intersects(query)) {
+    return;
+  }
+
+  // Every branch that is popped pushes at most |kBranchFactor| children,
+  // so the stack never holds more than |kBranchFactor - 1| entries per
+  // level plus one. A tree of 2^31 leaves is 11 levels high.
+  constexpr int kMaxStackSize = 128;
+  FML_DCHECK(height_ * (kBranchFactor - 1) + 1 <= kMaxStackSize);
+  uint32_t stack[kMaxStackSize];
+  int stack_size = 0;
+  stack[stack_size++] = static_cast<uint32_t>(branches_.size() - 1);
+  while (stack_size > 0) {
+    const uint32_t branch_index = stack[--stack_size];
+    const Branch& branch = branches_[branch_index];
+    const uint32_t hits = IntersectingChildren(branch, query);
+    if (hits == 0u) {
+      continue;
+    }
+    if (branch_index < leaf_branch_count_) {
+      for (int i = 0; i < kBranchFactor; i++) {
+        if (hits & (1u << i)) {
+          visit(static_cast<int>(branch.child[i]));
+        }
+      }
+    } else {
+      // Pushed in reverse so that the children are visited in order.
+      for (int i = kBranchFactor - 1; i >= 0; i--) {
+        if (hits & (1u << i)) {
+          stack[stack_size++] = branch.child[i];
+        }
       }
-      FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
-      parent->child.count++;
     }
-    FML_DCHECK(D == 0);
-    FML_DCHECK(sibling_index == gen_end);
-    FML_DCHECK(parent_index == gen_end + family_count);
-    gen_start = gen_end;
-    gen_count = family_count;
   }
-  FML_DCHECK(gen_start + gen_count == total_node_count);
 }
 
 void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
@@ -144,20 +261,31 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
   if (query.isEmpty()) {
     return;
   }
-  if (nodes_.size() <= 0) {
-    FML_DCHECK(leaf_count_ == 0);
-    return;
+  const size_t start = results->size();
+  VisitIntersectingLeaves(
+      query, [results](int index) { results->push_back(index); });
+  // The leaves are grouped spatially so they are found out of order.
+  std::sort(results->begin() + start, results->end());
+}
+
+size_t DlRTree::search(const SkRect& query,
+                       int results[],
+                       size_t capacity) const {
+  FML_DCHECK(results != nullptr || capacity == 0u);
+  if (query.isEmpty()) {
+    return 0u;
   }
-  const Node& root = nodes_.back();
-  if (root.bounds.intersects(query)) {
-    if (nodes_.size() == 1) {
-      FML_DCHECK(leaf_count_ == 1);
-      // The root node is the only node and it is a leaf node
-      results->push_back(0);
-    } else {
-      search(root, query, results);
+  size_t count = 0u;
+  VisitIntersectingLeaves(query, [results, capacity, &count](int index) {
+    if (count < capacity) {
+      results[count] = index;
     }
+    count++;
+  });
+  if (count <= capacity) {
+    std::sort(results, results + count);
   }
+  return count;
 }
 
 std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
@@ -183,30 +311,12 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
   return final_results;
 }
 
-void DlRTree::search(const Node& parent,
-                     const SkRect& query,
-                     std::vector<int>* results) const {
-  // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
-      } else {
-        search(node, query, results);
-      }
-    }
-  }
-}
-
 const DlRegion& DlRTree::region() const {
   if (!region_) {
     std::vector<SkIRect> rects;
     rects.resize(leaf_count_);
     for (int i = 0; i < leaf_count_; i++) {
-      nodes_[i].bounds.roundOut(&rects[i]);
+      leaf_bounds_[i].roundOut(&rects[i]);
     }
     region_.emplace(rects);
   }
@@ -214,11 +324,7 @@ const DlRegion& DlRTree::region() const {
 }
 
 const SkRect& DlRTree::bounds() const {
-  if (!nodes_.empty()) {
-    return nodes_.back().bounds;
-  } else {
-    return kEmpty;
-  }
+  return bounds_;
 }
 
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 
+#include <cstdint>
 #include <list>
 #include <optional>
 #include <vector>
@@ -28,19 +29,20 @@ namespace flutter {
 ///   @see |searchAndConsolidateRects|
 class DlRTree : public SkRefCnt {
  private:
-  static constexpr int kMaxChildren = 11;
-
-  // Leaf nodes at start of vector have an ID,
-  // Internal nodes after that have child index and count.
-  struct Node {
-    SkRect bounds;
-    union {
-      struct {
-        uint32_t index;
-        uint32_t count;
-      } child;
-      int id;
-    };
+  // The number of children of each internal node. Each node stores the
+  // bounds of its children as separate arrays of left, top, right and
+  // bottom coordinates so that all of them can be tested against a query
+  // with a handful of vector instructions.
+  static constexpr int kBranchFactor = 8;
+
+  struct alignas(16) Branch {
+    float left[kBranchFactor];
+    float top[kBranchFactor];
+    float right[kBranchFactor];
+    float bottom[kBranchFactor];
+    // Leaf indices for the branches in the lowest level of the tree,
+    // branch indices for all other branches.
+    uint32_t child[kBranchFactor];
   };
 
  public:
@@ -61,6 +63,10 @@ class DlRTree : public SkRefCnt {
   /// Duplicate rectangles and IDs are allowed and not processed in any
   /// way except to eliminate invalid rectangles and IDs that are rejected
   /// by the optional predicate function.
+  ///
+  /// The tree is bulk loaded with the Sort-Tile-Recursive algorithm, which
+  /// groups spatially nearby rectangles under the same parent regardless
+  /// of the order in which they were recorded.
   DlRTree(
       const SkRect rects[],
       int N,
@@ -80,11 +86,23 @@ class DlRTree : public SkRefCnt {
   /// |DlRTree::id| and |DlRTree::bounds| methods.
   void search(const SkRect& query, std::vector<int>* results) const;
 
+  /// Search the rectangles and store the leaf node indices for rectangles
+  /// that intersect the query into the caller-provided |results| buffer
+  /// which has room for |capacity| indices. This variant never allocates
+  /// memory and can be called repeatedly with the same buffer.
+  ///
+  /// The return value is the total number of intersecting rectangles. If
+  /// it is no larger than |capacity| then the buffer holds all of their
+  /// indices in the same order as |search| would return them. Otherwise
+  /// the contents of the buffer are unspecified and the caller should
+  /// retry with a buffer at least as large as the returned count.
+  size_t search(const SkRect& query, int results[], size_t capacity) const;
+
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].id
+               ? leaf_ids_[result_index]
                : invalid_id_;
   }
 
@@ -96,13 +114,15 @@ class DlRTree : public SkRefCnt {
   /// or an empty rect if the index is not a valid leaf node index.
   const SkRect& bounds(int result_index) const {
     return (result_index >= 0 && result_index < leaf_count_)
-               ? nodes_[result_index].bounds
+               ? leaf_bounds_[result_index]
                : kEmpty;
   }
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) +
+           (sizeof(SkRect) + sizeof(int)) * leaf_bounds_.size() +
+           sizeof(Branch) * branches_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -112,7 +132,9 @@ class DlRTree : public SkRefCnt {
 
   /// Return the total number of nodes used in the R-Tree, both leaf
   /// and internal consolidation nodes.
-  int node_count() const { return nodes_.size(); }
+  int node_count() const {
+    return leaf_count_ + static_cast<int>(branches_.size());
+  }
 
   /// Finds the rects in the tree that intersect with the query rect.
   ///
@@ -139,11 +161,26 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect kEmpty = SkRect::MakeEmpty();
 
-  void search(const Node& parent,
-              const SkRect& query,
-              std::vector<int>* results) const;
-
-  std::vector<Node> nodes_;
+  // Returns a bit mask of the children of |branch| whose bounds intersect
+  // the query.
+  static uint32_t IntersectingChildren(const Branch& branch,
+                                       const SkRect& query);
+
+  // Calls |visit| with the index of every leaf whose bounds intersect the
+  // non-empty |query|.
+  template <typename Visitor>
+  void VisitIntersectingLeaves(const SkRect& query, Visitor&& visit) const;
+
+  std::vector<SkRect> leaf_bounds_;
+  std::vector<int> leaf_ids_;
+  // The branches of each level of the tree are stored together, starting
+  // with the level just above the leaves. The root is the last branch.
+  std::vector<Branch> branches_;
+  // The number of branches whose children are leaves.
+  uint32_t leaf_branch_count_ = 0;
+  // The number of branches on the path from the root to a leaf.
+  int height_ = 0;
+  SkRect bounds_ = kEmpty;
   int leaf_count_ = 0;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <random>
+
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "gtest/gtest.h"
 
@@ -319,5 +321,90 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+TEST(DisplayListRTree, SearchIntoBuffer) {
+  SkRect rects[100];
+  for (int i = 0; i < 100; i++) {
+    rects[i].setXYWH(0, i * 10, 100, 10);
+  }
+  DlRTree tree(rects, 100);
+  int results[8];
+
+  // A query that misses all rects.
+  EXPECT_EQ(tree.search(SkRect::MakeLTRB(200, 0, 300, 1000), results, 8), 0u);
+  EXPECT_EQ(tree.search(SkRect::MakeEmpty(), results, 8), 0u);
+
+  // A query that hits 5 rects fits in the buffer.
+  ASSERT_EQ(tree.search(SkRect::MakeLTRB(0, 500, 100, 550), results, 8), 5u);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(results[i], 50 + i);
+  }
+
+  // A query that hits 20 rects does not, but still reports the count.
+  EXPECT_EQ(tree.search(SkRect::MakeLTRB(0, 500, 100, 700), results, 8), 20u);
+  EXPECT_EQ(tree.search(SkRect::MakeLTRB(0, 500, 100, 700), nullptr, 0), 20u);
+}
+
+TEST(DisplayListRTree, SearchMatchesBruteForce) {
+  // Randomly sized and placed rectangles that overlap heavily, recorded
+  // in no particular spatial order.
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float> position(0, 1000);
+  std::uniform_real_distribution<float> size(1, 100);
+  const int kCount = 2000;
+  std::vector<SkRect> rects(kCount);
+  for (auto& rect : rects) {
+    rect.setXYWH(position(random), position(random), size(random),
+                 size(random));
+  }
+  DlRTree tree(rects.data(), kCount);
+  ASSERT_EQ(tree.leaf_count(), kCount);
+
+  std::vector<int> buffer(kCount);
+  for (int q = 0; q < 200; q++) {
+    auto query = SkRect::MakeXYWH(position(random), position(random),
+                                  size(random) * 2, size(random) * 2);
+    std::vector<int> expected;
+    for (int i = 0; i < kCount; i++) {
+      if (rects[i].intersects(query)) {
+        expected.push_back(i);
+      }
+    }
+
+    std::vector<int> results;
+    tree.search(query, &results);
+    EXPECT_EQ(results, expected) << "query " << q;
+
+    size_t count = tree.search(query, buffer.data(), buffer.size());
+    ASSERT_EQ(count, expected.size()) << "query " << q;
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin()))
+        << "query " << q;
+  }
+}
+
+TEST(DisplayListRTree, ScrollingList) {
+  // Many list items laid out top to bottom, each with a background and
+  // a few overlapping foreground rects.
+  const int kItems = 1000;
+  std::vector<SkRect> rects;
+  for (int i = 0; i < kItems; i++) {
+    float y = i * 50;
+    rects.push_back(SkRect::MakeXYWH(0, y, 400, 50));
+    rects.push_back(SkRect::MakeXYWH(10, y + 5, 40, 40));
+    rects.push_back(SkRect::MakeXYWH(60, y + 10, 300, 15));
+    rects.push_back(SkRect::MakeXYWH(60, y + 25, 200, 15));
+  }
+  DlRTree tree(rects.data(), static_cast<int>(rects.size()));
+  EXPECT_EQ(tree.bounds(), SkRect::MakeLTRB(0, 0, 400, kItems * 50));
+
+  // A viewport covering items 500 through 509.
+  std::vector<int> results;
+  tree.search(SkRect::MakeXYWH(0, 25000, 400, 500), &results);
+  ASSERT_EQ(results.size(), 40u);
+  for (int i = 0; i < 40; i++) {
+    EXPECT_EQ(results[i], 2000 + i);
+    EXPECT_EQ(tree.bounds(results[i]), rects[2000 + i]);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
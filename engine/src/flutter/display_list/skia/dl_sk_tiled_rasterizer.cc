@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+
+// The state of a call to |Render| that is shared with its worker tasks.
+//
+// Workers may only start running after every tile has been rendered and
+// |Render| has returned, so they keep the frame alive and only look at
+// |next_tile| unless they claim a tile.
+struct DlSkTiledRasterizer::Frame {
+  Frame(sk_sp<DisplayList> display_list,
+        const SkPixmap& pixmap,
+        std::vector<SkIRect> tiles)
+      : display_list(std::move(display_list)),
+        pixmap(pixmap),
+        tiles(std::move(tiles)),
+        latch(this->tiles.size()) {}
+
+  // Renders tiles until there are none left to claim.
+  void RenderTiles() {
+    for (size_t index = next_tile.fetch_add(1); index < tiles.size();
+         index = next_tile.fetch_add(1)) {
+      RenderTile(tiles[index]);
+      latch.CountDown();
+    }
+  }
+
+  void RenderTile(const SkIRect& tile) {
+    TRACE_EVENT0("flutter", "DlSkTiledRasterizer::RenderTile");
+    SkPixmap tile_pixmap;
+    if (!pixmap.extractSubset(&tile_pixmap, tile)) {
+      return;
+    }
+    std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+        tile_pixmap.info(), tile_pixmap.writable_addr(),
+        tile_pixmap.rowBytes());
+    if (!canvas) {
+      return;
+    }
+    canvas->translate(-tile.left(), -tile.top());
+    canvas->clipRect(SkRect::Make(tile));
+    DlSkCanvasDispatcher dispatcher(canvas.get());
+    display_list->Dispatch(dispatcher, tile);
+  }
+
+  const sk_sp<DisplayList> display_list;
+  const SkPixmap pixmap;
+  const std::vector<SkIRect> tiles;
+  std::atomic_size_t next_tile = 0;
+  fml::CountDownLatch latch;
+};
+
+DlSkTiledRasterizer::DlSkTiledRasterizer(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t concurrency,
+    int tile_size)
+    : task_runner_(std::move(task_runner)),
+      concurrency_(concurrency),
+      tile_size_(std::max(tile_size, 1)) {}
+
+DlSkTiledRasterizer::~DlSkTiledRasterizer() = default;
+
+size_t DlSkTiledRasterizer::Render(const sk_sp<DisplayList>& display_list,
+                                   const SkPixmap& pixmap,
+                                   const SkIRect& dirty_rect) const {
+  TRACE_EVENT0("flutter", "DlSkTiledRasterizer::Render");
+  SkIRect render_rect = dirty_rect;
+  if (!display_list || !render_rect.intersect(pixmap.bounds())) {
+    return 0;
+  }
+
+  std::vector<SkIRect> tiles;
+  if (display_list->has_backdrop_filter()) {
+    tiles.push_back(render_rect);
+  } else {
+    // Tiles are aligned to the pixmap rather than to |dirty_rect| so that a
+    // tile covers the same pixels from one frame to the next.
+    const int top = render_rect.top() - render_rect.top() % tile_size_;
+    const int left = render_rect.left() - render_rect.left() % tile_size_;
+    for (int y = top; y < render_rect.bottom(); y += tile_size_) {
+      for (int x = left; x < render_rect.right(); x += tile_size_) {
+        SkIRect tile = SkIRect::MakeXYWH(x, y, tile_size_, tile_size_);
+        if (tile.intersect(render_rect)) {
+          tiles.push_back(tile);
+        }
+      }
+    }
+  }
+
+  const size_t tile_count = tiles.size();
+  auto frame =
+      std::make_shared<Frame>(display_list, pixmap, std::move(tiles));
+  if (task_runner_) {
+    // The calling thread renders tiles too, so one task fewer than there
+    // are tiles is enough to keep every tile busy.
+    const size_t task_count = std::min(concurrency_, tile_count - 1);
+    for (size_t i = 0; i < task_count; i++) {
+      task_runner_->PostTask([frame]() { frame->RenderTiles(); });
+    }
+  }
+  frame->RenderTiles();
+  frame->latch.Wait();
+  return tile_count;
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_SKIA_DL_SK_TILED_RASTERIZER_H_
+#define FLUTTER_DISPLAY_LIST_SKIA_DL_SK_TILED_RASTERIZER_H_
+
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Renders a |DisplayList| into a block of pixels with the Skia
+///             software backend, splitting the pixels into square tiles that
+///             are rendered in parallel.
+///
+///             Each tile only dispatches the ops that the |DlRTree| of the
+///             |DisplayList| reports as intersecting it, so a |DisplayList|
+///             built without an rtree is still rendered correctly but every
+///             tile dispatches all of its ops.
+///
+class DlSkTiledRasterizer {
+ public:
+  static constexpr int kDefaultTileSize = 256;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a rasterizer that renders tiles on up to
+  ///             |concurrency| tasks posted to |task_runner|, in addition to
+  ///             the thread that calls |Render|.
+  ///
+  /// @param[in]  task_runner  The runner of the worker tasks, usually a
+  ///                          |fml::ConcurrentTaskRunner|. If it is null,
+  ///                          every tile is rendered on the calling thread.
+  /// @param[in]  concurrency  The maximum number of worker tasks to post
+  ///                          for each frame.
+  /// @param[in]  tile_size    The width and height of the tiles, in pixels.
+  ///
+  DlSkTiledRasterizer(std::shared_ptr<fml::BasicTaskRunner> task_runner,
+                      size_t concurrency,
+                      int tile_size = kDefaultTileSize);
+
+  ~DlSkTiledRasterizer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders |display_list| into the pixels of |pixmap|, which
+  ///             are left unchanged outside of |dirty_rect|. Returns once
+  ///             every tile has been rendered.
+  ///
+  ///             The tiles are rendered independently, so a display list
+  ///             with a backdrop filter at any depth, which would read the
+  ///             pixels of neighboring tiles, is rendered as a single tile.
+  ///
+  /// @param[in]  display_list  The display list, in the pixel coordinates
+  ///                           of |pixmap|.
+  /// @param[in]  pixmap        The pixels to render into. The pixels must
+  ///                           remain valid until this method returns.
+  /// @param[in]  dirty_rect    The area of |pixmap| to render.
+  ///
+  /// @return     The number of tiles that were rendered.
+  ///
+  size_t Render(const sk_sp<DisplayList>& display_list,
+                const SkPixmap& pixmap,
+                const SkIRect& dirty_rect) const;
+
+  int tile_size() const { return tile_size_; }
+
+ private:
+  struct Frame;
+
+  const std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  const size_t concurrency_;
+  const int tile_size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlSkTiledRasterizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_SKIA_DL_SK_TILED_RASTERIZER_H_
@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+sk_sp<SkSurface> MakeSurface(int width, int height) {
+  return SkSurfaces::Raster(SkImageInfo::MakeN32Premul(width, height));
+}
+
+sk_sp<DisplayList> MakeScene(const SkRect& bounds) {
+  DisplayListBuilder builder(bounds, /*prepare_rtree=*/true);
+  DlPaint paint;
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  for (int i = 0; i < 20; i++) {
+    paint.setColor(DlColor(0xFF000000 | (i * 0x0A0B0C)));
+    paint.setAntiAlias(i % 2 == 0);
+    builder.DrawRect(SkRect::MakeXYWH(i * 13.5f, i * 7.25f, 40, 30), paint);
+    builder.DrawOval(SkRect::MakeXYWH(bounds.width() - i * 11.5f - 50,
+                                      i * 9.75f, 50, 35),
+                     paint);
+  }
+  return builder.Build();
+}
+}  // namespace
+
+TEST(DlSkTiledRasterizer, MatchesUntiledRendering) {
+  const int width = 300;
+  const int height = 200;
+  sk_sp<DisplayList> display_list =
+      MakeScene(SkRect::MakeWH(width, height));
+  ASSERT_TRUE(display_list->has_rtree());
+
+  sk_sp<SkSurface> expected_surface = MakeSurface(width, height);
+  DlSkCanvasDispatcher dispatcher(expected_surface->getCanvas());
+  display_list->Dispatch(dispatcher);
+  SkPixmap expected;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  DlSkTiledRasterizer rasterizer(loop->GetTaskRunner(), 4, /*tile_size=*/64);
+  sk_sp<SkSurface> tiled_surface = MakeSurface(width, height);
+  SkPixmap tiled;
+  ASSERT_TRUE(tiled_surface->peekPixels(&tiled));
+  EXPECT_EQ(rasterizer.Render(display_list, tiled, tiled.bounds()), 20u);
+
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      ASSERT_EQ(*tiled.addr32(x, y), *expected.addr32(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST(DlSkTiledRasterizer, LeavesPixelsOutsideDirtyRectUnchanged) {
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100), /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrc);
+  sk_sp<DisplayList> display_list = builder.Build();
+
+  sk_sp<SkSurface> surface = MakeSurface(100, 100);
+  SkPixmap pixmap;
+  ASSERT_TRUE(surface->peekPixels(&pixmap));
+  pixmap.erase(SK_ColorRED);
+
+  // Without a task runner, every tile is rendered on the calling thread.
+  DlSkTiledRasterizer rasterizer(nullptr, 0, /*tile_size=*/32);
+  EXPECT_EQ(rasterizer.Render(display_list, pixmap,
+                              SkIRect::MakeLTRB(10, 10, 50, 50)),
+            4u);
+
+  EXPECT_EQ(pixmap.getColor(5, 5), SK_ColorRED);
+  EXPECT_EQ(pixmap.getColor(10, 10), SK_ColorBLUE);
+  EXPECT_EQ(pixmap.getColor(49, 49), SK_ColorBLUE);
+  EXPECT_EQ(pixmap.getColor(50, 50), SK_ColorRED);
+  EXPECT_EQ(pixmap.getColor(40, 5), SK_ColorRED);
+}
+
+TEST(DlSkTiledRasterizer, RendersBackdropFilterAsSingleTile) {
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100), /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrc);
+  DlBlurImageFilter blur(5, 5, DlTileMode::kClamp);
+  builder.SaveLayer(nullptr, nullptr, &blur);
+  builder.Restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_TRUE(display_list->root_has_backdrop_filter());
+
+  sk_sp<SkSurface> surface = MakeSurface(100, 100);
+  SkPixmap pixmap;
+  ASSERT_TRUE(surface->peekPixels(&pixmap));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  DlSkTiledRasterizer rasterizer(loop->GetTaskRunner(), 4, /*tile_size=*/32);
+  EXPECT_EQ(rasterizer.Render(display_list, pixmap, pixmap.bounds()), 1u);
+  EXPECT_EQ(pixmap.getColor(50, 50), SK_ColorBLUE);
+}
+
+TEST(DlSkTiledRasterizer, RendersNestedBackdropFilterAsSingleTile) {
+  DlBlurImageFilter blur(5, 5, DlTileMode::kClamp);
+  DisplayListBuilder nested_builder;
+  nested_builder.SaveLayer(nullptr, nullptr, &blur);
+  nested_builder.Restore();
+  sk_sp<DisplayList> nested = nested_builder.Build();
+
+  // A backdrop filter inside a layer with opacity, and one inside a nested
+  // display list.
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100), /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrc);
+  DlPaint opacity = DlPaint().setOpacity(0.5f);
+  builder.SaveLayer(nullptr, &opacity);
+  builder.SaveLayer(nullptr, nullptr, &blur);
+  builder.Restore();
+  builder.Restore();
+  sk_sp<DisplayList> display_list = builder.Build();
+  ASSERT_FALSE(display_list->root_has_backdrop_filter());
+  ASSERT_TRUE(display_list->has_backdrop_filter());
+
+  DisplayListBuilder outer_builder(SkRect::MakeWH(100, 100),
+                                   /*prepare_rtree=*/true);
+  outer_builder.DrawColor(DlColor::kBlue(), DlBlendMode::kSrc);
+  outer_builder.SaveLayer(nullptr, &opacity);
+  outer_builder.DrawDisplayList(nested);
+  outer_builder.Restore();
+  sk_sp<DisplayList> outer_display_list = outer_builder.Build();
+  ASSERT_TRUE(outer_display_list->has_backdrop_filter());
+
+  sk_sp<SkSurface> surface = MakeSurface(100, 100);
+  SkPixmap pixmap;
+  ASSERT_TRUE(surface->peekPixels(&pixmap));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  DlSkTiledRasterizer rasterizer(loop->GetTaskRunner(), 4, /*tile_size=*/32);
+  EXPECT_EQ(rasterizer.Render(display_list, pixmap, pixmap.bounds()), 1u);
+  EXPECT_EQ(pixmap.getColor(50, 50), SK_ColorBLUE);
+  EXPECT_EQ(rasterizer.Render(outer_display_list, pixmap, pixmap.bounds()),
+            1u);
+  EXPECT_EQ(pixmap.getColor(50, 50), SK_ColorBLUE);
+}
+
+}  // namespace testing
+}  // namespace flutter
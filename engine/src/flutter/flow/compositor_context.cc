@@ -21,6 +21,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map,
                         has_raster_cache, impeller_enabled);
+    context.set_concurrent_traversal(concurrent_traversal_);
     context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
                                          layer_tree.frame_size().height()));
     {
@@ -122,6 +123,8 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 
   std::optional<SkRect> clip_rect;
   if (frame_damage) {
+    frame_damage->SetConcurrentLayerTraversal(
+        context_.concurrent_layer_traversal());
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
 
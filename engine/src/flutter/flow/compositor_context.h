@@ -7,9 +7,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/macros.h"
+#include "flutter/flow/concurrent_layer_traversal.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/raster_cache.h"
@@ -67,6 +69,12 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Sets the traversal used to diff large containers on worker threads. If
+  // not set, the layer tree is diffed serially.
+  void SetConcurrentLayerTraversal(const ConcurrentLayerTraversal* traversal) {
+    concurrent_traversal_ = traversal;
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
@@ -98,6 +106,7 @@ class FrameDamage {
   SkIRect additional_damage_ = SkIRect::MakeEmpty();
   std::optional<Damage> damage_;
   const LayerTree* prev_layer_tree_ = nullptr;
+  const ConcurrentLayerTraversal* concurrent_traversal_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
   bool ignore_damage_ = false;
@@ -194,9 +203,23 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  // The traversal used to preroll and diff large layer trees on worker
+  // threads, or null if they are traversed serially on the raster thread.
+  const ConcurrentLayerTraversal* concurrent_layer_traversal() const {
+    return concurrent_layer_traversal_.get();
+  }
+
+  // Enables the concurrent preroll and diff of large layer trees. Must not
+  // be called while a frame is being rasterized.
+  void SetConcurrentLayerTraversal(
+      std::shared_ptr<const ConcurrentLayerTraversal> traversal) {
+    concurrent_layer_traversal_ = std::move(traversal);
+  }
+
  private:
   NOT_SLIMPELLER(RasterCache raster_cache_);
   std::shared_ptr<TextureRegistry> texture_registry_;
+  std::shared_ptr<const ConcurrentLayerTraversal> concurrent_layer_traversal_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
 
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/concurrent_layer_traversal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// Shared between the calling thread and the posted worker tasks. Workers
+// that start after every index was claimed find no work and return without
+// touching |task|, which may be gone by then.
+struct ForEachState {
+  ForEachState(size_t count, const std::function<void(size_t)>& task)
+      : count(count), task(task) {}
+
+  const size_t count;
+  const std::function<void(size_t)>& task;
+  std::atomic_size_t next_index = 0;
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t completed = 0;
+
+  void RunTasks() {
+    size_t ran = 0;
+    for (size_t index = next_index.fetch_add(1); index < count;
+         index = next_index.fetch_add(1)) {
+      task(index);
+      ran++;
+    }
+    if (ran > 0) {
+      std::scoped_lock lock(mutex);
+      completed += ran;
+      if (completed == count) {
+        done.notify_all();
+      }
+    }
+  }
+};
+
+}  // namespace
+
+ConcurrentLayerTraversal::ConcurrentLayerTraversal(
+    std::shared_ptr<fml::BasicTaskRunner> worker_task_runner,
+    size_t worker_count,
+    size_t min_children)
+    : worker_task_runner_(std::move(worker_task_runner)),
+      worker_count_(worker_count),
+      min_children_(std::max<size_t>(min_children, 2u)) {
+  FML_DCHECK(worker_task_runner_);
+}
+
+ConcurrentLayerTraversal::~ConcurrentLayerTraversal() = default;
+
+void ConcurrentLayerTraversal::ForEach(
+    size_t count,
+    const std::function<void(size_t)>& task) const {
+  if (count == 0) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "ConcurrentLayerTraversal::ForEach");
+
+  auto state = std::make_shared<ForEachState>(count, task);
+  // The calling thread runs tasks as well, so one fewer worker is needed.
+  const size_t worker_tasks = std::min(worker_count_, count - 1);
+  for (size_t i = 0; i < worker_tasks; i++) {
+    worker_task_runner_->PostTask([state]() { state->RunTasks(); });
+  }
+  state->RunTasks();
+
+  std::unique_lock lock(state->mutex);
+  state->done.wait(lock,
+                   [&state]() { return state->completed == state->count; });
+}
+
+}  // namespace flutter
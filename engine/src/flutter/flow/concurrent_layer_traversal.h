@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_CONCURRENT_LAYER_TRAVERSAL_H_
+#define FLUTTER_FLOW_CONCURRENT_LAYER_TRAVERSAL_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs the independent children of a |ContainerLayer| through
+///             |Layer::Preroll| and |Layer::Diff| on a pool of worker
+///             threads.
+///
+///             A container only forks its children when it has at least
+///             |min_children| of them, and each child subtree is then
+///             traversed serially by a single thread. The results of every
+///             child are merged by the container in child order, so the
+///             outcome of a frame is identical to a serial traversal.
+///
+///             The raster thread takes part in the traversal and never waits
+///             for a task that no worker has started, so a busy or shut down
+///             worker pool only makes the traversal serial.
+///
+class ConcurrentLayerTraversal {
+ public:
+  // The smallest number of children worth forking for by default.
+  static constexpr size_t kDefaultMinChildren = 4;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a traversal that posts to the given worker pool.
+  ///
+  /// @param[in]  worker_task_runner  The task runner of the worker pool,
+  ///                                 usually the concurrent worker task
+  ///                                 runner of the shell.
+  /// @param[in]  worker_count        The number of tasks to post for each
+  ///                                 fork. Usually the number of workers in
+  ///                                 the pool.
+  /// @param[in]  min_children        The number of children a container
+  ///                                 needs before it forks.
+  ///
+  ConcurrentLayerTraversal(
+      std::shared_ptr<fml::BasicTaskRunner> worker_task_runner,
+      size_t worker_count,
+      size_t min_children = kDefaultMinChildren);
+
+  ~ConcurrentLayerTraversal();
+
+  size_t min_children() const { return min_children_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes |task| once for each index in [0, count) and returns
+  ///             once all invocations have completed. Invocations may run
+  ///             concurrently on the worker threads and the calling thread.
+  ///
+  void ForEach(size_t count, const std::function<void(size_t)>& task) const;
+
+ private:
+  std::shared_ptr<fml::BasicTaskRunner> worker_task_runner_;
+  const size_t worker_count_;
+  const size_t min_children_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentLayerTraversal);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_CONCURRENT_LAYER_TRAVERSAL_H_
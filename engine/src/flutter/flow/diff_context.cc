@@ -272,6 +272,58 @@ PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
   }
 }
 
+std::unique_ptr<DiffContext> DiffContext::CreateFragment(
+    PaintRegionMap& fragment_paint_region_map) const {
+  auto fragment = std::make_unique<DiffContext>(
+      frame_size_, fragment_paint_region_map, last_frame_paint_region_map_,
+      has_raster_cache_, impeller_enabled_);
+  fragment->state_ = state_;
+  fragment->state_.rect_index = 0;
+  fragment->state_.has_texture = false;
+  // The adjustments are owned by the subtrees of this context.
+  fragment->state_.has_filter_bounds_adjustment = false;
+  fragment->filter_bounds_adjustment_stack_ = filter_bounds_adjustment_stack_;
+  return fragment;
+}
+
+void DiffContext::MergeFragment(
+    const DiffContext& fragment,
+    const PaintRegionMap& fragment_paint_region_map) {
+  FML_DCHECK(fragment.state_stack_.empty());
+  const size_t offset = rects_->size();
+  rects_->insert(rects_->end(), fragment.rects_->begin(),
+                 fragment.rects_->end());
+  for (Readback readback : fragment.readbacks_) {
+    readback.position += offset;
+    readbacks_.push_back(readback);
+  }
+  damage_.join(fragment.damage_);
+  statistics_.Add(fragment.statistics_);
+  if (fragment.state_.has_texture) {
+    MarkSubtreeHasTextureLayer();
+  }
+  for (const auto& [id, region] : fragment_paint_region_map) {
+    if (region.rects_ == fragment.rects_) {
+      this_frame_paint_region_map_[id] =
+          PaintRegion(rects_, region.from_ + offset, region.to_ + offset,
+                      region.has_readback_, region.has_texture_);
+    } else {
+      // Regions of retained layers still refer to the rects of the previous
+      // frame.
+      this_frame_paint_region_map_[id] = region;
+    }
+  }
+}
+
+void DiffContext::Statistics::Add(const Statistics& other) {
+  new_pictures_ += other.new_pictures_;
+  pictures_too_complex_to_compare_ += other.pictures_too_complex_to_compare_;
+  same_instance_pictures_ += other.same_instance_pictures_;
+  deep_compare_pictures_ += other.deep_compare_pictures_;
+  different_instance_but_equal_pictures_ +=
+      other.different_instance_but_equal_pictures_;
+}
+
 void DiffContext::Statistics::LogStatistics() {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "DiffContext", reinterpret_cast<int64_t>(this),
@@ -7,6 +7,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 #include "display_list/utils/dl_matrix_clip_tracker.h"
@@ -18,6 +19,7 @@
 
 namespace flutter {
 
+class ConcurrentLayerTraversal;
 class Layer;
 
 // Represents area that needs to be updated in front buffer (frame_damage) and
@@ -168,6 +170,33 @@ class DiffContext {
 
   bool impeller_enabled() const { return impeller_enabled_; }
 
+  // The traversal used to diff the children of large containers on worker
+  // threads, or null if the children are diffed serially. Fragments never
+  // have a traversal so that only one level of the tree is forked.
+  const ConcurrentLayerTraversal* concurrent_traversal() const {
+    return concurrent_traversal_;
+  }
+  void set_concurrent_traversal(const ConcurrentLayerTraversal* traversal) {
+    concurrent_traversal_ = traversal;
+  }
+
+  // Creates a context that diffs a subtree starting at the current state
+  // independently of this one, for example on a worker thread. The fragment
+  // inherits the transform, cull rect, dirty flag and filter bounds
+  // adjustments of the current subtree and records the paint regions of
+  // the layers it diffs into |fragment_paint_region_map|.
+  //
+  // Nothing in this context may be modified while the fragment is in use.
+  std::unique_ptr<DiffContext> CreateFragment(
+      PaintRegionMap& fragment_paint_region_map) const;
+
+  // Adds the results of a fragment created by |CreateFragment| to the
+  // current subtree as if its layers had been diffed by this context.
+  // Fragments must be merged in the order in which the serial diff would
+  // have visited their subtrees.
+  void MergeFragment(const DiffContext& fragment,
+                     const PaintRegionMap& fragment_paint_region_map);
+
   class Statistics {
    public:
     // Picture replaced by different picture
@@ -189,6 +218,9 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Adds the counts of another statistics object, e.g. of a fragment.
+    void Add(const Statistics& other);
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -273,6 +305,7 @@ class DiffContext {
 
   std::vector<Readback> readbacks_;
   Statistics statistics_;
+  const ConcurrentLayerTraversal* concurrent_traversal_ = nullptr;
 };
 
 }  // namespace flutter
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/embedded_views.h"
 
+#include <deque>
+#include <mutex>
+
 namespace flutter {
 
 DisplayListEmbedderViewSlice::DisplayListEmbedderViewSlice(SkRect view_bounds) {
@@ -56,69 +59,114 @@ bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
 
+bool ExternalViewEmbedder::SupportsPartialRepaint() {
+  return false;
+}
+
 void ExternalViewEmbedder::Teardown() {}
 
+// The storage of the nodes of a stack and of its copies.
+//
+// Nodes are never freed or moved before the arena is destroyed, so stacks can
+// keep pointers to them. Copies of a stack may be pushed onto from different
+// threads.
+class MutatorsStack::Arena {
+ public:
+  const Node* Allocate(Mutator mutator, const Node* parent) {
+    std::scoped_lock lock(mutex_);
+    return &nodes_.emplace_back(std::move(mutator), parent);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<Node> nodes_;
+};
+
+void MutatorsStack::Push(Mutator mutator) {
+  if (!arena_) {
+    arena_ = std::make_shared<Arena>();
+  }
+  top_ = arena_->Allocate(std::move(mutator), top_);
+}
+
 void MutatorsStack::PushClipRect(const SkRect& rect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rect);
-  vector_.push_back(element);
+  Push(Mutator(rect));
 }
 
 void MutatorsStack::PushClipRRect(const SkRRect& rrect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rrect);
-  vector_.push_back(element);
+  Push(Mutator(rrect));
 }
 
 void MutatorsStack::PushClipPath(const SkPath& path) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(path);
-  vector_.push_back(element);
+  Push(Mutator(path));
 }
 
 void MutatorsStack::PushTransform(const SkMatrix& matrix) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(matrix);
-  vector_.push_back(element);
+  Push(Mutator(matrix));
 }
 
 void MutatorsStack::PushOpacity(const int& alpha) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(alpha);
-  vector_.push_back(element);
+  Push(Mutator(alpha));
 }
 
 void MutatorsStack::PushBackdropFilter(
     const std::shared_ptr<const DlImageFilter>& filter,
     const SkRect& filter_rect) {
-  std::shared_ptr<Mutator> element =
-      std::make_shared<Mutator>(filter, filter_rect);
-  vector_.push_back(element);
+  Push(Mutator(filter, filter_rect));
 }
 
 void MutatorsStack::Pop() {
-  vector_.pop_back();
+  FML_DCHECK(top_ != nullptr);
+  top_ = top_->parent;
 }
 
 void MutatorsStack::PopTo(size_t stack_count) {
-  while (vector_.size() > stack_count) {
+  while (stack_count < this->stack_count()) {
     Pop();
   }
 }
 
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Top() const {
-  return vector_.rend();
+MutatorsStack::Iterator::Iterator(const Node* top)
+    : count_(top ? top->depth : 0) {
+  const Node** path = inline_path_.data();
+  if (count_ > kInlineDepth) {
+    heap_path_.resize(count_);
+    path = heap_path_.data();
+  }
+  size_t index = count_;
+  for (const Node* node = top; node != nullptr; node = node->parent) {
+    path[--index] = node;
+  }
 }
 
-const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
-MutatorsStack::Bottom() const {
-  return vector_.rbegin();
+MutatorsStack::Iterator MutatorsStack::Begin() const {
+  return Iterator(top_);
 }
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator
-MutatorsStack::Begin() const {
-  return vector_.begin();
+bool MutatorsStack::operator==(const MutatorsStack& other) const {
+  if (stack_count() != other.stack_count()) {
+    return false;
+  }
+  // The nodes below a node that is shared by both stacks are shared too.
+  for (const Node *node = top_, *other_node = other.top_; node != other_node;
+       node = node->parent, other_node = other_node->parent) {
+    if (node->mutator != other_node->mutator) {
+      return false;
+    }
+  }
+  return true;
 }
 
-const std::vector<std::shared_ptr<Mutator>>::const_iterator MutatorsStack::End()
-    const {
-  return vector_.end();
+bool MutatorsStack::operator==(const std::vector<Mutator>& other) const {
+  if (stack_count() != other.size()) {
+    return false;
+  }
+  for (const Node* node = top_; node != nullptr; node = node->parent) {
+    if (node->mutator != other[node->depth - 1]) {
+      return false;
+    }
+  }
+  return true;
 }
 
 }  // namespace flutter
@@ -5,8 +5,10 @@
 #ifndef FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 #define FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 
+#include <array>
 #include <memory>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "flutter/display_list/dl_builder.h"
@@ -76,57 +78,32 @@ class ImageFilterMutation {
 // Each `type` is paired with an object that supports the mutation. For example,
 // if the `type` is kClipRect, `rect()` is used the represent the rect to be
 // clipped. One mutation object must only contain one type of mutation.
+//
+// Mutators are values: copying a clip path mutator shares the path data, as
+// copying an SkPath does.
 class Mutator {
  public:
-  Mutator(const Mutator& other) {
-    type_ = other.type_;
-    switch (other.type_) {
-      case kClipRect:
-        rect_ = other.rect_;
-        break;
-      case kClipRRect:
-        rrect_ = other.rrect_;
-        break;
-      case kClipPath:
-        path_ = new SkPath(*other.path_);
-        break;
-      case kTransform:
-        matrix_ = other.matrix_;
-        break;
-      case kOpacity:
-        alpha_ = other.alpha_;
-        break;
-      case kBackdropFilter:
-        filter_mutation_ = other.filter_mutation_;
-        break;
-      default:
-        break;
-    }
-  }
-
-  explicit Mutator(const SkRect& rect) : type_(kClipRect), rect_(rect) {}
-  explicit Mutator(const SkRRect& rrect) : type_(kClipRRect), rrect_(rrect) {}
-  explicit Mutator(const SkPath& path)
-      : type_(kClipPath), path_(new SkPath(path)) {}
+  explicit Mutator(const SkRect& rect) : type_(kClipRect), data_(rect) {}
+  explicit Mutator(const SkRRect& rrect) : type_(kClipRRect), data_(rrect) {}
+  explicit Mutator(const SkPath& path) : type_(kClipPath), data_(path) {}
   explicit Mutator(const SkMatrix& matrix)
-      : type_(kTransform), matrix_(matrix) {}
-  explicit Mutator(const int& alpha) : type_(kOpacity), alpha_(alpha) {}
+      : type_(kTransform), data_(matrix) {}
+  explicit Mutator(const int& alpha) : type_(kOpacity), data_(alpha) {}
   explicit Mutator(const std::shared_ptr<const DlImageFilter>& filter,
                    const SkRect& filter_rect)
       : type_(kBackdropFilter),
-        filter_mutation_(
-            std::make_shared<ImageFilterMutation>(filter, filter_rect)) {}
+        data_(std::in_place_type<ImageFilterMutation>, filter, filter_rect) {}
 
   const MutatorType& GetType() const { return type_; }
-  const SkRect& GetRect() const { return rect_; }
-  const SkRRect& GetRRect() const { return rrect_; }
-  const SkPath& GetPath() const { return *path_; }
-  const SkMatrix& GetMatrix() const { return matrix_; }
+  const SkRect& GetRect() const { return std::get<SkRect>(data_); }
+  const SkRRect& GetRRect() const { return std::get<SkRRect>(data_); }
+  const SkPath& GetPath() const { return std::get<SkPath>(data_); }
+  const SkMatrix& GetMatrix() const { return std::get<SkMatrix>(data_); }
   const ImageFilterMutation& GetFilterMutation() const {
-    return *filter_mutation_;
+    return std::get<ImageFilterMutation>(data_);
   }
-  const int& GetAlpha() const { return alpha_; }
-  float GetAlphaFloat() const { return (alpha_ / 255.0f); }
+  const int& GetAlpha() const { return std::get<int>(data_); }
+  float GetAlphaFloat() const { return (GetAlpha() / 255.0f); }
 
   bool operator==(const Mutator& other) const {
     if (type_ != other.type_) {
@@ -134,17 +111,17 @@ class Mutator {
     }
     switch (type_) {
       case kClipRect:
-        return rect_ == other.rect_;
+        return GetRect() == other.GetRect();
       case kClipRRect:
-        return rrect_ == other.rrect_;
+        return GetRRect() == other.GetRRect();
       case kClipPath:
-        return *path_ == *other.path_;
+        return GetPath() == other.GetPath();
       case kTransform:
-        return matrix_ == other.matrix_;
+        return GetMatrix() == other.GetMatrix();
       case kOpacity:
-        return alpha_ == other.alpha_;
+        return GetAlpha() == other.GetAlpha();
       case kBackdropFilter:
-        return *filter_mutation_ == *other.filter_mutation_;
+        return GetFilterMutation() == other.GetFilterMutation();
     }
 
     return false;
@@ -152,30 +129,14 @@ class Mutator {
 
   bool operator!=(const Mutator& other) const { return !operator==(other); }
 
-  bool IsClipType() {
+  bool IsClipType() const {
     return type_ == kClipRect || type_ == kClipRRect || type_ == kClipPath;
   }
 
-  ~Mutator() {
-    if (type_ == kClipPath) {
-      delete path_;
-    }
-  };
-
  private:
   MutatorType type_;
-
-  // TODO(cyanglaz): Remove union.
-  //  https://github.com/flutter/flutter/issues/108470
-  union {
-    SkRect rect_;
-    SkRRect rrect_;
-    SkMatrix matrix_;
-    SkPath* path_;
-    int alpha_;
-  };
-
-  std::shared_ptr<ImageFilterMutation> filter_mutation_;
+  std::variant<SkRect, SkRRect, SkMatrix, SkPath, int, ImageFilterMutation>
+      data_;
 };  // Mutator
 
 // A stack of mutators that can be applied to an embedded platform view.
@@ -187,8 +148,99 @@ class Mutator {
 // For example consider the following stack: [T1, T2, T3], where T1 is the top
 // of the stack and T3 is the bottom of the stack. Applying this mutators stack
 // to a platform view P1 will result in T1(T2(T3(P1))).
+//
+// The mutators are immutable nodes, each linked to the node below it, that
+// are allocated from an arena shared by the stack and its copies. Copying a
+// stack is constant time, a copy shares the mutators it was copied with, and
+// pushing onto a copy does not affect the original. Stacks that share mutators
+// are compared only up to the mutators they share.
 class MutatorsStack {
+ private:
+  struct Node {
+    Node(Mutator mutator, const Node* parent)
+        : mutator(std::move(mutator)),
+          parent(parent),
+          depth(parent ? parent->depth + 1 : 1) {}
+
+    const Mutator mutator;
+    // The node below this one, which is further from the leaf node.
+    const Node* const parent;
+    // The number of mutators in the stack that this node is the top of.
+    const size_t depth;
+  };
+
  public:
+  // Iterates from the mutator that is closest to the leaf node to the one
+  // that is furthest from it.
+  class ReverseIterator {
+   public:
+    const Mutator& operator*() const { return node_->mutator; }
+    const Mutator* operator->() const { return &node_->mutator; }
+
+    ReverseIterator& operator++() {
+      node_ = node_->parent;
+      return *this;
+    }
+
+    bool operator==(const ReverseIterator& other) const {
+      return node_ == other.node_;
+    }
+    bool operator!=(const ReverseIterator& other) const {
+      return node_ != other.node_;
+    }
+
+   private:
+    friend class MutatorsStack;
+
+    explicit ReverseIterator(const Node* node) : node_(node) {}
+
+    const Node* node_;
+  };
+
+  // Iterates from the mutator that is furthest from the leaf node to the one
+  // that is closest to it.
+  //
+  // The nodes are only linked towards the bottom of the stack, so the
+  // iterator records the path from the top of the stack once when it is
+  // created and increments are constant time. Paths of up to |kInlineDepth|
+  // nodes are stored inline.
+  class Iterator {
+   public:
+    const Mutator& operator*() const { return node()->mutator; }
+    const Mutator* operator->() const { return &node()->mutator; }
+
+    Iterator& operator++() {
+      index_++;
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return node() == other.node();
+    }
+    bool operator!=(const Iterator& other) const {
+      return node() != other.node();
+    }
+
+   private:
+    friend class MutatorsStack;
+
+    static constexpr size_t kInlineDepth = 16;
+
+    explicit Iterator(const Node* top);
+
+    const Node* node() const {
+      if (index_ >= count_) {
+        return nullptr;
+      }
+      return count_ > kInlineDepth ? heap_path_[index_] : inline_path_[index_];
+    }
+
+    std::array<const Node*, kInlineDepth> inline_path_;
+    std::vector<const Node*> heap_path_;
+    size_t count_;
+    size_t index_ = 0;
+  };
+
   MutatorsStack() = default;
 
   void PushClipRect(const SkRect& rect);
@@ -200,55 +252,33 @@ class MutatorsStack {
   void PushBackdropFilter(const std::shared_ptr<const DlImageFilter>& filter,
                           const SkRect& filter_rect);
 
-  // Removes the `Mutator` on the top of the stack
-  // and destroys it.
+  // Removes the `Mutator` on the top of the stack. Its storage is released
+  // with the arena.
   void Pop();
 
   void PopTo(size_t stack_count);
 
   // Returns a reverse iterator pointing to the top of the stack, which is the
   // mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Top()
-      const;
+  ReverseIterator Top() const { return ReverseIterator(nullptr); }
   // Returns a reverse iterator pointing to the bottom of the stack, which is
   // the mutator that is closeset from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator Bottom()
-      const;
+  ReverseIterator Bottom() const { return ReverseIterator(top_); }
 
-  // Returns an iterator pointing to the beginning of the mutator vector, which
-  // is the mutator that is furtherest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator Begin() const;
+  // Returns an iterator pointing to the beginning of the mutators, which is
+  // the mutator that is furtherest from the leaf node.
+  Iterator Begin() const;
 
-  // Returns an iterator pointing to the end of the mutator vector, which is the
-  // mutator that is closest from the leaf node.
-  const std::vector<std::shared_ptr<Mutator>>::const_iterator End() const;
+  // Returns an iterator pointing to the end of the mutators, which is past
+  // the mutator that is closest from the leaf node.
+  Iterator End() const { return Iterator(nullptr); }
 
-  bool is_empty() const { return vector_.empty(); }
-  size_t stack_count() const { return vector_.size(); }
+  bool is_empty() const { return top_ == nullptr; }
+  size_t stack_count() const { return top_ ? top_->depth : 0; }
 
-  bool operator==(const MutatorsStack& other) const {
-    if (vector_.size() != other.vector_.size()) {
-      return false;
-    }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != *other.vector_[i]) {
-        return false;
-      }
-    }
-    return true;
-  }
+  bool operator==(const MutatorsStack& other) const;
 
-  bool operator==(const std::vector<Mutator>& other) const {
-    if (vector_.size() != other.size()) {
-      return false;
-    }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != other[i]) {
-        return false;
-      }
-    }
-    return true;
-  }
+  bool operator==(const std::vector<Mutator>& other) const;
 
   bool operator!=(const MutatorsStack& other) const {
     return !operator==(other);
@@ -259,7 +289,12 @@ class MutatorsStack {
   }
 
  private:
-  std::vector<std::shared_ptr<Mutator>> vector_;
+  class Arena;
+
+  void Push(Mutator mutator);
+
+  std::shared_ptr<Arena> arena_;
+  const Node* top_ = nullptr;
 };  // MutatorsStack
 
 class EmbeddedViewParams {
@@ -483,6 +518,15 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether the embedder can use the damage of a frame to only render the
+  // parts of its layers that changed.
+  //
+  // Returning `true` makes the rasterizer diff each frame against the previous
+  // one, and set |SurfaceFrame::SubmitInfo::frame_damage| of the frame passed
+  // to |SubmitFlutterView|. The frame itself is still painted in full, since
+  // the layers that its contents end up in are only known after painting.
+  virtual bool SupportsPartialRepaint();
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
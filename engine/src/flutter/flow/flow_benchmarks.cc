@@ -0,0 +1,189 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/concurrent_layer_traversal.h"
+#include "flutter/flow/diff_context.h"
+#include "flutter/flow/embedded_views.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_state_stack.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/stopwatch.h"
+#include "flutter/fml/concurrent_message_loop.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr SkISize kFrameSize = SkISize::Make(1000, 1000);
+
+sk_sp<DisplayList> CreateDisplayList(int index) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 10; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i * 5, i * 3, 20, 20),
+                     DlPaint(DlColor(0xFF000000 | (index * 97 + i))));
+  }
+  return builder.Build();
+}
+
+std::shared_ptr<Layer> CreateLeaf(int index) {
+  auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(1, 1));
+  opacity->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), CreateDisplayList(index), false, false));
+  return opacity;
+}
+
+// A root with |width| children, each of which is a short subtree.
+std::shared_ptr<ContainerLayer> CreateWideTree(int width) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < width; i++) {
+    auto transform = std::make_shared<TransformLayer>(
+        SkM44::Translate((i % 20) * 50.0f, (i / 20) * 50.0f));
+    transform->Add(CreateLeaf(i));
+    root->Add(transform);
+  }
+  return root;
+}
+
+// A root with a few children, each of which is a chain of |depth| nested
+// transforms that ends in a handful of leaves.
+std::shared_ptr<ContainerLayer> CreateDeepTree(int depth) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < 8; i++) {
+    std::shared_ptr<ContainerLayer> parent = root;
+    for (int level = 0; level < depth; level++) {
+      auto transform =
+          std::make_shared<TransformLayer>(SkM44::Translate(1.0f, 1.0f));
+      parent->Add(transform);
+      parent = transform;
+    }
+    for (int leaf = 0; leaf < 4; leaf++) {
+      parent->Add(CreateLeaf(i * 4 + leaf));
+    }
+  }
+  return root;
+}
+
+const ConcurrentLayerTraversal* GetTraversal(bool concurrent) {
+  if (!concurrent) {
+    return nullptr;
+  }
+  static auto loop = fml::ConcurrentMessageLoop::Create();
+  static ConcurrentLayerTraversal traversal(loop->GetTaskRunner(),
+                                            loop->GetWorkerCount());
+  return &traversal;
+}
+
+void Preroll(ContainerLayer* root, const ConcurrentLayerTraversal* traversal) {
+  static FixedRefreshRateStopwatch raster_time;
+  static FixedRefreshRateStopwatch ui_time;
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(SkRect::Make(kFrameSize), SkMatrix::I());
+  PrerollContext context = {
+      // clang-format off
+      .raster_cache                  = nullptr,
+      .gr_context                    = nullptr,
+      .view_embedder                 = nullptr,
+      .state_stack                   = state_stack,
+      .dst_color_space               = nullptr,
+      .surface_needs_readback        = false,
+      .raster_time                   = raster_time,
+      .ui_time                       = ui_time,
+      .texture_registry              = nullptr,
+      .raster_cached_entries         = nullptr,
+      .concurrent_traversal          = traversal,
+      // clang-format on
+  };
+  root->Preroll(&context);
+}
+
+// Prerolls a frame and diffs it against an identical previous frame whose
+// layers are all distinct, so every layer is visited by both walks.
+void RunFrames(benchmark::State& state,
+               std::shared_ptr<ContainerLayer> (*create_tree)(int)) {
+  const auto* traversal = GetTraversal(state.range(1) != 0);
+  auto old_root = create_tree(state.range(0));
+  auto root = create_tree(state.range(0));
+  PaintRegionMap old_paint_region_map;
+  {
+    DiffContext context(kFrameSize, old_paint_region_map, PaintRegionMap(),
+                        false, true);
+    old_root->Diff(&context, nullptr);
+  }
+
+  PaintRegionMap paint_region_map;
+  for ([[maybe_unused]] auto _ : state) {
+    Preroll(root.get(), traversal);
+
+    paint_region_map.clear();
+    DiffContext context(kFrameSize, paint_region_map, old_paint_region_map,
+                        false, true);
+    context.set_concurrent_traversal(traversal);
+    context.PushCullRect(SkRect::Make(kFrameSize));
+    root->Diff(&context, old_root.get());
+    benchmark::DoNotOptimize(context.ComputeDamage(SkIRect::MakeEmpty()));
+  }
+}
+
+}  // namespace
+
+static void BM_PrerollAndDiffWideTree(benchmark::State& state) {
+  RunFrames(state, CreateWideTree);
+}
+
+static void BM_PrerollAndDiffDeepTree(benchmark::State& state) {
+  RunFrames(state, CreateDeepTree);
+}
+
+// The second argument selects the concurrent traversal.
+BENCHMARK(BM_PrerollAndDiffWideTree)
+    ->ArgsProduct({{16, 128, 1024}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_PrerollAndDiffDeepTree)
+    ->ArgsProduct({{4, 32, 256}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Collects the mutators of platform views that are laid out in a scrolled,
+// clipped list, as the platform view layers of a frame do, and compares them
+// with the mutators of the previous frame, as the embedders do to decide
+// whether a platform view has to be updated.
+static void BM_FillPlatformViewMutators(benchmark::State& state) {
+  const int view_count = state.range(0);
+  std::vector<MutatorsStack> old_mutators(view_count);
+  std::vector<MutatorsStack> mutators(view_count);
+  for ([[maybe_unused]] auto _ : state) {
+    LayerStateStack state_stack;
+    state_stack.set_preroll_delegate(SkRect::Make(kFrameSize), SkMatrix::I());
+    auto list = state_stack.save();
+    list.clipRect(SkRect::Make(kFrameSize), false);
+    list.translate(0, -100);
+    for (int i = 0; i < view_count; i++) {
+      auto item = state_stack.save();
+      item.translate(0, i * 50.0f);
+      item.clipRRect(SkRRect::MakeRectXY(SkRect::MakeWH(200, 40), 4, 4),
+                     true);
+      state_stack.fill(&mutators[i]);
+    }
+    for (int i = 0; i < view_count; i++) {
+      benchmark::DoNotOptimize(mutators[i] == old_mutators[i]);
+    }
+    std::swap(mutators, old_mutators);
+  }
+}
+
+BENCHMARK(BM_FillPlatformViewMutators)
+    ->Arg(16)
+    ->Arg(128)
+    ->Arg(1024)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -53,6 +53,13 @@ void BackdropFilterLayer::Preroll(PrerollContext* context) {
   context->renderable_state_flags = kSaveLayerRenderFlags;
 }
 
+bool BackdropFilterLayer::CanPrerollConcurrently(
+    const PrerollContext* context) const {
+  // The filter applies to the platform views visited before this layer.
+  return context->view_embedder == nullptr &&
+         ContainerLayer::CanPrerollConcurrently(context);
+}
+
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
@@ -19,6 +19,8 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Preroll(PrerollContext* context) override;
 
+  bool CanPrerollConcurrently(const PrerollContext* context) const override;
+
   void Paint(PaintContext& context) const override;
 
  private:
@@ -4,8 +4,11 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
 #include <optional>
 
+#include "flutter/flow/concurrent_layer_traversal.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
@@ -26,7 +29,16 @@ void ContainerLayer::PreservePaintRegion(DiffContext* context) {
 
 void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
+  const bool concurrent =
+      ShouldTraverseConcurrently(context->concurrent_traversal());
   if (context->IsSubtreeDirty()) {
+    if (concurrent) {
+      DiffChildrenConcurrently(context, [this](DiffContext* context,
+                                               size_t index) {
+        layers_[index]->Diff(context, nullptr);
+      });
+      return;
+    }
     for (auto& layer : layers_) {
       layer->Diff(context, nullptr);
     }
@@ -70,7 +82,8 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
   }
 
-  for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
+  auto diff_child = [&](DiffContext* context, size_t index) {
+    int i = static_cast<int>(index);
     if (i < new_children_top || i > new_children_bottom) {
       int i_prev =
           i < new_children_top ? i : prev_layers.size() - (layers_.size() - i);
@@ -100,6 +113,31 @@ void ContainerLayer::DiffChildren(DiffContext* context,
       auto layer = layers_[i];
       layer->Diff(context, nullptr);
     }
+  };
+
+  if (concurrent) {
+    DiffChildrenConcurrently(context, diff_child);
+    return;
+  }
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    diff_child(context, i);
+  }
+}
+
+void ContainerLayer::DiffChildrenConcurrently(
+    DiffContext* context,
+    const std::function<void(DiffContext*, size_t)>& diff_child) {
+  TRACE_EVENT0("flutter", "ContainerLayer::DiffChildrenConcurrently");
+  const size_t count = layers_.size();
+  std::vector<PaintRegionMap> paint_region_maps(count);
+  std::vector<std::unique_ptr<DiffContext>> fragments(count);
+  for (size_t i = 0; i < count; i++) {
+    fragments[i] = context->CreateFragment(paint_region_maps[i]);
+  }
+  context->concurrent_traversal()->ForEach(
+      count, [&](size_t i) { diff_child(fragments[i].get(), i); });
+  for (size_t i = 0; i < count; i++) {
+    context->MergeFragment(*fragments[i], paint_region_maps[i]);
   }
 }
 
@@ -113,6 +151,19 @@ void ContainerLayer::Preroll(PrerollContext* context) {
   set_paint_bounds(child_paint_bounds);
 }
 
+bool ContainerLayer::CanPrerollConcurrently(
+    const PrerollContext* context) const {
+  return std::all_of(layers_.begin(), layers_.end(),
+                     [context](const std::shared_ptr<Layer>& layer) {
+                       return layer->CanPrerollConcurrently(context);
+                     });
+}
+
+bool ContainerLayer::ShouldTraverseConcurrently(
+    const ConcurrentLayerTraversal* traversal) const {
+  return traversal != nullptr && layers_.size() >= traversal->min_children();
+}
+
 void ContainerLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
@@ -126,6 +177,76 @@ static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   return rect1->intersects(rect2);
 }
 
+namespace {
+
+// The state that each child reports back to its parent from |Preroll|.
+struct ChildPrerollState {
+  bool has_platform_view = false;
+  bool has_texture_layer = false;
+  int renderable_state_flags = 0;
+};
+
+// Combines the states of the children in child order.
+class ChildPrerollAccumulator {
+ public:
+  explicit ChildPrerollAccumulator(SkRect* child_paint_bounds)
+      : child_paint_bounds_(child_paint_bounds) {}
+
+  void Add(const Layer& layer, const ChildPrerollState& state) {
+    all_renderable_state_flags_ &= state.renderable_state_flags;
+    if (safe_intersection_test(child_paint_bounds_, layer.paint_bounds())) {
+      // This will allow inheritance by a linear sequence of non-overlapping
+      // children, but will fail with a grid or other arbitrary 2D layout.
+      // See https://github.com/flutter/flutter/issues/93899
+      all_renderable_state_flags_ = 0;
+    }
+    child_paint_bounds_->join(layer.paint_bounds());
+
+    child_has_platform_view_ =
+        child_has_platform_view_ || state.has_platform_view;
+    child_has_texture_layer_ =
+        child_has_texture_layer_ || state.has_texture_layer;
+  }
+
+  void Finish(PrerollContext* context, ContainerLayer* layer) const {
+    context->has_platform_view = child_has_platform_view_;
+    context->has_texture_layer = child_has_texture_layer_;
+    context->renderable_state_flags = all_renderable_state_flags_;
+    layer->set_subtree_has_platform_view(child_has_platform_view_);
+    layer->set_children_renderable_state_flags(all_renderable_state_flags_);
+    layer->set_child_paint_bounds(*child_paint_bounds_);
+  }
+
+ private:
+  SkRect* child_paint_bounds_;
+  bool child_has_platform_view_ = false;
+  bool child_has_texture_layer_ = false;
+  bool all_renderable_state_flags_ = LayerStateStack::kCallerCanApplyAnything;
+};
+
+// Prerolls |layer| with the shared |context|.
+ChildPrerollState PrerollChild(PrerollContext* context, Layer* layer) {
+  // Reset context->has_platform_view and context->has_texture_layer to false
+  // so that layers aren't treated as if they have a platform view or texture
+  // layer based on one being previously found in a sibling tree.
+  context->has_platform_view = false;
+  context->has_texture_layer = false;
+
+  // Initialize the renderable state flags to false to force the layer to
+  // opt-in to applying state attributes during its |Preroll|
+  context->renderable_state_flags = 0;
+
+  layer->Preroll(context);
+
+  return {
+      .has_platform_view = context->has_platform_view,
+      .has_texture_layer = context->has_texture_layer,
+      .renderable_state_flags = context->renderable_state_flags,
+  };
+}
+
+}  // namespace
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      SkRect* child_paint_bounds) {
   // Platform views have no children, so context->has_platform_view should
@@ -133,44 +254,81 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   FML_DCHECK(!context->has_texture_layer);
 
-  bool child_has_platform_view = false;
-  bool child_has_texture_layer = false;
-  bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  bool concurrent = ShouldTraverseConcurrently(context->concurrent_traversal);
+#if !SLIMPELLER
+  // The raster cache entries are collected and marked in tree order.
+  concurrent = concurrent && context->raster_cache == nullptr;
+#endif  //  !SLIMPELLER
+  if (concurrent) {
+    PrerollChildrenConcurrently(context, child_paint_bounds);
+    return;
+  }
 
+  ChildPrerollAccumulator accumulator(child_paint_bounds);
   for (auto& layer : layers_) {
-    // Reset context->has_platform_view and context->has_texture_layer to false
-    // so that layers aren't treated as if they have a platform view or texture
-    // layer based on one being previously found in a sibling tree.
-    context->has_platform_view = false;
-    context->has_texture_layer = false;
-
-    // Initialize the renderable state flags to false to force the layer to
-    // opt-in to applying state attributes during its |Preroll|
-    context->renderable_state_flags = 0;
-
-    layer->Preroll(context);
+    accumulator.Add(*layer, PrerollChild(context, layer.get()));
+  }
+  accumulator.Finish(context, this);
+}
 
-    all_renderable_state_flags &= context->renderable_state_flags;
-    if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
-      // This will allow inheritance by a linear sequence of non-overlapping
-      // children, but will fail with a grid or other arbitrary 2D layout.
-      // See https://github.com/flutter/flutter/issues/93899
-      all_renderable_state_flags = 0;
+void ContainerLayer::PrerollChildrenConcurrently(PrerollContext* context,
+                                                 SkRect* child_paint_bounds) {
+  TRACE_EVENT0("flutter", "ContainerLayer::PrerollChildrenConcurrently");
+  const size_t count = layers_.size();
+  std::vector<ChildPrerollState> states(count);
+
+  // Subtrees that talk to the view embedder are prerolled first, in tree
+  // order, with the shared context.
+  std::vector<size_t> concurrent_children;
+  concurrent_children.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    if (context->view_embedder == nullptr ||
+        layers_[i]->CanPrerollConcurrently(context)) {
+      concurrent_children.push_back(i);
+    } else {
+      states[i] = PrerollChild(context, layers_[i].get());
     }
-    child_paint_bounds->join(layer->paint_bounds());
-
-    child_has_platform_view =
-        child_has_platform_view || context->has_platform_view;
-    child_has_texture_layer =
-        child_has_texture_layer || context->has_texture_layer;
   }
 
-  context->has_platform_view = child_has_platform_view;
-  context->has_texture_layer = child_has_texture_layer;
-  context->renderable_state_flags = all_renderable_state_flags;
-  set_subtree_has_platform_view(child_has_platform_view);
-  set_children_renderable_state_flags(all_renderable_state_flags);
-  set_child_paint_bounds(*child_paint_bounds);
+  // Every other subtree gets a context of its own, starting from the
+  // transform and cull rect of this layer. A subtree can only ever add to
+  // the readback flag of its parent, so the flags are merged with an OR.
+  // (A std::vector<bool> cannot be written from several threads.)
+  const SkRect cull_rect = context->state_stack.device_cull_rect();
+  const SkM44 matrix = context->state_stack.transform_4x4();
+  std::vector<uint8_t> needs_readback(count, 0u);
+  context->concurrent_traversal->ForEach(
+      concurrent_children.size(), [&](size_t n) {
+        const size_t i = concurrent_children[n];
+        LayerStateStack state_stack;
+        state_stack.set_preroll_delegate(cull_rect, matrix);
+        PrerollContext child_context = {
+            // clang-format off
+#if !SLIMPELLER
+            .raster_cache           = nullptr,
+#endif  //  !SLIMPELLER
+            .gr_context             = context->gr_context,
+            .view_embedder          = context->view_embedder,
+            .state_stack            = state_stack,
+            .dst_color_space        = context->dst_color_space,
+            .surface_needs_readback = false,
+            .raster_time            = context->raster_time,
+            .ui_time                = context->ui_time,
+            .texture_registry       = context->texture_registry,
+            .raster_cached_entries  = nullptr,
+            // clang-format on
+        };
+        states[i] = PrerollChild(&child_context, layers_[i].get());
+        needs_readback[i] = child_context.surface_needs_readback ? 1u : 0u;
+      });
+
+  ChildPrerollAccumulator accumulator(child_paint_bounds);
+  for (size_t i = 0; i < count; i++) {
+    accumulator.Add(*layers_[i], states[i]);
+    context->surface_needs_readback =
+        context->surface_needs_readback || needs_readback[i] != 0u;
+  }
+  accumulator.Finish(context, this);
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
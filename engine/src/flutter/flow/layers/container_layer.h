@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <functional>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
@@ -21,6 +22,7 @@ class ContainerLayer : public Layer {
   virtual void Add(std::shared_ptr<Layer> layer);
 
   void Preroll(PrerollContext* context) override;
+  bool CanPrerollConcurrently(const PrerollContext* context) const override;
   void Paint(PaintContext& context) const override;
 
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
@@ -48,6 +50,20 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  // Whether the children are numerous enough to be forked onto the workers
+  // of |traversal|.
+  bool ShouldTraverseConcurrently(
+      const ConcurrentLayerTraversal* traversal) const;
+
+  void PrerollChildrenConcurrently(PrerollContext* context,
+                                   SkRect* child_paint_bounds);
+
+  // Invokes |diff_child| for each child with a fragment of |context| and
+  // merges the fragments in child order.
+  void DiffChildrenConcurrently(
+      DiffContext* context,
+      const std::function<void(DiffContext*, size_t)>& diff_child);
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
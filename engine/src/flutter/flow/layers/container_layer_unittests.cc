@@ -4,11 +4,19 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/concurrent_layer_traversal.h"
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/platform_view_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_embedder.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -560,6 +568,148 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+namespace {
+
+// A wide tree whose children exercise all of the state that a container
+// merges from its children during Preroll.
+std::shared_ptr<ContainerLayer> CreateWidePrerollTree(bool platform_views) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < 4; i++) {
+    auto transform = std::make_shared<TransformLayer>(
+        SkM44::Translate(i * 100.0f, 10.0f));
+    transform->Add(
+        MockLayer::MakeOpacityCompatible(SkPath().addRect(0, 0, 50, 50)));
+    auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(5, 5));
+    opacity->Add(
+        MockLayer::MakeOpacityCompatible(SkPath().addRect(0, 0, 20, 20)));
+    // Overlaps the previous sibling on odd iterations.
+    opacity->Add(MockLayer::MakeOpacityCompatible(
+        SkPath().addRect(i % 2 ? 10 : 30, 0, 50, 20)));
+    transform->Add(opacity);
+    root->Add(transform);
+  }
+
+  SkM44 perspective;
+  perspective.setRC(3, 1, 0.001f);
+  auto perspective_layer = std::make_shared<TransformLayer>(perspective);
+  perspective_layer->Add(
+      std::make_shared<MockLayer>(SkPath().addRect(0, 0, 100, 100)));
+  root->Add(perspective_layer);
+
+  auto clip = std::make_shared<ClipRectLayer>(
+      SkRect::MakeLTRB(0, 200, 300, 400), Clip::kHardEdge);
+  auto reads_surface =
+      std::make_shared<MockLayer>(SkPath().addRect(10, 210, 500, 500));
+  reads_surface->set_fake_reads_surface(true);
+  clip->Add(reads_surface);
+  root->Add(clip);
+
+  auto texture = std::make_shared<MockLayer>(SkPath().addRect(0, 600, 50, 650));
+  texture->set_fake_has_texture_layer(true);
+  root->Add(texture);
+
+  if (platform_views) {
+    root->Add(std::make_shared<PlatformViewLayer>(
+        SkPoint::Make(0, 700), SkSize::Make(50, 50), 1));
+    auto platform_view_clip = std::make_shared<ClipRectLayer>(
+        SkRect::MakeLTRB(100, 700, 150, 750), Clip::kHardEdge);
+    platform_view_clip->Add(std::make_shared<PlatformViewLayer>(
+        SkPoint::Make(100, 700), SkSize::Make(100, 100), 2));
+    root->Add(platform_view_clip);
+    root->Add(std::make_shared<BackdropFilterLayer>(
+        DlBlurImageFilter::Make(5, 5, DlTileMode::kClamp),
+        DlBlendMode::kSrcOver));
+  }
+  return root;
+}
+
+void ExpectSamePrerollResults(const Layer* expected, const Layer* actual) {
+  EXPECT_EQ(expected->paint_bounds(), actual->paint_bounds());
+  EXPECT_EQ(expected->subtree_has_platform_view(),
+            actual->subtree_has_platform_view());
+  if (auto* expected_mock = expected->as_mock_layer()) {
+    auto* actual_mock = actual->as_mock_layer();
+    ASSERT_NE(actual_mock, nullptr);
+    EXPECT_EQ(expected_mock->parent_matrix(), actual_mock->parent_matrix());
+    EXPECT_EQ(expected_mock->parent_cull_rect(),
+              actual_mock->parent_cull_rect());
+    EXPECT_EQ(expected_mock->parent_has_platform_view(),
+              actual_mock->parent_has_platform_view());
+    EXPECT_EQ(expected_mock->parent_has_texture_layer(),
+              actual_mock->parent_has_texture_layer());
+  }
+  if (auto* expected_container = expected->as_container_layer()) {
+    auto* actual_container = actual->as_container_layer();
+    ASSERT_NE(actual_container, nullptr);
+    EXPECT_EQ(expected_container->child_paint_bounds(),
+              actual_container->child_paint_bounds());
+    EXPECT_EQ(expected_container->children_renderable_state_flags(),
+              actual_container->children_renderable_state_flags());
+    ASSERT_EQ(expected_container->layers().size(),
+              actual_container->layers().size());
+    for (size_t i = 0; i < expected_container->layers().size(); i++) {
+      ExpectSamePrerollResults(expected_container->layers()[i].get(),
+                               actual_container->layers()[i].get());
+    }
+  }
+}
+
+}  // namespace
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollMatchesSerialPreroll) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  ConcurrentLayerTraversal traversal(loop->GetTaskRunner(),
+                                     loop->GetWorkerCount(), 2);
+
+  auto serial_root = CreateWidePrerollTree(false);
+  serial_root->Preroll(preroll_context());
+  const bool serial_needs_readback = preroll_context()->surface_needs_readback;
+  const bool serial_has_texture_layer = preroll_context()->has_texture_layer;
+  const int serial_flags = preroll_context()->renderable_state_flags;
+
+  preroll_context()->surface_needs_readback = false;
+  preroll_context()->has_texture_layer = false;
+  preroll_context()->renderable_state_flags = 0;
+  preroll_context()->concurrent_traversal = &traversal;
+  auto concurrent_root = CreateWidePrerollTree(false);
+  concurrent_root->Preroll(preroll_context());
+
+  EXPECT_TRUE(serial_needs_readback);
+  EXPECT_EQ(preroll_context()->surface_needs_readback, serial_needs_readback);
+  EXPECT_EQ(preroll_context()->has_texture_layer, serial_has_texture_layer);
+  EXPECT_EQ(preroll_context()->renderable_state_flags, serial_flags);
+  ExpectSamePrerollResults(serial_root.get(), concurrent_root.get());
+}
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollVisitsPlatformViewsInOrder) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  ConcurrentLayerTraversal traversal(loop->GetTaskRunner(),
+                                     loop->GetWorkerCount(), 2);
+
+  MockViewEmbedder serial_embedder;
+  preroll_context()->view_embedder = &serial_embedder;
+  auto serial_root = CreateWidePrerollTree(true);
+  serial_root->Preroll(preroll_context());
+  const bool serial_has_platform_view = preroll_context()->has_platform_view;
+
+  MockViewEmbedder concurrent_embedder;
+  preroll_context()->view_embedder = &concurrent_embedder;
+  preroll_context()->surface_needs_readback = false;
+  preroll_context()->has_platform_view = false;
+  preroll_context()->has_texture_layer = false;
+  preroll_context()->renderable_state_flags = 0;
+  preroll_context()->concurrent_traversal = &traversal;
+  auto concurrent_root = CreateWidePrerollTree(true);
+  concurrent_root->Preroll(preroll_context());
+
+  EXPECT_TRUE(serial_has_platform_view);
+  EXPECT_EQ(preroll_context()->has_platform_view, serial_has_platform_view);
+  EXPECT_EQ(serial_embedder.prerolled_views(), std::vector<int64_t>({1, 2}));
+  EXPECT_EQ(concurrent_embedder.prerolled_views(),
+            serial_embedder.prerolled_views());
+  ExpectSamePrerollResults(serial_root.get(), concurrent_root.get());
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -763,6 +913,95 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+namespace {
+
+void ExpectSamePaintRegions(const PaintRegionMap& expected,
+                            const PaintRegionMap& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (const auto& [id, expected_region] : expected) {
+    auto found = actual.find(id);
+    ASSERT_NE(found, actual.end());
+    const PaintRegion& actual_region = found->second;
+    ASSERT_EQ(expected_region.is_valid(), actual_region.is_valid());
+    if (!expected_region.is_valid()) {
+      continue;
+    }
+    EXPECT_EQ(
+        std::vector<SkRect>(expected_region.begin(), expected_region.end()),
+        std::vector<SkRect>(actual_region.begin(), actual_region.end()));
+    EXPECT_EQ(expected_region.has_readback(), actual_region.has_readback());
+    EXPECT_EQ(expected_region.has_texture(), actual_region.has_texture());
+  }
+}
+
+}  // namespace
+
+TEST_F(ContainerLayerDiffTest, ConcurrentDiffMatchesSerialDiff) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  ConcurrentLayerTraversal traversal(loop->GetTaskRunner(),
+                                     loop->GetWorkerCount(), 2);
+
+  auto retained = CreateContainerLayer(
+      CreateDisplayListLayer(CreateDisplayList(SkRect::MakeWH(50, 50))));
+  auto texture = CreateContainerLayer(std::make_shared<TextureLayer>(
+      SkPoint::Make(0, 100), SkSize::Make(50, 50), 0, false,
+      DlImageSampling::kLinear));
+  auto backdrop = std::make_shared<ClipRectLayer>(
+      SkRect::MakeLTRB(100, 100, 200, 200), Clip::kHardEdge);
+  backdrop->Add(std::make_shared<BackdropFilterLayer>(
+      DlBlurImageFilter::Make(10, 10, DlTileMode::kClamp),
+      DlBlendMode::kSrcOver));
+  auto transform = std::make_shared<TransformLayer>(SkM44::Translate(300, 0));
+  transform->Add(
+      CreateDisplayListLayer(CreateDisplayList(SkRect::MakeWH(40, 40))));
+
+  MockLayerTree t1;
+  t1.root()->Add(retained);
+  t1.root()->Add(texture);
+  t1.root()->Add(backdrop);
+  t1.root()->Add(transform);
+  for (int i = 0; i < 8; i++) {
+    auto rect = SkRect::MakeXYWH(i * 60, 400, 50, 50);
+    t1.root()->Add(
+        CreateOpacityLater({CreateDisplayListLayer(CreateDisplayList(rect))},
+                           128, SkPoint::Make(0, i)));
+  }
+
+  // Keeps the first four children, replaces two of the grid children with
+  // pictures of a different color and removes the others.
+  MockLayerTree t2;
+  t2.root()->Add(retained);
+  t2.root()->Add(texture);
+  t2.root()->Add(backdrop);
+  t2.root()->Add(transform);
+  t2.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeXYWH(0, 400, 50, 50), DlColor::kRed())));
+  t2.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeXYWH(60, 400, 50, 50), DlColor::kRed())));
+  t2.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(150, 150, 170, 170))));
+
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  PaintRegionMap serial_regions = t1.paint_region_map();
+  t1.paint_region_map().clear();
+  auto concurrent_damage = DiffLayerTree(t1, MockLayerTree(),
+                                         SkIRect::MakeEmpty(), 0, 0, true,
+                                         false, &traversal);
+  EXPECT_EQ(concurrent_damage.frame_damage, damage.frame_damage);
+  EXPECT_EQ(concurrent_damage.buffer_damage, damage.buffer_damage);
+  ExpectSamePaintRegions(serial_regions, t1.paint_region_map());
+
+  damage = DiffLayerTree(t2, t1);
+  serial_regions = t2.paint_region_map();
+  t2.paint_region_map().clear();
+  concurrent_damage = DiffLayerTree(t2, t1, SkIRect::MakeEmpty(), 0, 0, true,
+                                    false, &traversal);
+  EXPECT_NE(damage.frame_damage, SkIRect::MakeWH(1000, 1000));
+  EXPECT_EQ(concurrent_damage.frame_damage, damage.frame_damage);
+  EXPECT_EQ(concurrent_damage.buffer_damage, damage.buffer_damage);
+  ExpectSamePaintRegions(serial_regions, t2.paint_region_map());
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -57,6 +57,9 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // The complexity score computed during the last preroll, or zero if the
+  // display list was not scored because it is known to be complex.
+  unsigned int complexity_score_ = 0u;
 };
 
 }  // namespace flutter
@@ -39,6 +39,7 @@ namespace testing {
 class MockLayer;
 }  // namespace testing
 
+class ConcurrentLayerTraversal;
 class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
@@ -81,6 +82,10 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // The traversal used to preroll the children of large containers on
+  // worker threads, or null if the children are prerolled serially.
+  const ConcurrentLayerTraversal* concurrent_traversal = nullptr;
 };
 
 struct PaintContext {
@@ -162,6 +167,15 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Whether this subtree can be prerolled on a worker thread alongside its
+  // siblings. That is the case when its |Preroll| only uses the parts of the
+  // PrerollContext that a ContainerLayer gives to each of its children
+  // separately. Layers that talk to the view embedder, whose calls must
+  // happen in tree order, cannot be prerolled concurrently.
+  virtual bool CanPrerollConcurrently(const PrerollContext* context) const {
+    return true;
+  }
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/layer_state_stack.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -140,6 +142,9 @@ class PrerollDelegate : public LayerStateStack::Delegate {
   PrerollDelegate(const SkRect& cull_rect, const SkMatrix& matrix) {
     save_stack_.emplace_back(cull_rect, matrix);
   }
+  PrerollDelegate(const SkRect& cull_rect, const SkM44& matrix) {
+    save_stack_.emplace_back(cull_rect, matrix);
+  }
 
   void decommission() override {}
 
@@ -650,6 +655,12 @@ void LayerStateStack::set_preroll_delegate(const SkRect& cull_rect,
   delegate_ = std::make_shared<PrerollDelegate>(cull_rect, matrix);
   reapply_all();
 }
+void LayerStateStack::set_preroll_delegate(const SkRect& cull_rect,
+                                           const SkM44& matrix) {
+  clear_delegate();
+  delegate_ = std::make_shared<PrerollDelegate>(cull_rect, matrix);
+  reapply_all();
+}
 
 void LayerStateStack::reapply_all() {
   // We use a local RenderingAttributes instance so that it can track the
@@ -666,9 +677,15 @@ void LayerStateStack::reapply_all() {
 }
 
 void LayerStateStack::fill(MutatorsStack* mutators) {
-  for (auto& state : state_stack_) {
-    state->update_mutators(mutators);
+  filled_mutator_counts_.resize(filled_entry_count_);
+  filled_mutators_.PopTo(
+      filled_mutator_counts_.empty() ? 0 : filled_mutator_counts_.back());
+  for (size_t i = filled_entry_count_; i < state_stack_.size(); i++) {
+    state_stack_[i]->update_mutators(&filled_mutators_);
+    filled_mutator_counts_.push_back(filled_mutators_.stack_count());
   }
+  filled_entry_count_ = state_stack_.size();
+  *mutators = filled_mutators_;
 }
 
 void LayerStateStack::restore_to_count(size_t restore_count) {
@@ -676,6 +693,7 @@ void LayerStateStack::restore_to_count(size_t restore_count) {
     state_stack_.back()->restore(this);
     state_stack_.pop_back();
   }
+  filled_entry_count_ = std::min(filled_entry_count_, restore_count);
 }
 
 void LayerStateStack::push_opacity(const SkRect& bounds, SkScalar opacity) {
@@ -124,11 +124,16 @@ class LayerStateStack {
   // that only one delegate - either a DlCanvas or a preroll accumulator -
   // is present at any one time.
   void set_preroll_delegate(const SkRect& cull_rect, const SkMatrix& matrix);
+  void set_preroll_delegate(const SkRect& cull_rect, const SkM44& matrix);
   void set_preroll_delegate(const SkRect& cull_rect);
   void set_preroll_delegate(const SkMatrix& matrix);
 
-  // Fills the supplied MatatorsStack object with the mutations recorded
+  // Sets the supplied MatatorsStack object to the mutations recorded
   // by this LayerStateStack in the order encountered.
+  //
+  // The mutators of the entries that have not been restored since the
+  // previous call are shared with the stacks it returned, so that the
+  // platform views under the same layers share their common mutators.
   void fill(MutatorsStack* mutators);
 
   class AutoRestore {
@@ -466,6 +471,12 @@ class LayerStateStack {
   std::vector<std::unique_ptr<StateEntry>> state_stack_;
   friend class MutatorContext;
 
+  // The mutators of the first |filled_entry_count_| entries of
+  // |state_stack_|, and the size of |filled_mutators_| after each of them.
+  MutatorsStack filled_mutators_;
+  std::vector<size_t> filled_mutator_counts_;
+  size_t filled_entry_count_ = 0;
+
   std::shared_ptr<Delegate> delegate_;
   RenderingAttributes outstanding_;
 
@@ -548,5 +548,36 @@ TEST(LayerStateStack, ColorFilterAndImageFilterInteraction) {
   ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
 }
 
+TEST(LayerStateStack, FillMutatorsAfterRestore) {
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(kGiantRect, SkMatrix::I());
+  const SkRect clip = SkRect::MakeLTRB(10, 10, 50, 50);
+
+  MutatorsStack first;
+  MutatorsStack second;
+  {
+    auto mutator = state_stack.save();
+    mutator.clipRect(clip, false);
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.translate(5, 5);
+      state_stack.fill(&first);
+    }
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.transform(SkMatrix::Scale(2, 2));
+      state_stack.fill(&second);
+    }
+  }
+  MutatorsStack empty;
+  state_stack.fill(&empty);
+
+  EXPECT_EQ(first, std::vector({Mutator(clip),
+                                Mutator(SkMatrix::Translate(5, 5))}));
+  EXPECT_EQ(second, std::vector({Mutator(clip),
+                                 Mutator(SkMatrix::Scale(2, 2))}));
+  EXPECT_TRUE(empty.is_empty());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -34,6 +34,13 @@ void PlatformViewLayer::Preroll(PrerollContext* context) {
   context->view_embedder->PushVisitedPlatformView(view_id_);
 }
 
+bool PlatformViewLayer::CanPrerollConcurrently(
+    const PrerollContext* context) const {
+  // The embedder expects the platform views in paint order and needs the
+  // mutators of all of the ancestor layers.
+  return context->view_embedder == nullptr;
+}
+
 void PlatformViewLayer::Paint(PaintContext& context) const {
   if (context.view_embedder == nullptr) {
     FML_DLOG(ERROR) << "Trying to embed a platform view but the PaintContext "
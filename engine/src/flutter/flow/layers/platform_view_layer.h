@@ -17,6 +17,7 @@ class PlatformViewLayer : public Layer {
   PlatformViewLayer(const SkPoint& offset, const SkSize& size, int64_t view_id);
 
   void Preroll(PrerollContext* context) override;
+  bool CanPrerollConcurrently(const PrerollContext* context) const override;
   void Paint(PaintContext& context) const override;
 
  private:
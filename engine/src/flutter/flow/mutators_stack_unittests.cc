@@ -36,11 +36,11 @@ TEST(MutatorsStack, CopyAndUpdateTheCopy) {
   ASSERT_TRUE(copy.is_empty());
   ASSERT_TRUE(!stack.is_empty());
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::kClipRRect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::kClipRRect);
+  ASSERT_TRUE(iter->GetRRect() == rrect);
   ++iter;
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::kClipRect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::kClipRect);
+  ASSERT_TRUE(iter->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRect) {
@@ -48,8 +48,8 @@ TEST(MutatorsStack, PushClipRect) {
   auto rect = SkRect::MakeEmpty();
   stack.PushClipRect(rect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::kClipRect);
-  ASSERT_TRUE(iter->get()->GetRect() == rect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::kClipRect);
+  ASSERT_TRUE(iter->GetRect() == rect);
 }
 
 TEST(MutatorsStack, PushClipRRect) {
@@ -57,8 +57,8 @@ TEST(MutatorsStack, PushClipRRect) {
   auto rrect = SkRRect::MakeEmpty();
   stack.PushClipRRect(rrect);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::kClipRRect);
-  ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+  ASSERT_TRUE(iter->GetType() == MutatorType::kClipRRect);
+  ASSERT_TRUE(iter->GetRRect() == rrect);
 }
 
 TEST(MutatorsStack, PushClipPath) {
@@ -66,8 +66,8 @@ TEST(MutatorsStack, PushClipPath) {
   SkPath path;
   stack.PushClipPath(path);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == flutter::MutatorType::kClipPath);
-  ASSERT_TRUE(iter->get()->GetPath() == path);
+  ASSERT_TRUE(iter->GetType() == flutter::MutatorType::kClipPath);
+  ASSERT_TRUE(iter->GetPath() == path);
 }
 
 TEST(MutatorsStack, PushTransform) {
@@ -76,8 +76,8 @@ TEST(MutatorsStack, PushTransform) {
   matrix.setIdentity();
   stack.PushTransform(matrix);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::kTransform);
-  ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+  ASSERT_TRUE(iter->GetType() == MutatorType::kTransform);
+  ASSERT_TRUE(iter->GetMatrix() == matrix);
 }
 
 TEST(MutatorsStack, PushOpacity) {
@@ -85,8 +85,8 @@ TEST(MutatorsStack, PushOpacity) {
   int alpha = 240;
   stack.PushOpacity(alpha);
   auto iter = stack.Bottom();
-  ASSERT_TRUE(iter->get()->GetType() == MutatorType::kOpacity);
-  ASSERT_TRUE(iter->get()->GetAlpha() == 240);
+  ASSERT_TRUE(iter->GetType() == MutatorType::kOpacity);
+  ASSERT_TRUE(iter->GetAlpha() == 240);
 }
 
 TEST(MutatorsStack, PushBackdropFilter) {
@@ -100,13 +100,13 @@ TEST(MutatorsStack, PushBackdropFilter) {
   auto iter = stack.Begin();
   int i = 0;
   while (iter != stack.End()) {
-    ASSERT_EQ(iter->get()->GetType(), MutatorType::kBackdropFilter);
-    ASSERT_EQ(iter->get()->GetFilterMutation().GetFilter().asBlur()->sigma_x(),
+    ASSERT_EQ(iter->GetType(), MutatorType::kBackdropFilter);
+    ASSERT_EQ(iter->GetFilterMutation().GetFilter().asBlur()->sigma_x(),
               i);
-    ASSERT_EQ(iter->get()->GetFilterMutation().GetFilterRect().x(), i);
-    ASSERT_EQ(iter->get()->GetFilterMutation().GetFilterRect().x(), i);
-    ASSERT_EQ(iter->get()->GetFilterMutation().GetFilterRect().width(), i);
-    ASSERT_EQ(iter->get()->GetFilterMutation().GetFilterRect().height(), i);
+    ASSERT_EQ(iter->GetFilterMutation().GetFilterRect().x(), i);
+    ASSERT_EQ(iter->GetFilterMutation().GetFilterRect().x(), i);
+    ASSERT_EQ(iter->GetFilterMutation().GetFilterRect().width(), i);
+    ASSERT_EQ(iter->GetFilterMutation().GetFilterRect().height(), i);
     ++iter;
     ++i;
   }
@@ -137,16 +137,16 @@ TEST(MutatorsStack, Traversal) {
   while (iter != stack.Top()) {
     switch (index) {
       case 0:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::kClipRRect);
-        ASSERT_TRUE(iter->get()->GetRRect() == rrect);
+        ASSERT_TRUE(iter->GetType() == MutatorType::kClipRRect);
+        ASSERT_TRUE(iter->GetRRect() == rrect);
         break;
       case 1:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::kClipRect);
-        ASSERT_TRUE(iter->get()->GetRect() == rect);
+        ASSERT_TRUE(iter->GetType() == MutatorType::kClipRect);
+        ASSERT_TRUE(iter->GetRect() == rect);
         break;
       case 2:
-        ASSERT_TRUE(iter->get()->GetType() == MutatorType::kTransform);
-        ASSERT_TRUE(iter->get()->GetMatrix() == matrix);
+        ASSERT_TRUE(iter->GetType() == MutatorType::kTransform);
+        ASSERT_TRUE(iter->GetMatrix() == matrix);
         break;
       default:
         break;
@@ -189,6 +189,76 @@ TEST(MutatorsStack, Equality) {
   ASSERT_TRUE(stack == stack_other);
 }
 
+TEST(MutatorsStack, PushOntoCopyDoesNotUpdateTheOriginal) {
+  MutatorsStack stack;
+  auto rect = SkRect::MakeEmpty();
+  stack.PushClipRect(rect);
+  MutatorsStack copy = stack;
+  copy.PushOpacity(240);
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  ASSERT_EQ(stack.stack_count(), 2u);
+  ASSERT_EQ(copy.stack_count(), 2u);
+  ASSERT_TRUE(stack.Bottom()->GetType() == MutatorType::kTransform);
+  ASSERT_TRUE(copy.Bottom()->GetType() == MutatorType::kOpacity);
+  ASSERT_TRUE(copy != stack);
+
+  copy.Pop();
+  stack.Pop();
+  ASSERT_TRUE(copy == stack);
+}
+
+TEST(MutatorsStack, ForwardTraversal) {
+  MutatorsStack stack;
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  stack.PushTransform(matrix);
+  auto rect = SkRect::MakeEmpty();
+  stack.PushClipRect(rect);
+  stack.PushOpacity(240);
+  auto iter = stack.Begin();
+  ASSERT_TRUE(iter->GetType() == MutatorType::kTransform);
+  ASSERT_TRUE(iter->GetMatrix() == matrix);
+  ++iter;
+  ASSERT_TRUE(iter->GetType() == MutatorType::kClipRect);
+  ++iter;
+  ASSERT_TRUE(iter->GetType() == MutatorType::kOpacity);
+  ++iter;
+  ASSERT_TRUE(iter == stack.End());
+  ASSERT_TRUE(MutatorsStack().Begin() == MutatorsStack().End());
+}
+
+TEST(MutatorsStack, ForwardTraversalOfDeepStack) {
+  MutatorsStack stack;
+  for (int alpha = 0; alpha < 40; alpha++) {
+    stack.PushOpacity(alpha);
+  }
+  int expected_alpha = 0;
+  for (auto iter = stack.Begin(); iter != stack.End(); ++iter) {
+    ASSERT_TRUE(iter->GetType() == MutatorType::kOpacity);
+    ASSERT_EQ(iter->GetAlpha(), expected_alpha);
+    expected_alpha++;
+  }
+  ASSERT_EQ(expected_alpha, 40);
+}
+
+TEST(MutatorsStack, EqualityOfStacksWithSharedMutators) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  stack.PushClipRect(SkRect::MakeWH(10, 10));
+  MutatorsStack copy = stack;
+  stack.PushOpacity(240);
+  copy.PushOpacity(240);
+  ASSERT_TRUE(copy == stack);
+  ASSERT_TRUE(stack == std::vector({Mutator(SkMatrix::Scale(2, 2)),
+                                    Mutator(SkRect::MakeWH(10, 10)),
+                                    Mutator(240)}));
+
+  stack.Pop();
+  copy.Pop();
+  stack.PushOpacity(240);
+  copy.PushOpacity(120);
+  ASSERT_TRUE(copy != stack);
+}
+
 TEST(Mutator, Initialization) {
   SkRect rect = SkRect::MakeEmpty();
   Mutator mutator = Mutator(rect);
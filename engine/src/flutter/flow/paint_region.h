@@ -61,6 +61,10 @@ class PaintRegion {
   bool has_texture() const { return has_texture_; }
 
  private:
+  // Rebases the regions of concurrently diffed subtrees. See
+  // |DiffContext::MergeFragment|.
+  friend class DiffContext;
+
   std::shared_ptr<std::vector<SkRect>> rects_;
   size_t from_ = 0;
   size_t to_ = 0;
@@ -6,6 +6,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -26,6 +28,15 @@
 
 namespace flutter {
 
+// The rasterization cost assumed per pixel before any image has been
+// rasterized, roughly what filling a pixel with a few layers of content
+// takes on a mobile GPU.
+static constexpr double kDefaultMicrosPerPixel = 0.001;
+
+static double UpdateRunningAverage(double average, double sample) {
+  return average == 0.0 ? sample : average * 0.9 + sample * 0.1;
+}
+
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
                                      const SkRect& logical_rect,
                                      const char* type,
@@ -71,9 +82,34 @@ void RasterCacheResult::draw(DlCanvas& canvas,
 }
 
 RasterCache::RasterCache(size_t access_threshold,
-                         size_t display_list_cache_limit_per_frame)
+                         size_t display_list_cache_limit_per_frame,
+                         const RasterCachePolicy& policy)
     : access_threshold_(access_threshold),
-      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
+      display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
+      policy_(policy) {}
+
+void RasterCache::SetPolicy(const RasterCachePolicy& policy) {
+  policy_ = policy;
+  if (policy_.max_bytes == 0 || cache_bytes_ <= policy_.max_bytes) {
+    return;
+  }
+  std::vector<RasterCacheKey::Map<Entry>::iterator> candidates;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (it->second.image) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](auto a, auto b) {
+    return a->second.priority < b->second.priority;
+  });
+  for (auto it : candidates) {
+    if (cache_bytes_ <= policy_.max_bytes) {
+      break;
+    }
+    inflation_ = std::max(inflation_, it->second.priority);
+    EvictEntry(it);
+  }
+}
 
 /// @note Procedure doesn't copy all closures.
 std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
@@ -123,10 +159,38 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+    RasterCacheMetrics& metrics = GetMetricsForKind(key.kind());
+    if (policy_.max_bytes > 0) {
+      // Estimate the size of the image before paying for rasterizing it.
+      SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+          raster_cache_context.logical_rect,
+          RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix));
+      size_t estimated_bytes = static_cast<size_t>(dest_rect.width()) *
+                               static_cast<size_t>(dest_rect.height()) * 4;
+      if (!MakeRoom(estimated_bytes, ComputePriority(entry, estimated_bytes))) {
+        metrics.rejection_count++;
+        return false;
+      }
+    }
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+    fml::TimePoint start = fml::TimePoint::Now();
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
+    double micros = (fml::TimePoint::Now() - start).ToMicrosecondsF();
     if (entry.image != nullptr) {
+      entry.cost = std::max(micros, 1.0);
+      size_t bytes = entry.image->image_bytes();
+      if (entry.complexity_score > 0u) {
+        micros_per_complexity_unit_ = UpdateRunningAverage(
+            micros_per_complexity_unit_, micros / entry.complexity_score);
+      }
+      if (bytes > 0u) {
+        micros_per_pixel_ =
+            UpdateRunningAverage(micros_per_pixel_, micros * 4 / bytes);
+      }
+      entry.priority = ComputePriority(entry, bytes);
+      cache_bytes_ += bytes;
+      metrics.admission_count++;
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -141,16 +205,92 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
-RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
-                                             const SkMatrix& matrix,
-                                             bool visible) const {
+double RasterCache::EstimateCost(const Entry& entry, size_t bytes) const {
+  if (entry.image) {
+    return entry.cost;
+  }
+  if (entry.complexity_score > 0u && micros_per_complexity_unit_ > 0.0) {
+    return std::max(entry.complexity_score * micros_per_complexity_unit_, 1.0);
+  }
+  // Layers have no complexity score, so their cost is estimated from the
+  // number of pixels they cover.
+  double micros_per_pixel =
+      micros_per_pixel_ > 0.0 ? micros_per_pixel_ : kDefaultMicrosPerPixel;
+  return std::max(bytes / 4 * micros_per_pixel, 1.0);
+}
+
+double RasterCache::ComputePriority(const Entry& entry, size_t bytes) const {
+  double cost = EstimateCost(entry, bytes);
+  double frequency = std::max<size_t>(entry.accesses_since_visible, 1u);
+  return inflation_ + cost * frequency / std::max<size_t>(bytes, 1u);
+}
+
+bool RasterCache::MakeRoom(size_t bytes, double priority) const {
+  if (bytes > policy_.max_bytes) {
+    return false;
+  }
+  if (cache_bytes_ + bytes <= policy_.max_bytes) {
+    return true;
+  }
+  // Images used in this frame are never evicted to make room for another,
+  // otherwise two visible entries that do not fit together would replace
+  // each other on every frame.
+  std::vector<RasterCacheKey::Map<Entry>::iterator> candidates;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    const Entry& entry = it->second;
+    if (entry.image && !entry.encountered_this_frame &&
+        entry.priority < priority) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](auto a, auto b) {
+    return a->second.priority < b->second.priority;
+  });
+  size_t available = policy_.max_bytes - cache_bytes_;
+  size_t victim_count = 0;
+  while (available < bytes && victim_count < candidates.size()) {
+    available += candidates[victim_count++]->second.image->image_bytes();
+  }
+  if (available < bytes) {
+    return false;
+  }
+  for (size_t i = 0; i < victim_count; i++) {
+    inflation_ = std::max(inflation_, candidates[i]->second.priority);
+    EvictEntry(candidates[i]);
+  }
+  return true;
+}
+
+void RasterCache::EvictEntry(RasterCacheKey::Map<Entry>::iterator it) const {
+  if (it->second.image) {
+    size_t bytes = it->second.image->image_bytes();
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += bytes;
+    cache_bytes_ -= bytes;
+  }
+  cache_.erase(it);
+}
+
+RasterCache::CacheInfo RasterCache::MarkSeen(
+    const RasterCacheKeyID& id,
+    const SkMatrix& matrix,
+    bool visible,
+    unsigned int complexity_score) const {
   RasterCacheKey key = RasterCacheKey(id, matrix);
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
+  entry.unused_frames = 0;
+  if (complexity_score > 0u) {
+    entry.complexity_score = complexity_score;
+  }
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
+  if (entry.image) {
+    entry.priority = ComputePriority(entry, entry.image->image_bytes());
+  }
   return {entry.accesses_since_visible, entry.image != nullptr};
 }
 
@@ -186,6 +326,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    GetMetricsForKind(it->first.kind()).hit_count++;
     return true;
   }
 
@@ -201,11 +342,16 @@ void RasterCache::BeginFrame() {
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
+    FML_DCHECK(entry.encountered_this_frame || entry.image);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
     }
     entry.encountered_this_frame = false;
   }
@@ -216,18 +362,18 @@ void RasterCache::EvictUnusedCacheEntries() {
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (entry.encountered_this_frame) {
+      continue;
+    }
+    // Entries without an image only carry the access history, which is
+    // cheap to rebuild, so they are dropped as soon as they go unused.
+    if (!entry.image || ++entry.unused_frames > policy_.max_unused_frames) {
       dead.push_back(it);
     }
   }
 
   for (auto it : dead) {
-    if (it->second.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.eviction_count++;
-      metrics.eviction_bytes += it->second.image->image_bytes();
-    }
-    cache_.erase(it);
+    EvictEntry(it);
   }
 }
 
@@ -238,6 +384,8 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  cache_bytes_ = 0;
+  inflation_ = 0.0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -275,6 +423,19 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
       "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+  FML_TRACE_COUNTER(
+      "flutter",                                                      //
+      "RasterCachePolicy", reinterpret_cast<int64_t>(this),           //
+      "Hits", layer_metrics_.hit_count + picture_metrics_.hit_count,  //
+      "Admissions",
+      layer_metrics_.admission_count + picture_metrics_.admission_count,  //
+      "Rejections",
+      layer_metrics_.rejection_count + picture_metrics_.rejection_count,  //
+      "Evictions",
+      layer_metrics_.eviction_count + picture_metrics_.eviction_count,  //
+      "Retained",
+      layer_metrics_.retained_count + picture_metrics_.retained_count,  //
+      "BudgetMBytes", policy_.max_bytes / kMegaByteSizeInBytes);
 
 #endif  // !FLUTTER_RELEASE
 }
@@ -301,7 +462,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -80,15 +80,70 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were not used in this
+   * frame but are kept because they were used recently.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images that were retained in this frame.
+   */
+  size_t retained_bytes = 0;
+
+  /**
+   * The number of times an image was drawn from the cache in this frame.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of images that were created and admitted in this frame.
+   */
+  size_t admission_count = 0;
+
+  /**
+   * The number of entries that were ready to be cached in this frame but
+   * were rejected because their value did not justify the memory they would
+   * use under the byte budget.
+   */
+  size_t rejection_count = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
+};
+
+/**
+ * Controls how long the RasterCache keeps images around and how much memory
+ * they may use.
+ */
+struct RasterCachePolicy {
+  /**
+   * The number of consecutive frames in which an entry with an image may go
+   * unused before it is evicted. Zero evicts images as soon as a frame does
+   * not use them.
+   */
+  size_t max_unused_frames =
+      RasterCacheUtil::kDefaultMaxUnusedFramesBeforeEviction;
+
+  /**
+   * The maximum number of bytes of images held by the cache, or zero for no
+   * limit. The shell sets it from |Settings::raster_cache_max_bytes|.
+   *
+   * When a new image would exceed the budget, entries that were not used in
+   * the current frame are evicted in order of increasing value, as computed
+   * by the Greedy-Dual-Size-Frequency algorithm: the time it took to
+   * rasterize the entry, times the number of frames it has been used in,
+   * divided by its size. The new image is only admitted if enough entries
+   * of lower value can be evicted to make room for it.
+   */
+  size_t max_bytes = 0;
 };
 
 /**
@@ -106,9 +161,12 @@ struct RasterCacheMetrics {
  *         encountered by the current frame.
  * - Paint stage
  *   - RasterCache::EvictUnusedCacheEntries
- *       Evict cached images that are no longer used.
+ *       Evict cached images that have not been used for more than
+ *       `RasterCachePolicy::max_unused_frames` frames.
  *   - LayerTree::TryToPrepareRasterCache
- *       Create cache image for each cache entry if it does not exist.
+ *       Create cache image for each cache entry if it does not exist,
+ *       evicting less valuable images if needed to stay within
+ *       `RasterCachePolicy::max_bytes`.
  *   - LayerTree::Paint - for each layer in the tree:
  *       If layers or display lists are cached as cached images, the method
  *       `RasterCache::Draw` will be used to draw those cache images.
@@ -139,7 +197,8 @@ class RasterCache {
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_and_display_list_cache_limit_per_frame =
-          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      const RasterCachePolicy& policy = RasterCachePolicy());
 
   virtual ~RasterCache() = default;
 
@@ -168,6 +227,14 @@ class RasterCache {
 
   void Clear();
 
+  const RasterCachePolicy& policy() const { return policy_; }
+
+  /**
+   * @brief Change the eviction policy. Images are evicted immediately if
+   * needed to meet the new byte budget.
+   */
+  void SetPolicy(const RasterCachePolicy& policy);
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -228,12 +295,17 @@ class RasterCache {
    * as visible in the current frame if the caller determines that it
    * intersects the cull rect. The access_count of the entry will be
    * increased if it is visible, or if it was ever visible.
+   *
+   * The optional |complexity_score| is the DisplayListComplexityCalculator
+   * score of the content. It is used to estimate the time the entry would
+   * save before it has been rasterized for the first time.
    * @return the number of times the entry has been hit since it was created.
    * For a new entry that will be 1 if it is visible, or zero if non-visible.
    */
   CacheInfo MarkSeen(const RasterCacheKeyID& id,
                      const SkMatrix& matrix,
-                     bool visible) const;
+                     bool visible,
+                     unsigned int complexity_score = 0u) const;
 
   /**
    * Returns the access count (i.e. accesses_since_visible) for the given
@@ -251,19 +323,53 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // The number of consecutive frames that did not encounter this entry.
+    size_t unused_frames = 0;
+    unsigned int complexity_score = 0u;
+    // The time it took to rasterize the image, in microseconds, which is
+    // roughly the time saved each time the image is drawn.
+    double cost = 0.0;
+    // The Greedy-Dual-Size-Frequency priority of the entry.
+    double priority = 0.0;
     std::unique_ptr<RasterCacheResult> image;
   };
 
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  double ComputePriority(const Entry& entry, size_t bytes) const;
+
+  // Estimates the time in microseconds it would take to rasterize the entry
+  // into an image of |bytes| bytes.
+  double EstimateCost(const Entry& entry, size_t bytes) const;
+
+  // Evicts entries not used in this frame whose priority is lower than
+  // |priority| until |bytes| more bytes fit within the byte budget. Returns
+  // false without evicting anything if that is not possible.
+  bool MakeRoom(size_t bytes, double priority) const;
+
+  void EvictEntry(RasterCacheKey::Map<Entry>::iterator it) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  RasterCachePolicy policy_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  // The total size of all images in the cache.
+  mutable size_t cache_bytes_ = 0;
+  // The Greedy-Dual-Size-Frequency inflation value, which is raised to the
+  // priority of each evicted entry so that entries that have not been used
+  // in a long time age relative to newly added ones.
+  mutable double inflation_ = 0.0;
+  // A running average of rasterization microseconds per unit of display
+  // list complexity score.
+  mutable double micros_per_complexity_unit_ = 0.0;
+  // A running average of rasterization microseconds per pixel, used for
+  // entries without a complexity score such as layers.
+  mutable double micros_per_pixel_ = 0.0;
   bool checkerboard_images_ = false;
 
   void TraceStatsToTimeline() const;
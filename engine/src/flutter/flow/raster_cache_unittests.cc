@@ -320,6 +320,188 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, RetainsUnusedEntriesForShortGaps) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      {.max_unused_frames = 2});
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+
+  // The display list goes unused for two frames and keeps its image.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    cache.EvictUnusedCacheEntries();
+    cache.EndFrame();
+    ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+    ASSERT_EQ(cache.picture_metrics().in_use_count, 0u);
+    ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+    ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+    ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+  }
+
+  // When it comes back the image is drawn without rasterizing it again.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().admission_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().hit_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+
+  // A gap longer than the policy allows evicts it.
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame();
+    cache.EvictUnusedCacheEntries();
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, ByteBudgetIsRespected) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      {.max_unused_frames = 10, .max_bytes = 25624u});
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  // Only one of the two images fits in the budget, and an image that is in
+  // use is never evicted to make room for another one.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().admission_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().rejection_count, 1u);
+
+  // Once the first image is no longer in use it can be replaced.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().admission_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_FALSE(cache.HasEntry(display_list_item_1.GetId().value(), matrix));
+
+  // Lowering the budget evicts images right away.
+  cache.SetPolicy({.max_unused_frames = 10, .max_bytes = 1000u});
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
+TEST(RasterCache, LayerEntriesDoNotEvictMoreValuableImages) {
+  const SkMatrix matrix = SkMatrix::I();
+  const SkRect logical_rect = SkRect::MakeWH(10, 10);
+  const size_t image_bytes = 10 * 10 * 4;
+  flutter::RasterCache cache(
+      1, RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      {.max_unused_frames = 10, .max_bytes = image_bytes});
+  RasterCache::Context context = {nullptr, nullptr, matrix, logical_rect,
+                                  "RasterCacheFlow::Layer"};
+  auto draw = [](DlCanvas* canvas) {
+    canvas->DrawRect(SkRect::MakeWH(10, 10), DlPaint(DlColor::kRed()));
+  };
+  const RasterCacheKeyID frequent(1, RasterCacheKeyType::kLayer);
+  const RasterCacheKeyID rare(2, RasterCacheKeyType::kLayer);
+
+  // Layers have no complexity score.
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame();
+    cache.MarkSeen(frequent, matrix, true);
+    cache.EvictUnusedCacheEntries();
+    cache.UpdateCacheEntry(frequent, context, draw);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimateLayerCacheByteSize(), image_bytes);
+
+  // An entry whose content has never been rasterized does not replace an
+  // image that has been used more often.
+  cache.BeginFrame();
+  cache.MarkSeen(rare, matrix, true);
+  cache.EvictUnusedCacheEntries();
+  EXPECT_FALSE(cache.UpdateCacheEntry(rare, context, draw));
+  cache.EndFrame();
+  EXPECT_TRUE(cache.HasEntry(frequent, matrix));
+  EXPECT_EQ(cache.layer_metrics().rejection_count, 1u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
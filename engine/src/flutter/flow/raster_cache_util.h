@@ -19,6 +19,12 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDisplayListCacheLimitPerFrame = 3;
 
+  // The default number of consecutive frames in which a cached image may go
+  // unused before it is evicted. Images are evicted as soon as a frame does
+  // not use them unless a longer retention is configured with
+  // |Settings::raster_cache_max_unused_frames|.
+  static constexpr size_t kDefaultMaxUnusedFramesBeforeEviction = 0;
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
@@ -21,7 +21,8 @@ SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
                            const SubmitCallback& submit_callback,
                            SkISize frame_size,
                            std::unique_ptr<GLContextResult> context_result,
-                           bool display_list_fallback)
+                           bool display_list_fallback,
+                           bool display_list_rtree)
     : surface_(std::move(surface)),
       framebuffer_info_(framebuffer_info),
       encode_callback_(encode_callback),
@@ -40,11 +41,12 @@ SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
     FML_DCHECK(!frame_size.isEmpty());
     // The root frame of a surface will be filled by the layer_tree which
     // performs branch culling so it will be unlikely to need an rtree for
-    // further culling during `DisplayList::Dispatch`. Further, this canvas
-    // will live underneath any platform views so we do not need to compute
-    // exact coverage to describe "pixel ownership" to the platform.
+    // further culling during `DisplayList::Dispatch`, unless the surface
+    // renders the frame in tiles. Further, this canvas will live underneath
+    // any platform views so we do not need to compute exact coverage to
+    // describe "pixel ownership" to the platform.
     dl_builder_ = sk_make_sp<DisplayListBuilder>(SkRect::Make(frame_size),
-                                                 /*prepare_rtree=*/false);
+                                                 display_list_rtree);
     canvas_ = dl_builder_.get();
   }
 }
@@ -41,19 +41,19 @@ class MockLayer : public Layer {
   void Preroll(PrerollContext* context) override;
   void Paint(PaintContext& context) const override;
 
-  const MutatorsStack& parent_mutators() { return parent_mutators_; }
-  const SkMatrix& parent_matrix() { return parent_matrix_; }
-  const SkRect& parent_cull_rect() { return parent_cull_rect_; }
+  const MutatorsStack& parent_mutators() const { return parent_mutators_; }
+  const SkMatrix& parent_matrix() const { return parent_matrix_; }
+  const SkRect& parent_cull_rect() const { return parent_cull_rect_; }
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
   void Diff(DiffContext* context, const Layer* old_layer) override;
   const MockLayer* as_mock_layer() const override { return this; }
 
-  bool parent_has_platform_view() {
+  bool parent_has_platform_view() const {
     return mock_flags_ & kParentHasPlatformView;
   }
 
-  bool parent_has_texture_layer() {
+  bool parent_has_texture_layer() const {
     return mock_flags_ & kParentHasTextureLayer;
   }
 
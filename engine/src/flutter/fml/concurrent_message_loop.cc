@@ -11,19 +11,37 @@
 
 namespace fml {
 
+namespace {
+
+// The loop and worker index of the current thread if it is a worker.
+struct CurrentWorker {
+  const ConcurrentMessageLoop* loop = nullptr;
+  size_t index = 0;
+};
+
+thread_local CurrentWorker tCurrentWorker;
+
+// The maximum number of tasks a worker moves from the injection queue into
+// its own deque at once. Batching amortizes the injection lock and makes
+// the extra tasks available for peers to steal.
+constexpr size_t kMaxInjectionBatchSize = 32u;
+
+}  // namespace
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  worker_queues_.reserve(worker_count_);
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -32,6 +50,17 @@ ConcurrentMessageLoop::~ConcurrentMessageLoop() {
     FML_DCHECK(worker.joinable());
     worker.join();
   }
+
+  // All workers have exited. Tasks that were never picked up are dropped.
+  for (auto& queue : worker_queues_) {
+    while (auto task = queue->tasks.Pop()) {
+      delete task;
+    }
+  }
+  while (!injection_tasks_.empty()) {
+    delete injection_tasks_.front();
+    injection_tasks_.pop();
+  }
 }
 
 size_t ConcurrentMessageLoop::GetWorkerCount() const {
@@ -47,68 +76,126 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
-  if (shutdown_) {
+  if (shutdown_.load()) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     ExecuteTask(task);
     return;
   }
 
-  tasks_.push(task);
+  // The count is bumped before the task is published so that it never
+  // underflows when a worker takes the task right away. A worker that sees
+  // the count before the task simply retries.
+  pending_task_count_.fetch_add(1);
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  if (tCurrentWorker.loop == this) {
+    worker_queues_[tCurrentWorker.index]->tasks.Push(new fml::closure(task));
+  } else {
+    std::scoped_lock lock(injection_mutex_);
+    injection_tasks_.push(new fml::closure(task));
+  }
 
+  WakeWorker();
+}
+
+void ConcurrentMessageLoop::WakeWorker() {
+  if (sleeping_worker_count_.load() == 0) {
+    return;
+  }
+  // Sleeping workers check for pending tasks with the mutex held. Acquiring
+  // it here guarantees a worker is either already waiting on the condition
+  // variable or will observe the pending task before it does.
+  { std::scoped_lock lock(tasks_mutex_); }
   tasks_condition_.notify_one();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+fml::closure* ConcurrentMessageLoop::TakeTask(size_t worker_index) {
+  auto& own_tasks = worker_queues_[worker_index]->tasks;
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+  // Own tasks first. These are the most recently posted and are likely to
+  // still be warm in this core's caches.
+  if (auto task = own_tasks.Pop()) {
+    return task;
+  }
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+  // Then tasks posted from outside the loop.
+  {
+    std::scoped_lock lock(injection_mutex_);
+    if (!injection_tasks_.empty()) {
+      auto task = injection_tasks_.front();
+      injection_tasks_.pop();
+      const size_t batch_size = std::min(
+          injection_tasks_.size() / worker_count_, kMaxInjectionBatchSize);
+      for (size_t i = 0; i < batch_size; ++i) {
+        own_tasks.Push(injection_tasks_.front());
+        injection_tasks_.pop();
+      }
+      return task;
     }
+  }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  // Finally, steal from peers.
+  for (size_t i = 1; i < worker_count_; ++i) {
+    const size_t victim = (worker_index + i) % worker_count_;
+    if (auto task = worker_queues_[victim]->tasks.Steal()) {
+      return task;
     }
+  }
+
+  return nullptr;
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tCurrentWorker = {this, worker_index};
+  auto& queue = *worker_queues_[worker_index];
+
+  while (true) {
+    // Shutdown is read before looking for work so that a worker always runs
+    // at most one more task after the loop has been terminated.
+    const bool shutdown_now = shutdown_.load();
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+    std::vector<fml::closure> thread_tasks;
+    if (queue.has_thread_tasks.load()) {
+      std::scoped_lock lock(tasks_mutex_);
+      thread_tasks = GetThreadTasksLocked(worker_index);
+    }
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
+    std::unique_ptr<fml::closure> task(TakeTask(worker_index));
     if (task) {
-      ExecuteTask(task);
+      pending_task_count_.fetch_sub(1);
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+    if (task || !thread_tasks.empty()) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+      // Execute the primary task we found.
+      if (task) {
+        ExecuteTask(*task);
+      }
+
+      // Execute any thread tasks.
+      for (const auto& thread_task : thread_tasks) {
+        ExecuteTask(thread_task);
+      }
     }
 
     if (shutdown_now) {
       break;
     }
+
+    if (task || pending_task_count_.load() > 0) {
+      // There may be more work. Look again before going to sleep.
+      continue;
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    sleeping_worker_count_.fetch_add(1);
+    tasks_condition_.wait(lock, [&]() {
+      return pending_task_count_.load() > 0 || shutdown_.load() ||
+             HasThreadTasksLocked(worker_index);
+    });
+    sleeping_worker_count_.fetch_sub(1);
   }
 }
 
@@ -128,22 +215,23 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
   }
 
   std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (auto& queue : worker_queues_) {
+    queue->thread_tasks.emplace_back(task);
+    queue->has_thread_tasks = true;
   }
   tasks_condition_.notify_all();
 }
 
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
+bool ConcurrentMessageLoop::HasThreadTasksLocked(size_t worker_index) const {
+  return !worker_queues_[worker_index]->thread_tasks.empty();
 }
 
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
+std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked(
+    size_t worker_index) {
+  auto& queue = *worker_queues_[worker_index];
   std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
+  std::swap(pending_tasks, queue.thread_tasks);
+  queue.has_thread_tasks = false;
   return pending_tasks;
 }
 
@@ -170,13 +258,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return tCurrentWorker.loop == this;
 }
 
 }  // namespace fml
@@ -5,19 +5,33 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/work_stealing_deque.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+//------------------------------------------------------------------------------
+/// @brief      A pool of worker threads that run tasks in no particular order.
+///
+///             Each worker owns a lock-free work-stealing deque. Tasks posted
+///             from a worker are pushed onto that worker's deque. Tasks posted
+///             from any other thread land in a shared injection queue. Idle
+///             workers drain their own deque first, then the injection
+///             queue, and finally steal from their peers before going to
+///             sleep.
+///
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -43,22 +57,39 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  struct WorkerQueue {
+    // Only the owning worker pushes and pops. Peers steal.
+    WorkStealingDeque<fml::closure> tasks;
+    // Tasks posted via |PostTaskToAllWorkers|. Guarded by |tasks_mutex_|.
+    std::vector<fml::closure> thread_tasks;
+    std::atomic_bool has_thread_tasks = false;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  // Tasks posted from threads that are not workers of this loop.
+  std::mutex injection_mutex_;
+  std::queue<fml::closure*> injection_tasks_;
+  // Tasks that have been posted but not yet taken by any worker.
+  std::atomic_size_t pending_task_count_ = 0;
+  // Guards sleeping and waking workers.
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_size_t sleeping_worker_count_ = 0;
+  std::atomic_bool shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
   void PostTask(const fml::closure& task);
 
-  bool HasThreadTasksLocked() const;
+  fml::closure* TakeTask(size_t worker_index);
+
+  void WakeWorker();
+
+  bool HasThreadTasksLocked(size_t worker_index) const;
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  std::vector<fml::closure> GetThreadTasksLocked(size_t worker_index);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
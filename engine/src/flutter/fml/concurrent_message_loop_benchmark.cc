@@ -0,0 +1,196 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+// The single mutex and condition variable pool that |ConcurrentMessageLoop|
+// used before it switched to per-worker work-stealing deques. Kept here as a
+// baseline.
+class SharedQueueLoop {
+ public:
+  explicit SharedQueueLoop(size_t worker_count) {
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back([this]() { WorkerMain(); });
+    }
+  }
+
+  ~SharedQueueLoop() {
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      shutdown_ = true;
+    }
+    tasks_condition_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void PostTask(const fml::closure& task) {
+    std::unique_lock lock(tasks_mutex_);
+    tasks_.push(task);
+    lock.unlock();
+    tasks_condition_.notify_one();
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex tasks_mutex_;
+  std::condition_variable tasks_condition_;
+  std::queue<fml::closure> tasks_;
+  bool shutdown_ = false;
+
+  void WorkerMain() {
+    while (true) {
+      std::unique_lock lock(tasks_mutex_);
+      tasks_condition_.wait(lock,
+                            [&]() { return !tasks_.empty() || shutdown_; });
+      if (tasks_.empty()) {
+        return;
+      }
+      auto task = std::move(tasks_.front());
+      tasks_.pop();
+      lock.unlock();
+      task();
+    }
+  }
+};
+
+class WorkStealingLoop {
+ public:
+  explicit WorkStealingLoop(size_t worker_count)
+      : loop_(ConcurrentMessageLoop::Create(worker_count)),
+        task_runner_(loop_->GetTaskRunner()) {}
+
+  void PostTask(const fml::closure& task) { task_runner_->PostTask(task); }
+
+ private:
+  std::shared_ptr<ConcurrentMessageLoop> loop_;
+  std::shared_ptr<ConcurrentTaskRunner> task_runner_;
+};
+
+using Clock = std::chrono::steady_clock;
+
+void ReportLatencies(benchmark::State& state,
+                     std::vector<Clock::duration>& latencies) {
+  if (latencies.empty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    const size_t index = std::min(
+        latencies.size() - 1, static_cast<size_t>(p * latencies.size()));
+    return std::chrono::duration<double, std::micro>(latencies[index]).count();
+  };
+  state.counters["p50_latency_us"] = percentile(0.50);
+  state.counters["p99_latency_us"] = percentile(0.99);
+  state.counters["p999_latency_us"] = percentile(0.999);
+}
+
+}  // namespace
+
+// Posts many tiny tasks from several threads outside the loop, the way image
+// decoding and shader compilation requests arrive from the UI, raster and IO
+// threads at once.
+template <class Loop>
+static void BM_TinyTasksFromExternalThreads(
+    benchmark::State& state) {  // NOLINT
+  const size_t worker_count = state.range(0);
+  const size_t poster_count = 4;
+  const size_t tasks_per_poster = state.range(1);
+  const size_t task_count = poster_count * tasks_per_poster;
+
+  Loop loop(worker_count);
+  std::vector<Clock::duration> latencies(task_count);
+  std::vector<Clock::duration> all_latencies;
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(task_count);
+    std::vector<std::thread> posters;
+    posters.reserve(poster_count);
+    for (size_t i = 0; i < poster_count; i++) {
+      posters.emplace_back([&, offset = i * tasks_per_poster]() {
+        for (size_t j = 0; j < tasks_per_poster; j++) {
+          const auto posted = Clock::now();
+          loop.PostTask([&latencies, &tasks_done, posted, slot = offset + j]() {
+            latencies[slot] = Clock::now() - posted;
+            tasks_done.CountDown();
+          });
+        }
+      });
+    }
+    for (auto& poster : posters) {
+      poster.join();
+    }
+    tasks_done.Wait();
+
+    ::benchmarking::ScopedPauseTiming pause(state);
+    all_latencies.insert(all_latencies.end(), latencies.begin(),
+                         latencies.end());
+  }
+
+  state.SetItemsProcessed(state.iterations() * task_count);
+  ReportLatencies(state, all_latencies);
+}
+
+// Each task fans out into more tiny tasks posted from the worker itself. This
+// is the pattern of recursive work such as parallel tessellation or
+// tiled raster work where workers are both producers and consumers.
+template <class Loop>
+static void BM_TinyTasksFanOutFromWorkers(benchmark::State& state) {  // NOLINT
+  const size_t worker_count = state.range(0);
+  const size_t root_count = 64;
+  const size_t children_per_root = state.range(1);
+  const size_t task_count = root_count * (children_per_root + 1);
+
+  Loop loop(worker_count);
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(task_count);
+    for (size_t i = 0; i < root_count; i++) {
+      loop.PostTask([&loop, &tasks_done, children_per_root]() {
+        for (size_t j = 0; j < children_per_root; j++) {
+          loop.PostTask([&tasks_done]() { tasks_done.CountDown(); });
+        }
+        tasks_done.CountDown();
+      });
+    }
+    tasks_done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * task_count);
+}
+
+#define CONCURRENT_LOOP_BENCHMARKS(loop)                                 \
+  BENCHMARK_TEMPLATE(BM_TinyTasksFromExternalThreads, loop)              \
+      ->ArgsProduct({{2, 4, 8, 16}, {1000, 10000}})                      \
+      ->UseRealTime()                                                    \
+      ->Unit(benchmark::kMicrosecond);                                   \
+  BENCHMARK_TEMPLATE(BM_TinyTasksFanOutFromWorkers, loop)                \
+      ->ArgsProduct({{2, 4, 8, 16}, {16, 256}})                          \
+      ->UseRealTime()                                                    \
+      ->Unit(benchmark::kMicrosecond);
+
+CONCURRENT_LOOP_BENCHMARKS(SharedQueueLoop)
+CONCURRENT_LOOP_BENCHMARKS(WorkStealingLoop)
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <utility>
 
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_source.h"
@@ -35,22 +36,72 @@ static thread_local std::unique_ptr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
-    : subsumed_by(kUnmerged), created_for(created_for_arg) {
-  wakeable = NULL;
+    : wakeable(nullptr),
+      incoming(nullptr),
+      secondary_pause_requests(0),
+      wake_time(fml::TimePoint::Max().ToEpochDelta().ToNanoseconds()),
+      subsumed_by(kUnmerged),
+      created_for(created_for_arg) {
   task_observers = TaskObservers();
   task_source = std::make_unique<TaskSource>(created_for);
 }
 
+TaskQueueEntry::~TaskQueueEntry() {
+  IncomingTask* task = incoming.exchange(nullptr);
+  while (task) {
+    delete std::exchange(task, task->next);
+  }
+}
+
+void TaskQueueEntry::PushIncomingTask(const DelayedTask& task) {
+  auto* node = new IncomingTask{task, incoming.load(std::memory_order_relaxed)};
+  while (!incoming.compare_exchange_weak(node->next, node)) {
+  }
+}
+
+void TaskQueueEntry::DrainIncomingTasks() {
+  IncomingTask* task = incoming.exchange(nullptr);
+  while (task) {
+    // The task heaps order tasks by target time and registration order, so
+    // the order in which they are added does not matter.
+    task_source->RegisterTask(task->task);
+    delete std::exchange(task, task->next);
+  }
+}
+
+bool TaskQueueEntry::HasIncomingTasks() const {
+  return incoming.load() != nullptr;
+}
+
+class MessageLoopTaskQueues::EntryLock {
+ public:
+  explicit EntryLock(TaskQueueEntry& entry) : lock_(entry.mutex) {
+    // Merge and Unmerge change the set of subsumed entries with the mutex of
+    // the owner held, so it cannot change while this lock is held.
+    subsumed_locks_.reserve(entry.subsumed_entries.size());
+    for (const auto& subsumed : entry.subsumed_entries) {
+      subsumed_locks_.emplace_back(subsumed->mutex);
+    }
+  }
+
+ private:
+  std::unique_lock<std::mutex> lock_;
+  std::vector<std::unique_lock<std::mutex>> subsumed_locks_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EntryLock);
+};
+
 MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
   static MessageLoopTaskQueues* instance = new MessageLoopTaskQueues;
   return instance;
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
-  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
-  ++task_queue_id_counter_;
-  queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
+  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_++);
+  auto entry = std::make_shared<TaskQueueEntry>(loop_id);
+  Shard& shard = GetShard(loop_id);
+  std::unique_lock lock(shard.mutex);
+  shard.entries[loop_id] = std::move(entry);
   return loop_id;
 }
 
@@ -61,26 +112,52 @@ MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
+MessageLoopTaskQueues::Shard& MessageLoopTaskQueues::GetShard(
+    TaskQueueId queue_id) const {
+  return shards_[static_cast<size_t>(queue_id) % kShardCount];
+}
+
+MessageLoopTaskQueues::EntryPtr MessageLoopTaskQueues::GetEntry(
+    TaskQueueId queue_id) const {
+  const Shard& shard = GetShard(queue_id);
+  std::shared_lock lock(shard.mutex);
+  auto found = shard.entries.find(queue_id);
+  return found == shard.entries.end() ? nullptr : found->second;
+}
+
+MessageLoopTaskQueues::EntryPtr MessageLoopTaskQueues::GetEntryChecked(
+    TaskQueueId queue_id) const {
+  EntryPtr entry = GetEntry(queue_id);
+  FML_CHECK(entry) << "Unknown task queue: " << queue_id;
+  return entry;
+}
+
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
+  EntryPtr entry = GetEntryChecked(queue_id);
+  std::set<TaskQueueId> subsumed_set;
+  {
+    std::scoped_lock lock(entry->mutex);
+    FML_DCHECK(entry->subsumed_by == kUnmerged);
+    subsumed_set = entry->owner_of;
+  }
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.erase(subsumed);
+    Shard& shard = GetShard(subsumed);
+    std::unique_lock lock(shard.mutex);
+    shard.entries.erase(subsumed);
   }
-  // Erase owner queue_id at last to avoid &subsumed_set from being invalid
-  queue_entries_.erase(queue_id);
+  Shard& shard = GetShard(queue_id);
+  std::unique_lock lock(shard.mutex);
+  shard.entries.erase(queue_id);
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
-  queue_entry->task_source->ShutDown();
-  for (auto& subsumed : subsumed_set) {
-    queue_entries_.at(subsumed)->task_source->ShutDown();
+  EntryPtr entry = GetEntryChecked(queue_id);
+  EntryLock lock(*entry);
+  FML_DCHECK(entry->subsumed_by == kUnmerged);
+  DrainIncomingTasksLocked(*entry);
+  entry->task_source->ShutDown();
+  for (const auto& subsumed : entry->subsumed_entries) {
+    subsumed->task_source->ShutDown();
   }
 }
 
@@ -93,72 +170,106 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+  EntryPtr entry = GetEntryChecked(queue_id);
   size_t order = order_++;
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
-  TaskQueueId loop_to_wake = queue_id;
-  if (queue_entry->subsumed_by != kUnmerged) {
-    loop_to_wake = queue_entry->subsumed_by;
+  entry->PushIncomingTask({order, task, target_time, task_source_grade});
+
+  EntryPtr entry_to_wake = entry;
+  TaskQueueId owner = TaskQueueId(entry->subsumed_by);
+  if (owner != kUnmerged) {
+    entry_to_wake = GetEntry(owner);
+    if (!entry_to_wake) {
+      // The owner is being disposed along with this queue.
+      return;
+    }
   }
 
-  // This can happen when the secondary tasks are paused.
-  if (HasPendingTasksUnlocked(loop_to_wake)) {
-    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  // Tasks in a paused secondary source do not need a wake up of their own,
+  // but the loop is still woken for the tasks that are already pending.
+  bool is_pending = task_source_grade != TaskSourceGrade::kDartEventLoop ||
+                    entry->secondary_pause_requests == 0;
+  WakeUpForTask(*entry_to_wake, target_time, is_pending);
+}
+
+void MessageLoopTaskQueues::WakeUpForTask(TaskQueueEntry& entry,
+                                          fml::TimePoint time,
+                                          bool is_pending) const {
+  const int64_t max_ticks =
+      fml::TimePoint::Max().ToEpochDelta().ToNanoseconds();
+  int64_t ticks = is_pending ? time.ToEpochDelta().ToNanoseconds() : max_ticks;
+  int64_t wake_ticks = entry.wake_time;
+  while (ticks < wake_ticks &&
+         !entry.wake_time.compare_exchange_weak(wake_ticks, ticks)) {
+  }
+  wake_ticks = std::min(ticks, wake_ticks);
+  if (!is_pending && wake_ticks == max_ticks) {
+    return;
+  }
+  Wakeable* wakeable = entry.wakeable;
+  if (!wakeable) {
+    return;
+  }
+  while (true) {
+    wakeable->WakeUp(fml::TimePoint::FromTicks(wake_ticks));
+    // Another thread may have lowered the wake time while this one was
+    // waking up the loop with the previous time. Make sure the earliest one
+    // is the last the loop is woken up with.
+    int64_t latest_ticks = entry.wake_time;
+    if (latest_ticks >= wake_ticks) {
+      return;
+    }
+    wake_ticks = latest_ticks;
   }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  return HasPendingTasksUnlocked(queue_id);
+  EntryPtr entry = GetEntryChecked(queue_id);
+  EntryLock lock(*entry);
+  DrainIncomingTasksLocked(*entry);
+  return HasPendingTasksLocked(*entry);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
-  if (!HasPendingTasksUnlocked(queue_id)) {
+  EntryPtr entry = GetEntryChecked(queue_id);
+  EntryLock lock(*entry);
+  if (!UpdateWakeUpLocked(*entry)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
-
-  if (!HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
-  } else {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
-  }
-
+  TaskSource::TopTask top = PeekNextTaskLocked(*entry);
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
   fml::closure invocation = top.task.GetTask();
   const auto task_source_grade = top.task.GetTaskSourceGrade();
-  queue_entries_.at(top.task_queue_id)->task_source->PopTask(task_source_grade);
+  TaskSource* top_source = entry->task_source.get();
+  for (const auto& subsumed : entry->subsumed_entries) {
+    if (subsumed->created_for == top.task_queue_id) {
+      top_source = subsumed->task_source.get();
+    }
+  }
+  top_source->PopTask(task_source_grade);
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
-  return invocation;
-}
 
-void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
-                                           fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
-  }
+  // The loop was asked to wake up for the task that was just popped. Re-arm
+  // it for the next one, so that tasks registered from now on are compared
+  // against a wake time the loop will actually be woken up at.
+  UpdateWakeUpLocked(*entry);
+  return invocation;
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  if (queue_entry->subsumed_by != kUnmerged) {
+  EntryPtr entry = GetEntryChecked(queue_id);
+  EntryLock lock(*entry);
+  if (entry->subsumed_by != kUnmerged) {
     return 0;
   }
+  DrainIncomingTasksLocked(*entry);
 
   size_t total_tasks = 0;
-  total_tasks += queue_entry->task_source->GetNumPendingTasks();
-
-  auto& subsumed_set = queue_entry->owner_of;
-  for (auto& subsumed : subsumed_set) {
-    const auto& subsumed_entry = queue_entries_.at(subsumed);
-    total_tasks += subsumed_entry->task_source->GetNumPendingTasks();
+  total_tasks += entry->task_source->GetNumPendingTasks();
+  for (const auto& subsumed : entry->subsumed_entries) {
+    total_tasks += subsumed->task_source->GetNumPendingTasks();
   }
   return total_tasks;
 }
@@ -166,33 +277,35 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  EntryPtr entry = GetEntryChecked(queue_id);
+  std::scoped_lock lock(entry->mutex);
+  entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  EntryPtr entry = GetEntryChecked(queue_id);
+  std::scoped_lock lock(entry->mutex);
+  entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  EntryPtr entry = GetEntryChecked(queue_id);
+  EntryLock lock(*entry);
   std::vector<fml::closure> observers;
 
-  if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
+  if (entry->subsumed_by != kUnmerged) {
     return observers;
   }
 
-  for (const auto& observer : queue_entries_.at(queue_id)->task_observers) {
+  for (const auto& observer : entry->task_observers) {
     observers.push_back(observer.second);
   }
 
-  auto& subsumed_set = queue_entries_.at(queue_id)->owner_of;
-  for (auto& subsumed : subsumed_set) {
-    for (const auto& observer : queue_entries_.at(subsumed)->task_observers) {
+  for (const auto& subsumed : entry->subsumed_entries) {
+    for (const auto& observer : subsumed->task_observers) {
       observers.push_back(observer.second);
     }
   }
@@ -202,101 +315,114 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  EntryPtr entry = GetEntryChecked(queue_id);
+  std::scoped_lock lock(entry->mutex);
+  FML_CHECK(!entry->wakeable) << "Wakeable can only be set once.";
+  entry->wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
-  auto& owner_entry = queue_entries_.at(owner);
-  auto& subsumed_entry = queue_entries_.at(subsumed);
-  auto& subsumed_set = owner_entry->owner_of;
-  if (subsumed_set.find(subsumed) != subsumed_set.end()) {
-    return true;
-  }
-
-  // Won't check owner_entry->owner_of, because it may contains items when
-  // merged with other different queues.
+  EntryPtr owner_entry = GetEntryChecked(owner);
+  EntryPtr subsumed_entry = GetEntryChecked(subsumed);
+  {
+    std::scoped_lock lock(owner_entry->mutex, subsumed_entry->mutex);
+    auto& subsumed_set = owner_entry->owner_of;
+    if (subsumed_set.find(subsumed) != subsumed_set.end()) {
+      return true;
+    }
 
-  // Ensure owner_entry->subsumed_by being kUnmerged
-  if (owner_entry->subsumed_by != kUnmerged) {
-    FML_LOG(WARNING) << "Thread merging failed: owner_entry was already "
-                        "subsumed by others, owner="
-                     << owner << ", subsumed=" << subsumed
-                     << ", owner->subsumed_by=" << owner_entry->subsumed_by;
-    return false;
-  }
-  // Ensure subsumed_entry->owner_of being empty
-  if (!subsumed_entry->owner_of.empty()) {
-    FML_LOG(WARNING)
-        << "Thread merging failed: subsumed_entry already owns others, owner="
-        << owner << ", subsumed=" << subsumed
-        << ", subsumed->owner_of.size()=" << subsumed_entry->owner_of.size();
-    return false;
-  }
-  // Ensure subsumed_entry->subsumed_by being kUnmerged
-  if (subsumed_entry->subsumed_by != kUnmerged) {
-    FML_LOG(WARNING) << "Thread merging failed: subsumed_entry was already "
-                        "subsumed by others, owner="
-                     << owner << ", subsumed=" << subsumed
-                     << ", subsumed->subsumed_by="
-                     << subsumed_entry->subsumed_by;
-    return false;
+    // Won't check owner_entry->owner_of, because it may contains items when
+    // merged with other different queues.
+
+    // Ensure owner_entry->subsumed_by being kUnmerged
+    if (owner_entry->subsumed_by != kUnmerged) {
+      FML_LOG(WARNING) << "Thread merging failed: owner_entry was already "
+                          "subsumed by others, owner="
+                       << owner << ", subsumed=" << subsumed
+                       << ", owner->subsumed_by="
+                       << owner_entry->subsumed_by;
+      return false;
+    }
+    // Ensure subsumed_entry->owner_of being empty
+    if (!subsumed_entry->owner_of.empty()) {
+      FML_LOG(WARNING)
+          << "Thread merging failed: subsumed_entry already owns others, "
+             "owner="
+          << owner << ", subsumed=" << subsumed
+          << ", subsumed->owner_of.size()=" << subsumed_entry->owner_of.size();
+      return false;
+    }
+    // Ensure subsumed_entry->subsumed_by being kUnmerged
+    if (subsumed_entry->subsumed_by != kUnmerged) {
+      FML_LOG(WARNING) << "Thread merging failed: subsumed_entry was already "
+                          "subsumed by others, owner="
+                       << owner << ", subsumed=" << subsumed
+                       << ", subsumed->subsumed_by="
+                       << subsumed_entry->subsumed_by;
+      return false;
+    }
+    // All checking is OK, set merged state.
+    owner_entry->owner_of.insert(subsumed);
+    owner_entry->subsumed_entries.push_back(subsumed_entry);
+    subsumed_entry->subsumed_by = owner;
   }
-  // All checking is OK, set merged state.
-  owner_entry->owner_of.insert(subsumed);
-  subsumed_entry->subsumed_by = owner;
 
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
-  }
+  EntryLock lock(*owner_entry);
+  UpdateWakeUpLocked(*owner_entry);
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& owner_entry = queue_entries_.at(owner);
-  if (owner_entry->owner_of.empty()) {
-    FML_LOG(WARNING)
-        << "Thread unmerging failed: owner_entry doesn't own anyone, owner="
-        << owner << ", subsumed=" << subsumed;
-    return false;
-  }
-  if (owner_entry->subsumed_by != kUnmerged) {
-    FML_LOG(WARNING)
-        << "Thread unmerging failed: owner_entry was subsumed by others, owner="
-        << owner << ", subsumed=" << subsumed
-        << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by;
-    return false;
-  }
-  if (queue_entries_.at(subsumed)->subsumed_by == kUnmerged) {
-    FML_LOG(WARNING) << "Thread unmerging failed: subsumed_entry wasn't "
-                        "subsumed by others, owner="
-                     << owner << ", subsumed=" << subsumed;
-    return false;
-  }
-  if (owner_entry->owner_of.find(subsumed) == owner_entry->owner_of.end()) {
-    FML_LOG(WARNING) << "Thread unmerging failed: owner_entry didn't own the "
-                        "given subsumed queue id, owner="
-                     << owner << ", subsumed=" << subsumed;
-    return false;
-  }
-
-  queue_entries_.at(subsumed)->subsumed_by = kUnmerged;
-  owner_entry->owner_of.erase(subsumed);
+  EntryPtr owner_entry = GetEntryChecked(owner);
+  EntryPtr subsumed_entry = GetEntryChecked(subsumed);
+  {
+    std::scoped_lock lock(owner_entry->mutex, subsumed_entry->mutex);
+    if (owner_entry->owner_of.empty()) {
+      FML_LOG(WARNING)
+          << "Thread unmerging failed: owner_entry doesn't own anyone, owner="
+          << owner << ", subsumed=" << subsumed;
+      return false;
+    }
+    if (owner_entry->subsumed_by != kUnmerged) {
+      FML_LOG(WARNING)
+          << "Thread unmerging failed: owner_entry was subsumed by others, "
+             "owner="
+          << owner << ", subsumed=" << subsumed
+          << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by;
+      return false;
+    }
+    if (subsumed_entry->subsumed_by == kUnmerged) {
+      FML_LOG(WARNING) << "Thread unmerging failed: subsumed_entry wasn't "
+                          "subsumed by others, owner="
+                       << owner << ", subsumed=" << subsumed;
+      return false;
+    }
+    if (owner_entry->owner_of.find(subsumed) == owner_entry->owner_of.end()) {
+      FML_LOG(WARNING) << "Thread unmerging failed: owner_entry didn't own the "
+                          "given subsumed queue id, owner="
+                       << owner << ", subsumed=" << subsumed;
+      return false;
+    }
 
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+    subsumed_entry->subsumed_by = kUnmerged;
+    owner_entry->owner_of.erase(subsumed);
+    auto& subsumed_entries = owner_entry->subsumed_entries;
+    subsumed_entries.erase(std::remove(subsumed_entries.begin(),
+                                       subsumed_entries.end(), subsumed_entry),
+                           subsumed_entries.end());
   }
 
-  if (HasPendingTasksUnlocked(subsumed)) {
-    WakeUpUnlocked(subsumed, GetNextWakeTimeUnlocked(subsumed));
+  {
+    EntryLock lock(*owner_entry);
+    UpdateWakeUpLocked(*owner_entry);
+  }
+  {
+    EntryLock lock(*subsumed_entry);
+    UpdateWakeUpLocked(*subsumed_entry);
   }
 
   return true;
@@ -304,67 +430,99 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
   if (owner == kUnmerged || subsumed == kUnmerged) {
     return false;
   }
-  auto& subsumed_set = queue_entries_.at(owner)->owner_of;
+  EntryPtr entry = GetEntryChecked(owner);
+  std::scoped_lock lock(entry->mutex);
+  auto& subsumed_set = entry->owner_of;
   return subsumed_set.find(subsumed) != subsumed_set.end();
 }
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
-  return queue_entries_.at(owner)->owner_of;
+  EntryPtr entry = GetEntryChecked(owner);
+  std::scoped_lock lock(entry->mutex);
+  return entry->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  EntryPtr entry = GetEntryChecked(queue_id);
+  std::scoped_lock lock(entry->mutex);
+  entry->task_source->PauseSecondary();
+  entry->secondary_pause_requests++;
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->ResumeSecondary();
+  EntryPtr entry = GetEntryChecked(queue_id);
+  EntryLock lock(*entry);
+  entry->task_source->ResumeSecondary();
+  entry->secondary_pause_requests--;
   // Schedule a wake as needed.
-  if (HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+  UpdateWakeUpLocked(*entry);
+}
+
+void MessageLoopTaskQueues::DrainIncomingTasksLocked(
+    TaskQueueEntry& entry) const {
+  entry.DrainIncomingTasks();
+  for (const auto& subsumed : entry.subsumed_entries) {
+    subsumed->DrainIncomingTasks();
   }
 }
 
+bool MessageLoopTaskQueues::UpdateWakeUpLocked(TaskQueueEntry& entry) const {
+  bool has_pending_tasks;
+  do {
+    DrainIncomingTasksLocked(entry);
+    has_pending_tasks = HasPendingTasksLocked(entry);
+    fml::TimePoint wake_time =
+        has_pending_tasks ? PeekNextTaskLocked(entry).task.GetTargetTime()
+                          : fml::TimePoint::Max();
+    entry.wake_time = wake_time.ToEpochDelta().ToNanoseconds();
+    Wakeable* wakeable = entry.wakeable;
+    if (has_pending_tasks && wakeable) {
+      wakeable->WakeUp(wake_time);
+    }
+    // A task registered after the incoming tasks were drained may have
+    // computed its wake up time against the previous wake time and woken up
+    // the loop before this thread did, so it has to be accounted for here.
+  } while (HasIncomingTasksLocked(entry));
+  return has_pending_tasks;
+}
+
+bool MessageLoopTaskQueues::HasIncomingTasksLocked(
+    const TaskQueueEntry& entry) const {
+  return entry.HasIncomingTasks() ||
+         std::any_of(entry.subsumed_entries.begin(),
+                     entry.subsumed_entries.end(), [](const auto& subsumed) {
+                       return subsumed->HasIncomingTasks();
+                     });
+}
+
 // Subsumed queues will never have pending tasks.
 // Owning queues will consider both their and their subsumed tasks.
-bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
-    TaskQueueId queue_id) const {
-  const auto& entry = queue_entries_.at(queue_id);
-  bool is_subsumed = entry->subsumed_by != kUnmerged;
+bool MessageLoopTaskQueues::HasPendingTasksLocked(
+    const TaskQueueEntry& entry) const {
+  bool is_subsumed = entry.subsumed_by != kUnmerged;
   if (is_subsumed) {
     return false;
   }
 
-  if (!entry->task_source->IsEmpty()) {
+  if (!entry.task_source->IsEmpty()) {
     return true;
   }
 
-  auto& subsumed_set = entry->owner_of;
   return std::any_of(
-      subsumed_set.begin(), subsumed_set.end(), [&](const auto& subsumed) {
-        return !queue_entries_.at(subsumed)->task_source->IsEmpty();
-      });
+      entry.subsumed_entries.begin(), entry.subsumed_entries.end(),
+      [](const auto& subsumed) { return !subsumed->task_source->IsEmpty(); });
 }
 
-fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
-    TaskQueueId queue_id) const {
-  return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
-}
-
-TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
-  FML_DCHECK(HasPendingTasksUnlocked(owner));
-  const auto& entry = queue_entries_.at(owner);
-  if (entry->owner_of.empty()) {
-    FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskLocked(
+    const TaskQueueEntry& entry) const {
+  FML_DCHECK(HasPendingTasksLocked(entry));
+  if (entry.subsumed_entries.empty()) {
+    FML_CHECK(!entry.task_source->IsEmpty());
+    return entry.task_source->Top();
   }
 
   // Use optional for the memory of TopTask object.
@@ -380,15 +538,15 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
         }
       };
 
-  TaskSource* owner_tasks = entry->task_source.get();
+  TaskSource* owner_tasks = entry.task_source.get();
   top_task_updater(owner_tasks);
 
-  for (TaskQueueId subsumed : entry->owner_of) {
-    TaskSource* subsumed_tasks = queue_entries_.at(subsumed)->task_source.get();
+  for (const auto& subsumed : entry.subsumed_entries) {
+    TaskSource* subsumed_tasks = subsumed->task_source.get();
     top_task_updater(subsumed_tasks);
   }
-  // At least one task at the top because PeekNextTaskUnlocked() is called after
-  // HasPendingTasksUnlocked()
+  // At least one task at the top because PeekNextTaskLocked() is called after
+  // HasPendingTasksLocked()
   FML_CHECK(top_task.has_value());
   // Covered by FML_CHECK.
   // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -28,25 +31,65 @@ static const TaskQueueId kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
 /// this isn't the case when TaskQueues are merged via
 /// \p fml::MessageLoopTaskQueues::Merge.
+///
+/// Tasks are registered without taking any lock by pushing them onto the
+/// lock-free \p incoming list. The thread that services the queue moves them
+/// into the \p task_source, which like all other fields except the atomics is
+/// guarded by \p mutex.
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
-  Wakeable* wakeable;
+
+  /// A node of the list of tasks that were registered but have not yet been
+  /// moved into the task source.
+  struct IncomingTask {
+    DelayedTask task;
+    IncomingTask* next;
+  };
+
+  std::mutex mutex;
+  std::atomic<Wakeable*> wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
 
+  /// The most recently registered task that has not been moved into the task
+  /// source, linked to the ones registered before it.
+  std::atomic<IncomingTask*> incoming;
+
+  /// Mirrors the pause count of the secondary source of \p task_source so
+  /// that it can be read without holding \p mutex.
+  std::atomic_int secondary_pause_requests;
+
+  /// The time the wakeable was last asked to wake up at, in ticks, or the
+  /// ticks of \p fml::TimePoint::Max if there are no pending tasks.
+  std::atomic<int64_t> wake_time;
+
   /// Set of the TaskQueueIds which is owned by this TaskQueue. If the set is
   /// empty, this TaskQueue does not own any other TaskQueues.
   std::set<TaskQueueId> owner_of;
 
+  /// The entries of the TaskQueues in \p owner_of.
+  std::vector<std::shared_ptr<TaskQueueEntry>> subsumed_entries;
+
   /// Identifies the TaskQueue that subsumes this TaskQueue. If it is kUnmerged
   /// it indicates that this TaskQueue is not owned by any other TaskQueue.
-  TaskQueueId subsumed_by;
+  std::atomic<size_t> subsumed_by;
 
   TaskQueueId created_for;
 
   explicit TaskQueueEntry(TaskQueueId created_for);
 
+  ~TaskQueueEntry();
+
+  /// Pushes a task onto \p incoming. Safe to call from any thread.
+  void PushIncomingTask(const DelayedTask& task);
+
+  /// Moves the tasks from \p incoming into \p task_source. Must be called
+  /// with \p mutex held.
+  void DrainIncomingTasks();
+
+  bool HasIncomingTasks() const;
+
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskQueueEntry);
 };
@@ -139,22 +182,57 @@ class MessageLoopTaskQueues {
  private:
   class MergedQueuesRunner;
 
+  // Locks the mutexes of an entry and of the entries it owns, in that order.
+  class EntryLock;
+
+  using EntryPtr = std::shared_ptr<TaskQueueEntry>;
+
+  // The registry of entries is split into shards by queue id so that threads
+  // working with different queues do not contend on a single lock. Each
+  // shard is only locked exclusively when queues are created or disposed.
+  static constexpr size_t kShardCount = 16;
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::map<TaskQueueId, EntryPtr> entries;
+  };
+
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
-  void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
+  // Returns the entry for |queue_id| or null if it was disposed.
+  EntryPtr GetEntry(TaskQueueId queue_id) const;
+
+  // Returns the entry for |queue_id|, which must exist.
+  EntryPtr GetEntryChecked(TaskQueueId queue_id) const;
+
+  Shard& GetShard(TaskQueueId queue_id) const;
+
+  // Asks the wakeable of |entry| to wake up at |time| unless it has already
+  // been asked to wake up earlier. Safe to call without holding any lock.
+  void WakeUpForTask(TaskQueueEntry& entry,
+                     fml::TimePoint time,
+                     bool is_pending) const;
+
+  // The following methods must be called with the mutexes of |entry| and
+  // the entries it owns held.
+
+  void DrainIncomingTasksLocked(TaskQueueEntry& entry) const;
+
+  // Drains the incoming tasks and schedules a wake up at the time of the
+  // next pending task, if any. Returns whether there are pending tasks.
+  bool UpdateWakeUpLocked(TaskQueueEntry& entry) const;
 
-  bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
+  bool HasIncomingTasksLocked(const TaskQueueEntry& entry) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  bool HasPendingTasksLocked(const TaskQueueEntry& entry) const;
 
-  fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
+  TaskSource::TopTask PeekNextTaskLocked(const TaskQueueEntry& entry) const;
 
-  mutable std::mutex queue_mutex_;
-  std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
+  mutable std::array<Shard, kShardCount> shards_;
 
-  size_t task_queue_id_counter_ = 0;
+  std::atomic<size_t> task_queue_id_counter_ = 0;
 
   std::atomic_int order_;
 
@@ -64,7 +64,82 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
   }
 }
 
+// Measures contention between threads posting to the same queue while the
+// thread that services the queue drains it.
+static void BM_RegisterTasksContended(benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_producers = static_cast<int>(state.range(0));
+  const int num_tasks_per_producer = 1000;
+  const int num_tasks = num_producers * num_tasks_per_producer;
+
+  while (state.KeepRunning()) {
+    const TaskQueueId queue_id = task_queues->CreateTaskQueue();
+    const fml::TimePoint past = fml::TimePoint::Now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_producers);
+    for (int i = 0; i < num_producers; i++) {
+      threads.emplace_back([&task_queues, queue_id, past]() {
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          task_queues->RegisterTask(queue_id, [] {}, past);
+        }
+      });
+    }
+
+    int num_invocations = 0;
+    while (num_invocations < num_tasks) {
+      if (task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Now())) {
+        num_invocations++;
+      }
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    task_queues->Dispose(queue_id);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+
+// Measures threads posting to and draining queues of their own, which
+// should not contend with each other.
+static void BM_RegisterTasksUncontended(benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_threads = static_cast<int>(state.range(0));
+  const int num_tasks_per_thread = 1000;
+
+  while (state.KeepRunning()) {
+    std::vector<TaskQueueId> queue_ids;
+    for (int i = 0; i < num_threads; i++) {
+      queue_ids.push_back(task_queues->CreateTaskQueue());
+    }
+    const fml::TimePoint past = fml::TimePoint::Now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int i = 0; i < num_threads; i++) {
+      threads.emplace_back([&task_queues, queue_id = queue_ids[i], past]() {
+        for (int j = 0; j < num_tasks_per_thread; j++) {
+          task_queues->RegisterTask(queue_id, [] {}, past);
+          task_queues->GetNextTaskToRun(queue_id, past);
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto queue_id : queue_ids) {
+      task_queues->Dispose(queue_id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_threads *
+                          num_tasks_per_thread);
+}
+
 BENCHMARK(BM_RegisterAndGetTasks);
+BENCHMARK(BM_RegisterTasksContended)->RangeMultiplier(2)->Range(1, 8);
+BENCHMARK(BM_RegisterTasksUncontended)->RangeMultiplier(2)->Range(1, 8);
 
 }  // namespace benchmarking
 }  // namespace fml
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -404,6 +405,86 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+TEST(MessageLoopTaskQueue, ConcurrentRegisterWhileRunningTasks) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queues->CreateTaskQueue();
+
+  // kThreadCount threads post kThreadTaskCount tasks each to a queue while
+  // it is being drained. Every task runs exactly once.
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kThreadTaskCount = 500;
+
+  std::atomic_size_t wakes = 0;
+  auto wakeable = std::make_unique<TestWakeable>(
+      [&wakes](fml::TimePoint wake_time) { wakes++; });
+  task_queues->SetWakeable(queue_id, wakeable.get());
+
+  std::atomic_size_t tasks_run = 0;
+  auto thread_main = [&]() {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(
+          queue_id, [&tasks_run]() { tasks_run++; }, ChronoTicksSinceEpoch());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back(std::thread{thread_main});
+  }
+
+  size_t tasks_taken = 0;
+  while (tasks_taken < kThreadCount * kThreadTaskCount) {
+    auto invocation =
+        task_queues->GetNextTaskToRun(queue_id, ChronoTicksSinceEpoch());
+    if (invocation) {
+      invocation();
+      tasks_taken++;
+    }
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(tasks_run, kThreadCount * kThreadTaskCount);
+  ASSERT_GE(wakes, kThreadCount * kThreadTaskCount);
+  ASSERT_FALSE(task_queues->HasPendingTasks(queue_id));
+  ASSERT_EQ(task_queues->GetNumPendingTasks(queue_id), 0u);
+}
+
+TEST(MessageLoopTaskQueue, WokenUpForTaskRegisteredAfterRunningTask) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  std::vector<fml::TimePoint> wakes;
+  auto wakeable = std::make_unique<TestWakeable>(
+      [&wakes](fml::TimePoint wake_time) { wakes.push_back(wake_time); });
+  task_queue->SetWakeable(queue_id, wakeable.get());
+
+  const auto now = ChronoTicksSinceEpoch();
+  const auto later = now + fml::TimeDelta::FromSeconds(10);
+  task_queue->RegisterTask(queue_id, []() {}, now);
+  task_queue->RegisterTask(queue_id, []() {}, later);
+  wakes.clear();
+  ASSERT_TRUE(task_queue->GetNextTaskToRun(queue_id, now));
+  // Running the first task re-arms the loop for the next one.
+  ASSERT_FALSE(wakes.empty());
+  ASSERT_EQ(later, wakes.back());
+
+  // The next task is not due for a while. A task registered before it wakes
+  // up the queue at its own time.
+  const auto sooner = now + fml::TimeDelta::FromMilliseconds(1);
+  wakes.clear();
+  task_queue->RegisterTask(queue_id, []() {}, sooner);
+  ASSERT_EQ(1UL, wakes.size());
+  ASSERT_EQ(sooner, wakes[0]);
+
+  wakes.clear();
+  task_queue->RegisterTask(queue_id, []() {}, later);
+  ASSERT_EQ(1UL, wakes.size());
+  ASSERT_EQ(sooner, wakes[0]);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
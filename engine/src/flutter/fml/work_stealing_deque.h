@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_WORK_STEALING_DEQUE_H_
+#define FLUTTER_FML_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A lock-free single-owner, multi-thief deque of pointers.
+///
+///             This is the Chase-Lev work-stealing deque. The owning thread
+///             pushes and pops items at the bottom of the deque (LIFO)
+///             without taking any locks. Any other thread may steal items
+///             from the top of the deque (FIFO).
+///
+///             The deque does not own the items it holds. Items remaining in
+///             the deque when it is destroyed must be drained by the owner
+///             beforehand.
+///
+///             Buffers retired by growth are kept alive until the deque is
+///             destroyed since a concurrent thief may still be reading from
+///             them.
+///
+template <typename T>
+class WorkStealingDeque {
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 64) {
+    int64_t capacity = 1;
+    while (capacity < static_cast<int64_t>(initial_capacity)) {
+      capacity <<= 1;
+    }
+    buffers_.emplace_back(std::make_unique<Buffer>(capacity));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  ~WorkStealingDeque() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pushes an item to the bottom of the deque. Must only be
+  ///             called on the owning thread.
+  ///
+  void Push(T* item) {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->capacity() - 1) {
+      buffers_.emplace_back(buffer->Grow(top, bottom));
+      buffer = buffers_.back().get();
+      buffer_.store(buffer, std::memory_order_release);
+    }
+    buffer->Put(bottom, item);
+    // Publishes the item to thieves that acquire |bottom_|.
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pops the most recently pushed item. Must only be called on
+  ///             the owning thread.
+  ///
+  /// @return     The item or nullptr if the deque is empty.
+  ///
+  T* Pop() {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    // The store to |bottom_| and the load of |top_| must not be reordered
+    // with the corresponding operations in |Steal|.
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T* item = buffer->Get(bottom);
+    if (top == bottom) {
+      // Last item. Race against thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Steals the least recently pushed item. May be called on any
+  ///             thread.
+  ///
+  /// @return     The item or nullptr if the deque was empty or the item was
+  ///             taken by a concurrent pop or steal.
+  ///
+  T* Steal() {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+
+    if (top >= bottom) {
+      return nullptr;
+    }
+
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    T* item = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      An approximation of the number of items in the deque. Only
+  ///             exact when called on the owning thread with no concurrent
+  ///             thieves.
+  ///
+  size_t ApproximateSize() const {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+  }
+
+  bool IsEmpty() const { return ApproximateSize() == 0u; }
+
+ private:
+  class Buffer {
+   public:
+    explicit Buffer(int64_t capacity)
+        : capacity_(capacity),
+          mask_(capacity - 1),
+          items_(new std::atomic<T*>[capacity]) {
+      FML_DCHECK((capacity & mask_) == 0);
+    }
+
+    int64_t capacity() const { return capacity_; }
+
+    T* Get(int64_t index) const {
+      return items_[index & mask_].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, T* item) {
+      items_[index & mask_].store(item, std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<Buffer> Grow(int64_t top, int64_t bottom) const {
+      auto grown = std::make_unique<Buffer>(capacity_ * 2);
+      for (int64_t i = top; i < bottom; i++) {
+        grown->Put(i, Get(i));
+      }
+      return grown;
+    }
+
+   private:
+    const int64_t capacity_;
+    const int64_t mask_;
+    std::unique_ptr<std::atomic<T*>[]> items_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  std::atomic<int64_t> top_ = 0;
+  std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Buffer*> buffer_ = nullptr;
+  // Only accessed by the owner. Holds the current buffer and every buffer
+  // retired by |Grow|.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_WORK_STEALING_DEQUE_H_
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+TEST(WorkStealingDequeTest, PopIsLastInFirstOut) {
+  WorkStealingDeque<int> deque;
+  int values[3] = {1, 2, 3};
+  for (auto& value : values) {
+    deque.Push(&value);
+  }
+  ASSERT_EQ(deque.ApproximateSize(), 3u);
+  ASSERT_EQ(deque.Pop(), &values[2]);
+  ASSERT_EQ(deque.Pop(), &values[1]);
+  ASSERT_EQ(deque.Pop(), &values[0]);
+  ASSERT_EQ(deque.Pop(), nullptr);
+  ASSERT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, StealIsFirstInFirstOut) {
+  WorkStealingDeque<int> deque;
+  int values[3] = {1, 2, 3};
+  for (auto& value : values) {
+    deque.Push(&value);
+  }
+  ASSERT_EQ(deque.Steal(), &values[0]);
+  ASSERT_EQ(deque.Steal(), &values[1]);
+  ASSERT_EQ(deque.Pop(), &values[2]);
+  ASSERT_EQ(deque.Steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+  WorkStealingDeque<int> deque(2);
+  std::vector<int> values(100);
+  for (auto& value : values) {
+    deque.Push(&value);
+  }
+  ASSERT_EQ(deque.ApproximateSize(), values.size());
+  ASSERT_EQ(deque.Steal(), &values.front());
+  for (size_t i = values.size() - 1; i > 0; i--) {
+    ASSERT_EQ(deque.Pop(), &values[i]);
+  }
+  ASSERT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce) {
+  const size_t kItemCount = 100000;
+  const size_t kThiefCount = 4;
+  WorkStealingDeque<std::atomic_int> deque(16);
+  std::vector<std::atomic_int> taken(kItemCount);
+  std::atomic_bool done = false;
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefCount; i++) {
+    thieves.emplace_back([&]() {
+      while (!done.load()) {
+        if (auto item = deque.Steal()) {
+          item->fetch_add(1);
+        }
+      }
+    });
+  }
+
+  for (size_t i = 0; i < kItemCount; i++) {
+    deque.Push(&taken[i]);
+    if (i % 3 == 0) {
+      if (auto item = deque.Pop()) {
+        item->fetch_add(1);
+      }
+    }
+  }
+  while (auto item = deque.Pop()) {
+    item->fetch_add(1);
+  }
+
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  for (const auto& count : taken) {
+    ASSERT_EQ(count.load(), 1);
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -43,6 +43,48 @@ TEST_P(AiksTest, CanRenderColoredRect) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+// Consecutive solid color rects are batched into a single draw. The rects
+// overlap, so they must still blend in the order they were drawn.
+TEST_P(AiksTest, CanRenderManySolidRectsInOrder) {
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+  DlPaint paint;
+  paint.setColor(DlColor::kWhite());
+  builder.DrawPaint(paint);
+
+  auto draw_grid = [&builder](SkScalar x, SkScalar y) {
+    DlPaint paint;
+    for (int row = 0; row < 16; row++) {
+      for (int column = 0; column < 16; column++) {
+        uint32_t alpha = (row + column) % 3 == 0 ? 0x80 : 0xFF;
+        paint.setColor(DlColor((alpha << 24) | ((row * 16) << 16) |
+                               ((column * 16) << 8) | 0x80));
+        builder.DrawRect(
+            SkRect::MakeXYWH(x + column * 12, y + row * 12, 20, 20), paint);
+      }
+    }
+  };
+
+  draw_grid(20, 20);
+
+  // With a transform and a clip.
+  builder.Save();
+  builder.Translate(400, 20);
+  builder.Rotate(10);
+  builder.ClipRect(SkRect::MakeLTRB(20, 20, 180, 180));
+  draw_grid(0, 0);
+  builder.Restore();
+
+  // With an opacity that is distributed to the rects.
+  DlPaint layer_paint;
+  layer_paint.setOpacity(0.5);
+  builder.SaveLayer(nullptr, &layer_paint);
+  draw_grid(20, 300);
+  builder.Restore();
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 TEST_P(AiksTest, CanRenderImage) {
   DisplayListBuilder builder;
   DlPaint paint;
@@ -63,6 +63,7 @@ bool AiksPlayground::OpenPlaygroundHere(
         display_list->Dispatch(impeller_dispatcher);
         impeller_dispatcher.FinishRecording();
         renderer.GetContentContext().GetTransientsBuffer().Reset();
+        renderer.GetContentContext().EndFrame();
         renderer.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
         return true;
       });
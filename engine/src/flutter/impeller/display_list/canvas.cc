@@ -19,6 +19,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
@@ -591,6 +592,10 @@ void Canvas::DrawRect(const Rect& rect, const Paint& paint) {
     return;
   }
 
+  if (AttemptBatchRect(rect, paint)) {
+    return;
+  }
+
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
@@ -1049,6 +1054,7 @@ void Canvas::SaveLayer(const Paint& paint,
                        uint32_t total_content_depth,
                        bool can_distribute_opacity) {
   TRACE_EVENT0("flutter", "Canvas::saveLayer");
+  FlushRectBatch();
   if (IsSkipping()) {
     return SkipUntilMatchingRestore(total_content_depth);
   }
@@ -1199,6 +1205,7 @@ bool Canvas::Restore() {
   if (transform_stack_.size() == 1) {
     return false;
   }
+  FlushRectBatch();
 
   // This check is important to make sure we didn't exceed the depth
   // that the clips were rendered at while rendering any of the
@@ -1306,6 +1313,7 @@ bool Canvas::Restore() {
         renderer_,                                                         //
         *render_passes_.back().inline_pass_context->GetRenderPass(0).pass  //
     );
+    draw_statistics_.rendered_entity_count++;
     clip_coverage_stack_.PopSubpass();
     transform_stack_.pop_back();
 
@@ -1406,6 +1414,7 @@ void Canvas::DrawTextFrame(const std::shared_ptr<TextFrame>& text_frame,
 }
 
 void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
+  FlushRectBatch();
   if (IsSkipping()) {
     return;
   }
@@ -1502,9 +1511,80 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
   }
 
   entity.Render(renderer_, *result.pass);
+  draw_statistics_.rendered_entity_count++;
+}
+
+bool Canvas::AttemptBatchRect(const Rect& rect, const Paint& paint) {
+  if (IsSkipping() || paint.blend_mode != BlendMode::kSourceOver ||
+      paint.color_source != nullptr || paint.color_filter != nullptr ||
+      paint.invert_colors || paint.image_filter != nullptr ||
+      paint.mask_blur_descriptor.has_value()) {
+    return false;
+  }
+  // Until something is rendered, a rectangle that covers the whole pass is
+  // folded into the clear color instead of being drawn. Leave that to
+  // |AddRenderEntityToCurrentPass| so that batched rectangles are never
+  // drawn below a rectangle that came after them.
+  if (render_passes_.back().IsApplyingClearColor()) {
+    return false;
+  }
+  Matrix transform =
+      Matrix::MakeTranslation(Vector3(-GetGlobalPassPosition())) *
+      GetCurrentTransform();
+  if (!SolidRectBatchContents::CanBatchTransform(transform)) {
+    return false;
+  }
+
+  if (rect_batch_ && rect_batch_->IsFull()) {
+    FlushRectBatch();
+  }
+  if (!rect_batch_) {
+    rect_batch_ = std::make_shared<SolidRectBatchContents>();
+  }
+
+  ++current_depth_;
+  FML_DCHECK(current_depth_ <= transform_stack_.back().clip_depth)
+      << current_depth_ << " <=? " << transform_stack_.back().clip_depth;
+  // The batch is drawn at the depth of its last rectangle. The clips that
+  // affect the batch are all at or above that depth, so they still clip every
+  // rectangle in it.
+  rect_batch_depth_ = current_depth_;
+
+  Color color = paint.color;
+  color.alpha *= transform_stack_.back().distributed_opacity;
+  rect_batch_->AddRect(transform, rect, color);
+  return true;
+}
+
+void Canvas::FlushRectBatch() {
+  if (!rect_batch_) {
+    return;
+  }
+  std::shared_ptr<SolidRectBatchContents> batch = std::move(rect_batch_);
+  rect_batch_ = nullptr;
+  if (batch->GetRectCount() == 0u) {
+    return;
+  }
+
+  Entity entity;
+  entity.SetContents(batch);
+  entity.SetBlendMode(BlendMode::kSourceOver);
+  entity.SetClipDepth(rect_batch_depth_);
+
+  InlinePassContext::RenderPassResult result =
+      render_passes_.back().inline_pass_context->GetRenderPass(0);
+  if (!result.pass) {
+    return;
+  }
+
+  entity.Render(renderer_, *result.pass);
+  draw_statistics_.rendered_entity_count++;
+  draw_statistics_.batched_rect_count += batch->GetRectCount();
+  draw_statistics_.batch_count++;
 }
 
 void Canvas::AddClipEntityToCurrentPass(Entity& entity) {
+  FlushRectBatch();
   if (IsSkipping()) {
     return;
   }
@@ -1560,6 +1640,7 @@ void Canvas::AddClipEntityToCurrentPass(Entity& entity) {
   entity.Render(
       renderer_,
       *render_passes_.back().inline_pass_context->GetRenderPass(0).pass);
+  draw_statistics_.rendered_entity_count++;
 }
 
 bool Canvas::BlitToOnscreen() {
@@ -1623,6 +1704,13 @@ bool Canvas::BlitToOnscreen() {
 
 void Canvas::EndReplay() {
   FML_DCHECK(render_passes_.size() == 1u);
+  FlushRectBatch();
+  FML_TRACE_COUNTER("impeller", "Canvas",                                 //
+                    reinterpret_cast<int64_t>(this),                      //
+                    "RenderedEntities",                                   //
+                    draw_statistics_.rendered_entity_count,               //
+                    "BatchedRects", draw_statistics_.batched_rect_count,  //
+                    "Batches", draw_statistics_.batch_count);
   render_passes_.back().inline_pass_context->GetRenderPass(0);
   render_passes_.back().inline_pass_context->EndPass();
 
@@ -15,6 +15,7 @@
 #include "impeller/display_list/image_filter.h"
 #include "impeller/display_list/paint.h"
 #include "impeller/entity/contents/atlas_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass_clip_stack.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -231,6 +232,21 @@ class Canvas {
 
   uint64_t GetMaxOpDepth() const { return transform_stack_.back().clip_depth; }
 
+  struct DrawStatistics {
+    /// The number of entities that were rendered to a render pass, including
+    /// clips and batches.
+    size_t rendered_entity_count = 0u;
+    /// The number of rectangles that were drawn as part of a batch instead of
+    /// being rendered as their own entities.
+    size_t batched_rect_count = 0u;
+    /// The number of batches that were rendered.
+    size_t batch_count = 0u;
+  };
+
+  /// @brief Statistics about the entities this canvas rendered since it was
+  ///        created.
+  const DrawStatistics& GetDrawStatistics() const { return draw_statistics_; }
+
   struct SaveLayerState {
     Paint paint;
     Rect coverage;
@@ -249,6 +265,12 @@ class Canvas {
 
   uint64_t current_depth_ = 0u;
 
+  // Consecutive solid color rectangles that have not been rendered yet, and
+  // the depth of the last one.
+  std::shared_ptr<SolidRectBatchContents> rect_batch_;
+  uint32_t rect_batch_depth_ = 0u;
+  DrawStatistics draw_statistics_;
+
   Point GetGlobalPassPosition() const;
 
   // clip depth of the previous save or 0.
@@ -275,6 +297,17 @@ class Canvas {
 
   void AddClipEntityToCurrentPass(Entity& entity);
 
+  /// @brief Add the rectangle to the pending batch of solid color rectangles
+  ///        if the paint and the current state allow it.
+  ///
+  /// @return Whether the rectangle was batched.
+  bool AttemptBatchRect(const Rect& rect, const Paint& paint);
+
+  /// @brief Render the pending batch of solid color rectangles, if any. This
+  ///        must happen before anything else is rendered or the clip, the
+  ///        render pass or the depth of subsequent draws changes.
+  void FlushRectBatch();
+
   void ClipGeometry(const std::shared_ptr<Geometry>& geometry,
                     Entity::ClipOperation clip_op);
 
@@ -125,6 +125,66 @@ TEST_P(AiksTest, PaintWithFilters) {
   ASSERT_FALSE(paint.HasColorFilter());
 }
 
+TEST_P(AiksTest, ConsecutiveSolidRectsAreBatched) {
+  ContentContext context(GetContext(), nullptr);
+  auto canvas = CreateTestCanvas(context);
+
+  Paint paint;
+  paint.color = Color::Red();
+  // The first draw is never batched as it might become the clear color.
+  canvas->DrawRect(Rect::MakeXYWH(10, 10, 5, 5), paint);
+  EXPECT_EQ(canvas->GetOpDepth(), 1u);
+
+  for (int i = 0; i < 10; i++) {
+    paint.color = i % 2 ? Color::Blue() : Color::Green().WithAlpha(0.5);
+    canvas->DrawRect(Rect::MakeXYWH(i, i, 5, 5), paint);
+  }
+  // Batched rects still consume a depth each.
+  EXPECT_EQ(canvas->GetOpDepth(), 11u);
+  EXPECT_EQ(canvas->GetDrawStatistics().rendered_entity_count, 1u);
+
+  // Clips end the batch.
+  canvas->Save(10);
+  canvas->ClipRect(Rect::MakeXYWH(0, 0, 8, 8));
+  canvas->Rotate(Degrees(45));
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  canvas->DrawRect(Rect::MakeXYWH(2, 2, 5, 5), paint);
+
+  // So do draws that can't be batched.
+  paint.blend_mode = BlendMode::kSource;
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  paint.blend_mode = BlendMode::kSourceOver;
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  canvas->Restore();
+  canvas->EndReplay();
+
+  const Canvas::DrawStatistics& statistics = canvas->GetDrawStatistics();
+  EXPECT_EQ(statistics.batch_count, 3u);
+  EXPECT_EQ(statistics.batched_rect_count, 13u);
+}
+
+TEST_P(AiksTest, SolidRectsWithFiltersAreNotBatched) {
+  ContentContext context(GetContext(), nullptr);
+  auto canvas = CreateTestCanvas(context);
+
+  Paint paint;
+  canvas->DrawRect(Rect::MakeXYWH(10, 10, 5, 5), paint);
+
+  paint.color_filter =
+      ColorFilter::MakeBlend(BlendMode::kSourceOver, Color::Blue());
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  paint.color_filter = nullptr;
+
+  paint.style = Paint::Style::kStroke;
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  canvas->DrawRect(Rect::MakeXYWH(0, 0, 5, 5), paint);
+  canvas->EndReplay();
+
+  EXPECT_EQ(canvas->GetDrawStatistics().batch_count, 0u);
+  EXPECT_EQ(canvas->GetDrawStatistics().batched_rect_count, 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
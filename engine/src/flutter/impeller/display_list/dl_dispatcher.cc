@@ -1443,6 +1443,7 @@ bool RenderToOnscreen(ContentContext& context,
   impeller_dispatcher.FinishRecording();
   if (reset_host_buffer) {
     context.GetTransientsBuffer().Reset();
+    context.EndFrame();
   }
   context.GetLazyGlyphAtlas()->ResetTextFrames();
 
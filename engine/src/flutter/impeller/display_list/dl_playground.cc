@@ -58,6 +58,7 @@ bool DlPlayground::OpenPlaygroundHere(DisplayListPlaygroundCallback callback) {
         list->Dispatch(impeller_dispatcher);
         impeller_dispatcher.FinishRecording();
         context.GetContentContext().GetTransientsBuffer().Reset();
+        context.GetContentContext().EndFrame();
         context.GetContentContext().GetLazyGlyphAtlas()->ResetTextFrames();
         return true;
       });
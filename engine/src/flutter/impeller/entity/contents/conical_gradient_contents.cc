@@ -6,7 +6,7 @@
 
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
-#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/contents/gradient_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/gradient.h"
@@ -90,13 +90,13 @@ bool ConicalGradientContents::RenderSSBO(const ContentContext& renderer,
           frag_info.focus_radius = 0.0;
         }
 
-        auto& host_buffer = renderer.GetTransientsBuffer();
-        auto colors = CreateGradientColors(colors_, stops_);
-
-        frag_info.colors_length = colors.size();
-        auto color_buffer =
-            host_buffer.Emplace(colors.data(), colors.size() * sizeof(StopData),
-                                DefaultUniformAlignment());
+        frag_info.colors_length = stops_.size();
+        auto color_buffer = renderer.GetGradientCache().GetStopBuffer(
+            colors_, stops_, *renderer.GetContext()->GetResourceAllocator(),
+            renderer.GetTransientsBuffer());
+        if (!color_buffer) {
+          return false;
+        }
 
         FS::BindFragInfo(
             pass, renderer.GetTransientsBuffer().EmplaceUniform(frag_info));
@@ -113,9 +113,8 @@ bool ConicalGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = ConicalGradientFillPipeline::VertexShader;
   using FS = ConicalGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientCache().GetGradientTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -4,7 +4,10 @@
 
 #include "impeller/entity/contents/content_context.h"
 
+#include <functional>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 #include "fml/trace_event.h"
@@ -12,7 +15,9 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
+#include "impeller/entity/contents/filters/gaussian_blur_cache.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/gradient_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
@@ -221,6 +226,43 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
   desc.SetPolygonMode(wireframe ? PolygonMode::kLine : PolygonMode::kFill);
 }
 
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  const auto pixel_format = static_cast<uint8_t>(key >> 8);
+  const auto primitive_type = static_cast<uint8_t>(key >> 16);
+  const auto stencil_mode = static_cast<uint8_t>(key >> 24);
+  const auto depth_compare = static_cast<uint8_t>(key >> 32);
+  const auto blend_mode = static_cast<uint8_t>(key >> 40);
+  const auto sample_count = static_cast<uint8_t>(key >> 48);
+  if (pixel_format > static_cast<uint8_t>(PixelFormat::kD32FloatS8UInt) ||
+      primitive_type > static_cast<uint8_t>(PrimitiveType::kTriangleFan) ||
+      stencil_mode >
+          static_cast<uint8_t>(StencilMode::kOverdrawPreventionRestore) ||
+      depth_compare > static_cast<uint8_t>(CompareFunction::kGreaterEqual) ||
+      blend_mode > static_cast<uint8_t>(BlendMode::kLast) ||
+      (sample_count != static_cast<uint8_t>(SampleCount::kCount1) &&
+       sample_count != static_cast<uint8_t>(SampleCount::kCount4))) {
+    return std::nullopt;
+  }
+  ContentContextOptions options{
+      .sample_count = static_cast<SampleCount>(sample_count),
+      .blend_mode = static_cast<BlendMode>(blend_mode),
+      .depth_compare = static_cast<CompareFunction>(depth_compare),
+      .stencil_mode = static_cast<StencilMode>(stencil_mode),
+      .primitive_type = static_cast<PrimitiveType>(primitive_type),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(pixel_format),
+      .has_depth_stencil_attachments = (key & (1llu << 2)) != 0,
+      .depth_write_enabled = (key & (1llu << 3)) != 0,
+      .wireframe = (key & (1llu << 1)) != 0,
+      .is_for_rrect_blur_clear = (key & (1llu << 0)) != 0,
+  };
+  // Reject keys with bits that don't correspond to any option.
+  if (options.ToKey() != key) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 template <typename PipelineT>
 static std::unique_ptr<PipelineT> CreateDefaultPipeline(
     const Context& context) {
@@ -250,7 +292,10 @@ ContentContext::ContentContext(
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
                                : std::move(render_target_allocator)),
-      host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())) {
+      host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())),
+      gaussian_blur_cache_(std::make_unique<GaussianBlurCache>(
+          context_->GetResourceAllocator())),
+      gradient_cache_(std::make_unique<GradientCache>()) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -350,6 +395,7 @@ ContentContext::ContentContext(
     porter_duff_blend_pipelines_.CreateDefault(*context_, options_trianglestrip,
                                                {supports_decal});
     vertices_uber_shader_.CreateDefault(*context_, options, {supports_decal});
+    vertex_color_fill_pipelines_.CreateDefault(*context_, options);
   }
 
   if (context_->GetCapabilities()->SupportsFramebufferFetch()) {
@@ -461,7 +507,15 @@ ContentContext::ContentContext(
   }
 #endif  // IMPELLER_ENABLE_OPENGLES
 
+  VisitVariants([](const char* name, auto& container) {
+    container.SetUsageName(name);
+  });
+
   is_valid_ = true;
+  usage_record_ = context_->GetPipelineUsageRecord();
+  if (usage_record_) {
+    PrewarmRecordedVariants();
+  }
   InitializeCommonlyUsedShadersIfNeeded();
 }
 
@@ -543,6 +597,19 @@ fml::StatusOr<RenderTarget> ContentContext::MakeSubpass(
   return subpass_target;
 }
 
+GaussianBlurCache& ContentContext::GetGaussianBlurCache() const {
+  return *gaussian_blur_cache_;
+}
+
+GradientCache& ContentContext::GetGradientCache() const {
+  return *gradient_cache_;
+}
+
+void ContentContext::EndFrame() {
+  gaussian_blur_cache_->End();
+  gradient_cache_->End();
+}
+
 std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
@@ -585,6 +652,123 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+template <typename Visitor>
+void ContentContext::VisitVariants(Visitor&& visitor) {
+  visitor("SolidFill", solid_fill_pipelines_);
+  visitor("FastGradient", fast_gradient_pipelines_);
+  visitor("VertexColorFill", vertex_color_fill_pipelines_);
+  visitor("LinearGradientFill", linear_gradient_fill_pipelines_);
+  visitor("RadialGradientFill", radial_gradient_fill_pipelines_);
+  visitor("ConicalGradientFill", conical_gradient_fill_pipelines_);
+  visitor("SweepGradientFill", sweep_gradient_fill_pipelines_);
+  visitor("LinearGradientSSBOFill", linear_gradient_ssbo_fill_pipelines_);
+  visitor("RadialGradientSSBOFill", radial_gradient_ssbo_fill_pipelines_);
+  visitor("ConicalGradientSSBOFill", conical_gradient_ssbo_fill_pipelines_);
+  visitor("SweepGradientSSBOFill", sweep_gradient_ssbo_fill_pipelines_);
+  visitor("RRectBlur", rrect_blur_pipelines_);
+  visitor("Texture", texture_pipelines_);
+  visitor("TextureDownsample", texture_downsample_pipelines_);
+  visitor("TextureStrictSrc", texture_strict_src_pipelines_);
+#ifdef IMPELLER_ENABLE_OPENGLES
+  visitor("TiledTextureExternal", tiled_texture_external_pipelines_);
+#endif  // IMPELLER_ENABLE_OPENGLES
+  visitor("TiledTexture", tiled_texture_pipelines_);
+  visitor("GaussianBlur", gaussian_blur_pipelines_);
+  visitor("BorderMaskBlur", border_mask_blur_pipelines_);
+  visitor("MorphologyFilter", morphology_filter_pipelines_);
+  visitor("ColorMatrixColorFilter", color_matrix_color_filter_pipelines_);
+  visitor("LinearToSrgbFilter", linear_to_srgb_filter_pipelines_);
+  visitor("SrgbToLinearFilter", srgb_to_linear_filter_pipelines_);
+  visitor("Clip", clip_pipelines_);
+  visitor("GlyphAtlas", glyph_atlas_pipelines_);
+  visitor("YUVToRGBFilter", yuv_to_rgb_filter_pipelines_);
+  visitor("PorterDuffBlend", porter_duff_blend_pipelines_);
+  visitor("BlendColor", blend_color_pipelines_);
+  visitor("BlendColorBurn", blend_colorburn_pipelines_);
+  visitor("BlendColorDodge", blend_colordodge_pipelines_);
+  visitor("BlendDarken", blend_darken_pipelines_);
+  visitor("BlendDifference", blend_difference_pipelines_);
+  visitor("BlendExclusion", blend_exclusion_pipelines_);
+  visitor("BlendHardLight", blend_hardlight_pipelines_);
+  visitor("BlendHue", blend_hue_pipelines_);
+  visitor("BlendLighten", blend_lighten_pipelines_);
+  visitor("BlendLuminosity", blend_luminosity_pipelines_);
+  visitor("BlendMultiply", blend_multiply_pipelines_);
+  visitor("BlendOverlay", blend_overlay_pipelines_);
+  visitor("BlendSaturation", blend_saturation_pipelines_);
+  visitor("BlendScreen", blend_screen_pipelines_);
+  visitor("BlendSoftLight", blend_softlight_pipelines_);
+  visitor("FramebufferBlendColor", framebuffer_blend_color_pipelines_);
+  visitor("FramebufferBlendColorBurn", framebuffer_blend_colorburn_pipelines_);
+  visitor("FramebufferBlendColorDodge",
+          framebuffer_blend_colordodge_pipelines_);
+  visitor("FramebufferBlendDarken", framebuffer_blend_darken_pipelines_);
+  visitor("FramebufferBlendDifference",
+          framebuffer_blend_difference_pipelines_);
+  visitor("FramebufferBlendExclusion", framebuffer_blend_exclusion_pipelines_);
+  visitor("FramebufferBlendHardLight", framebuffer_blend_hardlight_pipelines_);
+  visitor("FramebufferBlendHue", framebuffer_blend_hue_pipelines_);
+  visitor("FramebufferBlendLighten", framebuffer_blend_lighten_pipelines_);
+  visitor("FramebufferBlendLuminosity",
+          framebuffer_blend_luminosity_pipelines_);
+  visitor("FramebufferBlendMultiply", framebuffer_blend_multiply_pipelines_);
+  visitor("FramebufferBlendOverlay", framebuffer_blend_overlay_pipelines_);
+  visitor("FramebufferBlendSaturation",
+          framebuffer_blend_saturation_pipelines_);
+  visitor("FramebufferBlendScreen", framebuffer_blend_screen_pipelines_);
+  visitor("FramebufferBlendSoftLight", framebuffer_blend_softlight_pipelines_);
+  visitor("VerticesUberShader", vertices_uber_shader_);
+}
+
+void ContentContext::PrewarmRecordedVariants() {
+  TRACE_EVENT0("flutter", "ContentContext::PrewarmRecordedVariants");
+  std::unordered_map<std::string_view,
+                     std::function<bool(const ContentContextOptions&)>>
+      prewarm_callbacks;
+  VisitVariants([&](const char* name, auto& container) {
+    prewarm_callbacks[name] = [this,
+                               &container](const ContentContextOptions& opts) {
+      return PrewarmVariant(container, opts);
+    };
+  });
+  for (const auto& entry : usage_record_->GetEntries()) {
+    auto callback = prewarm_callbacks.find(entry.pipeline_name);
+    if (callback == prewarm_callbacks.end()) {
+      continue;
+    }
+    auto opts = ContentContextOptions::FromKey(entry.variant_key);
+    // Wireframe variants are only used for debugging.
+    if (!opts.has_value() || opts->wireframe) {
+      continue;
+    }
+    if (callback->second(opts.value())) {
+      prewarmed_pipeline_count_++;
+    }
+  }
+}
+
+template <class RenderPipelineHandleT>
+bool ContentContext::PrewarmVariant(Variants<RenderPipelineHandleT>& container,
+                                    const ContentContextOptions& opts) const {
+  if (container.Get(opts)) {
+    return false;
+  }
+  // Variants without a default aren't supported by this device.
+  RenderPipelineHandleT* default_handle = container.GetDefault();
+  if (!default_handle) {
+    return false;
+  }
+  std::optional<PipelineDescriptor> desc = default_handle->GetDescriptor();
+  if (!desc.has_value()) {
+    return false;
+  }
+  opts.ApplyToPipelineDescriptor(desc.value());
+  desc->SetLabel(SPrintF("%s V#%zu", desc->GetLabel().c_str(),
+                         container.GetPipelineCount()));
+  container.Set(opts, std::make_unique<RenderPipelineHandleT>(*context_, desc));
+  return true;
+}
+
 void ContentContext::InitializeCommonlyUsedShadersIfNeeded() const {
   TRACE_EVENT0("flutter", "InitializeCommonlyUsedShadersIfNeeded");
   GetContext()->InitializeCommonlyUsedShadersIfNeeded();
@@ -19,6 +19,7 @@
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_usage_record.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/typographer_context.h"
@@ -54,6 +55,7 @@
 #include "impeller/entity/texture_fill_strict_src.frag.h"
 #include "impeller/entity/texture_uv_fill.vert.h"
 #include "impeller/entity/tiled_texture_fill.frag.h"
+#include "impeller/entity/vertex_color_fill.frag.h"
 #include "impeller/entity/yuv_to_rgb_filter.frag.h"
 
 #include "impeller/entity/conical_gradient_ssbo_fill.frag.h"
@@ -77,6 +79,9 @@ namespace impeller {
 
 using FastGradientPipeline =
     RenderPipelineHandle<FastGradientVertexShader, FastGradientFragmentShader>;
+using VertexColorFillPipeline =
+    RenderPipelineHandle<FastGradientVertexShader,
+                         VertexColorFillFragmentShader>;
 using LinearGradientFillPipeline =
     RenderPipelineHandle<GradientFillVertexShader,
                          LinearGradientFillFragmentShader>;
@@ -358,10 +363,20 @@ struct ContentContextOptions {
   };
 
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
+
+  /// A key that identifies these options and that is stable across launches
+  /// of the same engine version. Used to persist which variants were used.
+  uint64_t ToKey() const { return Hash{}(*this); }
+
+  /// The options identified by a key created by |ToKey|, or std::nullopt if
+  /// the key was not created by a compatible engine version.
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
 };
 
 class Tessellator;
 class RenderTargetCache;
+class GaussianBlurCache;
+class GradientCache;
 
 class ContentContext {
  public:
@@ -381,6 +396,11 @@ class ContentContext {
     return GetPipeline(fast_gradient_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetVertexColorFillPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(vertex_color_fill_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetLinearGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(linear_gradient_fill_pipelines_, opts);
@@ -746,12 +766,38 @@ class ContentContext {
   void ClearCachedRuntimeEffectPipeline(
       const std::string& unique_entrypoint_name) const;
 
+  /// The number of pipeline variants that were created ahead of their first
+  /// use because they were recorded as used by a previous launch.
+  ///
+  /// See also:
+  ///  - impeller::Context::GetPipelineUsageRecord
+  size_t GetPrewarmedPipelineCount() const { return prewarmed_pipeline_count_; }
+
   /// @brief Retrieve the currnent host buffer for transient storage.
   ///
   /// This is only safe to use from the raster threads. Other threads should
   /// allocate their own device buffers.
   HostBuffer& GetTransientsBuffer() const { return *host_buffer_; }
 
+  /// @brief Retrieve the cache of Gaussian blur kernels and results.
+  ///
+  /// Like the transients buffer, this is only safe to use from the raster
+  /// threads.
+  GaussianBlurCache& GetGaussianBlurCache() const;
+
+  /// @brief Retrieve the cache of gradient textures and stop buffers.
+  ///
+  /// Like the transients buffer, this is only safe to use from the raster
+  /// threads.
+  GradientCache& GetGradientCache() const;
+
+  /// @brief Mark the end of a frame rendered to a surface.
+  ///
+  /// Ends the frame of the caches that are kept across frames. Unlike the
+  /// render target cache, which is started and ended by each canvas, this is
+  /// called once per frame, when the transients buffer is reset.
+  void EndFrame();
+
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
@@ -848,8 +894,14 @@ class ContentContext {
 
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
+    /// The name that identifies the variants in the pipeline usage record.
+    void SetUsageName(const char* name) { usage_name_ = name; }
+
+    const char* GetUsageName() const { return usage_name_; }
+
    private:
     std::optional<ContentContextOptions> default_options_;
+    const char* usage_name_ = nullptr;
     std::unordered_map<ContentContextOptions,
                        std::unique_ptr<PipelineHandleT>,
                        ContentContextOptions::Hash,
@@ -867,6 +919,7 @@ class ContentContext {
 
   mutable Variants<SolidFillPipeline> solid_fill_pipelines_;
   mutable Variants<FastGradientPipeline> fast_gradient_pipelines_;
+  mutable Variants<VertexColorFillPipeline> vertex_color_fill_pipelines_;
   mutable Variants<LinearGradientFillPipeline> linear_gradient_fill_pipelines_;
   mutable Variants<RadialGradientFillPipeline> radial_gradient_fill_pipelines_;
   mutable Variants<ConicalGradientFillPipeline>
@@ -997,15 +1050,36 @@ class ContentContext {
     std::unique_ptr<RenderPipelineHandleT> variant =
         std::make_unique<RenderPipelineHandleT>(std::move(variant_future));
     container.Set(opts, std::move(variant));
+    if (usage_record_ && container.GetUsageName() && !wireframe_) {
+      usage_record_->Record(container.GetUsageName(), opts.ToKey());
+    }
     return container.Get(opts);
   }
 
+  /// Create the variants that were recorded as used by a previous launch, in
+  /// the order in which they were first used. The pipelines are compiled
+  /// asynchronously by the backend.
+  void PrewarmRecordedVariants();
+
+  /// Invokes |visitor| with a stable name and each of the variant
+  /// containers. The names identify the containers in the usage record.
+  template <typename Visitor>
+  void VisitVariants(Visitor&& visitor);
+
+  template <class RenderPipelineHandleT>
+  bool PrewarmVariant(Variants<RenderPipelineHandleT>& container,
+                      const ContentContextOptions& opts) const;
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
+  std::unique_ptr<GaussianBlurCache> gaussian_blur_cache_;
+  std::unique_ptr<GradientCache> gradient_cache_;
   std::shared_ptr<Texture> empty_texture_;
   bool wireframe_ = false;
+  std::shared_ptr<PipelineUsageRecord> usage_record_;
+  size_t prewarmed_pipeline_count_ = 0u;
 
   ContentContext(const ContentContext&) = delete;
 
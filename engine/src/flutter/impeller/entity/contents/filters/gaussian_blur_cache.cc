@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/gaussian_blur_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+bool GaussianBlurCache::ResultKey::operator==(const ResultKey& other) const {
+  return width_address_mode == other.width_address_mode &&
+         height_address_mode == other.height_address_mode &&
+         mip_filter == other.mip_filter && tile_mode == other.tile_mode &&
+         scaled_sigma == other.scaled_sigma &&
+         downsample_size == other.downsample_size &&
+         downsample_uvs == other.downsample_uvs &&
+         effective_scalar == other.effective_scalar;
+}
+
+std::size_t GaussianBlurCache::BlurParametersHash::operator()(
+    const BlurParameters& parameters) const {
+  return fml::HashCombine(parameters.blur_uv_offset.x,
+                          parameters.blur_uv_offset.y, parameters.blur_sigma,
+                          parameters.blur_radius, parameters.step_size);
+}
+
+bool GaussianBlurCache::BlurParametersEqual::operator()(
+    const BlurParameters& a,
+    const BlurParameters& b) const {
+  return a.blur_uv_offset == b.blur_uv_offset &&
+         a.blur_sigma == b.blur_sigma && a.blur_radius == b.blur_radius &&
+         a.step_size == b.step_size;
+}
+
+GaussianBlurCache::GaussianBlurCache(std::shared_ptr<Allocator> allocator)
+    : render_target_allocator_(std::move(allocator)) {}
+
+GaussianBlurCache::~GaussianBlurCache() = default;
+
+GaussianBlurCache::KernelSamples GaussianBlurCache::GetKernelSamples(
+    const BlurParameters& parameters) {
+  auto found = kernels_.find(parameters);
+  if (found != kernels_.end()) {
+    statistics_.kernel_hit_count++;
+    return found->second;
+  }
+  statistics_.kernel_miss_count++;
+  if (kernels_.size() >= kMaxKernelCount) {
+    kernels_.clear();
+  }
+  return kernels_
+      .emplace(parameters, LerpHackKernelSamples(GenerateBlurInfo(parameters)))
+      .first->second;
+}
+
+bool GaussianBlurCache::CanCacheInput(const Texture& texture) {
+  const TextureDescriptor& desc = texture.GetTextureDescriptor();
+  if (desc.type == TextureType::kTextureExternalOES) {
+    return false;
+  }
+  return !(desc.usage & TextureUsage::kRenderTarget) &&
+         !(desc.usage & TextureUsage::kShaderWrite);
+}
+
+void GaussianBlurCache::SetResultCachingEnabled(bool enabled) {
+  result_caching_enabled_ = enabled;
+  if (!enabled) {
+    results_.clear();
+    candidates_.clear();
+    free_targets_.clear();
+  }
+}
+
+bool GaussianBlurCache::IsResultCachingEnabled() const {
+  return result_caching_enabled_;
+}
+
+GaussianBlurCache::Lookup GaussianBlurCache::GetResult(
+    const std::shared_ptr<Texture>& input,
+    const ResultKey& key) {
+  if (!result_caching_enabled_ || !input) {
+    return {};
+  }
+  for (ResultEntry& entry : results_) {
+    // An expired input locks to null, so a new texture that happens to be
+    // allocated at the same address never matches it.
+    if (entry.input.lock() == input && entry.key == key) {
+      entry.used_this_frame = true;
+      statistics_.result_hit_count++;
+      return {.texture = entry.target.GetRenderTargetTexture()};
+    }
+  }
+  statistics_.result_miss_count++;
+
+  // Most blurs of immutable inputs are drawn once, or change every frame
+  // while they animate. Only those that are requested again unchanged are
+  // worth a target of their own.
+  for (CandidateEntry& candidate : candidates_) {
+    if (candidate.input.lock() == input && candidate.key == key) {
+      candidate.requested_this_frame = true;
+      return {.should_cache = true};
+    }
+  }
+  if (candidates_.size() >= kMaxCandidateCount) {
+    candidates_.erase(candidates_.begin());
+  }
+  candidates_.push_back(CandidateEntry{.input = input, .key = key});
+  return {};
+}
+
+RenderTarget GaussianBlurCache::CreateResultTarget(const Context& context,
+                                                   ISize size) {
+  for (auto it = free_targets_.begin(); it != free_targets_.end(); ++it) {
+    if (it->GetRenderTargetSize() == size) {
+      RenderTarget target = std::move(*it);
+      free_targets_.erase(it);
+      return target;
+    }
+  }
+  if (context.GetCapabilities()->SupportsOffscreenMSAA()) {
+    return render_target_allocator_.CreateOffscreenMSAA(
+        context, size, /*mip_count=*/1, "Gaussian Blur Cache Offscreen",
+        RenderTarget::kDefaultColorAttachmentConfigMSAA,
+        /*stencil_attachment_config=*/std::nullopt);
+  }
+  return render_target_allocator_.CreateOffscreen(
+      context, size, /*mip_count=*/1, "Gaussian Blur Cache Offscreen",
+      RenderTarget::kDefaultColorAttachmentConfig,
+      /*stencil_attachment_config=*/std::nullopt);
+}
+
+void GaussianBlurCache::SetResult(const std::shared_ptr<Texture>& input,
+                                  const ResultKey& key,
+                                  RenderTarget target) {
+  if (!result_caching_enabled_ || !input || !target.IsValid()) {
+    return;
+  }
+  candidates_.erase(
+      std::remove_if(candidates_.begin(), candidates_.end(),
+                     [&](const CandidateEntry& candidate) {
+                       return candidate.input.lock() == input &&
+                              candidate.key == key;
+                     }),
+      candidates_.end());
+  if (results_.size() >= kMaxResultCount) {
+    // Results used during this frame may still be drawn, so their targets
+    // can't be handed out again.
+    auto unused = std::find_if(
+        results_.begin(), results_.end(),
+        [](const ResultEntry& entry) { return !entry.used_this_frame; });
+    if (unused == results_.end()) {
+      return;
+    }
+    free_targets_.push_back(std::move(unused->target));
+    results_.erase(unused);
+  }
+  results_.push_back(ResultEntry{
+      .input = input,
+      .key = key,
+      .target = std::move(target),
+  });
+}
+
+size_t GaussianBlurCache::GetResultCount() const {
+  return results_.size();
+}
+
+const GaussianBlurCache::Statistics& GaussianBlurCache::GetStatistics() const {
+  return statistics_;
+}
+
+void GaussianBlurCache::End() {
+  // Targets that weren't reused during the frame are released, and those of
+  // the results evicted now are kept for the next frame.
+  free_targets_.clear();
+  auto evicted = std::stable_partition(
+      results_.begin(), results_.end(), [](const ResultEntry& entry) {
+        return entry.used_this_frame && !entry.input.expired();
+      });
+  for (auto it = evicted; it != results_.end(); ++it) {
+    free_targets_.push_back(std::move(it->target));
+  }
+  results_.erase(evicted, results_.end());
+  for (ResultEntry& entry : results_) {
+    entry.used_this_frame = false;
+  }
+
+  candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(),
+                                   [](const CandidateEntry& candidate) {
+                                     return !candidate.requested_this_frame ||
+                                            candidate.input.expired();
+                                   }),
+                    candidates_.end());
+  for (CandidateEntry& candidate : candidates_) {
+    candidate.requested_this_frame = false;
+  }
+
+  FML_TRACE_COUNTER("impeller", "GaussianBlurCache",                //
+                    reinterpret_cast<int64_t>(this),                //
+                    "KernelHits", statistics_.kernel_hit_count,     //
+                    "KernelMisses", statistics_.kernel_miss_count,  //
+                    "ResultHits", statistics_.result_hit_count,     //
+                    "ResultMisses", statistics_.result_miss_count);
+  statistics_ = {};
+}
+
+}  // namespace impeller
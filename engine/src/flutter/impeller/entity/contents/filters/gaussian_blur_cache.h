@@ -0,0 +1,203 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_CACHE_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/core/allocator.h"
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/size.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the work done by `GaussianBlurFilterContents` so that
+///             it can be reused by the blurs in later frames.
+///
+///             Two things are cached:
+///
+///             * The kernel samples for a set of `BlurParameters`. These only
+///               depend on the parameters, so they are always safe to reuse.
+///
+///             * The output of the blur passes for an input texture. A blur
+///               result only depends on the contents of its input, so it is
+///               only cached for inputs that can't be rendered to (decoded
+///               images, for example). A result is only cached once it has
+///               been requested again unchanged, and results that aren't used
+///               during a frame are evicted at the end of the frame.
+///
+///             The cache is owned by the `ContentContext` and, like the
+///             transients buffer, may only be used on the raster thread.
+///
+class GaussianBlurCache {
+ public:
+  using KernelSamples = GaussianBlurPipeline::FragmentShader::KernelSamples;
+
+  /// Everything, other than the identity of the input texture, that the
+  /// pixels output by the blur passes depend on.
+  ///
+  /// Where the output is drawn is not part of the key, so translating or
+  /// scrolling a blurred image still finds its result.
+  struct ResultKey {
+    /// The sampler the input snapshot asked to be sampled with.
+    SamplerAddressMode width_address_mode = SamplerAddressMode::kClampToEdge;
+    SamplerAddressMode height_address_mode = SamplerAddressMode::kClampToEdge;
+    MipFilter mip_filter = MipFilter::kBase;
+    Entity::TileMode tile_mode = Entity::TileMode::kDecal;
+    /// Sigma in source space, after the entity scale and the effect transform
+    /// are applied.
+    Vector2 scaled_sigma;
+    /// The size of the down-sampled output.
+    ISize downsample_size;
+    /// The region of the input that is down-sampled.
+    Quad downsample_uvs;
+    Vector2 effective_scalar;
+
+    bool operator==(const ResultKey& other) const;
+  };
+
+  struct Lookup {
+    /// The cached output of the blur passes, or null if there is none.
+    std::shared_ptr<Texture> texture;
+    /// Whether a missing result was already requested unchanged, in which
+    /// case it should be rendered into a target from `CreateResultTarget` and
+    /// passed to `SetResult`.
+    bool should_cache = false;
+  };
+
+  /// Counts of the lookups since the end of the last frame.
+  struct Statistics {
+    size_t kernel_hit_count = 0u;
+    size_t kernel_miss_count = 0u;
+    size_t result_hit_count = 0u;
+    size_t result_miss_count = 0u;
+  };
+
+  /// The most kernels the cache will hold. The cache is emptied when it is
+  /// full, which only happens with continuously animating blurs.
+  static constexpr size_t kMaxKernelCount = 64u;
+
+  /// The most blur results the cache will hold. Adding a result to a full
+  /// cache evicts the oldest one that wasn't used during the frame.
+  static constexpr size_t kMaxResultCount = 8u;
+
+  /// The most missed requests the cache remembers while waiting for them to
+  /// be repeated.
+  static constexpr size_t kMaxCandidateCount = 16u;
+
+  explicit GaussianBlurCache(std::shared_ptr<Allocator> allocator);
+
+  ~GaussianBlurCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The same as `LerpHackKernelSamples(GenerateBlurInfo(...))`,
+  ///             computed only once for each set of parameters.
+  ///
+  KernelSamples GetKernelSamples(const BlurParameters& parameters);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the result of blurring the given texture may be
+  ///             cached, which is only the case for textures whose contents
+  ///             can't change without the texture being replaced.
+  ///
+  static bool CanCacheInput(const Texture& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether blur results are cached. Kernels are always cached.
+  ///             Disabling result caching empties the cache.
+  ///
+  void SetResultCachingEnabled(bool enabled);
+
+  bool IsResultCachingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Look up the result of blurring the input texture, marking
+  ///             it as used during this frame. A miss is remembered until the
+  ///             end of the next frame so that repeating it can be detected.
+  ///
+  Lookup GetResult(const std::shared_ptr<Texture>& input,
+                   const ResultKey& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a render target for a blur result that will be passed
+  ///             to `SetResult`.
+  ///
+  ///             Targets from the `RenderTargetCache` are recycled once they
+  ///             haven't been used for a frame, so results are rendered into
+  ///             targets that are owned by this cache instead. The targets of
+  ///             evicted results are reused for a frame before being released.
+  ///
+  RenderTarget CreateResultTarget(const Context& context, ISize size);
+
+  void SetResult(const std::shared_ptr<Texture>& input,
+                 const ResultKey& key,
+                 RenderTarget target);
+
+  size_t GetResultCount() const;
+
+  const Statistics& GetStatistics() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. Evicts the results that weren't used
+  ///             during the frame, reports the statistics for the frame to the
+  ///             timeline and resets them.
+  ///
+  ///             Called once per frame by `ContentContext::EndFrame`.
+  ///
+  void End();
+
+ private:
+  struct BlurParametersHash {
+    std::size_t operator()(const BlurParameters& parameters) const;
+  };
+
+  struct BlurParametersEqual {
+    bool operator()(const BlurParameters& a, const BlurParameters& b) const;
+  };
+
+  struct ResultEntry {
+    std::weak_ptr<Texture> input;
+    ResultKey key;
+    RenderTarget target;
+    bool used_this_frame = true;
+  };
+
+  struct CandidateEntry {
+    std::weak_ptr<Texture> input;
+    ResultKey key;
+    bool requested_this_frame = true;
+  };
+
+  RenderTargetAllocator render_target_allocator_;
+  std::unordered_map<BlurParameters,
+                     KernelSamples,
+                     BlurParametersHash,
+                     BlurParametersEqual>
+      kernels_;
+  std::vector<ResultEntry> results_;
+  std::vector<CandidateEntry> candidates_;
+  // The targets of evicted results, which are released at the end of the
+  // frame after they were evicted unless they are reused.
+  std::vector<RenderTarget> free_targets_;
+  bool result_caching_enabled_ = true;
+  Statistics statistics_;
+
+  GaussianBlurCache(const GaussianBlurCache&) = delete;
+
+  GaussianBlurCache& operator=(const GaussianBlurCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_CACHE_H_
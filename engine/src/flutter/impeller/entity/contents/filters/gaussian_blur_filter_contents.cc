@@ -9,6 +9,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/gaussian_blur_cache.h"
 #include "impeller/entity/texture_downsample.frag.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
@@ -482,8 +483,9 @@ fml::StatusOr<RenderTarget> MakeBlurSubpass(
         GaussianBlurVertexShader::BindFrameInfo(
             pass, host_buffer.EmplaceUniform(frame_info));
         GaussianBlurFragmentShader::BindKernelSamples(
-            pass, host_buffer.EmplaceUniform(
-                      LerpHackKernelSamples(GenerateBlurInfo(blur_info))));
+            pass,
+            host_buffer.EmplaceUniform(
+                renderer.GetGaussianBlurCache().GetKernelSamples(blur_info)));
         return pass.Draw().ok();
       };
   if (destination_target.has_value()) {
@@ -496,6 +498,27 @@ fml::StatusOr<RenderTarget> MakeBlurSubpass(
   }
 }
 
+/// Positions the output of the blur passes relative to the entity.
+Entity MakeBlurOutputEntity(const Entity& entity,
+                            const Snapshot& input_snapshot,
+                            const std::shared_ptr<Texture>& blur_texture,
+                            Vector2 source_space_scalar,
+                            const Matrix& downsample_transform,
+                            Vector2 effective_scalar) {
+  SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
+      MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
+
+  return Entity::FromSnapshot(
+      Snapshot{.texture = blur_texture,
+               .transform = entity.GetTransform() *                         //
+                            Matrix::MakeScale(1.f / source_space_scalar) *  //
+                            downsample_transform *                          //
+                            Matrix::MakeScale(1 / effective_scalar),
+               .sampler_descriptor = sampler_desc,
+               .opacity = input_snapshot.opacity},
+      entity.GetBlendMode());
+}
+
 int ScaleBlurRadius(Scalar radius, Scalar scalar) {
   return static_cast<int>(std::round(radius * scalar));
 }
@@ -723,6 +746,47 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return result;
   }
 
+  DownsamplePassArgs downsample_pass_args = CalculateDownsamplePassArgs(
+      blur_info.scaled_sigma, blur_info.padding, input_snapshot.value(),
+      source_expanded_coverage_hint, inputs[0], snapshot_entity);
+
+  // Blurring an input whose contents can't change gives the same result every
+  // frame, so reuse the result from an earlier frame if there is one. Only
+  // the placement of the result depends on the transforms, so the key holds
+  // what the blur passes are given rather than the transforms.
+  GaussianBlurCache& blur_cache = renderer.GetGaussianBlurCache();
+  std::optional<GaussianBlurCache::ResultKey> result_key;
+  if (blur_cache.IsResultCachingEnabled() &&
+      GaussianBlurCache::CanCacheInput(*input_snapshot->texture)) {
+    GaussianBlurCache::ResultKey key = {
+        .width_address_mode =
+            input_snapshot->sampler_descriptor.width_address_mode,
+        .height_address_mode =
+            input_snapshot->sampler_descriptor.height_address_mode,
+        .mip_filter = input_snapshot->sampler_descriptor.mip_filter,
+        .tile_mode = tile_mode_,
+        .scaled_sigma = blur_info.scaled_sigma,
+        .downsample_size = downsample_pass_args.subpass_size,
+        .downsample_uvs = downsample_pass_args.uvs,
+        .effective_scalar = downsample_pass_args.effective_scalar,
+    };
+    GaussianBlurCache::Lookup lookup =
+        blur_cache.GetResult(input_snapshot->texture, key);
+    if (lookup.texture) {
+      Entity blur_output_entity = MakeBlurOutputEntity(
+          entity, input_snapshot.value(), lookup.texture,
+          blur_info.source_space_scalar, downsample_pass_args.transform,
+          downsample_pass_args.effective_scalar);
+      return ApplyBlurStyle(mask_blur_style_, entity, inputs[0],
+                            input_snapshot.value(),
+                            std::move(blur_output_entity), mask_geometry_,
+                            blur_info.source_space_scalar);
+    }
+    if (lookup.should_cache) {
+      result_key = key;
+    }
+  }
+
   // Note: The code below uses three different command buffers when it would be
   // possible to combine the operations into a single buffer. From testing and
   // user bug reports (see https://github.com/flutter/flutter/issues/154046 ),
@@ -735,10 +799,6 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  DownsamplePassArgs downsample_pass_args = CalculateDownsamplePassArgs(
-      blur_info.scaled_sigma, blur_info.padding, input_snapshot.value(),
-      source_expanded_coverage_hint, inputs[0], snapshot_entity);
-
   fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleSubpass(
       renderer, command_buffer_1, input_snapshot->texture,
       input_snapshot->sampler_descriptor, downsample_pass_args, tile_mode_);
@@ -781,11 +841,24 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
+  std::optional<RenderTarget> pass3_destination;
+  if (result_key.has_value()) {
+    // Results that will be cached can't be rendered into the targets of the
+    // render target cache since those are reused by later frames.
+    RenderTarget result_target = blur_cache.CreateResultTarget(
+        *renderer.GetContext(), pass1_out.value().GetRenderTargetSize());
+    if (result_target.IsValid()) {
+      pass3_destination = std::move(result_target);
+    } else {
+      result_key = std::nullopt;
+    }
+  }
   // Only ping pong if the first pass actually created a render target.
-  auto pass3_destination = pass2_out.value().GetRenderTargetTexture() !=
-                                   pass1_out.value().GetRenderTargetTexture()
-                               ? std::optional<RenderTarget>(pass1_out.value())
-                               : std::optional<RenderTarget>(std::nullopt);
+  if (!pass3_destination.has_value() &&
+      pass2_out.value().GetRenderTargetTexture() !=
+          pass1_out.value().GetRenderTargetTexture()) {
+    pass3_destination = pass1_out.value();
+  }
 
   fml::StatusOr<RenderTarget> pass3_out = MakeBlurSubpass(
       renderer, command_buffer_3, /*input_pass=*/pass2_out.value(),
@@ -819,19 +892,20 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
              (pass2_out.value().GetRenderTargetSize() ==
               pass3_out.value().GetRenderTargetSize()));
 
-  SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
-      MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
+  const std::shared_ptr<Texture>& blur_texture =
+      pass3_out.value().GetRenderTargetTexture();
+  // The last pass returns its input when there is nothing to blur, in which
+  // case the result is in a target that will be reused.
+  if (result_key.has_value() &&
+      blur_texture == pass3_destination->GetRenderTargetTexture()) {
+    blur_cache.SetResult(input_snapshot->texture, result_key.value(),
+                         pass3_destination.value());
+  }
 
-  Entity blur_output_entity = Entity::FromSnapshot(
-      Snapshot{.texture = pass3_out.value().GetRenderTargetTexture(),
-               .transform =
-                   entity.GetTransform() *                                   //
-                   Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
-                   downsample_pass_args.transform *                          //
-                   Matrix::MakeScale(1 / downsample_pass_args.effective_scalar),
-               .sampler_descriptor = sampler_desc,
-               .opacity = input_snapshot->opacity},
-      entity.GetBlendMode());
+  Entity blur_output_entity = MakeBlurOutputEntity(
+      entity, input_snapshot.value(), blur_texture,
+      blur_info.source_space_scalar, downsample_pass_args.transform,
+      downsample_pass_args.effective_scalar);
 
   return ApplyBlurStyle(mask_blur_style_, entity, inputs[0],
                         input_snapshot.value(), std::move(blur_output_entity),
@@ -6,6 +6,7 @@
 #include "fml/status_or.h"
 #include "gmock/gmock.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/gaussian_blur_cache.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity_playground.h"
@@ -107,6 +108,40 @@ class GaussianBlurFilterContentsTest : public EntityPlayground {
     }
     return nullptr;
   }
+
+  /// Create a texture that can only be sampled, like a decoded image.
+  std::shared_ptr<Texture> MakeImmutableTexture(ISize size) {
+    TextureDescriptor desc;
+    desc.storage_mode = StorageMode::kDevicePrivate;
+    desc.format = PixelFormat::kR8G8B8A8UNormInt;
+    desc.size = size;
+    desc.usage = TextureUsage::kShaderRead;
+    return GetContentContext()
+        ->GetContext()
+        ->GetResourceAllocator()
+        ->CreateTexture(desc);
+  }
+
+  /// Render a blur of the texture the way a canvas would. The frame of the
+  /// blur cache is left to the caller to end.
+  static std::optional<Entity> RenderBlurFrame(
+      const std::shared_ptr<ContentContext>& renderer,
+      const std::shared_ptr<Texture>& texture,
+      Scalar sigma,
+      const Matrix& transform = {}) {
+    auto contents = std::make_unique<GaussianBlurFilterContents>(
+        sigma, sigma, Entity::TileMode::kDecal,
+        FilterContents::BlurStyle::kNormal, /*mask_geometry=*/nullptr);
+    contents->SetInputs({FilterInput::Make(texture)});
+    Entity entity;
+    entity.SetTransform(transform);
+    renderer->GetRenderTargetCache()->Start();
+    std::optional<Entity> result =
+        contents->GetEntity(*renderer, entity, /*coverage_hint=*/{});
+    renderer->GetRenderTargetCache()->End();
+    renderer->GetTransientsBuffer().Reset();
+    return result;
+  }
 };
 INSTANTIATE_PLAYGROUND_SUITE(GaussianBlurFilterContentsTest);
 
@@ -632,5 +667,187 @@ TEST(GaussianBlurFilterContentsTest, ChopHugeBlurs) {
   EXPECT_TRUE(frag_kernel_samples.sample_count <= kGaussianBlurMaxKernelSize);
 }
 
+TEST(GaussianBlurFilterContentsTest, KernelSamplesAreCached) {
+  GaussianBlurCache cache(/*allocator=*/nullptr);
+  BlurParameters parameters = {.blur_uv_offset = Point(0.01, 0),
+                               .blur_sigma = 6.0f,
+                               .blur_radius = 18,
+                               .step_size = 1};
+  GaussianBlurPipeline::FragmentShader::KernelSamples expected =
+      LerpHackKernelSamples(GenerateBlurInfo(parameters));
+
+  for (int i = 0; i < 3; i++) {
+    GaussianBlurCache::KernelSamples samples =
+        cache.GetKernelSamples(parameters);
+    ASSERT_EQ(samples.sample_count, expected.sample_count);
+    for (int j = 0; j < expected.sample_count; j++) {
+      EXPECT_EQ(samples.sample_data[j], expected.sample_data[j]);
+    }
+  }
+  EXPECT_EQ(cache.GetStatistics().kernel_miss_count, 1u);
+  EXPECT_EQ(cache.GetStatistics().kernel_hit_count, 2u);
+
+  parameters.blur_uv_offset = Point(0, 0.01);
+  cache.GetKernelSamples(parameters);
+  EXPECT_EQ(cache.GetStatistics().kernel_miss_count, 2u);
+
+  cache.End();
+  EXPECT_EQ(cache.GetStatistics().kernel_miss_count, 0u);
+  EXPECT_EQ(cache.GetStatistics().kernel_hit_count, 0u);
+}
+
+TEST_P(GaussianBlurFilterContentsTest, BlurOfImmutableTextureIsCached) {
+  std::shared_ptr<Texture> texture = MakeImmutableTexture(ISize(100, 100));
+  ASSERT_TRUE(texture);
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  GaussianBlurCache& cache = renderer->GetGaussianBlurCache();
+
+  // A blur that is only requested once isn't worth a target of its own.
+  std::optional<Entity> first =
+      RenderBlurFrame(renderer, texture, /*sigma=*/10.0f);
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(cache.GetStatistics().result_miss_count, 1u);
+  EXPECT_EQ(cache.GetResultCount(), 0u);
+  cache.End();
+
+  // Requesting it again unchanged caches it.
+  ASSERT_TRUE(RenderBlurFrame(renderer, texture, /*sigma=*/10.0f).has_value());
+  EXPECT_EQ(cache.GetStatistics().result_miss_count, 1u);
+  EXPECT_EQ(cache.GetResultCount(), 1u);
+  cache.End();
+
+  std::optional<Entity> third =
+      RenderBlurFrame(renderer, texture, /*sigma=*/10.0f);
+  ASSERT_TRUE(third.has_value());
+  EXPECT_EQ(cache.GetStatistics().result_hit_count, 1u);
+  EXPECT_EQ(cache.GetStatistics().result_miss_count, 0u);
+  EXPECT_EQ(cache.GetResultCount(), 1u);
+  EXPECT_TRUE(RectNear(first->GetCoverage().value(),
+                       third->GetCoverage().value()));
+
+  // A different sigma is a different result.
+  RenderBlurFrame(renderer, texture, /*sigma=*/20.0f);
+  EXPECT_EQ(cache.GetStatistics().result_miss_count, 1u);
+  EXPECT_EQ(cache.GetResultCount(), 1u);
+  cache.End();
+}
+
+TEST_P(GaussianBlurFilterContentsTest, TranslatedBlurOfImmutableTextureHits) {
+  std::shared_ptr<Texture> texture = MakeImmutableTexture(ISize(100, 100));
+  ASSERT_TRUE(texture);
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  GaussianBlurCache& cache = renderer->GetGaussianBlurCache();
+
+  std::optional<Entity> untranslated;
+  for (int i = 0; i < 2; i++) {
+    untranslated = RenderBlurFrame(renderer, texture, /*sigma=*/10.0f);
+    ASSERT_TRUE(untranslated.has_value());
+    cache.End();
+  }
+  ASSERT_EQ(cache.GetResultCount(), 1u);
+
+  // Scrolling the blurred image moves the result without re-rendering it.
+  std::optional<Entity> translated =
+      RenderBlurFrame(renderer, texture, /*sigma=*/10.0f,
+                      Matrix::MakeTranslation({30, 40, 0}));
+  ASSERT_TRUE(translated.has_value());
+  EXPECT_EQ(cache.GetStatistics().result_hit_count, 1u);
+  EXPECT_EQ(cache.GetStatistics().result_miss_count, 0u);
+  EXPECT_TRUE(RectNear(untranslated->GetCoverage().value().Shift(30, 40),
+                       translated->GetCoverage().value()));
+  cache.End();
+}
+
+TEST_P(GaussianBlurFilterContentsTest, UnusedBlurResultsAreEvicted) {
+  std::shared_ptr<Texture> texture = MakeImmutableTexture(ISize(100, 100));
+  ASSERT_TRUE(texture);
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  GaussianBlurCache& cache = renderer->GetGaussianBlurCache();
+
+  for (int i = 0; i < 2; i++) {
+    RenderBlurFrame(renderer, texture, /*sigma=*/10.0f);
+    cache.End();
+  }
+  EXPECT_EQ(cache.GetResultCount(), 1u);
+
+  // Not used during this frame.
+  cache.End();
+  EXPECT_EQ(cache.GetResultCount(), 0u);
+
+  RenderBlurFrame(renderer, texture, /*sigma=*/10.0f);
+  RenderBlurFrame(renderer, texture, /*sigma=*/10.0f);
+  EXPECT_EQ(cache.GetResultCount(), 1u);
+  texture.reset();
+  cache.End();
+  EXPECT_EQ(cache.GetResultCount(), 0u);
+}
+
+TEST_P(GaussianBlurFilterContentsTest, EvictedResultTargetsAreReused) {
+  std::shared_ptr<Texture> texture = MakeImmutableTexture(ISize(100, 100));
+  ASSERT_TRUE(texture);
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  const Context& context = *renderer->GetContext();
+  GaussianBlurCache cache(context.GetResourceAllocator());
+  GaussianBlurCache::ResultKey key = {.scaled_sigma = Vector2(10, 10)};
+
+  RenderTarget target = cache.CreateResultTarget(context, ISize(50, 50));
+  ASSERT_TRUE(target.IsValid());
+  std::shared_ptr<Texture> target_texture = target.GetRenderTargetTexture();
+  cache.SetResult(texture, key, std::move(target));
+  EXPECT_EQ(cache.GetResult(texture, key).texture, target_texture);
+  cache.End();
+
+  // Not used during this frame, so its target is free for the next one.
+  cache.End();
+  EXPECT_EQ(cache.GetResultCount(), 0u);
+  EXPECT_EQ(
+      cache.CreateResultTarget(context, ISize(50, 50)).GetRenderTargetTexture(),
+      target_texture);
+}
+
+TEST_P(GaussianBlurFilterContentsTest, BlurOfRenderTargetIsNotCached) {
+  std::shared_ptr<Texture> texture = MakeTexture(ISize(100, 100));
+  ASSERT_TRUE(texture);
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  GaussianBlurCache& cache = renderer->GetGaussianBlurCache();
+
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(
+        RenderBlurFrame(renderer, texture, /*sigma=*/10.0f).has_value());
+    EXPECT_EQ(cache.GetStatistics().result_hit_count, 0u);
+    EXPECT_EQ(cache.GetStatistics().result_miss_count, 0u);
+    EXPECT_EQ(cache.GetResultCount(), 0u);
+    cache.End();
+  }
+}
+
+TEST_P(GaussianBlurFilterContentsTest, RepeatedBlurFramesHitResultCache) {
+  std::shared_ptr<Texture> texture = MakeImmutableTexture(ISize(1024, 1024));
+  ASSERT_TRUE(texture);
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  GaussianBlurCache& cache = renderer->GetGaussianBlurCache();
+  static constexpr int kFrameCount = 10;
+
+  cache.SetResultCachingEnabled(false);
+  for (int i = 0; i < kFrameCount; i++) {
+    ASSERT_TRUE(
+        RenderBlurFrame(renderer, texture, /*sigma=*/30.0f).has_value());
+    EXPECT_EQ(cache.GetStatistics().result_hit_count, 0u);
+    cache.End();
+  }
+  EXPECT_EQ(cache.GetResultCount(), 0u);
+
+  // Only the first two frames render the blur passes.
+  cache.SetResultCachingEnabled(true);
+  for (int i = 0; i < kFrameCount; i++) {
+    ASSERT_TRUE(
+        RenderBlurFrame(renderer, texture, /*sigma=*/30.0f).has_value());
+    EXPECT_EQ(cache.GetStatistics().result_hit_count, i < 2 ? 0u : 1u);
+    EXPECT_EQ(cache.GetStatistics().result_miss_count, i < 2 ? 1u : 0u);
+    cache.End();
+  }
+  EXPECT_EQ(cache.GetResultCount(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
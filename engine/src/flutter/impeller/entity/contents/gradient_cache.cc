@@ -0,0 +1,193 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/gradient_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/platform.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+GradientCache::GradientCache(size_t byte_budget) : byte_budget_(byte_budget) {}
+
+GradientCache::~GradientCache() = default;
+
+size_t GradientCache::Hash(Kind kind,
+                           const std::vector<Color>& colors,
+                           const std::vector<Scalar>& stops) {
+  size_t hash = fml::HashCombine(static_cast<int>(kind), colors.size());
+  for (const Color& color : colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue, color.alpha);
+  }
+  for (Scalar stop : stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
+GradientCache::Entry* GradientCache::Find(Kind kind,
+                                          const std::vector<Color>& colors,
+                                          const std::vector<Scalar>& stops) {
+  auto [begin, end] = index_.equal_range(Hash(kind, colors, stops));
+  for (auto it = begin; it != end; ++it) {
+    EntryList::iterator entry = it->second;
+    if (entry->kind == kind && entry->colors == colors &&
+        entry->stops == stops) {
+      entry->last_used_frame = frame_;
+      entries_.splice(entries_.begin(), entries_, entry);
+      return &*entry;
+    }
+  }
+  return nullptr;
+}
+
+void GradientCache::Insert(Entry entry) {
+  entry.last_used_frame = frame_;
+  byte_size_ += entry.byte_size;
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().hash, entries_.begin());
+  EvictToBudget();
+}
+
+void GradientCache::Evict(EntryList::iterator entry) {
+  auto [begin, end] = index_.equal_range(entry->hash);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second == entry) {
+      index_.erase(it);
+      break;
+    }
+  }
+  byte_size_ -= entry->byte_size;
+  entries_.erase(entry);
+}
+
+void GradientCache::EvictToBudget() {
+  while (byte_size_ > byte_budget_ && !entries_.empty()) {
+    Evict(std::prev(entries_.end()));
+  }
+}
+
+std::shared_ptr<Texture> GradientCache::GetGradientTexture(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<Context>& context) {
+  if (Entry* entry = Find(Kind::kTexture, colors, stops)) {
+    statistics_.texture_hit_count++;
+    return entry->texture;
+  }
+  statistics_.texture_miss_count++;
+
+  std::shared_ptr<Texture> texture =
+      CreateGradientTexture(CreateGradientBuffer(colors, stops), context);
+  if (!texture) {
+    return nullptr;
+  }
+  Insert(Entry{
+      .kind = Kind::kTexture,
+      .hash = Hash(Kind::kTexture, colors, stops),
+      .colors = colors,
+      .stops = stops,
+      .texture = texture,
+      .byte_size =
+          texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel(),
+  });
+  return texture;
+}
+
+BufferView GradientCache::GetStopBuffer(const std::vector<Color>& colors,
+                                        const std::vector<Scalar>& stops,
+                                        Allocator& allocator,
+                                        HostBuffer& host_buffer) {
+  Entry* entry = Find(Kind::kStopBuffer, colors, stops);
+  if (entry && entry->buffer) {
+    statistics_.stop_buffer_hit_count++;
+    return DeviceBuffer::AsBufferView(entry->buffer);
+  }
+  statistics_.stop_buffer_miss_count++;
+
+  std::vector<StopData> stop_data = CreateGradientColors(colors, stops);
+  if (stop_data.empty()) {
+    return {};
+  }
+  const size_t byte_size = stop_data.size() * sizeof(StopData);
+
+  // Remember the first request without allocating anything, so that the stops
+  // of an animated gradient are only ever written to the transients buffer.
+  if (!entry) {
+    Insert(Entry{
+        .kind = Kind::kStopBuffer,
+        .hash = Hash(Kind::kStopBuffer, colors, stops),
+        .colors = colors,
+        .stops = stops,
+    });
+    return host_buffer.Emplace(stop_data.data(), byte_size,
+                               DefaultUniformAlignment());
+  }
+
+  std::shared_ptr<DeviceBuffer> buffer = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(stop_data.data()), byte_size);
+  if (!buffer) {
+    return {};
+  }
+  buffer->SetLabel("GradientStops");
+  entry->buffer = buffer;
+  entry->byte_size = byte_size;
+  byte_size_ += byte_size;
+  EvictToBudget();
+  return DeviceBuffer::AsBufferView(std::move(buffer));
+}
+
+void GradientCache::SetByteBudget(size_t byte_budget) {
+  byte_budget_ = byte_budget;
+  EvictToBudget();
+}
+
+size_t GradientCache::GetByteBudget() const {
+  return byte_budget_;
+}
+
+size_t GradientCache::GetByteSize() const {
+  return byte_size_;
+}
+
+size_t GradientCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+const GradientCache::Statistics& GradientCache::GetStatistics() const {
+  return statistics_;
+}
+
+void GradientCache::End() {
+  // Entries are ordered by recency, so the stale ones are all at the back.
+  while (!entries_.empty() &&
+         frame_ - entries_.back().last_used_frame >= kMaxUnusedFrameCount) {
+    Evict(std::prev(entries_.end()));
+  }
+  // Stop data that was requested once and not again in this frame is most
+  // likely from an animated gradient, so stop tracking it.
+  for (auto entry = entries_.begin(); entry != entries_.end();) {
+    auto next = std::next(entry);
+    if (entry->kind == Kind::kStopBuffer && !entry->buffer &&
+        entry->last_used_frame != frame_) {
+      Evict(entry);
+    }
+    entry = next;
+  }
+  frame_++;
+
+  FML_TRACE_COUNTER("impeller", "GradientCache",                             //
+                    reinterpret_cast<int64_t>(this),                         //
+                    "TextureHits", statistics_.texture_hit_count,            //
+                    "TextureMisses", statistics_.texture_miss_count,         //
+                    "StopBufferHits", statistics_.stop_buffer_hit_count,     //
+                    "StopBufferMisses", statistics_.stop_buffer_miss_count,  //
+                    "Bytes", byte_size_);
+  statistics_ = {};
+}
+
+}  // namespace impeller
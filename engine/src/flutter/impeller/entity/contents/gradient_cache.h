@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_GRADIENT_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_GRADIENT_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/core/buffer_view.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/color.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Caches the device resources that the gradient contents create
+///             from their colors and stops.
+///
+///             Two kinds of resources are cached, both keyed by the contents
+///             of the colors and stops rather than by the gradient that asked
+///             for them:
+///
+///             * The host visible textures created by `CreateGradientTexture`
+///               for the gradient fill pipelines.
+///
+///             * The device buffers holding the `StopData` created by
+///               `CreateGradientColors` for the SSBO gradient fill pipelines.
+///               The stop data of a gradient is only written to a device
+///               buffer the second time it is requested. Until then it is
+///               written to the transients buffer, so that animated
+///               gradients, whose stops change every frame, don't allocate
+///               a device buffer per frame.
+///
+///             Neither resource is written to after it is created, so the
+///             same one may be used by any number of draws in any number of
+///             frames. Entries that haven't been used for
+///             `kMaxUnusedFrameCount` frames are evicted at the end of a
+///             frame, and the least recently used entries are evicted when
+///             the cache grows past its byte budget.
+///
+///             The cache is owned by the `ContentContext` and, like the
+///             transients buffer, may only be used on the raster thread.
+///
+class GradientCache {
+ public:
+  /// Counts of the lookups since the end of the last frame.
+  struct Statistics {
+    size_t texture_hit_count = 0u;
+    size_t texture_miss_count = 0u;
+    size_t stop_buffer_hit_count = 0u;
+    size_t stop_buffer_miss_count = 0u;
+  };
+
+  /// The number of bytes of textures and buffers the cache holds by default.
+  static constexpr size_t kDefaultByteBudget = 4u * 1024u * 1024u;
+
+  /// The number of consecutive frames an entry may go unused before it is
+  /// evicted.
+  static constexpr size_t kMaxUnusedFrameCount = 60u;
+
+  explicit GradientCache(size_t byte_budget = kDefaultByteBudget);
+
+  ~GradientCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The same as
+  ///             `CreateGradientTexture(CreateGradientBuffer(...), context)`,
+  ///             created only once for each set of colors and stops.
+  ///
+  /// @return     The texture, or nullptr if it could not be created.
+  ///
+  std::shared_ptr<Texture> GetGradientTexture(
+      const std::vector<Color>& colors,
+      const std::vector<Scalar>& stops,
+      const std::shared_ptr<Context>& context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A buffer containing the same `StopData` as
+  ///             `CreateGradientColors(...)`, created only once for each set
+  ///             of colors and stops.
+  ///
+  ///             The buffer holds one `StopData` for each stop. The first
+  ///             time a set of colors and stops is requested, the stop data
+  ///             is emplaced in `host_buffer`. If it is requested again
+  ///             before the end of the next frame, it is copied to a device
+  ///             buffer from `allocator` that is kept in the cache.
+  ///
+  /// @return     The buffer, or an invalid view if it could not be created.
+  ///
+  BufferView GetStopBuffer(const std::vector<Color>& colors,
+                           const std::vector<Scalar>& stops,
+                           Allocator& allocator,
+                           HostBuffer& host_buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Change the byte budget, evicting the least recently used
+  ///             entries until the cache fits in it.
+  ///
+  void SetByteBudget(size_t byte_budget);
+
+  size_t GetByteBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes of textures and buffers in the cache.
+  ///
+  size_t GetByteSize() const;
+
+  size_t GetEntryCount() const;
+
+  const Statistics& GetStatistics() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. Evicts the entries that have gone
+  ///             unused for too long, reports the statistics for the frame
+  ///             to the timeline and resets them.
+  ///
+  ///             Called once per frame by `ContentContext::EndFrame`.
+  ///
+  void End();
+
+ private:
+  enum class Kind {
+    kTexture,
+    kStopBuffer,
+  };
+
+  struct Entry {
+    Kind kind;
+    size_t hash;
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+    std::shared_ptr<Texture> texture;
+    // Null for stop data that has only been requested once.
+    std::shared_ptr<DeviceBuffer> buffer;
+    size_t byte_size = 0u;
+    size_t last_used_frame = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  size_t byte_budget_;
+  size_t byte_size_ = 0u;
+  size_t frame_ = 0u;
+  // Ordered from the most to the least recently used.
+  EntryList entries_;
+  std::unordered_multimap<size_t, EntryList::iterator> index_;
+  Statistics statistics_;
+
+  static size_t Hash(Kind kind,
+                     const std::vector<Color>& colors,
+                     const std::vector<Scalar>& stops);
+
+  Entry* Find(Kind kind,
+              const std::vector<Color>& colors,
+              const std::vector<Scalar>& stops);
+
+  void Insert(Entry entry);
+
+  void Evict(EntryList::iterator entry);
+
+  void EvictToBudget();
+
+  GradientCache(const GradientCache&) = delete;
+
+  GradientCache& operator=(const GradientCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_GRADIENT_CACHE_H_
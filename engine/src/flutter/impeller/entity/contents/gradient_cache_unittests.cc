@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <vector>
+
+#include "impeller/entity/contents/gradient_cache.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/entity_playground.h"
+#include "third_party/googletest/googletest/include/gtest/gtest.h"
+
+namespace impeller {
+namespace testing {
+
+using EntityTest = EntityPlayground;
+
+namespace {
+const std::vector<Color> kColors = {Color::Red(), Color::Blue()};
+const std::vector<Scalar> kStops = {0.0f, 1.0f};
+}  // namespace
+
+TEST_P(EntityTest, GradientCacheSharesTexturesOfIdenticalGradients) {
+  GradientCache cache;
+
+  auto texture = cache.GetGradientTexture(kColors, kStops, GetContext());
+  ASSERT_NE(texture, nullptr);
+  EXPECT_EQ(cache.GetGradientTexture(kColors, kStops, GetContext()), texture);
+  EXPECT_EQ(cache.GetStatistics().texture_hit_count, 1u);
+  EXPECT_EQ(cache.GetStatistics().texture_miss_count, 1u);
+
+  auto other = cache.GetGradientTexture({Color::Red(), Color::Green()}, kStops,
+                                        GetContext());
+  ASSERT_NE(other, nullptr);
+  EXPECT_NE(other, texture);
+  EXPECT_EQ(cache.GetStatistics().texture_miss_count, 2u);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(),
+            texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel() +
+                other->GetTextureDescriptor().GetByteSizeOfBaseMipLevel());
+}
+
+TEST_P(EntityTest, GradientCacheSharesStopBuffersOfIdenticalGradients) {
+  GradientCache cache;
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  // The first request is only written to the host buffer.
+  auto transient =
+      cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer);
+  ASSERT_TRUE(transient);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+
+  auto buffer = cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer);
+  ASSERT_TRUE(buffer);
+  EXPECT_NE(buffer.buffer, transient.buffer);
+  auto cached = cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer);
+  EXPECT_EQ(cached.buffer, buffer.buffer);
+  EXPECT_EQ(cache.GetStatistics().stop_buffer_hit_count, 1u);
+  EXPECT_EQ(cache.GetStatistics().stop_buffer_miss_count, 2u);
+
+  // Textures and stop buffers for the same gradient are separate entries.
+  ASSERT_NE(cache.GetGradientTexture(kColors, kStops, GetContext()), nullptr);
+  EXPECT_EQ(cache.GetStatistics().texture_miss_count, 1u);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  auto expected = CreateGradientColors(kColors, kStops);
+  for (const BufferView& view : {transient, buffer}) {
+    ASSERT_EQ(view.range.length, expected.size() * sizeof(StopData));
+    EXPECT_EQ(std::memcmp(view.buffer->OnGetContents() + view.range.offset,
+                          expected.data(), view.range.length),
+              0);
+  }
+}
+
+TEST_P(EntityTest, GradientCacheOnlyKeepsStopBuffersRequestedAgain) {
+  const size_t entry_size = kStops.size() * sizeof(StopData);
+  GradientCache cache;
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  // A gradient drawn once, like a frame of an animated gradient, is forgotten
+  // at the end of the next frame.
+  ASSERT_TRUE(cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer));
+  cache.End();
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  cache.End();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+
+  // A gradient drawn on consecutive frames is kept in a device buffer.
+  ASSERT_TRUE(cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer));
+  cache.End();
+  ASSERT_TRUE(cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer));
+  EXPECT_EQ(cache.GetByteSize(), entry_size);
+  cache.End();
+  cache.End();
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_TRUE(cache.GetStopBuffer(kColors, kStops, allocator, *host_buffer));
+  EXPECT_EQ(cache.GetStatistics().stop_buffer_hit_count, 1u);
+}
+
+TEST_P(EntityTest, GradientCacheEvictsUnusedGradients) {
+  GradientCache cache;
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  auto get_stop_buffer = [&](const std::vector<Scalar>& stops) {
+    return cache.GetStopBuffer(kColors, stops, allocator, *host_buffer);
+  };
+
+  // Request each gradient twice so that it is kept in a device buffer.
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_TRUE(get_stop_buffer(kStops));
+    ASSERT_TRUE(get_stop_buffer({0.0f, 0.5f}));
+  }
+  for (size_t i = 0; i < GradientCache::kMaxUnusedFrameCount; i++) {
+    // Keep one of the gradients in use.
+    ASSERT_TRUE(get_stop_buffer(kStops));
+    cache.End();
+    EXPECT_EQ(cache.GetStatistics().stop_buffer_hit_count, 0u);
+  }
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  cache.End();
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_TRUE(get_stop_buffer(kStops));
+  EXPECT_EQ(cache.GetStatistics().stop_buffer_hit_count, 1u);
+}
+
+TEST_P(EntityTest, GradientCacheEvictsLeastRecentlyUsedGradientsOverBudget) {
+  const size_t entry_size = kStops.size() * sizeof(StopData);
+  GradientCache cache(/*byte_budget=*/2u * entry_size);
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  auto get_stop_buffer = [&](const std::vector<Scalar>& stops) {
+    return cache.GetStopBuffer(kColors, stops, allocator, *host_buffer);
+  };
+
+  const std::vector<Scalar> other_stops = {0.0f, 0.5f};
+  const std::vector<Scalar> third_stops = {0.5f, 1.0f};
+  // Each gradient is kept in a device buffer from its second request on.
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_TRUE(get_stop_buffer(kStops));
+    ASSERT_TRUE(get_stop_buffer(other_stops));
+  }
+  // Make the first gradient the most recently used one.
+  ASSERT_TRUE(get_stop_buffer(kStops));
+  ASSERT_TRUE(get_stop_buffer(third_stops));
+  ASSERT_TRUE(get_stop_buffer(third_stops));
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(), 2u * entry_size);
+
+  ASSERT_TRUE(get_stop_buffer(kStops));
+  EXPECT_EQ(cache.GetStatistics().stop_buffer_hit_count, 2u);
+  ASSERT_TRUE(get_stop_buffer(other_stops));
+  EXPECT_EQ(cache.GetStatistics().stop_buffer_miss_count, 7u);
+
+  cache.SetByteBudget(0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
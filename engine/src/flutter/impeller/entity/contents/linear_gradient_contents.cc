@@ -6,7 +6,7 @@
 
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/content_context.h"
-#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/contents/gradient_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/scalar.h"
@@ -217,9 +217,8 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   return ColorSourceContents::DrawGeometry<VS>(
       renderer, entity, pass, pipeline_callback, frame_info,
       [this, &renderer, &entity](RenderPass& pass) {
-        auto gradient_data = CreateGradientBuffer(colors_, stops_);
-        auto gradient_texture =
-            CreateGradientTexture(gradient_data, renderer.GetContext());
+        auto gradient_texture = renderer.GetGradientCache().GetGradientTexture(
+            colors_, stops_, renderer.GetContext());
         if (gradient_texture == nullptr) {
           return false;
         }
@@ -292,13 +291,13 @@ bool LinearGradientContents::RenderSSBO(const ContentContext& renderer,
         frag_info.inverse_dot_start_to_end =
             CalculateInverseDotStartToEnd(start_point_, end_point_);
 
-        auto& host_buffer = renderer.GetTransientsBuffer();
-        auto colors = CreateGradientColors(colors_, stops_);
-
-        frag_info.colors_length = colors.size();
-        auto color_buffer =
-            host_buffer.Emplace(colors.data(), colors.size() * sizeof(StopData),
-                                DefaultUniformAlignment());
+        frag_info.colors_length = stops_.size();
+        auto color_buffer = renderer.GetGradientCache().GetStopBuffer(
+            colors_, stops_, *renderer.GetContext()->GetResourceAllocator(),
+            renderer.GetTransientsBuffer());
+        if (!color_buffer) {
+          return false;
+        }
 
         pass.SetCommandLabel("LinearGradientSSBOFill");
 
@@ -6,7 +6,7 @@
 
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
-#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/contents/gradient_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/gradient.h"
@@ -89,13 +89,13 @@ bool RadialGradientContents::RenderSSBO(const ContentContext& renderer,
             GetOpacityFactor() *
             GetGeometry()->ComputeAlphaCoverage(entity.GetTransform());
 
-        auto& host_buffer = renderer.GetTransientsBuffer();
-        auto colors = CreateGradientColors(colors_, stops_);
-
-        frag_info.colors_length = colors.size();
-        auto color_buffer =
-            host_buffer.Emplace(colors.data(), colors.size() * sizeof(StopData),
-                                DefaultUniformAlignment());
+        frag_info.colors_length = stops_.size();
+        auto color_buffer = renderer.GetGradientCache().GetStopBuffer(
+            colors_, stops_, *renderer.GetContext()->GetResourceAllocator(),
+            renderer.GetTransientsBuffer());
+        if (!color_buffer) {
+          return false;
+        }
 
         pass.SetCommandLabel("RadialGradientSSBOFill");
         FS::BindFragInfo(
@@ -112,9 +112,8 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = RadialGradientFillPipeline::VertexShader;
   using FS = RadialGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientCache().GetGradientTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
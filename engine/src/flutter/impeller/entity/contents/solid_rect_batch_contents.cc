@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+SolidRectBatchContents::SolidRectBatchContents() = default;
+
+SolidRectBatchContents::~SolidRectBatchContents() = default;
+
+bool SolidRectBatchContents::CanBatchTransform(const Matrix& transform) {
+  return !transform.HasPerspective();
+}
+
+bool SolidRectBatchContents::AddRect(const Matrix& transform,
+                                     const Rect& rect,
+                                     Color color) {
+  FML_DCHECK(CanBatchTransform(transform));
+  if (IsFull()) {
+    return false;
+  }
+  // Empty rectangles don't draw anything.
+  if (rect.IsEmpty()) {
+    return true;
+  }
+  if (vertices_.empty()) {
+    vertices_.reserve(6u * 64u);
+  }
+
+  auto points = rect.GetTransformedPoints(transform);
+  vertices_.push_back({points[0], color});
+  vertices_.push_back({points[1], color});
+  vertices_.push_back({points[2], color});
+  vertices_.push_back({points[1], color});
+  vertices_.push_back({points[2], color});
+  vertices_.push_back({points[3], color});
+
+  bounds_ = Rect::Union(bounds_, Rect::MakePointBounds(points.begin(),
+                                                       points.end()));
+  return true;
+}
+
+size_t SolidRectBatchContents::GetRectCount() const {
+  return vertices_.size() / 6u;
+}
+
+bool SolidRectBatchContents::IsFull() const {
+  return GetRectCount() >= kMaxRectCount;
+}
+
+const std::vector<SolidRectBatchContents::VS::PerVertexData>&
+SolidRectBatchContents::GetVertices() const {
+  return vertices_;
+}
+
+std::optional<Rect> SolidRectBatchContents::GetCoverage(
+    const Entity& entity) const {
+  if (!bounds_.has_value()) {
+    return std::nullopt;
+  }
+  return bounds_->TransformBounds(entity.GetTransform());
+}
+
+bool SolidRectBatchContents::Render(const ContentContext& renderer,
+                                    const Entity& entity,
+                                    RenderPass& pass) const {
+  if (vertices_.empty()) {
+    return true;
+  }
+  auto& host_buffer = renderer.GetTransientsBuffer();
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer =
+      host_buffer.Emplace(vertices_.data(),
+                          vertices_.size() * sizeof(VS::PerVertexData),
+                          alignof(VS::PerVertexData));
+  vertex_buffer.vertex_count = vertices_.size();
+  vertex_buffer.index_type = IndexType::kNone;
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+  // Every rectangle is drawn at the same depth, so writing it would make the
+  // later rectangles fail the depth test wherever they overlap the earlier
+  // ones.
+  options.depth_write_enabled = false;
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = entity.GetShaderTransform(pass);
+
+  pass.SetCommandLabel("Solid Rect Batch");
+  pass.SetPipeline(renderer.GetVertexColorFillPipeline(options));
+  pass.SetVertexBuffer(std::move(vertex_buffer));
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+  return pass.Draw().ok();
+}
+
+}  // namespace impeller
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_RECT_BATCH_CONTENTS_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_RECT_BATCH_CONTENTS_H_
+
+#include <optional>
+#include <vector>
+
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/fast_gradient.vert.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Draws many solid color rectangles, each with its own transform
+///             and color, with a single draw call.
+///
+///             The rectangles are transformed into the space of the entity
+///             when they are added and are drawn in the order in which they
+///             were added, so a batch of overlapping rectangles produces the
+///             same result as drawing each rectangle with its own
+///             `SolidColorContents` and source-over blending.
+///
+///             The batch never writes to the depth buffer, so every rectangle
+///             in it can share the clip depth of the entity without the later
+///             rectangles failing the depth test against the earlier ones.
+///
+class SolidRectBatchContents final : public Contents {
+ public:
+  using VS = FastGradientVertexShader;
+
+  /// The most rectangles a single batch will hold.
+  static constexpr size_t kMaxRectCount = 4096u;
+
+  SolidRectBatchContents();
+
+  ~SolidRectBatchContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a rectangle drawn with the given transform can be
+  ///             added to a batch.
+  ///
+  static bool CanBatchTransform(const Matrix& transform);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add a rectangle to the end of the batch.
+  ///
+  /// @param[in]  transform  The transform of the rectangle relative to the
+  ///                        entity that will render the batch. Must satisfy
+  ///                        `CanBatchTransform`.
+  /// @param[in]  rect       The rectangle.
+  /// @param[in]  color      The unpremultiplied color of the rectangle.
+  ///
+  /// @return     If the rectangle was added. Full batches reject rectangles.
+  ///
+  bool AddRect(const Matrix& transform, const Rect& rect, Color color);
+
+  size_t GetRectCount() const;
+
+  bool IsFull() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The triangle list, six vertices for each rectangle.
+  ///
+  const std::vector<VS::PerVertexData>& GetVertices() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  std::vector<VS::PerVertexData> vertices_;
+  std::optional<Rect> bounds_;
+
+  SolidRectBatchContents(const SolidRectBatchContents&) = delete;
+
+  SolidRectBatchContents& operator=(const SolidRectBatchContents&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_RECT_BATCH_CONTENTS_H_
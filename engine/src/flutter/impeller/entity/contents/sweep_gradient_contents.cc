@@ -7,7 +7,7 @@
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
-#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/contents/gradient_cache.h"
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/gradient.h"
 #include "impeller/renderer/render_pass.h"
@@ -98,13 +98,13 @@ bool SweepGradientContents::RenderSSBO(const ContentContext& renderer,
             GetOpacityFactor() *
             GetGeometry()->ComputeAlphaCoverage(entity.GetTransform());
 
-        auto& host_buffer = renderer.GetTransientsBuffer();
-        auto colors = CreateGradientColors(colors_, stops_);
-
-        frag_info.colors_length = colors.size();
-        auto color_buffer =
-            host_buffer.Emplace(colors.data(), colors.size() * sizeof(StopData),
-                                DefaultUniformAlignment());
+        frag_info.colors_length = stops_.size();
+        auto color_buffer = renderer.GetGradientCache().GetStopBuffer(
+            colors_, stops_, *renderer.GetContext()->GetResourceAllocator(),
+            renderer.GetTransientsBuffer());
+        if (!color_buffer) {
+          return false;
+        }
 
         pass.SetCommandLabel("SweepGradientSSBOFill");
 
@@ -122,9 +122,8 @@ bool SweepGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = SweepGradientFillPipeline::VertexShader;
   using FS = SweepGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientCache().GetGradientTexture(
+      colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
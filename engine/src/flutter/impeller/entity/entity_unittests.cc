@@ -2231,6 +2231,54 @@ TEST_P(EntityTest, ContentContextOptionsHasReasonableHashFunctions) {
   EXPECT_NE(hash_c, hash_d);
 }
 
+TEST_P(EntityTest, ContentContextOptionsCanRoundTripThroughKeys) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kLuminosity,
+      .depth_compare = CompareFunction::kGreaterEqual,
+      .stencil_mode =
+          ContentContextOptions::StencilMode::kOverdrawPreventionRestore,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB10G10R10A10XR,
+      .has_depth_stencil_attachments = false,
+      .depth_write_enabled = true,
+      .is_for_rrect_blur_clear = true,
+  };
+  auto round_trip = ContentContextOptions::FromKey(opts.ToKey());
+  ASSERT_TRUE(round_trip.has_value());
+  EXPECT_TRUE(ContentContextOptions::Equal{}(opts, round_trip.value()));
+
+  auto defaults =
+      ContentContextOptions::FromKey(ContentContextOptions{}.ToKey());
+  ASSERT_TRUE(defaults.has_value());
+  EXPECT_TRUE(ContentContextOptions::Equal{}(ContentContextOptions{},
+                                             defaults.value()));
+
+  // Keys from an incompatible version are rejected.
+  EXPECT_FALSE(ContentContextOptions::FromKey(opts.ToKey() | 1llu << 7));
+  EXPECT_FALSE(ContentContextOptions::FromKey(opts.ToKey() | 0xFFllu << 40));
+  EXPECT_FALSE(ContentContextOptions::FromKey(opts.ToKey() | 1llu << 63));
+}
+
+TEST_P(EntityTest, RecordedPipelineVariantsArePrewarmed) {
+  auto usage_record = GetContext()->GetPipelineUsageRecord();
+  if (!usage_record) {
+    GTEST_SKIP() << "The backend doesn't record pipeline usage.";
+  }
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kColorBurn,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat(),
+  };
+  usage_record->Record("SolidFill", opts.ToKey());
+
+  ContentContext content_context(GetContext(), TypographerContextSkia::Make());
+  ASSERT_TRUE(content_context.IsValid());
+  EXPECT_GE(content_context.GetPrewarmedPipelineCount(), 1u);
+  EXPECT_NE(content_context.GetSolidFillPipeline(opts), nullptr);
+}
+
 #ifdef FML_OS_LINUX
 TEST_P(EntityTest, FramebufferFetchVulkanBindingOffsetIsTheSame) {
   // Using framebuffer fetch on Vulkan requires that we maintain a subpass input
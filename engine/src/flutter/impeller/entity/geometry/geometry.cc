@@ -27,6 +27,8 @@ GeometryResult Geometry::ComputePositionGeometry(
     const Entity& entity,
     RenderPass& pass) {
   using VT = SolidFillVertexShader::PerVertexData;
+  static_assert(sizeof(VT) == sizeof(Point),
+                "The generator writes vertex positions directly.");
 
   size_t count = generator.GetVertexCount();
 
@@ -36,15 +38,10 @@ GeometryResult Geometry::ComputePositionGeometry(
           {
               .vertex_buffer = renderer.GetTransientsBuffer().Emplace(
                   count * sizeof(VT), alignof(VT),
-                  [&generator](uint8_t* buffer) {
-                    auto vertices = reinterpret_cast<VT*>(buffer);
-                    generator.GenerateVertices([&vertices](const Point& p) {
-                      *vertices++ = {
-                          .position = p,
-                      };
-                    });
-                    FML_DCHECK(vertices == reinterpret_cast<VT*>(buffer) +
-                                               generator.GetVertexCount());
+                  [&generator, count](uint8_t* buffer) {
+                    auto vertices = reinterpret_cast<Point*>(buffer);
+                    size_t written = generator.GenerateVertices(vertices);
+                    FML_DCHECK(written == count);
                   }),
               .vertex_count = count,
               .index_type = IndexType::kNone,
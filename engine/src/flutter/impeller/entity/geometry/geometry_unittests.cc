@@ -152,5 +152,46 @@ TEST(EntityGeometryTest, AlphaCoverageStrokePaths) {
   EXPECT_EQ(Geometry::MakeStrokePath({}, 40)->ComputeAlphaCoverage(matrix), 1);
 }
 
+TEST(EntityGeometryTest, StrokeVerticesForSingleLine) {
+  Path path = PathBuilder{}.MoveTo({0, 0}).LineTo({10, 0}).TakePath();
+  auto vertices = ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+      path.CreatePolyline(1.0f), /*stroke_width=*/2.0f, /*miter_limit=*/4.0f,
+      Join::kBevel, Cap::kButt, /*scale=*/1.0f);
+
+  std::vector<SolidFillVertexShader::PerVertexData> expected = {
+      // Start cap.
+      {.position = Point(0, 1)},
+      {.position = Point(0, -1)},
+      // Segment.
+      {.position = Point(0, 1)},
+      {.position = Point(0, -1)},
+      {.position = Point(10, 1)},
+      {.position = Point(10, -1)},
+      // End cap.
+      {.position = Point(10, 1)},
+      {.position = Point(10, -1)},
+  };
+  EXPECT_SOLID_VERTICES_NEAR(vertices, expected);
+}
+
+TEST(EntityGeometryTest, StrokeVertexCountForPolylineOfLines) {
+  static constexpr size_t kPointCount = 100u;
+  PathBuilder builder;
+  builder.MoveTo({0, 0});
+  for (size_t i = 1; i < kPointCount; i++) {
+    builder.LineTo({i * 10.0f, i % 2 == 0 ? 0.0f : 10.0f});
+  }
+  Path path = builder.TakePath();
+
+  auto vertices = ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+      path.CreatePolyline(1.0f), /*stroke_width=*/2.0f, /*miter_limit=*/4.0f,
+      Join::kBevel, Cap::kButt, /*scale=*/1.0f);
+
+  // Two vertices for each cap, four for each segment and three for each
+  // bevel join between segments.
+  EXPECT_EQ(vertices.size(),
+            2u + 4u * (kPointCount - 1) + 3u * (kPointCount - 2) + 2u);
+}
+
 }  // namespace testing
 }  // namespace impeller
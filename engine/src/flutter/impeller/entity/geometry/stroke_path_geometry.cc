@@ -4,6 +4,9 @@
 
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 
+#include <cmath>
+
+#include "flutter/fml/logging.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -11,55 +14,250 @@
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/separated_vector.h"
+#include "impeller/geometry/wangs_formula.h"
 
 namespace impeller {
 using VS = SolidFillVertexShader;
 
 namespace {
 
-template <typename VertexWriter>
-using CapProc = std::function<void(VertexWriter& vtx_builder,
-                                   const Point& position,
-                                   const Point& offset,
-                                   Scalar scale,
-                                   bool reverse)>;
+/// Counts the vertices of a stroke without writing them so that exactly
+/// enough memory for them can be reserved.
+class VertexCounter {
+ public:
+  void AppendVertex(const Point& point) { count_++; }
 
-template <typename VertexWriter>
-using JoinProc = std::function<void(VertexWriter& vtx_builder,
-                                    const Point& position,
-                                    const Point& start_offset,
-                                    const Point& end_offset,
-                                    Scalar miter_limit,
-                                    Scalar scale)>;
+  void AppendSegment(const Point& p0, const Point& p1, const Point& offset) {
+    count_ += 4;
+  }
+
+  size_t GetCount() const { return count_; }
 
+ private:
+  size_t count_ = 0u;
+};
+
+/// Writes the vertices of a stroke into memory that was reserved using the
+/// count from a |VertexCounter|.
 class PositionWriter {
  public:
+  PositionWriter(VS::PerVertexData* data, size_t capacity)
+      : data_(data), capacity_(capacity) {}
+
   void AppendVertex(const Point& point) {
-    data_.emplace_back(SolidFillVertexShader::PerVertexData{.position = point});
+    FML_DCHECK(count_ < capacity_);
+    data_[count_++].position = point;
   }
 
-  const std::vector<SolidFillVertexShader::PerVertexData>& GetData() const {
-    return data_;
+  /// Appends the four vertices of a straight segment of the stroke.
+  void AppendSegment(const Point& p0, const Point& p1, const Point& offset) {
+    FML_DCHECK(count_ + 4 <= capacity_);
+    VS::PerVertexData* vertices = data_ + count_;
+    vertices[0].position = p0 + offset;
+    vertices[1].position = p0 - offset;
+    vertices[2].position = p1 + offset;
+    vertices[3].position = p1 - offset;
+    count_ += 4;
   }
 
+  size_t GetCount() const { return count_; }
+
  private:
-  std::vector<SolidFillVertexShader::PerVertexData> data_ = {};
+  VS::PerVertexData* data_;
+  size_t capacity_;
+  size_t count_ = 0u;
 };
 
+/// Calls |proc| with the same points as
+/// |CubicPathComponent::ToLinearPathComponents| without the indirection of a
+/// |std::function|.
+template <typename PointProc>
+void ForEachLinearPoint(const CubicPathComponent& cubic,
+                        Scalar scale,
+                        const PointProc& proc) {
+  Scalar line_count = std::ceilf(ComputeCubicSubdivisions(scale, cubic));
+  for (size_t i = 1; i < line_count; i++) {
+    proc(cubic.Solve(i / line_count));
+  }
+  proc(cubic.p2);
+}
+
+template <typename VertexWriter>
+void CreateButtCap(VertexWriter& vtx_builder,
+                   const Point& position,
+                   const Point& offset,
+                   bool reverse) {
+  Point orientation = offset * (reverse ? -1 : 1);
+  VS::PerVertexData vtx;
+  vtx.position = position + orientation;
+  vtx_builder.AppendVertex(vtx.position);
+  vtx.position = position - orientation;
+  vtx_builder.AppendVertex(vtx.position);
+}
+
 template <typename VertexWriter>
+void CreateRoundCap(VertexWriter& vtx_builder,
+                    const Point& position,
+                    const Point& offset,
+                    Scalar scale,
+                    bool reverse) {
+  Point orientation = offset * (reverse ? -1 : 1);
+  Point forward(offset.y, -offset.x);
+  Point forward_normal = forward.Normalize();
+
+  CubicPathComponent arc;
+  if (reverse) {
+    arc = CubicPathComponent(
+        forward, forward + orientation * PathBuilder::kArcApproximationMagic,
+        orientation + forward * PathBuilder::kArcApproximationMagic,
+        orientation);
+  } else {
+    arc = CubicPathComponent(
+        orientation,
+        orientation + forward * PathBuilder::kArcApproximationMagic,
+        forward + orientation * PathBuilder::kArcApproximationMagic, forward);
+  }
+
+  Point vtx = position + orientation;
+  vtx_builder.AppendVertex(vtx);
+  vtx = position - orientation;
+  vtx_builder.AppendVertex(vtx);
+
+  ForEachLinearPoint(arc, scale, [&vtx_builder, &vtx, forward_normal,
+                                  position](const Point& point) {
+    vtx = position + point;
+    vtx_builder.AppendVertex(vtx);
+    vtx = position + (-point).Reflect(forward_normal);
+    vtx_builder.AppendVertex(vtx);
+  });
+}
+
+template <typename VertexWriter>
+void CreateSquareCap(VertexWriter& vtx_builder,
+                     const Point& position,
+                     const Point& offset,
+                     bool reverse) {
+  Point orientation = offset * (reverse ? -1 : 1);
+  Point forward(offset.y, -offset.x);
+
+  Point vtx = position + orientation;
+  vtx_builder.AppendVertex(vtx);
+  vtx = position - orientation;
+  vtx_builder.AppendVertex(vtx);
+  vtx = position + orientation + forward;
+  vtx_builder.AppendVertex(vtx);
+  vtx = position - orientation + forward;
+  vtx_builder.AppendVertex(vtx);
+}
+
+template <typename VertexWriter>
+Scalar CreateBevelAndGetDirection(VertexWriter& vtx_builder,
+                                  const Point& position,
+                                  const Point& start_offset,
+                                  const Point& end_offset) {
+  Point vtx = position;
+  vtx_builder.AppendVertex(vtx);
+
+  Scalar dir = start_offset.Cross(end_offset) > 0 ? -1 : 1;
+  vtx = position + start_offset * dir;
+  vtx_builder.AppendVertex(vtx);
+  vtx = position + end_offset * dir;
+  vtx_builder.AppendVertex(vtx);
+
+  return dir;
+}
+
+template <typename VertexWriter>
+void CreateMiterJoin(VertexWriter& vtx_builder,
+                     const Point& position,
+                     const Point& start_offset,
+                     const Point& end_offset,
+                     Scalar miter_limit) {
+  Point start_normal = start_offset.Normalize();
+  Point end_normal = end_offset.Normalize();
+
+  // 1 for no joint (straight line), 0 for max joint (180 degrees).
+  Scalar alignment = (start_normal.Dot(end_normal) + 1) / 2;
+  if (ScalarNearlyEqual(alignment, 1)) {
+    return;
+  }
+
+  Scalar direction = CreateBevelAndGetDirection(vtx_builder, position,
+                                                start_offset, end_offset);
+
+  Point miter_point = (((start_offset + end_offset) / 2) / alignment);
+  if (miter_point.GetDistanceSquared({0, 0}) > miter_limit * miter_limit) {
+    return;  // Convert to bevel when we exceed the miter limit.
+  }
+
+  // Outer miter point.
+  VS::PerVertexData vtx;
+  vtx.position = position + miter_point * direction;
+  vtx_builder.AppendVertex(vtx.position);
+}
+
+template <typename VertexWriter>
+void CreateRoundJoin(VertexWriter& vtx_builder,
+                     const Point& position,
+                     const Point& start_offset,
+                     const Point& end_offset,
+                     Scalar scale) {
+  Point start_normal = start_offset.Normalize();
+  Point end_normal = end_offset.Normalize();
+
+  // 0 for no joint (straight line), 1 for max joint (180 degrees).
+  Scalar alignment = 1 - (start_normal.Dot(end_normal) + 1) / 2;
+  if (ScalarNearlyEqual(alignment, 0)) {
+    return;
+  }
+
+  Scalar direction = CreateBevelAndGetDirection(vtx_builder, position,
+                                                start_offset, end_offset);
+
+  Point middle =
+      (start_offset + end_offset).Normalize() * start_offset.GetLength();
+  Point middle_normal = middle.Normalize();
+
+  Point middle_handle = middle + Point(-middle.y, middle.x) *
+                                     PathBuilder::kArcApproximationMagic *
+                                     alignment * direction;
+  Point start_handle = start_offset + Point(start_offset.y, -start_offset.x) *
+                                          PathBuilder::kArcApproximationMagic *
+                                          alignment * direction;
+
+  VS::PerVertexData vtx;
+  ForEachLinearPoint(
+      CubicPathComponent(start_offset, start_handle, middle_handle, middle),
+      scale, [&vtx_builder, direction, &vtx, position,
+              middle_normal](const Point& point) {
+        vtx.position = position + point * direction;
+        vtx_builder.AppendVertex(vtx.position);
+        vtx.position = position + (-point * direction).Reflect(middle_normal);
+        vtx_builder.AppendVertex(vtx.position);
+      });
+}
+
+template <typename VertexWriter>
+void CreateBevelJoin(VertexWriter& vtx_builder,
+                     const Point& position,
+                     const Point& start_offset,
+                     const Point& end_offset) {
+  CreateBevelAndGetDirection(vtx_builder, position, start_offset, end_offset);
+}
+
+/// Generates the triangle strip for a stroke. The cap and join styles are
+/// template parameters so that they are resolved when the generator is
+/// compiled rather than for every cap and join.
+template <typename VertexWriter, Join kJoin, Cap kCap>
 class StrokeGenerator {
  public:
   StrokeGenerator(const Path::Polyline& p_polyline,
                   const Scalar p_stroke_width,
                   const Scalar p_scaled_miter_limit,
-                  const JoinProc<VertexWriter>& p_join_proc,
-                  const CapProc<VertexWriter>& p_cap_proc,
                   const Scalar p_scale)
       : polyline(p_polyline),
         stroke_width(p_stroke_width),
         scaled_miter_limit(p_scaled_miter_limit),
-        join_proc(p_join_proc),
-        cap_proc(p_cap_proc),
         scale(p_scale) {}
 
   void Generate(VertexWriter& vtx_builder) {
@@ -73,10 +271,8 @@ class StrokeGenerator {
       auto contour_delta = contour_end_point_i - contour_start_point_i;
       if (contour_delta == 1) {
         Point p = polyline.GetPoint(contour_start_point_i);
-        cap_proc(vtx_builder, p, {-stroke_width * 0.5f, 0}, scale,
-                 /*reverse=*/false);
-        cap_proc(vtx_builder, p, {stroke_width * 0.5f, 0}, scale,
-                 /*reverse=*/false);
+        AddCap(vtx_builder, p, {-stroke_width * 0.5f, 0}, /*reverse=*/false);
+        AddCap(vtx_builder, p, {stroke_width * 0.5f, 0}, /*reverse=*/false);
         continue;
       } else if (contour_delta == 0) {
         continue;  // This contour has no renderable content.
@@ -114,8 +310,8 @@ class StrokeGenerator {
         Point cap_offset =
             Vector2(-contour.start_direction.y, contour.start_direction.x) *
             stroke_width * 0.5f;  // Counterclockwise normal
-        cap_proc(vtx_builder, polyline.GetPoint(contour_start_point_i),
-                 cap_offset, scale, /*reverse=*/true);
+        AddCap(vtx_builder, polyline.GetPoint(contour_start_point_i),
+               cap_offset, /*reverse=*/true);
       }
 
       for (size_t contour_component_i = 0;
@@ -147,12 +343,11 @@ class StrokeGenerator {
         auto cap_offset =
             Vector2(-contour.end_direction.y, contour.end_direction.x) *
             stroke_width * 0.5f;  // Clockwise normal
-        cap_proc(vtx_builder, polyline.GetPoint(contour_end_point_i - 1),
-                 cap_offset, scale, /*reverse=*/false);
+        AddCap(vtx_builder, polyline.GetPoint(contour_end_point_i - 1),
+               cap_offset, /*reverse=*/false);
       } else {
-        join_proc(vtx_builder, polyline.GetPoint(contour_start_point_i),
-                  offset.GetVector(), contour_first_offset, scaled_miter_limit,
-                  scale);
+        AddJoin(vtx_builder, polyline.GetPoint(contour_start_point_i),
+                offset.GetVector(), contour_first_offset);
       }
     }
   }
@@ -188,31 +383,22 @@ class StrokeGenerator {
 
     for (size_t point_i = component_start_index; point_i < component_end_index;
          point_i++) {
-      bool is_end_of_component = point_i == component_end_index - 1;
-
-      Point offset_vector = offset.GetVector();
-
-      vtx.position = polyline.GetPoint(point_i) + offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
-      vtx.position = polyline.GetPoint(point_i) - offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
-
-      // For line components, two additional points need to be appended
-      // prior to appending a join connecting the next component.
-      vtx.position = polyline.GetPoint(point_i + 1) + offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
-      vtx.position = polyline.GetPoint(point_i + 1) - offset_vector;
-      vtx_builder.AppendVertex(vtx.position);
+      // For line components, the two points at the end of the segment need to
+      // be appended prior to appending a join connecting the next component,
+      // so all four points of the segment are written at once.
+      vtx_builder.AppendSegment(polyline.GetPoint(point_i),
+                                polyline.GetPoint(point_i + 1),
+                                offset.GetVector());
 
       previous_offset = offset;
       offset = ComputeOffset(point_i + 2, contour_start_point_i,
                              contour_end_point_i, contour);
-      if (!is_last_component && is_end_of_component) {
-        // Generate join from the current line to the next line.
-        join_proc(vtx_builder, polyline.GetPoint(point_i + 1),
-                  previous_offset.GetVector(), offset.GetVector(),
-                  scaled_miter_limit, scale);
-      }
+    }
+
+    if (!is_last_component && component_start_index < component_end_index) {
+      // Generate join from the current line to the next line.
+      AddJoin(vtx_builder, polyline.GetPoint(component_end_index),
+              previous_offset.GetVector(), offset.GetVector());
     }
   }
 
@@ -285,19 +471,45 @@ class StrokeGenerator {
         vtx_builder.AppendVertex(vtx.position);
         // Generate join from the current line to the next line.
         if (!is_last_component) {
-          join_proc(vtx_builder, polyline.GetPoint(point_i + 1),
-                    previous_offset.GetVector(), offset.GetVector(),
-                    scaled_miter_limit, scale);
+          AddJoin(vtx_builder, polyline.GetPoint(point_i + 1),
+                  previous_offset.GetVector(), offset.GetVector());
         }
       }
     }
   }
 
+  void AddCap(VertexWriter& vtx_builder,
+              const Point& position,
+              const Point& offset,
+              bool reverse) {
+    if constexpr (kCap == Cap::kButt) {
+      CreateButtCap(vtx_builder, position, offset, reverse);
+    } else if constexpr (kCap == Cap::kRound) {
+      CreateRoundCap(vtx_builder, position, offset, scale, reverse);
+    } else {
+      static_assert(kCap == Cap::kSquare);
+      CreateSquareCap(vtx_builder, position, offset, reverse);
+    }
+  }
+
+  void AddJoin(VertexWriter& vtx_builder,
+               const Point& position,
+               const Point& start_offset,
+               const Point& end_offset) {
+    if constexpr (kJoin == Join::kBevel) {
+      CreateBevelJoin(vtx_builder, position, start_offset, end_offset);
+    } else if constexpr (kJoin == Join::kMiter) {
+      CreateMiterJoin(vtx_builder, position, start_offset, end_offset,
+                      scaled_miter_limit);
+    } else {
+      static_assert(kJoin == Join::kRound);
+      CreateRoundJoin(vtx_builder, position, start_offset, end_offset, scale);
+    }
+  }
+
   const Path::Polyline& polyline;
   const Scalar stroke_width;
   const Scalar scaled_miter_limit;
-  const JoinProc<VertexWriter>& join_proc;
-  const CapProc<VertexWriter>& cap_proc;
   const Scalar scale;
 
   SeparatedVector2 previous_offset;
@@ -305,172 +517,30 @@ class StrokeGenerator {
   SolidFillVertexShader::PerVertexData vtx;
 };
 
-template <typename VertexWriter>
-void CreateButtCap(VertexWriter& vtx_builder,
-                   const Point& position,
-                   const Point& offset,
-                   Scalar scale,
-                   bool reverse) {
-  Point orientation = offset * (reverse ? -1 : 1);
-  VS::PerVertexData vtx;
-  vtx.position = position + orientation;
-  vtx_builder.AppendVertex(vtx.position);
-  vtx.position = position - orientation;
-  vtx_builder.AppendVertex(vtx.position);
-}
-
-template <typename VertexWriter>
-void CreateRoundCap(VertexWriter& vtx_builder,
-                    const Point& position,
-                    const Point& offset,
-                    Scalar scale,
-                    bool reverse) {
-  Point orientation = offset * (reverse ? -1 : 1);
-  Point forward(offset.y, -offset.x);
-  Point forward_normal = forward.Normalize();
-
-  CubicPathComponent arc;
-  if (reverse) {
-    arc = CubicPathComponent(
-        forward, forward + orientation * PathBuilder::kArcApproximationMagic,
-        orientation + forward * PathBuilder::kArcApproximationMagic,
-        orientation);
-  } else {
-    arc = CubicPathComponent(
-        orientation,
-        orientation + forward * PathBuilder::kArcApproximationMagic,
-        forward + orientation * PathBuilder::kArcApproximationMagic, forward);
-  }
-
-  Point vtx = position + orientation;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position - orientation;
-  vtx_builder.AppendVertex(vtx);
-
-  arc.ToLinearPathComponents(scale, [&vtx_builder, &vtx, forward_normal,
-                                     position](const Point& point) {
-    vtx = position + point;
-    vtx_builder.AppendVertex(vtx);
-    vtx = position + (-point).Reflect(forward_normal);
-    vtx_builder.AppendVertex(vtx);
-  });
-}
-
-template <typename VertexWriter>
-void CreateSquareCap(VertexWriter& vtx_builder,
-                     const Point& position,
-                     const Point& offset,
-                     Scalar scale,
-                     bool reverse) {
-  Point orientation = offset * (reverse ? -1 : 1);
-  Point forward(offset.y, -offset.x);
-
-  Point vtx = position + orientation;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position - orientation;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position + orientation + forward;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position - orientation + forward;
-  vtx_builder.AppendVertex(vtx);
-}
-
-template <typename VertexWriter>
-Scalar CreateBevelAndGetDirection(VertexWriter& vtx_builder,
-                                  const Point& position,
-                                  const Point& start_offset,
-                                  const Point& end_offset) {
-  Point vtx = position;
-  vtx_builder.AppendVertex(vtx);
-
-  Scalar dir = start_offset.Cross(end_offset) > 0 ? -1 : 1;
-  vtx = position + start_offset * dir;
-  vtx_builder.AppendVertex(vtx);
-  vtx = position + end_offset * dir;
-  vtx_builder.AppendVertex(vtx);
-
-  return dir;
-}
-
-template <typename VertexWriter>
-void CreateMiterJoin(VertexWriter& vtx_builder,
-                     const Point& position,
-                     const Point& start_offset,
-                     const Point& end_offset,
-                     Scalar miter_limit,
-                     Scalar scale) {
-  Point start_normal = start_offset.Normalize();
-  Point end_normal = end_offset.Normalize();
-
-  // 1 for no joint (straight line), 0 for max joint (180 degrees).
-  Scalar alignment = (start_normal.Dot(end_normal) + 1) / 2;
-  if (ScalarNearlyEqual(alignment, 1)) {
-    return;
-  }
-
-  Scalar direction = CreateBevelAndGetDirection(vtx_builder, position,
-                                                start_offset, end_offset);
-
-  Point miter_point = (((start_offset + end_offset) / 2) / alignment);
-  if (miter_point.GetDistanceSquared({0, 0}) > miter_limit * miter_limit) {
-    return;  // Convert to bevel when we exceed the miter limit.
-  }
-
-  // Outer miter point.
-  VS::PerVertexData vtx;
-  vtx.position = position + miter_point * direction;
-  vtx_builder.AppendVertex(vtx.position);
-}
-
-template <typename VertexWriter>
-void CreateRoundJoin(VertexWriter& vtx_builder,
-                     const Point& position,
-                     const Point& start_offset,
-                     const Point& end_offset,
-                     Scalar miter_limit,
-                     Scalar scale) {
-  Point start_normal = start_offset.Normalize();
-  Point end_normal = end_offset.Normalize();
-
-  // 0 for no joint (straight line), 1 for max joint (180 degrees).
-  Scalar alignment = 1 - (start_normal.Dot(end_normal) + 1) / 2;
-  if (ScalarNearlyEqual(alignment, 0)) {
-    return;
+template <typename VertexWriter, Join kJoin>
+void CreateSolidStrokeVerticesWithJoin(VertexWriter& vtx_builder,
+                                       const Path::Polyline& polyline,
+                                       Scalar stroke_width,
+                                       Scalar scaled_miter_limit,
+                                       Cap stroke_cap,
+                                       Scalar scale) {
+  switch (stroke_cap) {
+    case Cap::kButt:
+      StrokeGenerator<VertexWriter, kJoin, Cap::kButt>(
+          polyline, stroke_width, scaled_miter_limit, scale)
+          .Generate(vtx_builder);
+      return;
+    case Cap::kRound:
+      StrokeGenerator<VertexWriter, kJoin, Cap::kRound>(
+          polyline, stroke_width, scaled_miter_limit, scale)
+          .Generate(vtx_builder);
+      return;
+    case Cap::kSquare:
+      StrokeGenerator<VertexWriter, kJoin, Cap::kSquare>(
+          polyline, stroke_width, scaled_miter_limit, scale)
+          .Generate(vtx_builder);
+      return;
   }
-
-  Scalar direction = CreateBevelAndGetDirection(vtx_builder, position,
-                                                start_offset, end_offset);
-
-  Point middle =
-      (start_offset + end_offset).Normalize() * start_offset.GetLength();
-  Point middle_normal = middle.Normalize();
-
-  Point middle_handle = middle + Point(-middle.y, middle.x) *
-                                     PathBuilder::kArcApproximationMagic *
-                                     alignment * direction;
-  Point start_handle = start_offset + Point(start_offset.y, -start_offset.x) *
-                                          PathBuilder::kArcApproximationMagic *
-                                          alignment * direction;
-
-  VS::PerVertexData vtx;
-  CubicPathComponent(start_offset, start_handle, middle_handle, middle)
-      .ToLinearPathComponents(scale, [&vtx_builder, direction, &vtx, position,
-                                      middle_normal](const Point& point) {
-        vtx.position = position + point * direction;
-        vtx_builder.AppendVertex(vtx.position);
-        vtx.position = position + (-point * direction).Reflect(middle_normal);
-        vtx_builder.AppendVertex(vtx.position);
-      });
-}
-
-template <typename VertexWriter>
-void CreateBevelJoin(VertexWriter& vtx_builder,
-                     const Point& position,
-                     const Point& start_offset,
-                     const Point& end_offset,
-                     Scalar miter_limit,
-                     Scalar scale) {
-  CreateBevelAndGetDirection(vtx_builder, position, start_offset, end_offset);
 }
 
 template <typename VertexWriter>
@@ -478,38 +548,28 @@ void CreateSolidStrokeVertices(VertexWriter& vtx_builder,
                                const Path::Polyline& polyline,
                                Scalar stroke_width,
                                Scalar scaled_miter_limit,
-                               const JoinProc<VertexWriter>& join_proc,
-                               const CapProc<VertexWriter>& cap_proc,
+                               Join stroke_join,
+                               Cap stroke_cap,
                                Scalar scale) {
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
-  stroke_generator.Generate(vtx_builder);
-}
-
-// static
-template <typename VertexWriter>
-JoinProc<VertexWriter> GetJoinProc(Join stroke_join) {
   switch (stroke_join) {
     case Join::kBevel:
-      return &CreateBevelJoin<VertexWriter>;
+      CreateSolidStrokeVerticesWithJoin<VertexWriter, Join::kBevel>(
+          vtx_builder, polyline, stroke_width, scaled_miter_limit, stroke_cap,
+          scale);
+      return;
     case Join::kMiter:
-      return &CreateMiterJoin<VertexWriter>;
+      CreateSolidStrokeVerticesWithJoin<VertexWriter, Join::kMiter>(
+          vtx_builder, polyline, stroke_width, scaled_miter_limit, stroke_cap,
+          scale);
+      return;
     case Join::kRound:
-      return &CreateRoundJoin<VertexWriter>;
+      CreateSolidStrokeVerticesWithJoin<VertexWriter, Join::kRound>(
+          vtx_builder, polyline, stroke_width, scaled_miter_limit, stroke_cap,
+          scale);
+      return;
   }
 }
 
-template <typename VertexWriter>
-CapProc<VertexWriter> GetCapProc(Cap stroke_cap) {
-  switch (stroke_cap) {
-    case Cap::kButt:
-      return &CreateButtCap<VertexWriter>;
-    case Cap::kRound:
-      return &CreateRoundCap<VertexWriter>;
-    case Cap::kSquare:
-      return &CreateSquareCap<VertexWriter>;
-  }
-}
 }  // namespace
 
 std::vector<SolidFillVertexShader::PerVertexData>
@@ -520,13 +580,16 @@ StrokePathGeometry::GenerateSolidStrokeVertices(const Path::Polyline& polyline,
                                                 Cap stroke_cap,
                                                 Scalar scale) {
   auto scaled_miter_limit = stroke_width * miter_limit * 0.5f;
-  auto join_proc = GetJoinProc<PositionWriter>(stroke_join);
-  auto cap_proc = GetCapProc<PositionWriter>(stroke_cap);
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
-  PositionWriter vtx_builder;
-  stroke_generator.Generate(vtx_builder);
-  return vtx_builder.GetData();
+  VertexCounter counter;
+  CreateSolidStrokeVertices(counter, polyline, stroke_width, scaled_miter_limit,
+                            stroke_join, stroke_cap, scale);
+  std::vector<SolidFillVertexShader::PerVertexData> vertices(
+      counter.GetCount());
+  PositionWriter vtx_builder(vertices.data(), vertices.size());
+  CreateSolidStrokeVertices(vtx_builder, polyline, stroke_width,
+                            scaled_miter_limit, stroke_join, stroke_cap, scale);
+  FML_DCHECK(vtx_builder.GetCount() == vertices.size());
+  return vertices;
 }
 
 StrokePathGeometry::StrokePathGeometry(const Path& path,
@@ -583,25 +646,33 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   auto& host_buffer = renderer.GetTransientsBuffer();
   auto scale = entity.GetTransform().GetMaxBasisLength();
 
-  PositionWriter position_writer;
   auto polyline = renderer.GetTessellator()->CreateTempPolyline(path_, scale);
-  CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc<PositionWriter>(stroke_join_),
-                            GetCapProc<PositionWriter>(stroke_cap_), scale);
-
-  BufferView buffer_view =
-      host_buffer.Emplace(position_writer.GetData().data(),
-                          position_writer.GetData().size() *
-                              sizeof(SolidFillVertexShader::PerVertexData),
-                          alignof(SolidFillVertexShader::PerVertexData));
+  Scalar scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5f;
+
+  // Count the vertices first so that they can be written straight into the
+  // host buffer instead of being accumulated and then copied.
+  VertexCounter counter;
+  CreateSolidStrokeVertices(counter, polyline, stroke_width, scaled_miter_limit,
+                            stroke_join_, stroke_cap_, scale);
+  size_t vertex_count = counter.GetCount();
+
+  BufferView buffer_view = host_buffer.Emplace(
+      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+      [&](uint8_t* data) {
+        PositionWriter vtx_builder(reinterpret_cast<VS::PerVertexData*>(data),
+                                   vertex_count);
+        CreateSolidStrokeVertices(vtx_builder, polyline, stroke_width,
+                                  scaled_miter_limit, stroke_join_,
+                                  stroke_cap_, scale);
+        FML_DCHECK(vtx_builder.GetCount() == vertex_count);
+      });
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
       .vertex_buffer =
           {
               .vertex_buffer = buffer_view,
-              .vertex_count = position_writer.GetData().size(),
+              .vertex_count = vertex_count,
               .index_type = IndexType::kNone,
           },
       .transform = entity.GetShaderTransform(pass),
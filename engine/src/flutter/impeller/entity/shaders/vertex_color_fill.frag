@@ -0,0 +1,18 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/color.glsl>
+#include <impeller/types.glsl>
+
+in vec4 v_color;
+
+out vec4 frag_color;
+
+// Unlike the fast gradient shader, the color is not dithered, so that each
+// vertex color renders exactly as a solid fill of that color would.
+void main() {
+  frag_color = IPPremultiply(v_color);
+}
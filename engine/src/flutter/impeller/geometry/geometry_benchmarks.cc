@@ -2,13 +2,19 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+
 #include "flutter/benchmarking/benchmarking.h"
 
 #include "flutter/impeller/entity/solid_fill.vert.h"
 
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
+#include "impeller/entity/entity.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellator.h"
 #include "impeller/tessellator/tessellator_libtess.h"
 
 namespace impeller {
@@ -35,6 +41,9 @@ Path CreateCubic(bool closed);
 Path CreateQuadratic(bool closed);
 /// Create a rounded rect.
 Path CreateRRect();
+/// A line chart with thousands of straight segments, like the series drawn
+/// by chart and graph widgets.
+Path CreateLineChart(bool closed);
 }  // namespace
 
 static TessellatorLibtess tess;
@@ -116,6 +125,81 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+enum class EllipticalShape {
+  kFilledCircle,
+  kStrokedCircle,
+  kRoundCapLine,
+  kFilledRoundRect,
+};
+
+static Tessellator::EllipticalVertexGenerator CreateEllipticalGenerator(
+    Tessellator& tessellator,
+    EllipticalShape shape,
+    Scalar radius) {
+  switch (shape) {
+    case EllipticalShape::kFilledCircle:
+      return tessellator.FilledCircle({}, {}, radius);
+    case EllipticalShape::kStrokedCircle:
+      return tessellator.StrokedCircle({}, {}, radius, radius * 0.25f);
+    case EllipticalShape::kRoundCapLine:
+      return tessellator.RoundCapLine({}, {}, {radius * 4, 0}, radius);
+    case EllipticalShape::kFilledRoundRect:
+      return tessellator.FilledRoundRect(
+          {}, Rect::MakeXYWH(0, 0, radius * 4, radius * 3), {radius, radius});
+  }
+  FML_UNREACHABLE();
+}
+
+/// Generates the vertices of a shape with the given radius into a buffer
+/// sized up front, as done when writing into a |HostBuffer|.
+static void BM_EllipticalVertices(benchmark::State& state,
+                                  EllipticalShape shape) {
+  Tessellator tessellator;
+  auto radius = static_cast<Scalar>(state.range(0));
+  std::vector<Point> vertices;
+
+  size_t vertex_count = 0u;
+  while (state.KeepRunning()) {
+    auto generator = CreateEllipticalGenerator(tessellator, shape, radius);
+    vertices.resize(generator.GetVertexCount());
+    vertex_count = generator.GenerateVertices(vertices.data());
+    benchmark::DoNotOptimize(vertices.data());
+  }
+  state.counters["VertexCount"] = vertex_count;
+  state.SetItemsProcessed(state.iterations() * vertex_count);
+}
+
+/// The same as |BM_EllipticalVertices| but delivers each vertex through a
+/// callback for comparison.
+static void BM_EllipticalVerticesCallback(benchmark::State& state,
+                                          EllipticalShape shape) {
+  Tessellator tessellator;
+  auto radius = static_cast<Scalar>(state.range(0));
+  std::vector<Point> vertices;
+
+  size_t vertex_count = 0u;
+  while (state.KeepRunning()) {
+    auto generator = CreateEllipticalGenerator(tessellator, shape, radius);
+    vertices.clear();
+    vertices.reserve(generator.GetVertexCount());
+    generator.GenerateVertices(
+        [&vertices](const Point& p) { vertices.push_back(p); });
+    vertex_count = vertices.size();
+    benchmark::DoNotOptimize(vertices.data());
+  }
+  state.counters["VertexCount"] = vertex_count;
+  state.SetItemsProcessed(state.iterations() * vertex_count);
+}
+
+#define MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(shape)                             \
+  BENCHMARK_CAPTURE(BM_EllipticalVertices, shape, EllipticalShape::k##shape) \
+      ->RangeMultiplier(4)                                                   \
+      ->Range(1, 4096);                                                      \
+  BENCHMARK_CAPTURE(BM_EllipticalVerticesCallback, shape,                    \
+                    EllipticalShape::k##shape)                               \
+      ->RangeMultiplier(4)                                                   \
+      ->Range(1, 4096)
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed)         \
   BENCHMARK_CAPTURE(BM_StrokePolyline, stroke_##path##_##cap##_##join, \
                     Create##path(closed), Cap::k##cap, Join::k##join)
@@ -135,6 +219,10 @@ BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(true));
 BENCHMARK_CAPTURE(BM_Polyline, unclosed_quad_polyline, CreateQuadratic(false));
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Quadratic, false);
 
+BENCHMARK_CAPTURE(BM_Polyline, line_chart_polyline, CreateLineChart(false));
+MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(LineChart, false);
+MAKE_STROKE_BENCHMARK_CAPTURE(LineChart, Round, Round, false);
+
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
 // A round rect has no ends so we don't need to try it with all cap values
 // but it does have joins and even though they should all be almost
@@ -143,6 +231,62 @@ MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Bevel, );
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Miter, );
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Round, );
 
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(FilledCircle);
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(StrokedCircle);
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(RoundCapLine);
+MAKE_ELLIPTICAL_BENCHMARK_CAPTURE(FilledRoundRect);
+
+/// Records a grid of solid color rects as one entity each, the way the
+/// canvas records rects that can't be batched.
+static void BM_SolidRectEntities(benchmark::State& state) {
+  const auto rect_count = static_cast<size_t>(state.range(0));
+  const Matrix transform = Matrix::MakeTranslation({10, 20});
+  std::vector<Entity> entities;
+  entities.reserve(rect_count);
+
+  while (state.KeepRunning()) {
+    entities.clear();
+    for (size_t i = 0; i < rect_count; i++) {
+      auto contents = std::make_shared<SolidColorContents>();
+      contents->SetGeometry(Geometry::MakeRect(
+          Rect::MakeXYWH((i % 64) * 10.0f, (i / 64) * 10.0f, 8, 8)));
+      contents->SetColor(Color::Red().WithAlpha((i % 4) / 4.0f));
+      Entity& entity = entities.emplace_back();
+      entity.SetTransform(transform);
+      entity.SetContents(std::move(contents));
+    }
+    benchmark::DoNotOptimize(entities.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rect_count);
+}
+
+/// The same as |BM_SolidRectEntities| but records the rects into batches for
+/// comparison.
+static void BM_SolidRectBatch(benchmark::State& state) {
+  const auto rect_count = static_cast<size_t>(state.range(0));
+  const Matrix transform = Matrix::MakeTranslation({10, 20});
+
+  size_t batch_count = 0u;
+  while (state.KeepRunning()) {
+    std::vector<std::shared_ptr<SolidRectBatchContents>> batches;
+    for (size_t i = 0; i < rect_count; i++) {
+      if (batches.empty() || batches.back()->IsFull()) {
+        batches.push_back(std::make_shared<SolidRectBatchContents>());
+      }
+      batches.back()->AddRect(
+          transform, Rect::MakeXYWH((i % 64) * 10.0f, (i / 64) * 10.0f, 8, 8),
+          Color::Red().WithAlpha((i % 4) / 4.0f));
+    }
+    batch_count = batches.size();
+    benchmark::DoNotOptimize(batches.data());
+  }
+  state.counters["DrawCount"] = batch_count;
+  state.SetItemsProcessed(state.iterations() * rect_count);
+}
+
+BENCHMARK(BM_SolidRectEntities)->RangeMultiplier(8)->Range(8, 8192);
+BENCHMARK(BM_SolidRectBatch)->RangeMultiplier(8)->Range(8, 8192);
+
 namespace {
 
 Path CreateRRect() {
@@ -151,6 +295,22 @@ Path CreateRRect() {
       .TakePath();
 }
 
+Path CreateLineChart(bool closed) {
+  static constexpr int kPointCount = 4096;
+  PathBuilder builder;
+  builder.MoveTo({0, 200});
+  for (int i = 1; i < kPointCount; i++) {
+    // A slow wave with some deterministic noise, so that consecutive
+    // segments meet at a variety of angles.
+    Scalar y = 200 + 150 * std::sin(i * 0.01f) + ((i * 37) % 11) - 5;
+    builder.LineTo({i * 0.5f, y});
+  }
+  if (closed) {
+    builder.Close();
+  }
+  return builder.TakePath();
+}
+
 Path CreateCubic(bool closed) {
   auto builder = PathBuilder{};
   builder  //
@@ -30,11 +30,16 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     const std::vector<ShaderStageIOSlot>& p_inputs,
     const std::vector<ShaderStageBufferLayout>& layouts) {
   std::vector<VertexAttribPointer> vertex_attrib_arrays;
+  uint32_t vertex_attrib_array_mask = 0u;
   for (auto i = 0u; i < p_inputs.size(); i++) {
     const auto& input = p_inputs[i];
     const auto& layout = layouts[input.binding];
     VertexAttribPointer attrib;
     attrib.index = input.location;
+    // The state tracker enables the arrays using a 32 bit mask.
+    if (attrib.index >= 32u) {
+      return false;
+    }
     // Component counts must be 1, 2, 3 or 4. Do that validation now.
     if (input.vec_size < 1u || input.vec_size > 4u) {
       return false;
@@ -49,8 +54,10 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     attrib.offset = input.offset;
     attrib.stride = layout.stride;
     vertex_attrib_arrays.emplace_back(attrib);
+    vertex_attrib_array_mask |= 1u << attrib.index;
   }
   vertex_attrib_arrays_ = std::move(vertex_attrib_arrays);
+  vertex_attrib_array_mask_ = vertex_attrib_array_mask;
   return true;
 }
 
@@ -142,10 +149,11 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindVertexAttributes(StateTrackerGLES& state,
                                               size_t vertex_offset) const {
+  const auto& gl = state.GetProcTable();
+  state.SetEnabledVertexAttribArrays(vertex_attrib_array_mask_);
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -159,10 +167,11 @@ bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindUniformData(StateTrackerGLES& state,
                                          Allocator& transients_allocator,
                                          const Bindings& vertex_bindings,
                                          const Bindings& fragment_bindings) {
+  const auto& gl = state.GetProcTable();
   for (const auto& buffer : vertex_bindings.buffers) {
     if (!BindUniformBuffer(gl, transients_allocator, buffer.view)) {
       return false;
@@ -175,12 +184,12 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   }
 
   std::optional<size_t> next_unit_index =
-      BindTextures(gl, vertex_bindings, ShaderStage::kVertex);
+      BindTextures(state, vertex_bindings, ShaderStage::kVertex);
   if (!next_unit_index.has_value()) {
     return false;
   }
 
-  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment,
+  if (!BindTextures(state, fragment_bindings, ShaderStage::kFragment,
                     *next_unit_index)
            .has_value()) {
     return false;
@@ -189,13 +198,6 @@ bool BufferBindingsGLES::BindUniformData(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
-  }
-  return true;
-}
-
 GLint BufferBindingsGLES::ComputeTextureLocation(
     const ShaderMetadata* metadata) {
   auto location = binding_map_.find(metadata->name);
@@ -360,10 +362,11 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
 }
 
 std::optional<size_t> BufferBindingsGLES::BindTextures(
-    const ProcTableGLES& gl,
+    StateTrackerGLES& state,
     const Bindings& bindings,
     ShaderStage stage,
     size_t unit_start_index) {
+  const auto& gl = state.GetProcTable();
   size_t active_index = unit_start_index;
   for (const auto& data : bindings.sampled_images) {
     const auto& texture_gles = TextureGLES::Cast(*data.texture.resource);
@@ -385,7 +388,7 @@ std::optional<size_t> BufferBindingsGLES::BindTextures(
                         "this shader stage.";
       return std::nullopt;
     }
-    gl.ActiveTexture(GL_TEXTURE0 + active_index);
+    state.ActiveTexture(GL_TEXTURE0 + active_index);
 
     //--------------------------------------------------------------------------
     /// Bind the texture.
@@ -11,6 +11,7 @@
 #include "impeller/core/shader_types.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
 #include "impeller/renderer/command.h"
 
 namespace impeller {
@@ -32,16 +33,14 @@ class BufferBindingsGLES {
 
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
-  bool BindVertexAttributes(const ProcTableGLES& gl,
+  bool BindVertexAttributes(StateTrackerGLES& state,
                             size_t vertex_offset) const;
 
-  bool BindUniformData(const ProcTableGLES& gl,
+  bool BindUniformData(StateTrackerGLES& state,
                        Allocator& transients_allocator,
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings);
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -55,6 +54,8 @@ class BufferBindingsGLES {
     GLsizei offset = 0u;
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
+  // The indices of |vertex_attrib_arrays_| as a mask.
+  uint32_t vertex_attrib_array_mask_ = 0u;
 
   std::unordered_map<std::string, GLint> uniform_locations_;
 
@@ -70,7 +71,7 @@ class BufferBindingsGLES {
                          Allocator& transients_allocator,
                          const BufferResource& buffer);
 
-  std::optional<size_t> BindTextures(const ProcTableGLES& gl,
+  std::optional<size_t> BindTextures(StateTrackerGLES& state,
                                      const Bindings& bindings,
                                      ShaderStage stage,
                                      size_t unit_start_index = 0);
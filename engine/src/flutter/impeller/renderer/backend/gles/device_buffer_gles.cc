@@ -79,7 +79,9 @@ static GLenum ToTarget(DeviceBufferGLES::BindingType type) {
   FML_UNREACHABLE();
 }
 
-bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
+bool DeviceBufferGLES::BindAndUploadDataIfNecessary(
+    BindingType type,
+    StateTrackerGLES& state) const {
   if (!reactor_) {
     return false;
   }
@@ -92,7 +94,7 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   const auto target_type = ToTarget(type);
   const auto& gl = reactor_->GetProcTable();
 
-  gl.BindBuffer(target_type, buffer.value());
+  state.BindBuffer(target_type, buffer.value());
   if (!initialized_) {
     gl.BufferData(target_type, backing_store_->GetLength().GetByteSize(),
                   nullptr, GL_DYNAMIC_DRAW);
@@ -0,0 +1,368 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr size_t kFrontFace = 0u;
+constexpr size_t kBackFace = 1u;
+
+// The faces in |StateTrackerGLES::stencil_| that are set by a call on |face|.
+std::pair<size_t, size_t> StencilFaces(GLenum face) {
+  switch (face) {
+    case GL_FRONT:
+      return {kFrontFace, kFrontFace + 1u};
+    case GL_BACK:
+      return {kBackFace, kBackFace + 1u};
+    default:
+      return {kFrontFace, kBackFace + 1u};
+  }
+}
+
+}  // namespace
+
+StateTrackerGLES::StateTrackerGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateTrackerGLES::~StateTrackerGLES() = default;
+
+const ProcTableGLES& StateTrackerGLES::GetProcTable() const {
+  return gl_;
+}
+
+template <class T>
+bool StateTrackerGLES::ShouldCall(std::optional<T>& shadow, const T& value) {
+  if (shadow.has_value() && shadow.value() == value) {
+    skipped_call_count_++;
+    return false;
+  }
+  shadow = value;
+  call_count_++;
+  return true;
+}
+
+void StateTrackerGLES::SetCap(GLenum cap, bool enabled) {
+  auto found = std::find(kShadowedCaps.begin(), kShadowedCaps.end(), cap);
+  if (found == kShadowedCaps.end()) {
+    call_count_++;
+  } else if (!ShouldCall(caps_[found - kShadowedCaps.begin()], enabled)) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(cap);
+  } else {
+    gl_.Disable(cap);
+  }
+}
+
+void StateTrackerGLES::Enable(GLenum cap) {
+  SetCap(cap, true);
+}
+
+void StateTrackerGLES::Disable(GLenum cap) {
+  SetCap(cap, false);
+}
+
+void StateTrackerGLES::BlendFuncSeparate(GLenum src_color,
+                                         GLenum dst_color,
+                                         GLenum src_alpha,
+                                         GLenum dst_alpha) {
+  if (ShouldCall(blend_func_, {src_color, dst_color, src_alpha, dst_alpha})) {
+    gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  }
+}
+
+void StateTrackerGLES::BlendEquationSeparate(GLenum mode_color,
+                                             GLenum mode_alpha) {
+  if (ShouldCall(blend_equation_, {mode_color, mode_alpha})) {
+    gl_.BlendEquationSeparate(mode_color, mode_alpha);
+  }
+}
+
+void StateTrackerGLES::ColorMask(GLboolean red,
+                                 GLboolean green,
+                                 GLboolean blue,
+                                 GLboolean alpha) {
+  if (ShouldCall(color_mask_, {red, green, blue, alpha})) {
+    gl_.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateTrackerGLES::DepthFunc(GLenum func) {
+  if (ShouldCall(depth_func_, func)) {
+    gl_.DepthFunc(func);
+  }
+}
+
+void StateTrackerGLES::DepthMask(GLboolean flag) {
+  if (ShouldCall(depth_mask_, flag)) {
+    gl_.DepthMask(flag);
+  }
+}
+
+void StateTrackerGLES::DepthRange(GLfloat z_near, GLfloat z_far) {
+  if (!ShouldCall(depth_range_, {z_near, z_far})) {
+    return;
+  }
+  if (gl_.DepthRangef.IsAvailable()) {
+    gl_.DepthRangef(z_near, z_far);
+  } else {
+    gl_.DepthRange(z_near, z_far);
+  }
+}
+
+void StateTrackerGLES::StencilOpSeparate(GLenum face,
+                                         GLenum stencil_fail,
+                                         GLenum depth_fail,
+                                         GLenum depth_stencil_pass) {
+  const std::array<GLenum, 3> op = {stencil_fail, depth_fail,
+                                    depth_stencil_pass};
+  auto [begin, end] = StencilFaces(face);
+  bool changed = false;
+  for (size_t i = begin; i < end; i++) {
+    changed |= stencil_[i].op != op;
+    stencil_[i].op = op;
+  }
+  if (!changed) {
+    skipped_call_count_++;
+    return;
+  }
+  call_count_++;
+  gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+}
+
+void StateTrackerGLES::StencilFuncSeparate(GLenum face,
+                                           GLenum func,
+                                           GLint ref,
+                                           GLuint mask) {
+  const std::array<GLint, 3> stencil_func = {static_cast<GLint>(func), ref,
+                                             static_cast<GLint>(mask)};
+  auto [begin, end] = StencilFaces(face);
+  bool changed = false;
+  for (size_t i = begin; i < end; i++) {
+    changed |= stencil_[i].func != stencil_func;
+    stencil_[i].func = stencil_func;
+  }
+  if (!changed) {
+    skipped_call_count_++;
+    return;
+  }
+  call_count_++;
+  gl_.StencilFuncSeparate(face, func, ref, mask);
+}
+
+void StateTrackerGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  auto [begin, end] = StencilFaces(face);
+  bool changed = false;
+  for (size_t i = begin; i < end; i++) {
+    changed |= stencil_[i].write_mask != mask;
+    stencil_[i].write_mask = mask;
+  }
+  if (!changed) {
+    skipped_call_count_++;
+    return;
+  }
+  call_count_++;
+  gl_.StencilMaskSeparate(face, mask);
+}
+
+void StateTrackerGLES::Viewport(GLint x,
+                                GLint y,
+                                GLsizei width,
+                                GLsizei height) {
+  if (ShouldCall(viewport_, {x, y, width, height})) {
+    gl_.Viewport(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::Scissor(GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height) {
+  if (ShouldCall(scissor_, {x, y, width, height})) {
+    gl_.Scissor(x, y, width, height);
+  }
+}
+
+void StateTrackerGLES::CullFace(GLenum mode) {
+  if (ShouldCall(cull_face_, mode)) {
+    gl_.CullFace(mode);
+  }
+}
+
+void StateTrackerGLES::FrontFace(GLenum mode) {
+  if (ShouldCall(front_face_, mode)) {
+    gl_.FrontFace(mode);
+  }
+}
+
+void StateTrackerGLES::UseProgram(GLuint program) {
+  if (ShouldCall(program_, program)) {
+    gl_.UseProgram(program);
+  }
+}
+
+void StateTrackerGLES::BindBuffer(GLenum target, GLuint buffer) {
+  std::optional<GLuint>* shadow = nullptr;
+  switch (target) {
+    case GL_ARRAY_BUFFER:
+      shadow = &array_buffer_;
+      break;
+    case GL_ELEMENT_ARRAY_BUFFER:
+      shadow = &element_array_buffer_;
+      break;
+    default:
+      call_count_++;
+      gl_.BindBuffer(target, buffer);
+      return;
+  }
+  if (ShouldCall(*shadow, buffer)) {
+    gl_.BindBuffer(target, buffer);
+  }
+}
+
+void StateTrackerGLES::ActiveTexture(GLenum texture) {
+  if (ShouldCall(active_texture_, texture)) {
+    gl_.ActiveTexture(texture);
+  }
+}
+
+void StateTrackerGLES::SetEnabledVertexAttribArrays(uint32_t mask) {
+  const uint32_t changed = mask ^ enabled_vertex_attrib_arrays_;
+  for (GLuint index = 0u; index < 32u; index++) {
+    const uint32_t bit = 1u << index;
+    if (!(changed & bit)) {
+      if (mask & bit) {
+        skipped_call_count_++;
+      }
+      continue;
+    }
+    call_count_++;
+    if (mask & bit) {
+      gl_.EnableVertexAttribArray(index);
+    } else {
+      gl_.DisableVertexAttribArray(index);
+    }
+  }
+  enabled_vertex_attrib_arrays_ = mask;
+}
+
+size_t StateTrackerGLES::GetCallCount() const {
+  return call_count_;
+}
+
+size_t StateTrackerGLES::GetSkippedCallCount() const {
+  return skipped_call_count_;
+}
+
+bool StateTrackerGLES::Validate() const {
+  bool valid = true;
+  const auto check = [&valid](const char* name, const auto& shadow,
+                              const auto& actual) {
+    if (shadow.has_value() && shadow.value() != actual) {
+      VALIDATION_LOG << "The shadowed GL " << name
+                     << " does not match the state of the context.";
+      valid = false;
+    }
+  };
+  const auto get_integer = [this](GLenum pname) -> GLint {
+    GLint value = 0;
+    gl_.GetIntegerv(pname, &value);
+    return value;
+  };
+  const auto get_boolean = [this](GLenum pname) -> GLboolean {
+    GLboolean value = GL_FALSE;
+    gl_.GetBooleanv(pname, &value);
+    return value;
+  };
+
+  for (size_t i = 0; i < kShadowedCaps.size(); i++) {
+    check("capability", caps_[i], get_boolean(kShadowedCaps[i]) == GL_TRUE);
+  }
+
+  check("blend func", blend_func_,
+        std::array<GLenum, 4>{
+            static_cast<GLenum>(get_integer(GL_BLEND_SRC_RGB)),
+            static_cast<GLenum>(get_integer(GL_BLEND_DST_RGB)),
+            static_cast<GLenum>(get_integer(GL_BLEND_SRC_ALPHA)),
+            static_cast<GLenum>(get_integer(GL_BLEND_DST_ALPHA)),
+        });
+  check("blend equation", blend_equation_,
+        std::array<GLenum, 2>{
+            static_cast<GLenum>(get_integer(GL_BLEND_EQUATION_RGB)),
+            static_cast<GLenum>(get_integer(GL_BLEND_EQUATION_ALPHA)),
+        });
+
+  std::array<GLboolean, 4> color_mask = {};
+  gl_.GetBooleanv(GL_COLOR_WRITEMASK, color_mask.data());
+  check("color mask", color_mask_, color_mask);
+
+  check("depth func", depth_func_,
+        static_cast<GLenum>(get_integer(GL_DEPTH_FUNC)));
+  check("depth mask", depth_mask_, get_boolean(GL_DEPTH_WRITEMASK));
+
+  std::array<GLfloat, 2> depth_range = {};
+  gl_.GetFloatv(GL_DEPTH_RANGE, depth_range.data());
+  check("depth range", depth_range_, depth_range);
+
+  check("front stencil op", stencil_[kFrontFace].op,
+        std::array<GLenum, 3>{
+            static_cast<GLenum>(get_integer(GL_STENCIL_FAIL)),
+            static_cast<GLenum>(get_integer(GL_STENCIL_PASS_DEPTH_FAIL)),
+            static_cast<GLenum>(get_integer(GL_STENCIL_PASS_DEPTH_PASS)),
+        });
+  check("front stencil func", stencil_[kFrontFace].func,
+        std::array<GLint, 3>{
+            get_integer(GL_STENCIL_FUNC),
+            get_integer(GL_STENCIL_REF),
+            get_integer(GL_STENCIL_VALUE_MASK),
+        });
+  check("front stencil write mask", stencil_[kFrontFace].write_mask,
+        static_cast<GLuint>(get_integer(GL_STENCIL_WRITEMASK)));
+  check("back stencil op", stencil_[kBackFace].op,
+        std::array<GLenum, 3>{
+            static_cast<GLenum>(get_integer(GL_STENCIL_BACK_FAIL)),
+            static_cast<GLenum>(get_integer(GL_STENCIL_BACK_PASS_DEPTH_FAIL)),
+            static_cast<GLenum>(get_integer(GL_STENCIL_BACK_PASS_DEPTH_PASS)),
+        });
+  check("back stencil func", stencil_[kBackFace].func,
+        std::array<GLint, 3>{
+            get_integer(GL_STENCIL_BACK_FUNC),
+            get_integer(GL_STENCIL_BACK_REF),
+            get_integer(GL_STENCIL_BACK_VALUE_MASK),
+        });
+  check("back stencil write mask", stencil_[kBackFace].write_mask,
+        static_cast<GLuint>(get_integer(GL_STENCIL_BACK_WRITEMASK)));
+
+  std::array<GLint, 4> rect = {};
+  gl_.GetIntegerv(GL_VIEWPORT, rect.data());
+  check("viewport", viewport_, rect);
+  gl_.GetIntegerv(GL_SCISSOR_BOX, rect.data());
+  check("scissor", scissor_, rect);
+
+  check("cull face", cull_face_,
+        static_cast<GLenum>(get_integer(GL_CULL_FACE_MODE)));
+  check("front face", front_face_,
+        static_cast<GLenum>(get_integer(GL_FRONT_FACE)));
+
+  check("program", program_,
+        static_cast<GLuint>(get_integer(GL_CURRENT_PROGRAM)));
+  check("array buffer", array_buffer_,
+        static_cast<GLuint>(get_integer(GL_ARRAY_BUFFER_BINDING)));
+  check("element array buffer", element_array_buffer_,
+        static_cast<GLuint>(get_integer(GL_ELEMENT_ARRAY_BUFFER_BINDING)));
+  check("active texture", active_texture_,
+        static_cast<GLenum>(get_integer(GL_ACTIVE_TEXTURE)));
+
+  return valid;
+}
+
+}  // namespace impeller
@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Shadows the fixed function state, program, buffer bindings,
+///             active texture unit and enabled vertex attribute arrays of a
+///             GL context so that calls that wouldn't change that state are
+///             skipped.
+///
+///             Calls that change shadowed state must all be made through the
+///             tracker for as long as it is in use. State that hasn't been
+///             set through the tracker is unknown, so the first call that
+///             sets it is never skipped. The one exception is the vertex
+///             attribute arrays, which are assumed to all be disabled, as
+///             they are in a new context and after every render pass.
+///
+///             GL state belongs to a context, and reactions may run on
+///             different contexts, so a tracker must only be used for the
+///             duration of a single reaction.
+///
+class StateTrackerGLES {
+ public:
+  explicit StateTrackerGLES(const ProcTableGLES& gl);
+
+  ~StateTrackerGLES();
+
+  const ProcTableGLES& GetProcTable() const;
+
+  void Enable(GLenum cap);
+
+  void Disable(GLenum cap);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_color, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Calls `glDepthRangef` or, on desktop GL, `glDepthRange`.
+  ///
+  void DepthRange(GLfloat z_near, GLfloat z_far);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  void BindBuffer(GLenum target, GLuint buffer);
+
+  void ActiveTexture(GLenum texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enable the vertex attribute arrays whose bits are set in the
+  ///             mask and disable all the others.
+  ///
+  void SetEnabledVertexAttribArrays(uint32_t mask);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of GL calls made through the tracker.
+  ///
+  size_t GetCallCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of GL calls the tracker skipped because they
+  ///             wouldn't have changed the state of the context.
+  ///
+  size_t GetSkippedCallCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Query the context for all of the state that is known to the
+  ///             tracker and log the state that doesn't match the shadow.
+  ///
+  ///             This is slow and is meant for debug builds only.
+  ///
+  /// @return     If the shadowed state matches the state of the context.
+  ///
+  bool Validate() const;
+
+ private:
+  // The capabilities that are shadowed, in the order of |caps_|.
+  static constexpr std::array<GLenum, 6> kShadowedCaps = {
+      GL_BLEND,     GL_CULL_FACE,    GL_DEPTH_TEST,
+      GL_DITHER,    GL_SCISSOR_TEST, GL_STENCIL_TEST,
+  };
+
+  struct StencilFaceState {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::array<GLint, 3>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  const ProcTableGLES& gl_;
+  std::array<std::optional<bool>, kShadowedCaps.size()> caps_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLfloat, 2>> depth_range_;
+  // Front and back.
+  std::array<StencilFaceState, 2> stencil_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  std::optional<GLuint> array_buffer_;
+  std::optional<GLuint> element_array_buffer_;
+  std::optional<GLenum> active_texture_;
+  uint32_t enabled_vertex_attrib_arrays_ = 0u;
+  size_t call_count_ = 0u;
+  size_t skipped_call_count_ = 0u;
+
+  void SetCap(GLenum cap, bool enabled);
+
+  template <class T>
+  bool ShouldCall(std::optional<T>& shadow, const T& value);
+
+  StateTrackerGLES(const StateTrackerGLES&) = delete;
+
+  StateTrackerGLES& operator=(const StateTrackerGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_TRACKER_GLES_H_
@@ -163,6 +163,96 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+void mockEnable(GLenum cap) {
+  RecordGLCall("glEnable");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  RecordGLCall("glDisable");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockBlendFuncSeparate(GLenum src_color,
+                           GLenum dst_color,
+                           GLenum src_alpha,
+                           GLenum dst_alpha) {
+  RecordGLCall("glBlendFuncSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockBlendFuncSeparate),  //
+                                 decltype(glBlendFuncSeparate)>::value);
+
+void mockColorMask(GLboolean red,
+                   GLboolean green,
+                   GLboolean blue,
+                   GLboolean alpha) {
+  RecordGLCall("glColorMask");
+}
+
+static_assert(CheckSameSignature<decltype(mockColorMask),  //
+                                 decltype(glColorMask)>::value);
+
+void mockDepthMask(GLboolean flag) {
+  RecordGLCall("glDepthMask");
+}
+
+static_assert(CheckSameSignature<decltype(mockDepthMask),  //
+                                 decltype(glDepthMask)>::value);
+
+void mockViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glViewport");
+}
+
+static_assert(CheckSameSignature<decltype(mockViewport),  //
+                                 decltype(glViewport)>::value);
+
+void mockScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glScissor");
+}
+
+static_assert(CheckSameSignature<decltype(mockScissor),  //
+                                 decltype(glScissor)>::value);
+
+void mockUseProgram(GLuint program) {
+  RecordGLCall("glUseProgram");
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockBindBuffer(GLenum target, GLuint buffer) {
+  RecordGLCall("glBindBuffer");
+}
+
+static_assert(CheckSameSignature<decltype(mockBindBuffer),  //
+                                 decltype(glBindBuffer)>::value);
+
+void mockActiveTexture(GLenum texture) {
+  RecordGLCall("glActiveTexture");
+}
+
+static_assert(CheckSameSignature<decltype(mockActiveTexture),  //
+                                 decltype(glActiveTexture)>::value);
+
+void mockEnableVertexAttribArray(GLuint index) {
+  RecordGLCall("glEnableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockEnableVertexAttribArray),  //
+                                 decltype(glEnableVertexAttribArray)>::value);
+
+void mockDisableVertexAttribArray(GLuint index) {
+  RecordGLCall("glDisableVertexAttribArray");
+}
+
+static_assert(CheckSameSignature<decltype(mockDisableVertexAttribArray),  //
+                                 decltype(glDisableVertexAttribArray)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions,
     const char* version_string,
@@ -202,6 +292,30 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(&mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(&mockDisable);
+  } else if (strcmp(name, "glBlendFuncSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockBlendFuncSeparate);
+  } else if (strcmp(name, "glColorMask") == 0) {
+    return reinterpret_cast<void*>(&mockColorMask);
+  } else if (strcmp(name, "glDepthMask") == 0) {
+    return reinterpret_cast<void*>(&mockDepthMask);
+  } else if (strcmp(name, "glViewport") == 0) {
+    return reinterpret_cast<void*>(&mockViewport);
+  } else if (strcmp(name, "glScissor") == 0) {
+    return reinterpret_cast<void*>(&mockScissor);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(&mockUseProgram);
+  } else if (strcmp(name, "glBindBuffer") == 0) {
+    return reinterpret_cast<void*>(&mockBindBuffer);
+  } else if (strcmp(name, "glActiveTexture") == 0) {
+    return reinterpret_cast<void*>(&mockActiveTexture);
+  } else if (strcmp(name, "glEnableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockEnableVertexAttribArray);
+  } else if (strcmp(name, "glDisableVertexAttribArray") == 0) {
+    return reinterpret_cast<void*>(&mockDisableVertexAttribArray);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
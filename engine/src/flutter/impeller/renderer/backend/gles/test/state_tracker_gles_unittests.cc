@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_tracker_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+// The state a render pass sets up for each draw of a simple pipeline.
+void SetDrawState(StateTrackerGLES& state) {
+  state.Enable(GL_BLEND);
+  state.BlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                          GL_ONE_MINUS_SRC_ALPHA);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.Disable(GL_STENCIL_TEST);
+  state.Disable(GL_DEPTH_TEST);
+  state.Viewport(0, 0, 100, 100);
+  state.Disable(GL_SCISSOR_TEST);
+  state.Disable(GL_CULL_FACE);
+  state.BindBuffer(GL_ARRAY_BUFFER, 1u);
+  state.UseProgram(2u);
+  state.SetEnabledVertexAttribArrays(0b11u);
+}
+}  // namespace
+
+TEST(StateTrackerGLES, SkipsRedundantStateChangesBetweenDraws) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  SetDrawState(state);
+  const std::vector<std::string> first_draw = mock_gles->GetCapturedCalls();
+  EXPECT_EQ(first_draw.size(), 12u);
+  EXPECT_EQ(state.GetCallCount(), 12u);
+  EXPECT_EQ(state.GetSkippedCallCount(), 0u);
+
+  SetDrawState(state);
+  EXPECT_TRUE(mock_gles->GetCapturedCalls().empty());
+  EXPECT_EQ(state.GetCallCount(), 12u);
+  EXPECT_EQ(state.GetSkippedCallCount(), 12u);
+
+  // Only the state that changes is set again.
+  state.Viewport(0, 0, 50, 50);
+  state.UseProgram(3u);
+  state.SetEnabledVertexAttribArrays(0b01u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glViewport", "glUseProgram",
+                                      "glDisableVertexAttribArray"}));
+}
+
+TEST(StateTrackerGLES, TracksStencilFacesSeparately) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFFu);
+  state.StencilMaskSeparate(GL_FRONT, 0xFFu);
+  state.StencilMaskSeparate(GL_BACK, 0xFFu);
+  EXPECT_EQ(state.GetCallCount(), 1u);
+  EXPECT_EQ(state.GetSkippedCallCount(), 2u);
+
+  state.StencilMaskSeparate(GL_BACK, 0x0Fu);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0x0Fu);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0x0Fu);
+  EXPECT_EQ(state.GetCallCount(), 3u);
+  EXPECT_EQ(state.GetSkippedCallCount(), 3u);
+}
+
+TEST(StateTrackerGLES, DoesNotSkipUnshadowedState) {
+  auto mock_gles = MockGLES::Init();
+  StateTrackerGLES state(mock_gles->GetProcTable());
+
+  state.Enable(GL_POLYGON_OFFSET_FILL);
+  state.Enable(GL_POLYGON_OFFSET_FILL);
+  state.BindBuffer(GL_UNIFORM_BUFFER, 1u);
+  state.BindBuffer(GL_UNIFORM_BUFFER, 1u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>(
+                {"glEnable", "glEnable", "glBindBuffer", "glBindBuffer"}));
+  EXPECT_EQ(state.GetSkippedCallCount(), 0u);
+}
+
+TEST(StateTrackerGLES, StateIsUnknownUntilSet) {
+  auto mock_gles = MockGLES::Init();
+  {
+    StateTrackerGLES state(mock_gles->GetProcTable());
+    state.UseProgram(1u);
+  }
+  // A new tracker can't assume anything about the state of the context.
+  StateTrackerGLES state(mock_gles->GetProcTable());
+  state.UseProgram(1u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls(),
+            std::vector<std::string>({"glUseProgram", "glUseProgram"}));
+}
+
+}  // namespace testing
+}  // namespace impeller
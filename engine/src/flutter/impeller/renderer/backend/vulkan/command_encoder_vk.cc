@@ -172,6 +172,21 @@ fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSets(
                                                                       context);
 }
 
+fml::StatusOr<vk::DescriptorSet> CommandEncoderVK::GetCachedDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const std::shared_ptr<const void>* resources,
+    size_t resource_count,
+    const ContextVK& context) {
+  if (!IsValid()) {
+    return fml::Status(fml::StatusCode::kUnknown, "command encoder invalid");
+  }
+
+  return tracked_objects_->GetDescriptorPool().GetCachedDescriptorSet(
+      layout, writes, write_count, resources, resource_count, context);
+}
+
 void CommandEncoderVK::PushDebugGroup(std::string_view label) const {
   if (!HasValidationLayers()) {
     return;
@@ -87,6 +87,14 @@ class CommandEncoderVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context);
 
+  fml::StatusOr<vk::DescriptorSet> GetCachedDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const std::shared_ptr<const void>* resources,
+      size_t resource_count,
+      const ContextVK& context);
+
  private:
   friend class ContextVK;
   friend class CommandQueueVK;
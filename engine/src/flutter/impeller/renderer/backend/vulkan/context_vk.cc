@@ -31,6 +31,7 @@
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/command_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
@@ -407,6 +408,9 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  auto descriptor_set_cache =
+      std::make_shared<DescriptorSetCacheVK>(weak_from_this());
+
   //----------------------------------------------------------------------------
   /// Fetch the queues.
   ///
@@ -443,6 +447,7 @@ void ContextVK::Setup(Settings settings) {
   resource_manager_ = std::move(resource_manager);
   command_pool_recycler_ = std::move(command_pool_recycler);
   descriptor_pool_recycler_ = std::move(descriptor_pool_recycler);
+  descriptor_set_cache_ = std::move(descriptor_set_cache);
   device_name_ = std::string(physical_device_properties.deviceName);
   command_queue_vk_ = std::make_shared<CommandQueueVK>(weak_from_this());
   should_disable_surface_control_ = settings.disable_surface_control;
@@ -565,6 +570,11 @@ std::shared_ptr<DescriptorPoolRecyclerVK> ContextVK::GetDescriptorPoolRecycler()
   return descriptor_pool_recycler_;
 }
 
+const std::shared_ptr<DescriptorSetCacheVK>& ContextVK::GetDescriptorSetCache()
+    const {
+  return descriptor_set_cache_;
+}
+
 std::shared_ptr<CommandQueue> ContextVK::GetCommandQueue() const {
   return command_queue_vk_;
 }
@@ -608,6 +618,13 @@ void ContextVK::InitializeCommonlyUsedShadersIfNeeded() const {
   auto pass = builder.Build(GetDevice());
 }
 
+std::shared_ptr<PipelineUsageRecord> ContextVK::GetPipelineUsageRecord() const {
+  if (!pipeline_library_) {
+    return nullptr;
+  }
+  return pipeline_library_->GetPSOCache()->GetUsageRecord();
+}
+
 void ContextVK::DisposeThreadLocalCachedResources() {
   command_pool_recycler_->Dispose();
 }
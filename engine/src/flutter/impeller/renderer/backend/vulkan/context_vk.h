@@ -37,6 +37,7 @@ class ResourceManagerVK;
 class SurfaceContextVK;
 class GPUTracerVK;
 class DescriptorPoolRecyclerVK;
+class DescriptorSetCacheVK;
 class CommandQueueVK;
 
 class ContextVK final : public Context,
@@ -161,6 +162,8 @@ class ContextVK final : public Context,
 
   std::shared_ptr<DescriptorPoolRecyclerVK> GetDescriptorPoolRecycler() const;
 
+  const std::shared_ptr<DescriptorSetCacheVK>& GetDescriptorSetCache() const;
+
   std::shared_ptr<CommandQueue> GetCommandQueue() const override;
 
   std::shared_ptr<GPUTracerVK> GetGPUTracer() const;
@@ -170,6 +173,9 @@ class ContextVK final : public Context,
   // |Context|
   void InitializeCommonlyUsedShadersIfNeeded() const override;
 
+  // |Context|
+  std::shared_ptr<PipelineUsageRecord> GetPipelineUsageRecord() const override;
+
   // |Context|
   void DisposeThreadLocalCachedResources() override;
 
@@ -208,6 +214,7 @@ class ContextVK final : public Context,
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
   std::shared_ptr<GPUTracerVK> gpu_tracer_;
   std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<DescriptorSetCacheVK> descriptor_set_cache_;
   std::shared_ptr<CommandQueue> command_queue_vk_;
   bool should_disable_surface_control_ = false;
 
@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/resource_manager_vk.h"
 #include "vulkan/vulkan_enums.hpp"
@@ -120,6 +122,37 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
   return set;
 }
 
+fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::GetCachedDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const std::shared_ptr<const void>* resources,
+    size_t resource_count,
+    const ContextVK& context_vk) {
+  const std::shared_ptr<DescriptorSetCacheVK>& cache =
+      context_vk.GetDescriptorSetCache();
+  if (!cache) {
+    auto set = AllocateDescriptorSets(layout, context_vk);
+    if (!set.ok()) {
+      return set;
+    }
+    for (auto i = 0u; i < write_count; i++) {
+      writes[i].dstSet = set.value();
+    }
+    context_vk.GetDevice().updateDescriptorSets(write_count, writes, 0u, {});
+    return set;
+  }
+
+  std::shared_ptr<const DescriptorPoolVK> pool;
+  auto set = cache->GetDescriptorSet(layout, writes, write_count, resources,
+                                     resource_count, context_vk, pool);
+  if (set.ok() && pool &&
+      (cache_pools_.empty() || cache_pools_.back() != pool)) {
+    cache_pools_.push_back(std::move(pool));
+  }
+  return set;
+}
+
 fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
   auto new_pool = context_vk.GetDescriptorPoolRecycler()->Get();
   if (!new_pool) {
@@ -169,6 +202,8 @@ vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
                              kDefaultBindingSize.texture_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
                              kDefaultBindingSize.buffer_bindings},
+      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic,
+                             kDefaultBindingSize.buffer_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
                              kDefaultBindingSize.storage_bindings},
       vk::DescriptorPoolSize{vk::DescriptorType::eInputAttachment,
@@ -198,4 +233,134 @@ std::optional<vk::UniqueDescriptorPool> DescriptorPoolRecyclerVK::Reuse() {
   return recycled;
 }
 
+bool DescriptorSetCacheVK::Binding::operator==(const Binding& other) const {
+  return binding == other.binding && type == other.type &&
+         buffer == other.buffer && offset == other.offset &&
+         range == other.range && image_view == other.image_view &&
+         sampler == other.sampler && image_layout == other.image_layout;
+}
+
+bool DescriptorSetCacheVK::Entry::IsExpired() const {
+  for (const std::weak_ptr<const void>& resource : resources) {
+    if (resource.expired()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+DescriptorSetCacheVK::DescriptorSetCacheVK(
+    std::weak_ptr<const ContextVK> context)
+    : context_(std::move(context)) {}
+
+DescriptorSetCacheVK::~DescriptorSetCacheVK() = default;
+
+fml::StatusOr<vk::DescriptorSet> DescriptorSetCacheVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    vk::WriteDescriptorSet* writes,
+    size_t write_count,
+    const std::shared_ptr<const void>* resources,
+    size_t resource_count,
+    const ContextVK& context_vk,
+    std::shared_ptr<const DescriptorPoolVK>& pool) {
+  std::vector<Binding> bindings;
+  bindings.reserve(write_count);
+  size_t hash = fml::HashCombine(static_cast<VkDescriptorSetLayout>(layout));
+  for (auto i = 0u; i < write_count; i++) {
+    const vk::WriteDescriptorSet& write = writes[i];
+    FML_DCHECK(write.descriptorCount == 1u);
+    Binding binding;
+    binding.binding = write.dstBinding;
+    binding.type = write.descriptorType;
+    if (write.pBufferInfo) {
+      binding.buffer = write.pBufferInfo->buffer;
+      binding.offset = write.pBufferInfo->offset;
+      binding.range = write.pBufferInfo->range;
+    }
+    if (write.pImageInfo) {
+      binding.image_view = write.pImageInfo->imageView;
+      binding.sampler = write.pImageInfo->sampler;
+      binding.image_layout = write.pImageInfo->imageLayout;
+    }
+    fml::HashCombineSeed(hash, binding.binding,
+                         static_cast<VkBuffer>(binding.buffer), binding.offset,
+                         static_cast<VkImageView>(binding.image_view),
+                         static_cast<VkSampler>(binding.sampler));
+    bindings.push_back(binding);
+  }
+
+  Lock lock(mutex_);
+  auto [begin, end] = entries_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    const Entry& entry = it->second;
+    if (entry.layout != layout || entry.bindings != bindings) {
+      continue;
+    }
+    if (entry.IsExpired()) {
+      // A handle referenced by this set may have been reused by a new
+      // resource, so the set has to be written again.
+      entries_.erase(it);
+      break;
+    }
+    statistics_.avoided_update_count++;
+    pool = pool_;
+    return entry.set;
+  }
+
+  if (!pool_ || pool_set_count_ >= kMaxCachedSets) {
+    // Encoders that used sets from the previous pool keep it alive until
+    // their command buffers complete.
+    entries_.clear();
+    pool_ = std::make_shared<DescriptorPoolVK>(context_);
+    pool_set_count_ = 0u;
+  }
+  auto set = pool_->AllocateDescriptorSets(layout, context_vk);
+  if (!set.ok()) {
+    return set;
+  }
+  pool_set_count_++;
+  for (auto i = 0u; i < write_count; i++) {
+    writes[i].dstSet = set.value();
+  }
+  context_vk.GetDevice().updateDescriptorSets(write_count, writes, 0u, {});
+  statistics_.update_count++;
+
+  Entry entry;
+  entry.layout = layout;
+  entry.bindings = std::move(bindings);
+  entry.resources.assign(resources, resources + resource_count);
+  entry.set = set.value();
+  entries_.emplace(hash, std::move(entry));
+  pool = pool_;
+  return set;
+}
+
+size_t DescriptorSetCacheVK::GetCachedSetCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+DescriptorSetCacheVK::Statistics DescriptorSetCacheVK::GetStatistics() const {
+  Lock lock(mutex_);
+  return statistics_;
+}
+
+void DescriptorSetCacheVK::EndFrame() {
+  Lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.IsExpired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  FML_TRACE_COUNTER("impeller", "DescriptorSetCacheVK",                  //
+                    reinterpret_cast<int64_t>(this),                     //
+                    "Updates", statistics_.update_count,                 //
+                    "AvoidedUpdates", statistics_.avoided_update_count,  //
+                    "CachedSets", entries_.size());
+  statistics_ = {};
+}
+
 }  // namespace impeller
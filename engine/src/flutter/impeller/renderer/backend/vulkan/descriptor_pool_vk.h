@@ -6,8 +6,12 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 
 #include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "fml/status_or.h"
+#include "impeller/base/thread_safety.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "vulkan/vulkan_handles.hpp"
 
@@ -34,9 +38,40 @@ class DescriptorPoolVK {
       const vk::DescriptorSetLayout& layout,
       const ContextVK& context_vk);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set with the given writes applied to it.
+  ///
+  ///             Identical descriptor sets are shared through the
+  ///             |DescriptorSetCacheVK| of the context, so the writes are
+  ///             only applied if there is no identical set to reuse. The
+  ///             `dstSet` of the writes is ignored.
+  ///
+  ///             The sets returned by this method may be used by other
+  ///             encoders and must never be updated.
+  ///
+  /// @param[in]  layout          The layout of the descriptor set.
+  /// @param[in]  writes          The writes that describe the set.
+  /// @param[in]  write_count     The number of writes.
+  /// @param[in]  resources       The objects that own the buffers and images
+  ///                             referenced by the writes. A set is only
+  ///                             reused while all of them are alive.
+  /// @param[in]  resource_count  The number of resources.
+  /// @param[in]  context_vk      The context.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetCachedDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const std::shared_ptr<const void>* resources,
+      size_t resource_count,
+      const ContextVK& context_vk);
+
  private:
   std::weak_ptr<const ContextVK> context_;
   std::vector<vk::UniqueDescriptorPool> pools_;
+  // The pools of the cached descriptor sets handed out by this pool. They
+  // must stay alive as long as the encoder that used the sets.
+  std::vector<std::shared_ptr<const DescriptorPoolVK>> cache_pools_;
 
   fml::Status CreateNewPool(const ContextVK& context_vk);
 
@@ -96,6 +131,114 @@ class DescriptorPoolRecyclerVK final
   DescriptorPoolRecyclerVK& operator=(const DescriptorPoolRecyclerVK&) = delete;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      A cache of descriptor sets that outlives individual frames.
+///
+///             Sets are keyed by their layout and the bindings written to
+///             them. Render passes bind uniform buffers as dynamic, with an
+///             offset of zero, so sets don't depend on where each draw's
+///             uniforms were suballocated. A set is only ever written to
+///             once, when it is first created, so the same set may be bound
+///             by any number of encoders at once without the
+///             `vkUpdateDescriptorSets` call that a freshly allocated set
+///             would need.
+///
+///             Descriptor sets that reference a destroyed buffer or image
+///             are invalid, so each cached set holds weak references to the
+///             resources it was written with and is discarded once any of
+///             them has been collected. Because encoders keep the resources
+///             they use alive until their command buffer completes, no
+///             pending command buffer can be using a discarded set.
+///
+///             Cached sets are allocated from a |DescriptorPoolVK| owned by
+///             the cache. Once `kMaxCachedSets` sets have been allocated from
+///             it, the cache is emptied and a new pool is started. Encoders
+///             keep the pools of the sets they used alive, so the old pool is
+///             only recycled once the last command buffer using it completes.
+///
+///             The cache may be used from any thread.
+class DescriptorSetCacheVK final {
+ public:
+  /// Counts of the descriptor sets requested since the end of the last frame.
+  struct Statistics {
+    /// The sets that were created and written to.
+    size_t update_count = 0u;
+    /// The sets that were reused without calling `vkUpdateDescriptorSets`.
+    size_t avoided_update_count = 0u;
+  };
+
+  /// The most sets allocated from a single pool before the cache is emptied.
+  static constexpr size_t kMaxCachedSets = 512u;
+
+  explicit DescriptorSetCacheVK(std::weak_ptr<const ContextVK> context);
+
+  ~DescriptorSetCacheVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set with the given writes applied to it. See
+  ///             |DescriptorPoolVK::GetCachedDescriptorSet|.
+  ///
+  /// @param[out] pool  The pool that the set was allocated from. It must be
+  ///                   kept alive for as long as the set is in use.
+  ///
+  fml::StatusOr<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      vk::WriteDescriptorSet* writes,
+      size_t write_count,
+      const std::shared_ptr<const void>* resources,
+      size_t resource_count,
+      const ContextVK& context_vk,
+      std::shared_ptr<const DescriptorPoolVK>& pool);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of sets that can currently be reused.
+  ///
+  size_t GetCachedSetCount() const;
+
+  Statistics GetStatistics() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame. Discards the sets whose resources
+  ///             have been collected, reports the statistics for the frame to
+  ///             the timeline and resets them.
+  ///
+  void EndFrame();
+
+ private:
+  struct Binding {
+    uint32_t binding = 0u;
+    vk::DescriptorType type = vk::DescriptorType::eSampler;
+    vk::Buffer buffer;
+    vk::DeviceSize offset = 0u;
+    vk::DeviceSize range = 0u;
+    vk::ImageView image_view;
+    vk::Sampler sampler;
+    vk::ImageLayout image_layout = vk::ImageLayout::eUndefined;
+
+    bool operator==(const Binding& other) const;
+  };
+
+  struct Entry {
+    vk::DescriptorSetLayout layout;
+    std::vector<Binding> bindings;
+    std::vector<std::weak_ptr<const void>> resources;
+    vk::DescriptorSet set;
+
+    bool IsExpired() const;
+  };
+
+  const std::weak_ptr<const ContextVK> context_;
+  mutable Mutex mutex_;
+  std::shared_ptr<DescriptorPoolVK> pool_ IPLR_GUARDED_BY(mutex_);
+  size_t pool_set_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  std::unordered_multimap<size_t, Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  Statistics statistics_ IPLR_GUARDED_BY(mutex_);
+
+  DescriptorSetCacheVK(const DescriptorSetCacheVK&) = delete;
+
+  DescriptorSetCacheVK& operator=(const DescriptorSetCacheVK&) = delete;
+};
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
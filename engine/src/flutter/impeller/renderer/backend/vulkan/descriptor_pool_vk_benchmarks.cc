@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr size_t kDrawsPerFrame = 64u;
+constexpr size_t kImageCount = 4u;
+constexpr vk::DeviceSize kUniformSize = 256u;
+constexpr vk::DeviceSize kHostBufferSize = 1024u * 1024u;
+
+enum class DescriptorSets {
+  /// Allocate and write a set for every draw.
+  kUncached,
+  /// Cache sets whose uniform buffers are bound at their offset in the host
+  /// buffer.
+  kCachedStaticUniforms,
+  /// Cache sets whose uniform buffers are dynamic, as render passes bind
+  /// them, so the offsets aren't part of the set.
+  kCachedDynamicUniforms,
+};
+
+/// Gets the descriptor sets for frames of draws that each bind a uniform
+/// buffer and one of a few images, as a render pass would.
+///
+/// The uniforms of each draw are suballocated from a host buffer, and a
+/// frame's uniforms rarely land at the same offsets as in earlier frames, so
+/// the offsets are never repeated.
+///
+/// The Vulkan functions are mocked, so this measures the CPU cost per draw
+/// of getting a set and reports the fraction of draws that reused one.
+void BM_DescriptorSetPerDraw(benchmark::State& state,
+                             DescriptorSets descriptor_sets) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  const std::shared_ptr<DescriptorSetCacheVK>& cache =
+      context->GetDescriptorSetCache();
+
+  std::shared_ptr<const void> buffer_owner = std::make_shared<int>(0);
+  std::vector<std::shared_ptr<const void>> image_owners;
+  for (size_t i = 0; i < kImageCount; i++) {
+    image_owners.push_back(std::make_shared<size_t>(i));
+  }
+  vk::Buffer buffer(reinterpret_cast<VkBuffer>(0x1000));
+  vk::Sampler sampler(reinterpret_cast<VkSampler>(0x2000));
+
+  vk::DeviceSize host_buffer_offset = 0u;
+  size_t update_count = 0u;
+  size_t avoided_update_count = 0u;
+  for (auto _ : state) {
+    DescriptorPoolVK pool(context);
+    for (size_t draw = 0; draw < kDrawsPerFrame; draw++) {
+      vk::DeviceSize uniform_offset = host_buffer_offset;
+      host_buffer_offset =
+          (host_buffer_offset + kUniformSize) % kHostBufferSize;
+      size_t image = draw % kImageCount;
+
+      vk::DescriptorBufferInfo buffer_info(
+          buffer,
+          descriptor_sets == DescriptorSets::kCachedDynamicUniforms
+              ? 0u
+              : uniform_offset,
+          kUniformSize);
+      vk::DescriptorImageInfo image_info(
+          sampler, reinterpret_cast<VkImageView>(0x3000 + image),
+          vk::ImageLayout::eShaderReadOnlyOptimal);
+
+      std::array<vk::WriteDescriptorSet, 2> writes;
+      writes[0].dstBinding = 0u;
+      writes[0].descriptorCount = 1u;
+      writes[0].descriptorType =
+          descriptor_sets == DescriptorSets::kCachedDynamicUniforms
+              ? vk::DescriptorType::eUniformBufferDynamic
+              : vk::DescriptorType::eUniformBuffer;
+      writes[0].pBufferInfo = &buffer_info;
+      writes[1].dstBinding = 1u;
+      writes[1].descriptorCount = 1u;
+      writes[1].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+      writes[1].pImageInfo = &image_info;
+      std::array<std::shared_ptr<const void>, 2> resources = {
+          buffer_owner, image_owners[image]};
+
+      fml::StatusOr<vk::DescriptorSet> set =
+          fml::Status(fml::StatusCode::kUnknown, "");
+      if (descriptor_sets == DescriptorSets::kUncached) {
+        set = pool.AllocateDescriptorSets({}, *context);
+        if (set.ok()) {
+          for (vk::WriteDescriptorSet& write : writes) {
+            write.dstSet = set.value();
+          }
+          context->GetDevice().updateDescriptorSets(writes.size(),
+                                                    writes.data(), 0u, {});
+          update_count++;
+        }
+      } else {
+        set = pool.GetCachedDescriptorSet({}, writes.data(), writes.size(),
+                                          resources.data(), resources.size(),
+                                          *context);
+      }
+      benchmark::DoNotOptimize(set);
+    }
+    DescriptorSetCacheVK::Statistics statistics = cache->GetStatistics();
+    update_count += statistics.update_count;
+    avoided_update_count += statistics.avoided_update_count;
+    cache->EndFrame();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kDrawsPerFrame);
+  state.counters["HitRate"] =
+      static_cast<double>(avoided_update_count) /
+      std::max<size_t>(update_count + avoided_update_count, 1u);
+  context->Shutdown();
+}
+
+}  // namespace
+
+// The mock records every Vulkan call, so the number of frames is bounded.
+BENCHMARK_CAPTURE(BM_DescriptorSetPerDraw,
+                  uncached,
+                  DescriptorSets::kUncached)
+    ->Iterations(1000);
+BENCHMARK_CAPTURE(BM_DescriptorSetPerDraw,
+                  cached_static_uniforms,
+                  DescriptorSets::kCachedStaticUniforms)
+    ->Iterations(1000);
+BENCHMARK_CAPTURE(BM_DescriptorSetPerDraw,
+                  cached_dynamic_uniforms,
+                  DescriptorSets::kCachedDynamicUniforms)
+    ->Iterations(1000);
+
+}  // namespace impeller
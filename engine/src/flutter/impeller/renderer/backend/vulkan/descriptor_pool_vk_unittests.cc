@@ -123,5 +123,116 @@ TEST(DescriptorPoolRecyclerVKTest, ReclaimDropsDescriptorPoolIfSizeIsExceeded) {
   context->Shutdown();
 }
 
+namespace {
+
+vk::WriteDescriptorSet MakeBufferWrite(const vk::DescriptorBufferInfo& info) {
+  vk::WriteDescriptorSet write;
+  write.dstBinding = 0u;
+  write.descriptorCount = 1u;
+  write.descriptorType = vk::DescriptorType::eUniformBuffer;
+  write.pBufferInfo = &info;
+  return write;
+}
+
+size_t CountUpdates(const ContextVK& context) {
+  auto const called = GetMockVulkanFunctions(context.GetDevice());
+  return std::count(called->begin(), called->end(), "vkUpdateDescriptorSets");
+}
+
+}  // namespace
+
+TEST(DescriptorSetCacheVKTest, IdenticalBindingsShareDescriptorSet) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const& cache = context->GetDescriptorSetCache();
+  ASSERT_NE(cache, nullptr);
+
+  std::shared_ptr<const void> resource = std::make_shared<int>(0);
+  vk::DescriptorBufferInfo info(reinterpret_cast<VkBuffer>(0x1234), 0u, 64u);
+  vk::WriteDescriptorSet write = MakeBufferWrite(info);
+  {
+    DescriptorPoolVK pool(context);
+    auto first = pool.GetCachedDescriptorSet({}, &write, 1u, &resource, 1u,
+                                             *context);
+    ASSERT_TRUE(first.ok());
+    auto second = pool.GetCachedDescriptorSet({}, &write, 1u, &resource, 1u,
+                                              *context);
+    ASSERT_TRUE(second.ok());
+    EXPECT_EQ(first.value(), second.value());
+
+    // A different range of the same buffer needs a set of its own.
+    vk::DescriptorBufferInfo other_info = info;
+    other_info.offset = 256u;
+    vk::WriteDescriptorSet other_write = MakeBufferWrite(other_info);
+    auto third = pool.GetCachedDescriptorSet({}, &other_write, 1u, &resource,
+                                             1u, *context);
+    ASSERT_TRUE(third.ok());
+    EXPECT_NE(third.value(), first.value());
+  }
+
+  EXPECT_EQ(CountUpdates(*context), 2u);
+  EXPECT_EQ(cache->GetCachedSetCount(), 2u);
+  EXPECT_EQ(cache->GetStatistics().update_count, 2u);
+  EXPECT_EQ(cache->GetStatistics().avoided_update_count, 1u);
+
+  context->Shutdown();
+}
+
+TEST(DescriptorSetCacheVKTest, CollectedResourcesInvalidateDescriptorSets) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const& cache = context->GetDescriptorSetCache();
+
+  vk::DescriptorBufferInfo info(reinterpret_cast<VkBuffer>(0x1234), 0u, 64u);
+  vk::WriteDescriptorSet write = MakeBufferWrite(info);
+  {
+    DescriptorPoolVK pool(context);
+    std::shared_ptr<const void> resource = std::make_shared<int>(0);
+    auto first = pool.GetCachedDescriptorSet({}, &write, 1u, &resource, 1u,
+                                             *context);
+    ASSERT_TRUE(first.ok());
+
+    // The handle of a collected resource may be reused by a new one, so the
+    // set written for the old resource must not be reused.
+    resource = std::make_shared<int>(1);
+    auto second = pool.GetCachedDescriptorSet({}, &write, 1u, &resource, 1u,
+                                              *context);
+    ASSERT_TRUE(second.ok());
+    EXPECT_NE(first.value(), second.value());
+    EXPECT_EQ(CountUpdates(*context), 2u);
+    EXPECT_EQ(cache->GetCachedSetCount(), 1u);
+  }
+
+  // The set is discarded at the end of the frame once its resource is gone.
+  cache->EndFrame();
+  EXPECT_EQ(cache->GetCachedSetCount(), 0u);
+  EXPECT_EQ(cache->GetStatistics().update_count, 0u);
+  EXPECT_EQ(cache->GetStatistics().avoided_update_count, 0u);
+
+  context->Shutdown();
+}
+
+TEST(DescriptorSetCacheVKTest, CacheIsEmptiedWhenItsPoolIsFull) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const& cache = context->GetDescriptorSetCache();
+
+  std::shared_ptr<const void> resource = std::make_shared<int>(0);
+  {
+    DescriptorPoolVK pool(context);
+    for (auto i = 0u; i <= DescriptorSetCacheVK::kMaxCachedSets; i++) {
+      vk::DescriptorBufferInfo info(reinterpret_cast<VkBuffer>(0x1234),
+                                    i * 256u, 64u);
+      vk::WriteDescriptorSet write = MakeBufferWrite(info);
+      ASSERT_TRUE(pool.GetCachedDescriptorSet({}, &write, 1u, &resource, 1u,
+                                              *context)
+                      .ok());
+    }
+  }
+
+  EXPECT_EQ(cache->GetCachedSetCount(), 1u);
+  EXPECT_EQ(cache->GetStatistics().update_count,
+            DescriptorSetCacheVK::kMaxCachedSets + 1u);
+
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -287,6 +287,19 @@ constexpr vk::DescriptorType ToVKDescriptorType(DescriptorType type) {
   FML_UNREACHABLE();
 }
 
+/// The descriptor type that render pipelines use for |type|.
+///
+/// Uniform buffers are suballocated from the host buffer, so each draw binds
+/// them at a different offset. Render pipelines make them dynamic and supply
+/// the offsets when binding descriptor sets, so that the sets themselves stay
+/// the same from draw to draw and can be reused.
+constexpr vk::DescriptorType ToVKRenderDescriptorType(DescriptorType type) {
+  if (type == DescriptorType::kUniformBuffer) {
+    return vk::DescriptorType::eUniformBufferDynamic;
+  }
+  return ToVKDescriptorType(type);
+}
+
 constexpr vk::DescriptorSetLayoutBinding ToVKDescriptorSetLayoutBinding(
     const DescriptorSetLayout& layout) {
   vk::DescriptorSetLayoutBinding binding;
@@ -25,6 +25,10 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
     return;
   }
 
+  if (cache_directory_.is_valid()) {
+    usage_record_ = PipelineUsageRecordRetrieve(cache_directory_);
+  }
+
   const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
 
   auto existing_cache_data = PipelineCacheDataRetrieve(
@@ -111,6 +115,9 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   if (!is_valid_) {
     return;
   }
+  if (usage_record_) {
+    PipelineUsageRecordPersist(cache_directory_, *usage_record_);
+  }
   const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
   PipelineCacheDataPersist(cache_directory_,                       //
                            vk_caps.GetPhysicalDeviceProperties(),  //
@@ -118,6 +125,11 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   );
 }
 
+const std::shared_ptr<PipelineUsageRecord>& PipelineCacheVK::GetUsageRecord()
+    const {
+  return usage_record_;
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
@@ -8,6 +8,7 @@
 #include "flutter/fml/file.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/pipeline_usage_record.h"
 
 namespace impeller {
 
@@ -33,10 +34,16 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  /// The record of the pipeline variants used by the application. It is
+  /// persisted alongside the pipeline cache data, and is null if there is
+  /// no cache directory.
+  const std::shared_ptr<PipelineUsageRecord>& GetUsageRecord() const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
   const fml::UniqueFD cache_directory_;
+  std::shared_ptr<PipelineUsageRecord> usage_record_;
   vk::UniquePipelineCache cache_;
   bool is_valid_ = false;
 
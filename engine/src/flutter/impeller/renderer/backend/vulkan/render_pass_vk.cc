@@ -322,6 +322,8 @@ void RenderPassVK::SetPipeline(
     write_set.descriptorType = vk::DescriptorType::eInputAttachment;
     write_set.pImageInfo = &image_workspace_[bound_image_offset_ - 1];
 
+    resource_workspace_[descriptor_write_offset_] =
+        TextureVK::Cast(*color_image_vk_).GetTextureSource();
     write_workspace_[descriptor_write_offset_++] = write_set;
   }
 }
@@ -460,9 +462,26 @@ fml::Status RenderPassVK::Draw() {
   const auto& context_vk = ContextVK::Cast(*context_);
   const auto& pipeline_vk = PipelineVK::Cast(*pipeline_);
 
-  auto descriptor_result =
-      command_buffer_->GetEncoder()->AllocateDescriptorSets(
-          pipeline_vk.GetDescriptorSetLayout(), context_vk);
+  fml::StatusOr<vk::DescriptorSet> descriptor_result =
+      fml::Status(fml::StatusCode::kUnknown, "");
+  if (immutable_sampler_) {
+    // Pipeline variants for immutable samplers are created on demand, so the
+    // lifetime of their descriptor set layouts isn't tracked by the cache.
+    descriptor_result = command_buffer_->GetEncoder()->AllocateDescriptorSets(
+        pipeline_vk.GetDescriptorSetLayout(), context_vk);
+    if (descriptor_result.ok()) {
+      for (auto i = 0u; i < descriptor_write_offset_; i++) {
+        write_workspace_[i].dstSet = descriptor_result.value();
+      }
+      context_vk.GetDevice().updateDescriptorSets(
+          descriptor_write_offset_, write_workspace_.data(), 0u, {});
+    }
+  } else {
+    descriptor_result = command_buffer_->GetEncoder()->GetCachedDescriptorSet(
+        pipeline_vk.GetDescriptorSetLayout(), write_workspace_.data(),
+        descriptor_write_offset_, resource_workspace_.data(),
+        descriptor_write_offset_, context_vk);
+  }
   if (!descriptor_result.ok()) {
     return fml::Status(fml::StatusCode::kAborted,
                        "Could not allocate descriptor sets.");
@@ -472,21 +491,14 @@ fml::Status RenderPassVK::Draw() {
   command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
                                   pipeline_vk.GetPipeline());
 
-  for (auto i = 0u; i < descriptor_write_offset_; i++) {
-    write_workspace_[i].dstSet = descriptor_set;
-  }
-
-  context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
-                                              write_workspace_.data(), 0u, {});
-
   command_buffer_vk_.bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,  // bind point
       pipeline_layout,                   // layout
       0,                                 // first set
       1,                                 // set count
       &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
+      dynamic_offset_count_,             // offset count
+      dynamic_offsets_.data()            // offsets
   );
 
   if (pipeline_uses_input_attachments_) {
@@ -518,7 +530,11 @@ fml::Status RenderPassVK::Draw() {
   has_index_buffer_ = false;
   bound_image_offset_ = 0u;
   bound_buffer_offset_ = 0u;
+  for (auto i = 0u; i < descriptor_write_offset_; i++) {
+    resource_workspace_[i].reset();
+  }
   descriptor_write_offset_ = 0u;
+  dynamic_offset_count_ = 0u;
   instance_count_ = 1u;
   base_vertex_ = 0u;
   vertex_count_ = 0u;
@@ -565,6 +581,20 @@ bool RenderPassVK::BindResource(size_t binding,
   }
 
   uint32_t offset = view.range.offset;
+  vk::DescriptorType descriptor_type = ToVKRenderDescriptorType(type);
+  if (descriptor_type == vk::DescriptorType::eUniformBufferDynamic) {
+    // The offset is supplied when the descriptor set is bound, so that the
+    // set can be reused by draws whose uniforms are elsewhere in the buffer.
+    size_t index = dynamic_offset_count_++;
+    while (index > 0 && dynamic_offset_bindings_[index - 1] > binding) {
+      dynamic_offset_bindings_[index] = dynamic_offset_bindings_[index - 1];
+      dynamic_offsets_[index] = dynamic_offsets_[index - 1];
+      index--;
+    }
+    dynamic_offset_bindings_[index] = binding;
+    dynamic_offsets_[index] = offset;
+    offset = 0u;
+  }
 
   vk::DescriptorBufferInfo buffer_info;
   buffer_info.buffer = buffer;
@@ -575,9 +605,10 @@ bool RenderPassVK::BindResource(size_t binding,
   vk::WriteDescriptorSet write_set;
   write_set.dstBinding = binding;
   write_set.descriptorCount = 1u;
-  write_set.descriptorType = ToVKDescriptorType(type);
+  write_set.descriptorType = descriptor_type;
   write_set.pBufferInfo = &buffer_workspace_[bound_buffer_offset_ - 1];
 
+  resource_workspace_[descriptor_write_offset_] = device_buffer;
   write_workspace_[descriptor_write_offset_++] = write_set;
   return true;
 }
@@ -617,6 +648,7 @@ bool RenderPassVK::BindResource(ShaderStage stage,
   write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
   write_set.pImageInfo = &image_workspace_[bound_image_offset_ - 1];
 
+  resource_workspace_[descriptor_write_offset_] = texture_vk.GetTextureSource();
   write_workspace_[descriptor_write_offset_++] = write_set;
   return true;
 }
@@ -41,9 +41,17 @@ class RenderPassVK final : public RenderPass {
   std::array<vk::DescriptorBufferInfo, kMaxBindings> buffer_workspace_;
   std::array<vk::WriteDescriptorSet, kMaxBindings + kMaxBindings>
       write_workspace_;
+  // The owners of the buffers and images referenced by the writes.
+  std::array<std::shared_ptr<const void>, kMaxBindings + kMaxBindings>
+      resource_workspace_;
+  // The offsets of the dynamic uniform buffers, ordered by binding as
+  // vkCmdBindDescriptorSets expects.
+  std::array<uint32_t, kMaxBindings> dynamic_offset_bindings_;
+  std::array<uint32_t, kMaxBindings> dynamic_offsets_;
   size_t bound_image_offset_ = 0u;
   size_t bound_buffer_offset_ = 0u;
   size_t descriptor_write_offset_ = 0u;
+  size_t dynamic_offset_count_ = 0u;
   size_t instance_count_ = 1u;
   size_t base_vertex_ = 0u;
   size_t vertex_count_ = 0u;
@@ -7,6 +7,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain/khr/khr_swapchain_vk.h"
 #include "impeller/renderer/surface.h"
 
@@ -87,6 +88,7 @@ std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
         .DidAcquireSurfaceFrame();
   }
   parent_->GetCommandPoolRecycler()->Dispose();
+  parent_->GetDescriptorSetCache()->EndFrame();
   parent_->GetResourceAllocator()->DebugTraceMemoryStatistics();
   return surface;
 }
@@ -103,6 +105,11 @@ void SurfaceContextVK::InitializeCommonlyUsedShadersIfNeeded() const {
   parent_->InitializeCommonlyUsedShadersIfNeeded();
 }
 
+std::shared_ptr<PipelineUsageRecord> SurfaceContextVK::GetPipelineUsageRecord()
+    const {
+  return parent_->GetPipelineUsageRecord();
+}
+
 void SurfaceContextVK::DisposeThreadLocalCachedResources() {
   parent_->DisposeThreadLocalCachedResources();
 }
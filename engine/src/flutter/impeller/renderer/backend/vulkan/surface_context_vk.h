@@ -83,6 +83,9 @@ class SurfaceContextVK : public Context,
   // |Context|
   void InitializeCommonlyUsedShadersIfNeeded() const override;
 
+  // |Context|
+  std::shared_ptr<PipelineUsageRecord> GetPipelineUsageRecord() const override;
+
   // |Context|
   void DisposeThreadLocalCachedResources() override;
 
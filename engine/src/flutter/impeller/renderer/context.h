@@ -20,6 +20,7 @@ namespace impeller {
 class ShaderLibrary;
 class CommandBuffer;
 class PipelineLibrary;
+class PipelineUsageRecord;
 
 //------------------------------------------------------------------------------
 /// @brief      To do anything rendering related with Impeller, you need a
@@ -196,6 +197,15 @@ class Context {
   /// shader variants, as well as forcing driver initialization.
   virtual void InitializeCommonlyUsedShadersIfNeeded() const {}
 
+  /// Returns the record of the pipeline variants used by this application,
+  /// or null if the backend cannot persist one between launches.
+  ///
+  /// Renderers record the variants they create on first use and create the
+  /// variants recorded by a previous launch ahead of time.
+  virtual std::shared_ptr<PipelineUsageRecord> GetPipelineUsageRecord() const {
+    return nullptr;
+  }
+
   /// Dispose resources that are cached on behalf of the current thread.
   ///
   /// Some backends such as Vulkan may cache resources that can be reused while
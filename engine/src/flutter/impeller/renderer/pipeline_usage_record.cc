@@ -0,0 +1,191 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/pipeline_usage_record.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+static constexpr const char* kPipelineUsageRecordFileName =
+    "flutter.impeller.pipeline_usage";
+
+// The data starts with the magic number, the version and the number of
+// entries. Each entry is the length of the pipeline name, the name itself
+// and the variant key. All integers are in host byte order.
+static constexpr uint32_t kMagic = 0x49505552;  // IPUR
+static constexpr uint32_t kVersion = 1u;
+
+namespace {
+
+class Reader {
+ public:
+  explicit Reader(const fml::Mapping& data)
+      : data_(data.GetMapping()), size_(data.GetSize()) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    if (size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(size_t length, std::string* value) {
+    if (size_ - offset_ < length) {
+      return false;
+    }
+    value->assign(reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return true;
+  }
+
+  bool IsAtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0u;
+};
+
+template <typename T>
+void Write(std::vector<uint8_t>& data, T value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+}  // namespace
+
+PipelineUsageRecord::PipelineUsageRecord(std::vector<Entry> entries) {
+  for (auto& entry : entries) {
+    if (entries_.size() == kMaxEntries) {
+      break;
+    }
+    if (known_entries_.emplace(entry.pipeline_name, entry.variant_key)
+            .second) {
+      entries_.push_back(std::move(entry));
+    }
+  }
+}
+
+PipelineUsageRecord::~PipelineUsageRecord() = default;
+
+bool PipelineUsageRecord::Record(std::string_view pipeline_name,
+                                 uint64_t variant_key) {
+  Lock lock(mutex_);
+  if (entries_.size() == kMaxEntries) {
+    return false;
+  }
+  if (!known_entries_.emplace(std::string{pipeline_name}, variant_key)
+           .second) {
+    return false;
+  }
+  entries_.push_back({std::string{pipeline_name}, variant_key});
+  dirty_ = true;
+  return true;
+}
+
+std::vector<PipelineUsageRecord::Entry> PipelineUsageRecord::GetEntries()
+    const {
+  Lock lock(mutex_);
+  return entries_;
+}
+
+size_t PipelineUsageRecord::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+bool PipelineUsageRecord::IsDirty() const {
+  return dirty_;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageRecord::Serialize() {
+  Lock lock(mutex_);
+  std::vector<uint8_t> data;
+  Write(data, kMagic);
+  Write(data, kVersion);
+  Write(data, static_cast<uint32_t>(entries_.size()));
+  for (const auto& entry : entries_) {
+    Write(data, static_cast<uint32_t>(entry.pipeline_name.size()));
+    data.insert(data.end(), entry.pipeline_name.begin(),
+                entry.pipeline_name.end());
+    Write(data, entry.variant_key);
+  }
+  dirty_ = false;
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+std::optional<std::vector<PipelineUsageRecord::Entry>>
+PipelineUsageRecord::Deserialize(const fml::Mapping& data) {
+  if (data.GetMapping() == nullptr) {
+    return std::nullopt;
+  }
+  Reader reader(data);
+  uint32_t magic = 0u;
+  uint32_t version = 0u;
+  uint32_t count = 0u;
+  if (!reader.Read(&magic) || magic != kMagic ||
+      !reader.Read(&version) || version != kVersion ||
+      !reader.Read(&count) || count > kMaxEntries) {
+    return std::nullopt;
+  }
+  std::vector<Entry> entries(count);
+  for (auto& entry : entries) {
+    uint32_t name_length = 0u;
+    if (!reader.Read(&name_length) ||
+        !reader.ReadString(name_length, &entry.pipeline_name) ||
+        !reader.Read(&entry.variant_key)) {
+      return std::nullopt;
+    }
+  }
+  if (!reader.IsAtEnd()) {
+    return std::nullopt;
+  }
+  return entries;
+}
+
+bool PipelineUsageRecordPersist(const fml::UniqueFD& cache_directory,
+                                PipelineUsageRecord& record) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  if (!record.IsDirty()) {
+    return true;
+  }
+  auto data = record.Serialize();
+  if (!fml::WriteAtomically(cache_directory, kPipelineUsageRecordFileName,
+                            *data)) {
+    VALIDATION_LOG << "Could not write pipeline usage record to disk.";
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<PipelineUsageRecord> PipelineUsageRecordRetrieve(
+    const fml::UniqueFD& cache_directory) {
+  if (!cache_directory.is_valid()) {
+    return std::make_shared<PipelineUsageRecord>();
+  }
+  auto on_disk_data = fml::FileMapping::CreateReadOnly(
+      cache_directory, kPipelineUsageRecordFileName);
+  if (!on_disk_data) {
+    return std::make_shared<PipelineUsageRecord>();
+  }
+  auto entries = PipelineUsageRecord::Deserialize(*on_disk_data);
+  if (!entries.has_value()) {
+    FML_LOG(WARNING) << "Persisted pipeline usage record is malformed or was "
+                        "written by an incompatible version. Ignoring.";
+    return std::make_shared<PipelineUsageRecord>();
+  }
+  return std::make_shared<PipelineUsageRecord>(std::move(entries.value()));
+}
+
+}  // namespace impeller
@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_RECORD_H_
+#define FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_RECORD_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A record of the pipeline variants that were used by an
+///             application, in the order in which they were first used.
+///
+///             Each entry names a family of pipelines (usually all the
+///             variants of one shader) and an opaque key that identifies
+///             the variant within that family. The renderer that records
+///             the entries is the only one that can interpret them.
+///
+///             The record is persisted between launches so that the
+///             variants that were needed by the previous launch can be
+///             created ahead of their first use. Entries from the previous
+///             launch are retained, so variants that were created ahead of
+///             time don't need to be recorded again.
+///
+///             Records are thread-safe.
+///
+class PipelineUsageRecord {
+ public:
+  struct Entry {
+    std::string pipeline_name;
+    uint64_t variant_key = 0u;
+
+    bool operator==(const Entry& other) const {
+      return pipeline_name == other.pipeline_name &&
+             variant_key == other.variant_key;
+    }
+  };
+
+  /// The most entries a record will hold. Anything beyond this is more
+  /// likely to be a bug than an application that actually needs it.
+  static constexpr size_t kMaxEntries = 4096u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a record that starts out with the given entries,
+  ///             usually the entries persisted by a previous launch.
+  ///
+  explicit PipelineUsageRecord(std::vector<Entry> entries = {});
+
+  ~PipelineUsageRecord();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the use of a pipeline variant. Variants that are
+  ///             already in the record are ignored.
+  ///
+  /// @return     If the variant was added to the record.
+  ///
+  bool Record(std::string_view pipeline_name, uint64_t variant_key);
+
+  //----------------------------------------------------------------------------
+  /// @return     A copy of the entries in the order they were first used.
+  ///
+  std::vector<Entry> GetEntries() const;
+
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     If entries were recorded since the record was created or
+  ///             last serialized.
+  ///
+  bool IsDirty() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serialize the entries and mark the record as clean.
+  ///
+  std::unique_ptr<fml::Mapping> Serialize();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read the entries from data created by |Serialize|.
+  ///
+  /// @return     The entries, or std::nullopt if the data is malformed or
+  ///             was written by an incompatible version.
+  ///
+  static std::optional<std::vector<Entry>> Deserialize(
+      const fml::Mapping& data);
+
+ private:
+  mutable Mutex mutex_;
+  std::vector<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  std::set<std::pair<std::string, uint64_t>> known_entries_
+      IPLR_GUARDED_BY(mutex_);
+  std::atomic_bool dirty_ = false;
+
+  PipelineUsageRecord(const PipelineUsageRecord&) = delete;
+
+  PipelineUsageRecord& operator=(const PipelineUsageRecord&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Persist the record to a file in the given cache directory if
+///             anything was recorded since it was last persisted.
+///
+/// @param[in]  cache_directory  The cache directory.
+/// @param[in]  record           The record.
+///
+/// @return     If the record is up to date on disk.
+///
+bool PipelineUsageRecordPersist(const fml::UniqueFD& cache_directory,
+                                PipelineUsageRecord& record);
+
+//------------------------------------------------------------------------------
+/// @brief      Retrieve the record persisted in the given cache directory.
+///
+/// @param[in]  cache_directory  The cache directory.
+///
+/// @return     The persisted record, or an empty record if there is none or
+///             it could not be read.
+///
+std::shared_ptr<PipelineUsageRecord> PipelineUsageRecordRetrieve(
+    const fml::UniqueFD& cache_directory);
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_PIPELINE_USAGE_RECORD_H_
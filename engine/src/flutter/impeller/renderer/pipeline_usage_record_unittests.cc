@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/pipeline_usage_record.h"
+
+namespace impeller {
+namespace testing {
+
+using Entry = PipelineUsageRecord::Entry;
+
+TEST(PipelineUsageRecordTest, RecordsEntriesInOrderOfFirstUse) {
+  PipelineUsageRecord record;
+  EXPECT_FALSE(record.IsDirty());
+  EXPECT_TRUE(record.Record("SolidFill", 2u));
+  EXPECT_TRUE(record.Record("Texture", 1u));
+  EXPECT_TRUE(record.Record("SolidFill", 1u));
+  EXPECT_FALSE(record.Record("Texture", 1u));
+  EXPECT_TRUE(record.IsDirty());
+
+  std::vector<Entry> expected = {
+      {"SolidFill", 2u},
+      {"Texture", 1u},
+      {"SolidFill", 1u},
+  };
+  EXPECT_EQ(record.GetEntries(), expected);
+  EXPECT_EQ(record.GetEntryCount(), 3u);
+}
+
+TEST(PipelineUsageRecordTest, EntriesFromPreviousLaunchAreNotRecordedAgain) {
+  PipelineUsageRecord record({{"SolidFill", 2u}, {"SolidFill", 2u}});
+  EXPECT_EQ(record.GetEntryCount(), 1u);
+  EXPECT_FALSE(record.IsDirty());
+  EXPECT_FALSE(record.Record("SolidFill", 2u));
+  EXPECT_FALSE(record.IsDirty());
+}
+
+TEST(PipelineUsageRecordTest, CanSerializeAndDeserialize) {
+  PipelineUsageRecord record;
+  record.Record("SolidFill", 0x0004000300020101u);
+  record.Record("GaussianBlur", 7u);
+  record.Record("", 0u);
+
+  auto data = record.Serialize();
+  ASSERT_NE(data, nullptr);
+  EXPECT_FALSE(record.IsDirty());
+
+  auto entries = PipelineUsageRecord::Deserialize(*data);
+  ASSERT_TRUE(entries.has_value());
+  EXPECT_EQ(entries.value(), record.GetEntries());
+}
+
+TEST(PipelineUsageRecordTest, RejectsMalformedData) {
+  PipelineUsageRecord record;
+  record.Record("SolidFill", 1u);
+  auto data = record.Serialize();
+  const uint8_t* bytes = data->GetMapping();
+  const size_t size = data->GetSize();
+
+  // Truncated.
+  for (size_t length = 0u; length < size; length++) {
+    fml::NonOwnedMapping truncated(bytes, length);
+    EXPECT_FALSE(PipelineUsageRecord::Deserialize(truncated).has_value());
+  }
+
+  // Trailing data.
+  {
+    std::vector<uint8_t> padded(bytes, bytes + size);
+    padded.push_back(0u);
+    fml::DataMapping mapping(padded);
+    EXPECT_FALSE(PipelineUsageRecord::Deserialize(mapping).has_value());
+  }
+
+  // Bad magic.
+  {
+    std::vector<uint8_t> copy(bytes, bytes + size);
+    copy[0] ^= 0xFF;
+    fml::DataMapping mapping(copy);
+    EXPECT_FALSE(PipelineUsageRecord::Deserialize(mapping).has_value());
+  }
+
+  // Bad version.
+  {
+    std::vector<uint8_t> copy(bytes, bytes + size);
+    copy[sizeof(uint32_t)] ^= 0xFF;
+    fml::DataMapping mapping(copy);
+    EXPECT_FALSE(PipelineUsageRecord::Deserialize(mapping).has_value());
+  }
+
+  // Too many entries.
+  {
+    std::vector<uint8_t> copy(bytes, bytes + size);
+    const uint32_t count = PipelineUsageRecord::kMaxEntries + 1u;
+    std::memcpy(copy.data() + 2 * sizeof(uint32_t), &count, sizeof(count));
+    fml::DataMapping mapping(copy);
+    EXPECT_FALSE(PipelineUsageRecord::Deserialize(mapping).has_value());
+  }
+}
+
+TEST(PipelineUsageRecordTest, CanPersistAndRetrieve) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  {
+    auto record = PipelineUsageRecordRetrieve(temp_dir.fd());
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->GetEntryCount(), 0u);
+    record->Record("SolidFill", 1u);
+    record->Record("Texture", 2u);
+    ASSERT_TRUE(PipelineUsageRecordPersist(temp_dir.fd(), *record));
+    EXPECT_FALSE(record->IsDirty());
+  }
+
+  auto record = PipelineUsageRecordRetrieve(temp_dir.fd());
+  ASSERT_NE(record, nullptr);
+  std::vector<Entry> expected = {
+      {"SolidFill", 1u},
+      {"Texture", 2u},
+  };
+  EXPECT_EQ(record->GetEntries(), expected);
+  EXPECT_FALSE(record->IsDirty());
+}
+
+TEST(PipelineUsageRecordTest, MalformedRecordOnDiskIsIgnored) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  fml::DataMapping garbage(std::string("garbage"));
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(),
+                                   "flutter.impeller.pipeline_usage", garbage));
+
+  auto record = PipelineUsageRecordRetrieve(temp_dir.fd());
+  ASSERT_NE(record, nullptr);
+  EXPECT_EQ(record->GetEntryCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
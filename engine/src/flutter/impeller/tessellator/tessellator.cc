@@ -223,13 +223,59 @@ Tessellator::Trigs Tessellator::GetTrigsForDivisions(size_t divisions) {
 using TessellatedVertexProc = Tessellator::TessellatedVertexProc;
 using EllipticalVertexGenerator = Tessellator::EllipticalVertexGenerator;
 
+// Writes generated vertices to consecutive elements of an array.
+class Tessellator::ArrayVertexWriter {
+ public:
+  explicit ArrayVertexWriter(Point* vertices) : next_(vertices) {}
+
+  void Write(const Point& point) { *next_++ = point; }
+
+  Point* end() const { return next_; }
+
+ private:
+  Point* next_;
+};
+
+// Delivers generated vertices to a callback one at a time.
+class Tessellator::CallbackVertexWriter {
+ public:
+  explicit CallbackVertexWriter(const TessellatedVertexProc& proc)
+      : proc_(proc) {}
+
+  void Write(const Point& point) { proc_(point); }
+
+ private:
+  const TessellatedVertexProc& proc_;
+};
+
+template <Tessellator::EllipticalGenerator<Tessellator::ArrayVertexWriter>*
+              Generate>
+Point* Tessellator::WriteVertices(const Trigs& trigs,
+                                  const EllipticalVertexGenerator::Data& data,
+                                  Point* vertices) {
+  ArrayVertexWriter writer(vertices);
+  Generate(trigs, data, writer);
+  return writer.end();
+}
+
+template <Tessellator::EllipticalGenerator<Tessellator::CallbackVertexWriter>*
+              Generate>
+void Tessellator::DeliverVertices(const Trigs& trigs,
+                                  const EllipticalVertexGenerator::Data& data,
+                                  const TessellatedVertexProc& proc) {
+  CallbackVertexWriter writer(proc);
+  Generate(trigs, data, writer);
+}
+
 EllipticalVertexGenerator::EllipticalVertexGenerator(
     EllipticalVertexGenerator::GeneratorProc& generator,
+    EllipticalVertexGenerator::StreamingGeneratorProc& streaming_generator,
     Trigs&& trigs,
     PrimitiveType triangle_type,
     size_t vertices_per_trig,
     Data&& data)
     : impl_(generator),
+      streaming_impl_(streaming_generator),
       trigs_(std::move(trigs)),
       data_(data),
       vertices_per_trig_(vertices_per_trig) {}
@@ -240,14 +286,16 @@ EllipticalVertexGenerator Tessellator::FilledCircle(
     Scalar radius) {
   size_t divisions =
       ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledCircle,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = {radius, radius},
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      WriteVertices<GenerateFilledCircle>,
+      DeliverVertices<GenerateFilledCircle>,
+      GetTrigsForDivisions(divisions),
+      PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = {radius, radius},
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::StrokedCircle(
@@ -258,14 +306,16 @@ EllipticalVertexGenerator Tessellator::StrokedCircle(
   if (half_width > 0) {
     auto divisions = ComputeQuadrantDivisions(
         view_transform.GetMaxBasisLengthXY() * radius + half_width);
-    return EllipticalVertexGenerator(Tessellator::GenerateStrokedCircle,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 8,
-                                     {
-                                         .reference_centers = {center, center},
-                                         .radii = {radius, radius},
-                                         .half_width = half_width,
-                                     });
+    return EllipticalVertexGenerator(
+        WriteVertices<GenerateStrokedCircle>,
+        DeliverVertices<GenerateStrokedCircle>,
+        GetTrigsForDivisions(divisions),
+        PrimitiveType::kTriangleStrip, 8,
+        {
+            .reference_centers = {center, center},
+            .radii = {radius, radius},
+            .half_width = half_width,
+        });
   } else {
     return FilledCircle(view_transform, center, radius);
   }
@@ -281,14 +331,16 @@ EllipticalVertexGenerator Tessellator::RoundCapLine(
   if (length > kEhCloseEnough) {
     auto divisions =
         ComputeQuadrantDivisions(view_transform.GetMaxBasisLengthXY() * radius);
-    return EllipticalVertexGenerator(Tessellator::GenerateRoundCapLine,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers = {p0, p1},
-                                         .radii = {radius, radius},
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        WriteVertices<GenerateRoundCapLine>,
+        DeliverVertices<GenerateRoundCapLine>,
+        GetTrigsForDivisions(divisions),
+        PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers = {p0, p1},
+            .radii = {radius, radius},
+            .half_width = -1.0f,
+        });
   } else {
     return FilledCircle(view_transform, p0, radius);
   }
@@ -305,14 +357,16 @@ EllipticalVertexGenerator Tessellator::FilledEllipse(
   auto divisions = ComputeQuadrantDivisions(
       view_transform.GetMaxBasisLengthXY() * max_radius);
   auto center = bounds.GetCenter();
-  return EllipticalVertexGenerator(Tessellator::GenerateFilledEllipse,
-                                   GetTrigsForDivisions(divisions),
-                                   PrimitiveType::kTriangleStrip, 4,
-                                   {
-                                       .reference_centers = {center, center},
-                                       .radii = bounds.GetSize() * 0.5f,
-                                       .half_width = -1.0f,
-                                   });
+  return EllipticalVertexGenerator(
+      WriteVertices<GenerateFilledEllipse>,
+      DeliverVertices<GenerateFilledEllipse>,
+      GetTrigsForDivisions(divisions),
+      PrimitiveType::kTriangleStrip, 4,
+      {
+          .reference_centers = {center, center},
+          .radii = bounds.GetSize() * 0.5f,
+          .half_width = -1.0f,
+      });
 }
 
 EllipticalVertexGenerator Tessellator::FilledRoundRect(
@@ -326,27 +380,30 @@ EllipticalVertexGenerator Tessellator::FilledRoundRect(
         view_transform.GetMaxBasisLengthXY() * max_radius);
     auto upper_left = bounds.GetLeftTop() + radii;
     auto lower_right = bounds.GetRightBottom() - radii;
-    return EllipticalVertexGenerator(Tessellator::GenerateFilledRoundRect,
-                                     GetTrigsForDivisions(divisions),
-                                     PrimitiveType::kTriangleStrip, 4,
-                                     {
-                                         .reference_centers =
-                                             {
-                                                 upper_left,
-                                                 lower_right,
-                                             },
-                                         .radii = radii,
-                                         .half_width = -1.0f,
-                                     });
+    return EllipticalVertexGenerator(
+        WriteVertices<GenerateFilledRoundRect>,
+        DeliverVertices<GenerateFilledRoundRect>,
+        GetTrigsForDivisions(divisions),
+        PrimitiveType::kTriangleStrip, 4,
+        {
+            .reference_centers =
+                {
+                    upper_left,
+                    lower_right,
+                },
+            .radii = radii,
+            .half_width = -1.0f,
+        });
   } else {
     return FilledEllipse(view_transform, bounds);
   }
 }
 
+template <typename VertexWriter>
 void Tessellator::GenerateFilledCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexWriter& writer) {
   auto center = data.reference_centers[0];
   auto radius = data.radii.width;
 
@@ -357,8 +414,8 @@ void Tessellator::GenerateFilledCircle(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radius;
-    proc({center.x - offset.x, center.y + offset.y});
-    proc({center.x - offset.x, center.y - offset.y});
+    writer.Write(Point(center.x - offset.x, center.y + offset.y));
+    writer.Write(Point(center.x - offset.x, center.y - offset.y));
   }
 
   // The second half of the circle should be iterated in reverse, but
@@ -368,15 +425,16 @@ void Tessellator::GenerateFilledCircle(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = trig * radius;
-    proc({center.x + offset.y, center.y + offset.x});
-    proc({center.x + offset.y, center.y - offset.x});
+    writer.Write(Point(center.x + offset.y, center.y + offset.x));
+    writer.Write(Point(center.x + offset.y, center.y - offset.x));
   }
 }
 
+template <typename VertexWriter>
 void Tessellator::GenerateStrokedCircle(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexWriter& writer) {
   auto center = data.reference_centers[0];
 
   FML_DCHECK(center == data.reference_centers[1]);
@@ -395,8 +453,8 @@ void Tessellator::GenerateStrokedCircle(
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x - outer.x, center.y - outer.y});
-    proc({center.x - inner.x, center.y - inner.y});
+    writer.Write(Point(center.x - outer.x, center.y - outer.y));
+    writer.Write(Point(center.x - inner.x, center.y - inner.y));
   }
 
   // The even quadrants of the circle should be iterated in reverse, but
@@ -407,31 +465,32 @@ void Tessellator::GenerateStrokedCircle(
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x + outer.y, center.y - outer.x});
-    proc({center.x + inner.y, center.y - inner.x});
+    writer.Write(Point(center.x + outer.y, center.y - outer.x));
+    writer.Write(Point(center.x + inner.y, center.y - inner.x));
   }
 
   // Quadrant 3:
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x + outer.x, center.y + outer.y});
-    proc({center.x + inner.x, center.y + inner.y});
+    writer.Write(Point(center.x + outer.x, center.y + outer.y));
+    writer.Write(Point(center.x + inner.x, center.y + inner.y));
   }
 
   // Quadrant 4:
   for (auto& trig : trigs) {
     auto outer = trig * outer_radius;
     auto inner = trig * inner_radius;
-    proc({center.x - outer.y, center.y + outer.x});
-    proc({center.x - inner.y, center.y + inner.x});
+    writer.Write(Point(center.x - outer.y, center.y + outer.x));
+    writer.Write(Point(center.x - inner.y, center.y + inner.x));
   }
 }
 
+template <typename VertexWriter>
 void Tessellator::GenerateRoundCapLine(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexWriter& writer) {
   auto p0 = data.reference_centers[0];
   auto p1 = data.reference_centers[1];
   auto radius = data.radii.width;
@@ -446,8 +505,8 @@ void Tessellator::GenerateRoundCapLine(
   for (auto& trig : trigs) {
     auto relative_along = along * trig.cos;
     auto relative_across = across * trig.sin;
-    proc(p0 - relative_along + relative_across);
-    proc(p0 - relative_along - relative_across);
+    writer.Write(p0 - relative_along + relative_across);
+    writer.Write(p0 - relative_along - relative_across);
   }
 
   // The second half of the round caps should be iterated in reverse, but
@@ -456,15 +515,16 @@ void Tessellator::GenerateRoundCapLine(
   for (auto& trig : trigs) {
     auto relative_along = along * trig.sin;
     auto relative_across = across * trig.cos;
-    proc(p1 + relative_along + relative_across);
-    proc(p1 + relative_along - relative_across);
+    writer.Write(p1 + relative_along + relative_across);
+    writer.Write(p1 + relative_along - relative_across);
   }
 }
 
+template <typename VertexWriter>
 void Tessellator::GenerateFilledEllipse(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexWriter& writer) {
   auto center = data.reference_centers[0];
   auto radii = data.radii;
 
@@ -474,8 +534,8 @@ void Tessellator::GenerateFilledEllipse(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radii;
-    proc({center.x - offset.x, center.y + offset.y});
-    proc({center.x - offset.x, center.y - offset.y});
+    writer.Write(Point(center.x - offset.x, center.y + offset.y));
+    writer.Write(Point(center.x - offset.x, center.y - offset.y));
   }
 
   // The second half of the circle should be iterated in reverse, but
@@ -485,15 +545,16 @@ void Tessellator::GenerateFilledEllipse(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = Point(trig.sin * radii.width, trig.cos * radii.height);
-    proc({center.x + offset.x, center.y + offset.y});
-    proc({center.x + offset.x, center.y - offset.y});
+    writer.Write(Point(center.x + offset.x, center.y + offset.y));
+    writer.Write(Point(center.x + offset.x, center.y - offset.y));
   }
 }
 
+template <typename VertexWriter>
 void Tessellator::GenerateFilledRoundRect(
     const Trigs& trigs,
     const EllipticalVertexGenerator::Data& data,
-    const TessellatedVertexProc& proc) {
+    VertexWriter& writer) {
   Scalar left = data.reference_centers[0].x;
   Scalar top = data.reference_centers[0].y;
   Scalar right = data.reference_centers[1].x;
@@ -505,8 +566,8 @@ void Tessellator::GenerateFilledRoundRect(
   // Quadrant 1 connecting with Quadrant 4:
   for (auto& trig : trigs) {
     auto offset = trig * radii;
-    proc({left - offset.x, bottom + offset.y});
-    proc({left - offset.x, top - offset.y});
+    writer.Write(Point(left - offset.x, bottom + offset.y));
+    writer.Write(Point(left - offset.x, top - offset.y));
   }
 
   // The second half of the round rect should be iterated in reverse, but
@@ -516,8 +577,8 @@ void Tessellator::GenerateFilledRoundRect(
   // Quadrant 2 connecting with Quadrant 2:
   for (auto& trig : trigs) {
     auto offset = Point(trig.sin * radii.width, trig.cos * radii.height);
-    proc({right + offset.x, bottom + offset.y});
-    proc({right + offset.x, top - offset.y});
+    writer.Write(Point(right + offset.x, bottom + offset.y));
+    writer.Write(Point(right + offset.x, top - offset.y));
   }
 }
 
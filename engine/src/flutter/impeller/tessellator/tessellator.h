@@ -98,21 +98,32 @@ class Tessellator {
     virtual PrimitiveType GetTriangleType() const = 0;
 
     /// @brief  Returns the number of vertices that the generator plans to
-    ///         produce, if known.
+    ///         produce.
     ///
-    ///         This value is advisory only and can be used to reserve space
-    ///         where the vertices will be placed, but the count may be an
-    ///         estimate.
-    ///
-    ///         Implementations are encouraged to avoid overestimating
-    ///         the count by too large a number and to provide a best
-    ///         guess so as to minimize potential buffer reallocations
-    ///         as the vertices are delivered.
+    ///         This value is used to size the space where the vertices will
+    ///         be placed, so it must never be smaller than the number of
+    ///         vertices that are actually produced. Implementations are
+    ///         encouraged to avoid overestimating the count by too large a
+    ///         number.
     virtual size_t GetVertexCount() const = 0;
 
+    /// @brief  Generate the vertices and write them in the necessary
+    ///         order (as required by the PrimitiveType) to the given
+    ///         array, which must have room for |GetVertexCount| vertices.
+    ///
+    ///         This is the preferred way to produce the vertices as it
+    ///         can write them directly into a |HostBuffer| allocation
+    ///         without any per-vertex indirection.
+    ///
+    /// @return The number of vertices written.
+    virtual size_t GenerateVertices(Point* vertices) const = 0;
+
     /// @brief  Generate the vertices and deliver them in the necessary
     ///         order (as required by the PrimitiveType) to the given
     ///         callback function.
+    ///
+    ///         The vertices are delivered one at a time as they are
+    ///         generated, without being stored anywhere first.
     virtual void GenerateVertices(const TessellatedVertexProc& proc) const = 0;
   };
 
@@ -130,9 +141,14 @@ class Tessellator {
       return trigs_.size() * vertices_per_trig_;
     }
 
+    /// |VertexGenerator|
+    size_t GenerateVertices(Point* vertices) const override {
+      return impl_(trigs_, data_, vertices) - vertices;
+    }
+
     /// |VertexGenerator|
     void GenerateVertices(const TessellatedVertexProc& proc) const override {
-      impl_(trigs_, data_, proc);
+      streaming_impl_(trigs_, data_, proc);
     }
 
    private:
@@ -151,16 +167,25 @@ class Tessellator {
       const Scalar half_width;
     };
 
-    typedef void GeneratorProc(const Trigs& trigs,
-                               const Data& data,
-                               const TessellatedVertexProc& proc);
+    // Writes the vertices to |vertices| and returns the end of the
+    // written range.
+    typedef Point* GeneratorProc(const Trigs& trigs,
+                                 const Data& data,
+                                 Point* vertices);
+
+    // Delivers the vertices to |proc| as they are generated.
+    typedef void StreamingGeneratorProc(const Trigs& trigs,
+                                        const Data& data,
+                                        const TessellatedVertexProc& proc);
 
     GeneratorProc& impl_;
+    StreamingGeneratorProc& streaming_impl_;
     const Trigs trigs_;
     const Data data_;
     const size_t vertices_per_trig_;
 
     EllipticalVertexGenerator(GeneratorProc& generator,
+                              StreamingGeneratorProc& streaming_generator,
                               Trigs&& trigs,
                               PrimitiveType triangle_type,
                               size_t vertices_per_trig,
@@ -296,26 +321,52 @@ class Tessellator {
 
   Trigs GetTrigsForDivisions(size_t divisions);
 
+  class ArrayVertexWriter;
+  class CallbackVertexWriter;
+
+  template <typename VertexWriter>
+  using EllipticalGenerator =
+      void(const Trigs& trigs,
+           const EllipticalVertexGenerator::Data& data,
+           VertexWriter& writer);
+
+  // Runs |Generate| to write the vertices into an array.
+  template <EllipticalGenerator<ArrayVertexWriter>* Generate>
+  static Point* WriteVertices(const Trigs& trigs,
+                              const EllipticalVertexGenerator::Data& data,
+                              Point* vertices);
+
+  // Runs |Generate| to deliver the vertices to a callback.
+  template <EllipticalGenerator<CallbackVertexWriter>* Generate>
+  static void DeliverVertices(const Trigs& trigs,
+                              const EllipticalVertexGenerator::Data& data,
+                              const TessellatedVertexProc& proc);
+
+  template <typename VertexWriter>
   static void GenerateFilledCircle(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+                                   VertexWriter& writer);
 
+  template <typename VertexWriter>
   static void GenerateStrokedCircle(const Trigs& trigs,
                                     const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+                                    VertexWriter& writer);
 
+  template <typename VertexWriter>
   static void GenerateRoundCapLine(const Trigs& trigs,
                                    const EllipticalVertexGenerator::Data& data,
-                                   const TessellatedVertexProc& proc);
+                                   VertexWriter& writer);
 
+  template <typename VertexWriter>
   static void GenerateFilledEllipse(const Trigs& trigs,
                                     const EllipticalVertexGenerator::Data& data,
-                                    const TessellatedVertexProc& proc);
+                                    VertexWriter& writer);
 
+  template <typename VertexWriter>
   static void GenerateFilledRoundRect(
       const Trigs& trigs,
       const EllipticalVertexGenerator::Data& data,
-      const TessellatedVertexProc& proc);
+      VertexWriter& writer);
 
   Tessellator(const Tessellator&) = delete;
 
@@ -496,6 +496,35 @@ TEST(TessellatorTest, FilledRoundRectTessellationVertices) {
        Rect::MakeXYWH(5000, 10000, 2000, 3000), {50, 70});
 }
 
+TEST(TessellatorTest, GeneratedVerticesMatchCallbackVertices) {
+  auto tessellator = std::make_shared<Tessellator>();
+
+  auto test = [](const Tessellator::VertexGenerator& generator) {
+    auto vertex_count = generator.GetVertexCount();
+    std::vector<Point> expected;
+    generator.GenerateVertices([&expected](const Point& p) {  //
+      expected.push_back(p);
+    });
+
+    // One extra slot to check that nothing is written past the count.
+    std::vector<Point> vertices(vertex_count + 1, Point(-1, -1));
+    EXPECT_EQ(generator.GenerateVertices(vertices.data()), vertex_count);
+    EXPECT_EQ(vertices.back(), Point(-1, -1));
+    vertices.pop_back();
+    EXPECT_EQ(vertices, expected);
+  };
+
+  for (auto scale : {0.5f, 1.0f, 10.0f}) {
+    auto transform = Matrix::MakeScale({scale, scale, 1.0});
+    test(tessellator->FilledCircle(transform, {10, 10}, 5));
+    test(tessellator->StrokedCircle(transform, {10, 10}, 5, 2));
+    test(tessellator->RoundCapLine(transform, {10, 10}, {20, 30}, 4));
+    test(tessellator->FilledEllipse(transform, Rect::MakeLTRB(0, 0, 20, 10)));
+    test(tessellator->FilledRoundRect(transform, Rect::MakeLTRB(0, 0, 20, 30),
+                                      {2, 3}));
+  }
+}
+
 TEST(TessellatorTest, EarlyReturnEmptyConvexShape) {
   // This path is not technically empty (it has a size in one dimension),
   // but is otherwise completely flat.
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -96,40 +97,123 @@ static SkImageInfo GetImageInfo(const GlyphAtlas& atlas, Size size) {
   FML_UNREACHABLE();
 }
 
-/// Append as many glyphs to the texture as will fit, and return the first index
-/// of [extra_pairs] that did not fit.
-static size_t AppendToExistingAtlas(
-    const std::shared_ptr<GlyphAtlas>& atlas,
-    const std::vector<FontGlyphPair>& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    const std::vector<Rect>& glyph_sizes,
-    ISize atlas_size,
-    int64_t height_adjustment,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+/// Append as many of the glyphs starting at |start_index| to the pages of the
+/// atlas as will fit. The glyphs that were placed, along with their sizes, are
+/// moved in front of the ones that did not fit. Both keep their relative order.
+///
+/// Glyphs are placed in the open pages of the atlas, stopping at the first
+/// glyph that doesn't fit. If |only_page| is set, glyphs are only placed in
+/// that page, and every glyph that fits is placed.
+///
+/// @return The index of the first glyph that did not fit.
+static size_t AppendToExistingAtlas(GlyphAtlas& atlas,
+                                    std::vector<FontGlyphPair>& glyphs,
+                                    std::vector<Rect>& glyph_sizes,
+                                    std::vector<Rect>& glyph_positions,
+                                    std::vector<size_t>& glyph_pages,
+                                    size_t start_index,
+                                    std::optional<size_t> only_page) {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
-    return 0;
+  FML_DCHECK(glyph_positions.size() == start_index);
+  FML_DCHECK(glyph_pages.size() == start_index);
+
+  const size_t first_page = only_page.value_or(0u);
+  const size_t end_page =
+      only_page.has_value() ? first_page + 1 : atlas.GetPageCount();
+
+  std::vector<FontGlyphPair> placed_glyphs;
+  std::vector<Rect> placed_sizes;
+  std::vector<FontGlyphPair> missing_glyphs;
+  std::vector<Rect> missing_sizes;
+  placed_glyphs.reserve(glyphs.size());
+  placed_sizes.reserve(glyphs.size());
+  for (size_t i = 0; i < start_index; i++) {
+    placed_glyphs.push_back(glyphs[i]);
+    placed_sizes.push_back(glyph_sizes[i]);
   }
 
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
+  for (size_t i = start_index; i < glyphs.size(); i++) {
     ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
-    IPoint16 location_in_atlas;
-    if (!rect_packer->AddRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return i;
+    bool placed = false;
+    for (size_t page_index = first_page; page_index < end_page; page_index++) {
+      GlyphAtlas::Page& page = atlas.GetPage(page_index);
+      if (!page.is_open) {
+        continue;
+      }
+      IPoint16 location_in_atlas;
+      if (!page.rect_packer ||
+          !page.rect_packer->AddRect(glyph_size.width + kPadding,   //
+                                     glyph_size.height + kPadding,  //
+                                     &location_in_atlas             //
+                                     )) {
+        continue;
+      }
+      page.last_used_generation = atlas.GetGeneration();
+      // Position the glyph in the center of the 1px padding.
+      glyph_positions.push_back(Rect::MakeXYWH(
+          location_in_atlas.x() + 1,             //
+          location_in_atlas.y() + page.top + 1,  //
+          glyph_size.width,                      //
+          glyph_size.height                      //
+          ));
+      glyph_pages.push_back(page_index);
+      placed = true;
+      break;
     }
-    // Position the glyph in the center of the 1px padding.
-    glyph_positions.push_back(Rect::MakeXYWH(
-        location_in_atlas.x() + 1,                      //
-        location_in_atlas.y() + height_adjustment + 1,  //
-        glyph_size.width,                               //
-        glyph_size.height                               //
-        ));
+    if (placed) {
+      placed_glyphs.push_back(glyphs[i]);
+      placed_sizes.push_back(glyph_sizes[i]);
+      continue;
+    }
+    if (!only_page.has_value()) {
+      // The open pages are full. Leave the rest of the glyphs for the area
+      // that will be added to the atlas.
+      for (; i < glyphs.size(); i++) {
+        missing_glyphs.push_back(glyphs[i]);
+        missing_sizes.push_back(glyph_sizes[i]);
+      }
+      break;
+    }
+    missing_glyphs.push_back(glyphs[i]);
+    missing_sizes.push_back(glyph_sizes[i]);
+  }
+
+  const size_t placed_count = placed_glyphs.size();
+  for (size_t i = 0; i < missing_glyphs.size(); i++) {
+    placed_glyphs.push_back(missing_glyphs[i]);
+    placed_sizes.push_back(missing_sizes[i]);
   }
+  glyphs.swap(placed_glyphs);
+  glyph_sizes.swap(placed_sizes);
+  return placed_count;
+}
 
-  return extra_pairs.size();
+/// Evict the least recently used pages of the atlas, one at a time, and
+/// append the glyphs starting at |start_index| to them until all the glyphs
+/// fit or no page can be evicted. Pages with glyphs used in the current
+/// generation are never evicted.
+///
+/// @return The index of the first glyph that did not fit.
+static size_t EvictAndAppendToExistingAtlas(
+    GlyphAtlas& atlas,
+    std::vector<FontGlyphPair>& glyphs,
+    std::vector<Rect>& glyph_sizes,
+    std::vector<Rect>& glyph_positions,
+    std::vector<size_t>& glyph_pages,
+    size_t start_index,
+    GlyphAtlasContext::FrameStatistics& statistics) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  while (start_index < glyphs.size()) {
+    std::optional<size_t> page = atlas.FindLeastRecentlyUsedPage();
+    if (!page.has_value()) {
+      break;
+    }
+    statistics.evicted_glyph_count += atlas.EvictPage(page.value());
+    start_index =
+        AppendToExistingAtlas(atlas, glyphs, glyph_sizes, glyph_positions,
+                              glyph_pages, start_index, page);
+  }
+  return start_index;
 }
 
 static size_t PairsFitInAtlasOfSize(
@@ -250,13 +334,15 @@ static void DrawGlyph(SkCanvas* canvas,
 /// @brief Batch render to a single surface.
 ///
 /// This is only safe for use when updating a fresh texture.
-static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
-                                  std::shared_ptr<BlitPass>& blit_pass,
-                                  HostBuffer& host_buffer,
-                                  const std::shared_ptr<Texture>& texture,
-                                  const std::vector<FontGlyphPair>& new_pairs,
-                                  size_t start_index,
-                                  size_t end_index) {
+static bool BulkUpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    std::shared_ptr<BlitPass>& blit_pass,
+    HostBuffer& host_buffer,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<FontGlyphPair>& new_pairs,
+    size_t start_index,
+    size_t end_index,
+    GlyphAtlasContext::FrameStatistics& statistics) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
@@ -291,16 +377,18 @@ static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
     DrawGlyph(canvas, SkPoint::Make(pos.GetLeft(), pos.GetTop()),
               pair.scaled_font, pair.glyph, bounds, pair.glyph.properties,
               has_color);
+    statistics.rendered_glyph_count++;
   }
 
   // Writing to a malloc'd buffer and then copying to the staging buffers
   // benchmarks as substantially faster on a number of Android devices.
-  BufferView buffer_view = host_buffer.Emplace(
-      bitmap.getAddr(0, 0),
+  const size_t bytes =
       texture->GetSize().Area() *
-          BytesPerPixelForPixelFormat(
-              atlas.GetTexture()->GetTextureDescriptor().format),
-      DefaultUniformAlignment());
+      BytesPerPixelForPixelFormat(
+          atlas.GetTexture()->GetTextureDescriptor().format);
+  BufferView buffer_view = host_buffer.Emplace(bitmap.getAddr(0, 0), bytes,
+                                               DefaultUniformAlignment());
+  statistics.uploaded_bytes += bytes;
 
   return blit_pass->AddCopy(std::move(buffer_view),  //
                             texture,                 //
@@ -314,7 +402,8 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                               const std::shared_ptr<Texture>& texture,
                               const std::vector<FontGlyphPair>& new_pairs,
                               size_t start_index,
-                              size_t end_index) {
+                              size_t end_index,
+                              GlyphAtlasContext::FrameStatistics& statistics) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
@@ -352,14 +441,16 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
 
     DrawGlyph(canvas, SkPoint::Make(1, 1), pair.scaled_font, pair.glyph, bounds,
               pair.glyph.properties, has_color);
+    statistics.rendered_glyph_count++;
 
     // Writing to a malloc'd buffer and then copying to the staging buffers
     // benchmarks as substantially faster on a number of Android devices.
-    BufferView buffer_view = host_buffer.Emplace(
-        bitmap.getAddr(0, 0),
+    const size_t bytes =
         size.Area() * BytesPerPixelForPixelFormat(
-                          atlas.GetTexture()->GetTextureDescriptor().format),
-        DefaultUniformAlignment());
+                          atlas.GetTexture()->GetTextureDescriptor().format);
+    BufferView buffer_view = host_buffer.Emplace(bitmap.getAddr(0, 0), bytes,
+                                                 DefaultUniformAlignment());
+    statistics.uploaded_bytes += bytes;
 
     // convert_to_read is set to false so that the texture remains in a transfer
     // dst layout until we finish writing to it below. This only has an impact
@@ -402,13 +493,16 @@ static Rect ComputeGlyphSize(const SkFont& font,
                         scaled_bounds.fBottom);
 };
 
+/// Collect the glyphs that are not in the atlas yet and mark the ones that are
+/// as used in the current generation of the atlas.
 static void CollectNewGlyphs(const std::shared_ptr<GlyphAtlas>& atlas,
                              const FontGlyphMap& font_glyph_map,
                              std::vector<FontGlyphPair>& new_glyphs,
                              std::vector<Rect>& glyph_sizes) {
+  const uint64_t generation = atlas->GetGeneration();
   for (const auto& font_value : font_glyph_map) {
     const ScaledFont& scaled_font = font_value.first;
-    const FontGlyphAtlas* font_glyph_atlas =
+    FontGlyphAtlas* font_glyph_atlas =
         atlas->GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
 
     auto metrics = scaled_font.font.GetMetrics();
@@ -427,7 +521,7 @@ static void CollectNewGlyphs(const std::shared_ptr<GlyphAtlas>& atlas,
 
     if (font_glyph_atlas) {
       for (const SubpixelGlyph& glyph : font_value.second) {
-        if (!font_glyph_atlas->FindGlyphBounds(glyph)) {
+        if (!font_glyph_atlas->MarkGlyphUsed(glyph, generation)) {
           new_glyphs.emplace_back(scaled_font, glyph);
           glyph_sizes.push_back(
               ComputeGlyphSize(sk_font, glyph, scaled_font.scale));
@@ -456,6 +550,21 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   std::shared_ptr<GlyphAtlas> last_atlas = atlas_context->GetGlyphAtlas();
   FML_DCHECK(last_atlas->GetType() == type);
 
+  GlyphAtlasContext::FrameStatistics& statistics =
+      atlas_context->GetMutableFrameStatistics();
+  statistics = {};
+  fml::ScopedCleanupClosure trace_statistics([&statistics]() {
+    if (statistics.rendered_glyph_count == 0u &&
+        statistics.evicted_glyph_count == 0u) {
+      return;
+    }
+    FML_TRACE_COUNTER("impeller", "GlyphAtlas",                           //
+                      reinterpret_cast<int64_t>(&statistics),             //
+                      "RenderedGlyphs", statistics.rendered_glyph_count,  //
+                      "UploadedBytes", statistics.uploaded_bytes,         //
+                      "EvictedGlyphs", statistics.evicted_glyph_count);
+  });
+
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
@@ -463,8 +572,10 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
   //         with the current atlas and reuse if possible. For each new font and
-  //         glyph pair, compute the glyph size at scale.
+  //         glyph pair, compute the glyph size at scale. Glyphs that are
+  //         already in the atlas are marked as used by this generation.
   // ---------------------------------------------------------------------------
+  last_atlas->NextGeneration();
   std::vector<FontGlyphPair> new_glyphs;
   std::vector<Rect> glyph_sizes;
   CollectNewGlyphs(last_atlas, font_glyph_map, new_glyphs, glyph_sizes);
@@ -472,20 +583,42 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     return last_atlas;
   }
 
+  const int64_t max_texture_height =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported().height;
+
+  // OpenGLES cannot reliably perform the blit required to grow the atlas, as
+  // 1) it requires attaching textures as read and write framebuffers which has
+  // substantially smaller size limits that max textures and 2) is missing a
+  // GLES 2.0 implementation and cap check. Growing the atlas then requires
+  // rendering every glyph again.
+  const bool can_blit_old_atlas =
+      context.GetBackendType() != Context::BackendType::kOpenGLES;
+
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas.
+  //         pages of the existing bitmap without recreating the atlas. Once
+  //         the atlas can no longer grow cheaply, make room by evicting the
+  //         least recently used pages.
   // ---------------------------------------------------------------------------
   std::vector<Rect> glyph_positions;
+  std::vector<size_t> glyph_pages;
   glyph_positions.reserve(new_glyphs.size());
+  glyph_pages.reserve(new_glyphs.size());
   size_t first_missing_index = 0;
 
   if (last_atlas->GetTexture()) {
     // Append all glyphs that fit into the current atlas.
     first_missing_index = AppendToExistingAtlas(
-        last_atlas, new_glyphs, glyph_positions, glyph_sizes,
-        atlas_context->GetAtlasSize(), atlas_context->GetHeightAdjustment(),
-        atlas_context->GetRectPacker());
+        *last_atlas, new_glyphs, glyph_sizes, glyph_positions, glyph_pages,
+        /*start_index=*/0, /*only_page=*/std::nullopt);
+
+    if (first_missing_index < new_glyphs.size() &&
+        (!can_blit_old_atlas ||
+         atlas_context->GetAtlasSize().height >= max_texture_height)) {
+      first_missing_index = EvictAndAppendToExistingAtlas(
+          *last_atlas, new_glyphs, glyph_sizes, glyph_positions, glyph_pages,
+          first_missing_index, statistics);
+    }
 
     // ---------------------------------------------------------------------------
     // Step 3a: Record the positions in the glyph atlas of the newly added
@@ -493,7 +626,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // ---------------------------------------------------------------------------
     for (size_t i = 0; i < first_missing_index; i++) {
       last_atlas->AddTypefaceGlyphPositionAndBounds(
-          new_glyphs[i], glyph_positions[i], glyph_sizes[i]);
+          new_glyphs[i], glyph_positions[i], glyph_sizes[i], glyph_pages[i]);
     }
 
     std::shared_ptr<CommandBuffer> cmd_buffer = context.CreateCommandBuffer();
@@ -510,7 +643,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // ---------------------------------------------------------------------------
     if (!UpdateAtlasBitmap(*last_atlas, blit_pass, host_buffer,
                            last_atlas->GetTexture(), new_glyphs, 0,
-                           first_missing_index)) {
+                           first_missing_index, statistics)) {
       return nullptr;
     }
 
@@ -521,26 +654,23 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   }
 
   int64_t height_adjustment = atlas_context->GetAtlasSize().height;
-  const int64_t max_texture_height =
-      context.GetResourceAllocator()->GetMaxTextureSizeSupported().height;
 
   // IF the current atlas size is as big as it can get, then "GC" and create an
-  // atlas with only the required glyphs. OpenGLES cannot reliably perform the
-  // blit required here, as 1) it requires attaching textures as read and write
-  // framebuffers which has substantially smaller size limits that max textures
-  // and 2) is missing a GLES 2.0 implementation and cap check.
+  // atlas with only the required glyphs.
   bool blit_old_atlas = true;
   std::shared_ptr<GlyphAtlas> new_atlas = last_atlas;
   if (atlas_context->GetAtlasSize().height >= max_texture_height ||
-      context.GetBackendType() == Context::BackendType::kOpenGLES) {
+      !can_blit_old_atlas) {
     blit_old_atlas = false;
-    new_atlas = std::make_shared<GlyphAtlas>(type);
+    new_atlas =
+        std::make_shared<GlyphAtlas>(type, last_atlas->GetGeneration());
 
     new_glyphs.clear();
     glyph_sizes.clear();
     CollectNewGlyphs(new_atlas, font_glyph_map, new_glyphs, glyph_sizes);
     glyph_positions.clear();
     glyph_positions.reserve(new_glyphs.size());
+    glyph_pages.clear();
     first_missing_index = 0;
 
     height_adjustment = 0;
@@ -563,6 +693,13 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   }
   FML_DCHECK(new_glyphs.size() == glyph_positions.size());
 
+  // The area added to the atlas becomes a new page.
+  const size_t new_page =
+      new_atlas->AddPage(height_adjustment,                      //
+                         atlas_size.height - height_adjustment,  //
+                         atlas_context->GetRectPacker()          //
+      );
+
   TextureDescriptor descriptor;
   switch (type) {
     case GlyphAtlas::Type::kAlphaBitmap:
@@ -602,7 +739,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   for (size_t i = first_missing_index; i < glyph_positions.size(); i++) {
     new_atlas->AddTypefaceGlyphPositionAndBounds(
-        new_glyphs[i], glyph_positions[i], glyph_sizes[i]);
+        new_glyphs[i], glyph_positions[i], glyph_sizes[i], new_page);
   }
 
   // ---------------------------------------------------------------------------
@@ -611,7 +748,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   if (!BulkUpdateAtlasBitmap(*new_atlas, blit_pass, host_buffer,
                              new_atlas->GetTexture(), new_glyphs,
-                             first_missing_index, new_glyphs.size())) {
+                             first_missing_index, new_glyphs.size(),
+                             statistics)) {
     return nullptr;
   }
 
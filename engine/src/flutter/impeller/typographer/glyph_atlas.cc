@@ -4,9 +4,13 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/logging.h"
+
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext(GlyphAtlas::Type type)
@@ -43,7 +47,18 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
-GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
+const GlyphAtlasContext::FrameStatistics&
+GlyphAtlasContext::GetFrameStatistics() const {
+  return frame_statistics_;
+}
+
+GlyphAtlasContext::FrameStatistics&
+GlyphAtlasContext::GetMutableFrameStatistics() {
+  return frame_statistics_;
+}
+
+GlyphAtlas::GlyphAtlas(Type type, uint64_t generation)
+    : type_(type), generation_(generation) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
 
@@ -65,9 +80,15 @@ void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
 
 void GlyphAtlas::AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                                    Rect position,
-                                                   Rect bounds) {
-  font_atlas_map_[pair.scaled_font].positions_[pair.glyph] =
-      std::make_pair(position, bounds);
+                                                   Rect bounds,
+                                                   size_t page) {
+  font_atlas_map_[pair.scaled_font].positions_.insert_or_assign(
+      pair.glyph, FontGlyphAtlas::GlyphPosition{
+                      .position = position,
+                      .bounds = bounds,
+                      .page = page,
+                      .last_used_generation = generation_,
+                  });
 }
 
 std::optional<std::pair<Rect, Rect>> GlyphAtlas::FindFontGlyphBounds(
@@ -88,6 +109,101 @@ const FontGlyphAtlas* GlyphAtlas::GetFontGlyphAtlas(const Font& font,
   return &found->second;
 }
 
+FontGlyphAtlas* GlyphAtlas::GetFontGlyphAtlas(const Font& font, Scalar scale) {
+  auto found = font_atlas_map_.find(ScaledFont{font, scale});
+  if (found == font_atlas_map_.end()) {
+    return nullptr;
+  }
+  return &found->second;
+}
+
+uint64_t GlyphAtlas::NextGeneration() {
+  return ++generation_;
+}
+
+uint64_t GlyphAtlas::GetGeneration() const {
+  return generation_;
+}
+
+size_t GlyphAtlas::AddPage(int64_t top,
+                           int64_t height,
+                           std::shared_ptr<RectanglePacker> rect_packer) {
+  for (Page& page : pages_) {
+    page.is_open = false;
+  }
+  pages_.push_back(Page{
+      .top = top,
+      .height = height,
+      .rect_packer = std::move(rect_packer),
+      .last_used_generation = generation_,
+  });
+  return pages_.size() - 1;
+}
+
+size_t GlyphAtlas::GetPageCount() const {
+  return pages_.size();
+}
+
+GlyphAtlas::Page& GlyphAtlas::GetPage(size_t index) {
+  FML_DCHECK(index < pages_.size());
+  return pages_[index];
+}
+
+std::optional<size_t> GlyphAtlas::FindLeastRecentlyUsedPage() const {
+  std::vector<uint64_t> recency;
+  recency.reserve(pages_.size());
+  for (const Page& page : pages_) {
+    recency.push_back(page.last_used_generation);
+  }
+  for (const auto& font_value : font_atlas_map_) {
+    for (const auto& glyph_value : font_value.second.positions_) {
+      const FontGlyphAtlas::GlyphPosition& glyph = glyph_value.second;
+      if (glyph.page < recency.size()) {
+        recency[glyph.page] =
+            std::max(recency[glyph.page], glyph.last_used_generation);
+      }
+    }
+  }
+
+  std::optional<size_t> least_recent;
+  uint64_t least_recency = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < recency.size(); i++) {
+    if (recency[i] < generation_ && recency[i] < least_recency) {
+      least_recent = i;
+      least_recency = recency[i];
+    }
+  }
+  return least_recent;
+}
+
+size_t GlyphAtlas::EvictPage(size_t index) {
+  FML_DCHECK(index < pages_.size());
+  size_t evicted = 0u;
+  for (auto font = font_atlas_map_.begin(); font != font_atlas_map_.end();) {
+    auto& positions = font->second.positions_;
+    for (auto glyph = positions.begin(); glyph != positions.end();) {
+      if (glyph->second.page == index) {
+        glyph = positions.erase(glyph);
+        evicted++;
+      } else {
+        ++glyph;
+      }
+    }
+    if (positions.empty()) {
+      font = font_atlas_map_.erase(font);
+    } else {
+      ++font;
+    }
+  }
+  Page& page = pages_[index];
+  if (page.rect_packer) {
+    page.rect_packer->Reset();
+  }
+  page.last_used_generation = generation_;
+  page.is_open = true;
+  return evicted;
+}
+
 size_t GlyphAtlas::GetGlyphCount() const {
   return std::accumulate(font_atlas_map_.begin(), font_atlas_map_.end(), 0,
                          [](const int a, const auto& b) {
@@ -108,7 +224,7 @@ size_t GlyphAtlas::IterateGlyphs(
     for (const auto& glyph_value : font_value.second.positions_) {
       count++;
       if (!iterator(font_value.first, glyph_value.first,
-                    glyph_value.second.first)) {
+                    glyph_value.second.position)) {
         return count;
       }
     }
@@ -122,7 +238,17 @@ std::optional<std::pair<Rect, Rect>> FontGlyphAtlas::FindGlyphBounds(
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return std::make_pair(found->second.position, found->second.bounds);
+}
+
+bool FontGlyphAtlas::MarkGlyphUsed(const SubpixelGlyph& glyph,
+                                   uint64_t generation) {
+  auto found = positions_.find(glyph);
+  if (found == positions_.end()) {
+    return false;
+  }
+  found->second.last_used_generation = generation;
+  return true;
 }
 
 }  // namespace impeller
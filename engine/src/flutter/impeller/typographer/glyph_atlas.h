@@ -5,10 +5,12 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_GLYPH_ATLAS_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_GLYPH_ATLAS_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "impeller/core/texture.h"
 #include "impeller/geometry/rect.h"
@@ -24,6 +26,11 @@ class FontGlyphAtlas;
 ///             different fonts along with the ability to query the location of
 ///             specific font glyphs within the texture.
 ///
+///             The texture is divided into pages. Every glyph records the
+///             generation in which it was last used so that, once the atlas
+///             can't grow any further, the least recently used page can be
+///             evicted to make room for new glyphs.
+///
 class GlyphAtlas {
  public:
   //----------------------------------------------------------------------------
@@ -44,12 +51,32 @@ class GlyphAtlas {
     kColorBitmap,
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      A horizontal band of the atlas texture. Glyphs are packed
+  ///             into a page by its own rectangle packer and are evicted from
+  ///             the atlas a page at a time.
+  ///
+  struct Page {
+    /// The first row of the texture covered by the page.
+    int64_t top = 0;
+    /// The number of rows of the texture covered by the page.
+    int64_t height = 0;
+    std::shared_ptr<RectanglePacker> rect_packer;
+    /// The generation in which glyphs were last added to the page.
+    uint64_t last_used_generation = 0;
+    /// If new glyphs are appended to the page. A page is closed once a newer
+    /// page is added, and opened again when it is evicted.
+    bool is_open = true;
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
-  /// @param[in]  type  How the glyphs are represented in the texture.
+  /// @param[in]  type        How the glyphs are represented in the texture.
+  /// @param[in]  generation  The generation to start at. Used to carry the
+  ///                         generation over when an atlas is replaced.
   ///
-  explicit GlyphAtlas(Type type);
+  explicit GlyphAtlas(Type type, uint64_t generation = 0);
 
   ~GlyphAtlas();
 
@@ -81,10 +108,12 @@ class GlyphAtlas {
   /// @param[in]  pair  The font-glyph pair
   /// @param[in]  rect  The position in the atlas
   /// @param[in]  bounds The bounds of the glyph at scale
+  /// @param[in]  page  The index of the page that contains the position
   ///
   void AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                          Rect position,
-                                         Rect bounds);
+                                         Rect bounds,
+                                         size_t page = 0u);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -132,9 +161,62 @@ class GlyphAtlas {
   ///
   const FontGlyphAtlas* GetFontGlyphAtlas(const Font& font, Scalar scale) const;
 
+  FontGlyphAtlas* GetFontGlyphAtlas(const Font& font, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new generation. Glyphs that are used or added
+  ///             afterwards are marked with the new generation. Typographer
+  ///             contexts start a generation for every atlas update, which is
+  ///             usually once per frame.
+  ///
+  /// @return     The new generation.
+  ///
+  uint64_t NextGeneration();
+
+  uint64_t GetGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add a page to the atlas and close the existing pages.
+  ///
+  /// @return     The index of the new page.
+  ///
+  size_t AddPage(int64_t top,
+                 int64_t height,
+                 std::shared_ptr<RectanglePacker> rect_packer);
+
+  size_t GetPageCount() const;
+
+  Page& GetPage(size_t index);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the page that was used least recently, ignoring pages
+  ///             that were used in the current generation.
+  ///
+  ///             The recency of a page is that of the most recently used
+  ///             glyph in it.
+  ///
+  /// @return     The index of the page, or `std::nullopt` if every page was
+  ///             used in the current generation.
+  ///
+  std::optional<size_t> FindLeastRecentlyUsedPage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove all the glyphs in a page from the atlas and reset the
+  ///             rectangle packer of the page. The texture is not modified.
+  ///
+  ///             The page is opened and marked as used in the current
+  ///             generation so that it is not evicted again before its
+  ///             replacement glyphs are added.
+  ///
+  /// @return     The number of glyphs that were removed.
+  ///
+  size_t EvictPage(size_t index);
+
  private:
   const Type type_;
   std::shared_ptr<Texture> texture_;
+  uint64_t generation_ = 0;
+  std::vector<Page> pages_;
 
   std::unordered_map<ScaledFont,
                      FontGlyphAtlas,
@@ -186,11 +268,30 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Counters for the work done by the most recent update of the
+  ///             glyph atlas, which is usually the update for the current
+  ///             frame.
+  ///
+  struct FrameStatistics {
+    /// The number of glyphs rasterized on the CPU.
+    size_t rendered_glyph_count = 0u;
+    /// The number of bytes of glyph bitmaps uploaded to the atlas texture.
+    size_t uploaded_bytes = 0u;
+    /// The number of glyphs evicted from the atlas to make room.
+    size_t evicted_glyph_count = 0u;
+  };
+
+  const FrameStatistics& GetFrameStatistics() const;
+
+  FrameStatistics& GetMutableFrameStatistics();
+
  private:
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<RectanglePacker> rect_packer_;
   int64_t height_adjustment_;
+  FrameStatistics frame_statistics_;
 
   GlyphAtlasContext(const GlyphAtlasContext&) = delete;
 
@@ -216,10 +317,25 @@ class FontGlyphAtlas {
   std::optional<std::pair<Rect, Rect>> FindGlyphBounds(
       const SubpixelGlyph& glyph) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Mark a glyph as used in the given generation.
+  ///
+  /// @return     If the glyph is in the atlas.
+  ///
+  bool MarkGlyphUsed(const SubpixelGlyph& glyph, uint64_t generation);
+
  private:
   friend class GlyphAtlas;
+
+  struct GlyphPosition {
+    Rect position;
+    Rect bounds;
+    size_t page = 0u;
+    uint64_t last_used_generation = 0u;
+  };
+
   std::unordered_map<SubpixelGlyph,
-                     std::pair<Rect, Rect>,
+                     GlyphPosition,
                      SubpixelGlyph::Hash,
                      SubpixelGlyph::Equal>
       positions_;
@@ -435,8 +435,8 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
                        *MakeTextFrameFromTextBlobSkia(blob));
   // Continually append new glyphs until the glyph size grows to the maximum.
   // Note that the sizes here are more or less experimentally determined, but
-  // the important expectation is that the atlas size will shrink again after
-  // growing to the maximum size.
+  // the important expectation is that once the atlas has grown to the maximum
+  // size, room is made by evicting pages instead of recreating the atlas.
   constexpr ISize expected_sizes[13] = {
       {4096, 4096},   //
       {4096, 4096},   //
@@ -450,7 +450,7 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
       {4096, 16384},  //
       {4096, 16384},  //
       {4096, 16384},  //
-      {4096, 4096}    // Shrinks!
+      {4096, 16384}   // Evicts!
   };
 
   SkFont sk_font_small = flutter::testing::CreateTestFontOfSize(10);
@@ -479,10 +479,139 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
               expected_sizes[i]);
   }
 
-  // The final atlas should contain both the "A" glyph (which was not present
-  // in the previous atlas) and the "B" glyph (which existed in the previous
-  // atlas).
-  ASSERT_EQ(atlas->GetGlyphCount(), 2u);
+  // Only the two new glyphs of the final frame were rendered, and at least
+  // one page of older glyphs was evicted to make room for them.
+  const auto& statistics = atlas_context->GetFrameStatistics();
+  EXPECT_EQ(statistics.rendered_glyph_count, 2u);
+  EXPECT_GT(statistics.evicted_glyph_count, 0u);
+  EXPECT_GE(atlas->GetGlyphCount(), 2u);
+}
+
+TEST_P(TypographerTest, GlyphAtlasOnlyRendersNewGlyphs) {
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("abc", sk_font);
+  auto blob2 = SkTextBlob::MakeFromString("abd", sk_font);
+  ASSERT_TRUE(blob && blob2);
+  const auto& statistics = atlas_context->GetFrameStatistics();
+
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                       *MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(statistics.rendered_glyph_count, 3u);
+  EXPECT_GT(statistics.uploaded_bytes, 0u);
+
+  atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                           GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                           *MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(statistics.rendered_glyph_count, 0u);
+  EXPECT_EQ(statistics.uploaded_bytes, 0u);
+
+  atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                           GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                           *MakeTextFrameFromTextBlobSkia(blob2));
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(statistics.rendered_glyph_count, 1u);
+  EXPECT_EQ(statistics.evicted_glyph_count, 0u);
+  EXPECT_EQ(atlas->GetGlyphCount(), 4u);
+}
+
+TEST(TypographerTest, GlyphAtlasEvictsLeastRecentlyUsedPage) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("abc", sk_font);
+  ASSERT_TRUE(blob);
+  FontGlyphMap font_glyph_map;
+  MakeTextFrameFromTextBlobSkia(blob)->CollectUniqueFontGlyphPairs(
+      font_glyph_map, 1.0f, {0, 0}, {});
+  ASSERT_EQ(font_glyph_map.size(), 1u);
+  const ScaledFont& scaled_font = font_glyph_map.begin()->first;
+  std::vector<FontGlyphPair> pairs;
+  for (const SubpixelGlyph& glyph : font_glyph_map.begin()->second) {
+    pairs.emplace_back(scaled_font, glyph);
+  }
+  ASSERT_EQ(pairs.size(), 3u);
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  atlas.AddPage(0, 64, RectanglePacker::Factory(64, 64));
+  atlas.AddPage(64, 64, RectanglePacker::Factory(64, 64));
+  EXPECT_FALSE(atlas.GetPage(0).is_open);
+  EXPECT_TRUE(atlas.GetPage(1).is_open);
+
+  atlas.NextGeneration();
+  atlas.AddTypefaceGlyphPositionAndBounds(pairs[0], Rect::MakeXYWH(1, 1, 8, 8),
+                                          Rect::MakeXYWH(0, 0, 8, 8), 0);
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      pairs[1], Rect::MakeXYWH(1, 65, 8, 8), Rect::MakeXYWH(0, 0, 8, 8), 1);
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      pairs[2], Rect::MakeXYWH(11, 65, 8, 8), Rect::MakeXYWH(0, 0, 8, 8), 1);
+
+  // Every page was used in the current generation.
+  EXPECT_FALSE(atlas.FindLeastRecentlyUsedPage().has_value());
+
+  // Only the glyph in the first page is used by the next generation.
+  const uint64_t generation = atlas.NextGeneration();
+  FontGlyphAtlas* font_atlas =
+      atlas.GetFontGlyphAtlas(scaled_font.font, scaled_font.scale);
+  ASSERT_NE(font_atlas, nullptr);
+  EXPECT_TRUE(font_atlas->MarkGlyphUsed(pairs[0].glyph, generation));
+
+  std::optional<size_t> page = atlas.FindLeastRecentlyUsedPage();
+  ASSERT_TRUE(page.has_value());
+  EXPECT_EQ(page.value(), 1u);
+  EXPECT_EQ(atlas.EvictPage(page.value()), 2u);
+  EXPECT_TRUE(atlas.GetPage(1).is_open);
+  EXPECT_EQ(atlas.GetGlyphCount(), 1u);
+  EXPECT_TRUE(atlas.FindFontGlyphBounds(pairs[0]).has_value());
+  EXPECT_FALSE(atlas.FindFontGlyphBounds(pairs[1]).has_value());
+  EXPECT_FALSE(atlas.FindFontGlyphBounds(pairs[2]).has_value());
+
+  // The evicted page isn't evicted again in the same generation.
+  EXPECT_FALSE(atlas.FindLeastRecentlyUsedPage().has_value());
+}
+
+TEST_P(TypographerTest, GlyphAtlasWithAnimatedFontScale) {
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "The quick brown fox jumps over the lazy dog.", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  // Animate the scale back and forth, as a zoom animation would. Every scale
+  // is rendered once on the way up, and found in the atlas on the way down.
+  constexpr size_t kSteps = 30;
+  size_t rendered_on_way_up = 0u;
+  size_t rendered_on_way_down = 0u;
+  for (size_t frame_index = 0; frame_index < 2 * kSteps; frame_index++) {
+    size_t step =
+        frame_index < kSteps ? frame_index : 2 * kSteps - frame_index - 1;
+    Scalar scale = 1.0f + step * 0.25f;
+    auto atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                                  GlyphAtlas::Type::kAlphaBitmap, scale,
+                                  atlas_context, *frame);
+    ASSERT_NE(atlas, nullptr);
+    const auto& statistics = atlas_context->GetFrameStatistics();
+    if (frame_index < kSteps) {
+      rendered_on_way_up += statistics.rendered_glyph_count;
+    } else {
+      rendered_on_way_down += statistics.rendered_glyph_count;
+    }
+    host_buffer->Reset();
+  }
+
+  EXPECT_GT(rendered_on_way_up, 0u);
+  EXPECT_EQ(rendered_on_way_down, 0u);
 }
 
 }  // namespace testing
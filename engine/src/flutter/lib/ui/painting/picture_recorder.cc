@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/picture_recorder.h"
 
+#include "flutter/display_list/dl_builder_pool.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -26,8 +27,8 @@ PictureRecorder::PictureRecorder() {}
 PictureRecorder::~PictureRecorder() {}
 
 sk_sp<DisplayListBuilder> PictureRecorder::BeginRecording(SkRect bounds) {
-  display_list_builder_ =
-      sk_make_sp<DisplayListBuilder>(bounds, /*prepare_rtree=*/true);
+  display_list_builder_ = DisplayListBuilderPool::GetInstance().Acquire(
+      bounds, /*prepare_rtree=*/true);
   return display_list_builder_;
 }
 
@@ -37,13 +38,16 @@ void PictureRecorder::endRecording(Dart_Handle dart_picture) {
   }
 
   auto display_list = display_list_builder_->Build();
-  display_list_builder_ = nullptr;
 
   FML_DCHECK(display_list->has_rtree());
   Picture::CreateAndAssociateWithDartWrapper(dart_picture, display_list);
 
   canvas_->Invalidate();
   canvas_ = nullptr;
+  // The canvas no longer references the builder so it can be reused for the
+  // next recording.
+  DisplayListBuilderPool::GetInstance().Recycle(
+      std::move(display_list_builder_));
   ClearDartWrapper();
 }
 
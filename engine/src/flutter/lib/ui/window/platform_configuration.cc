@@ -27,6 +27,34 @@ Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
 
+void MappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::Mapping*>(peer);
+}
+
+// Hands the mapping to Dart without copying it. The mapping is destroyed when
+// the |ByteData| is garbage collected.
+Dart_Handle ToExternalByteData(std::unique_ptr<fml::Mapping> buffer) {
+  const intptr_t size = buffer->GetSize();
+  const void* data = buffer->GetMapping();
+  return Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
+      /*type=*/Dart_TypedData_kByteData,
+      /*data=*/data,
+      /*length=*/size,
+      /*peer=*/buffer.release(),
+      /*external_allocation_size=*/size,
+      /*callback=*/MappingFinalizer);
+}
+
+Dart_Handle ToByteData(PlatformMessage& message) {
+  if (!message.hasData()) {
+    return Dart_Null();
+  }
+  if (message.hasExternalData()) {
+    return ToExternalByteData(message.releaseExternalData());
+  }
+  return ToByteData(message.data());
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -304,8 +332,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
     return;
   }
   tonic::DartState::Scope scope(dart_state);
-  Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+  Dart_Handle data_handle = ToByteData(*message);
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -5,9 +5,11 @@
 #ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 #define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
@@ -21,21 +23,42 @@ class PlatformMessage {
                   fml::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string channel,
                   fml::RefPtr<PlatformMessageResponse> response);
+
+  /// Creates a message whose data is owned by the given mapping rather than
+  /// copied into a |fml::MallocMapping|. The mapping is handed to Dart as an
+  /// unmodifiable external |ByteData|, so it must not change for as long as
+  /// it is alive and may be destroyed on any thread.
+  ///
+  /// Such messages have no |data()|, so anything that reads one must use
+  /// |mapping()| instead.
+  PlatformMessage(std::string channel,
+                  std::unique_ptr<fml::Mapping> external_data,
+                  fml::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
   const std::string& channel() const { return channel_; }
   const fml::MallocMapping& data() const { return data_; }
   bool hasData() { return has_data_; }
 
+  /// The data of the message, whether it was copied or is external.
+  const fml::Mapping& mapping() const;
+
+  bool hasExternalData() const { return external_data_ != nullptr; }
+
   const fml::RefPtr<PlatformMessageResponse>& response() const {
     return response_;
   }
 
   fml::MallocMapping releaseData() { return std::move(data_); }
 
+  std::unique_ptr<fml::Mapping> releaseExternalData() {
+    return std::move(external_data_);
+  }
+
  private:
   std::string channel_;
   fml::MallocMapping data_;
+  std::unique_ptr<fml::Mapping> external_data_;
   bool has_data_;
   fml::RefPtr<PlatformMessageResponse> response_;
 };
@@ -342,7 +342,7 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
 }
 
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
   std::string state(reinterpret_cast<const char*>(data.GetMapping()),
                     data.GetSize());
 
@@ -360,7 +360,7 @@ bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
 
 bool Engine::HandleNavigationPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
 
   rapidjson::Document document;
   document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
@@ -379,7 +379,7 @@ bool Engine::HandleNavigationPlatformMessage(
 }
 
 bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
 
   rapidjson::Document document;
   document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
@@ -422,7 +422,7 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 }
 
 void Engine::HandleSettingsPlatformMessage(PlatformMessage* message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
   std::string jsonData(reinterpret_cast<const char*>(data.GetMapping()),
                        data.GetSize());
   if (runtime_controller_->SetUserSettingsData(jsonData)) {
@@ -544,7 +544,7 @@ void Engine::HandleAssetPlatformMessage(
   if (!response) {
     return;
   }
-  const auto& data = message->data();
+  const auto& data = message->mapping();
   std::string asset_name(reinterpret_cast<const char*>(data.GetMapping()),
                          data.GetSize());
 
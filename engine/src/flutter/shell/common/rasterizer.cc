@@ -59,6 +59,14 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+#if !SLIMPELLER
+  RasterCachePolicy raster_cache_policy =
+      compositor_context_->raster_cache().policy();
+  raster_cache_policy.max_bytes = delegate.GetSettings().raster_cache_max_bytes;
+  raster_cache_policy.max_unused_frames =
+      delegate.GetSettings().raster_cache_max_unused_frames;
+  compositor_context_->raster_cache().SetPolicy(raster_cache_policy);
+#endif  //  !SLIMPELLER
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -740,17 +748,23 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     NOT_SLIMPELLER(compositor_context_->raster_cache().BeginFrame());
 
     std::unique_ptr<FrameDamage> damage;
-    // when leaf layer tracing is enabled we wish to repaint the whole frame
-    // for accurate performance metrics.
-    if (frame->framebuffer_info().supports_partial_repaint) {
-      // Disable partial repaint if external_view_embedder_ SubmitFlutterView is
-      // involved - ExternalViewEmbedder unconditionally clears the entire
-      // surface and also partial repaint with platform view present is
-      // something that still need to be figured out.
-      bool force_full_repaint =
-          external_view_embedder_ &&
-          (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
-
+    // Disable partial repaint if external_view_embedder_ SubmitFlutterView is
+    // involved - ExternalViewEmbedder unconditionally clears the entire
+    // surface and also partial repaint with platform view present is
+    // something that still need to be figured out.
+    bool force_full_repaint =
+        external_view_embedder_ &&
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+    if (force_full_repaint &&
+        external_view_embedder_->SupportsPartialRepaint()) {
+      // The embedder renders the damage into each of its layers itself, so
+      // the whole frame is painted but the damage is still computed.
+      damage = std::make_unique<FrameDamage>();
+      damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
+      damage->AddAdditionalDamage(SkIRect::MakeSize(layer_tree.frame_size()));
+    } else if (frame->framebuffer_info().supports_partial_repaint) {
+      // when leaf layer tracing is enabled we wish to repaint the whole frame
+      // for accurate performance metrics.
       damage = std::make_unique<FrameDamage>();
       auto existing_damage = frame->framebuffer_info().existing_damage;
       if (existing_damage.has_value() && !force_full_repaint) {
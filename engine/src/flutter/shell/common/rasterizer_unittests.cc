@@ -135,6 +135,24 @@ TEST(RasterizerTest, create) {
   EXPECT_TRUE(rasterizer != nullptr);
 }
 
+#if !SLIMPELLER
+TEST(RasterizerTest, AppliesRasterCachePolicyFromSettings) {
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  // The byte budget and the retention are opt-in.
+  EXPECT_EQ(settings.raster_cache_max_bytes, 0u);
+  EXPECT_EQ(settings.raster_cache_max_unused_frames, 0u);
+  settings.raster_cache_max_bytes = 1234u;
+  settings.raster_cache_max_unused_frames = 3u;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  const RasterCachePolicy& policy =
+      rasterizer->compositor_context()->raster_cache().policy();
+  EXPECT_EQ(policy.max_bytes, 1234u);
+  EXPECT_EQ(policy.max_unused_frames, 3u);
+}
+#endif  //  !SLIMPELLER
+
 static std::unique_ptr<FrameTimingsRecorder> CreateFinishedBuildRecorder(
     fml::TimePoint timestamp) {
   std::unique_ptr<FrameTimingsRecorder> recorder =
@@ -13,6 +13,7 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/concurrent_layer_traversal.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
@@ -745,6 +746,13 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
 
+  if (settings_.enable_concurrent_layer_traversal) {
+    rasterizer_->compositor_context()->SetConcurrentLayerTraversal(
+        std::make_shared<ConcurrentLayerTraversal>(
+            GetConcurrentWorkerTaskRunner(),
+            vm_->GetConcurrentMessageLoop()->GetWorkerCount()));
+  }
+
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
   weak_engine_ = engine_->GetWeakPtr();
@@ -1413,7 +1421,7 @@ void Shell::OnEngineChannelUpdate(std::string name, bool listening) {
 }
 
 void Shell::HandleEngineSkiaMessage(std::unique_ptr<PlatformMessage> message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
 
   rapidjson::Document document;
   document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
@@ -6,60 +6,89 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
 
+static Settings CreateBenchmarkSettings(testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = []() {
+      auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                           fml::FilePermission::kRead);
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+static std::unique_ptr<ThreadHost> CreateBenchmarkThreadHost() {
+  return std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.",
+      ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
+          ThreadHost::Type::kIo | ThreadHost::Type::kUi));
+}
+
+static std::unique_ptr<Shell> CreateBenchmarkShell(
+    const Settings& settings,
+    const ThreadHost& thread_host) {
+  TaskRunners task_runners("test",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  return Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+}
+
+// Shutdown must occur synchronously on the platform thread.
+static void ShutdownBenchmarkShell(std::unique_ptr<Shell>& shell,
+                                   std::unique_ptr<ThreadHost>& thread_host) {
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      thread_host->platform_thread->GetTaskRunner(),
+      [&shell, &latch]() mutable {
+        shell.reset();
+        latch.Signal();
+      });
+  latch.Wait();
+  thread_host.reset();
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
-  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
-                                       fml::FilePermission::kRead);
   std::unique_ptr<Shell> shell;
   std::unique_ptr<ThreadHost> thread_host;
   testing::ELFAOTSymbols aot_symbols;
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
-
-    thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
-        "io.flutter.bench.",
-        ThreadHost::Type::kPlatform | ThreadHost::Type::kRaster |
-            ThreadHost::Type::kIo | ThreadHost::Type::kUi));
-
-    TaskRunners task_runners("test",
-                             thread_host->platform_thread->GetTaskRunner(),
-                             thread_host->raster_thread->GetTaskRunner(),
-                             thread_host->ui_thread->GetTaskRunner(),
-                             thread_host->io_thread->GetTaskRunner());
-
-    shell = Shell::Create(
-        flutter::PlatformData(), task_runners, settings,
-        [](Shell& shell) {
-          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
-        },
-        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    Settings settings = CreateBenchmarkSettings(aot_symbols);
+    thread_host = CreateBenchmarkThreadHost();
+    shell = CreateBenchmarkShell(settings, *thread_host);
   }
 
   FML_CHECK(shell);
@@ -81,16 +110,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_shutdown);
-    // Shutdown must occur synchronously on the platform thread.
-    fml::AutoResetWaitableEvent latch;
-    fml::TaskRunner::RunNowOrPostTask(
-        thread_host->platform_thread->GetTaskRunner(),
-        [&shell, &latch]() mutable {
-          shell.reset();
-          latch.Signal();
-        });
-    latch.Wait();
-    thread_host.reset();
+    ShutdownBenchmarkShell(shell, thread_host);
   }
 
   FML_CHECK(!shell);
@@ -120,4 +140,84 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Sends |state.range(0)| byte messages from the platform thread to a running
+// isolate. Messages either copy their data, as the embedder API does by
+// default, or hand an external mapping over to Dart without copying it.
+static void DispatchPlatformMessages(benchmark::State& state,
+                                     bool external_data) {
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = CreateBenchmarkSettings(aot_symbols);
+  std::unique_ptr<ThreadHost> thread_host = CreateBenchmarkThreadHost();
+  std::unique_ptr<Shell> shell = CreateBenchmarkShell(settings, *thread_host);
+  FML_CHECK(shell);
+
+  fml::RefPtr<fml::TaskRunner> platform_task_runner =
+      thread_host->platform_thread->GetTaskRunner();
+  fml::RefPtr<fml::TaskRunner> ui_task_runner =
+      thread_host->ui_thread->GetTaskRunner();
+
+  {
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(platform_task_runner, [&]() {
+      auto configuration = RunConfiguration::InferFromSettings(settings);
+      configuration.SetEntrypoint("platformMessageSinkMain");
+      shell->RunEngine(std::move(configuration),
+                       [&latch](Engine::RunStatus status) {
+                         FML_CHECK(status == Engine::RunStatus::Success);
+                         latch.Signal();
+                       });
+    });
+    latch.Wait();
+  }
+
+  const size_t size = state.range(0);
+  // Shared with the external mappings, which live until Dart collects them.
+  auto payload = std::make_shared<std::vector<uint8_t>>(size, 0xA5);
+
+  while (state.KeepRunning()) {
+    fml::AutoResetWaitableEvent latch;
+    platform_task_runner->PostTask([&]() {
+      std::unique_ptr<PlatformMessage> message;
+      if (external_data) {
+        message = std::make_unique<PlatformMessage>(
+            "flutter/benchmark",
+            std::make_unique<fml::NonOwnedMapping>(
+                payload->data(), size,
+                [payload](const uint8_t*, size_t) {}),
+            nullptr);
+      } else {
+        message = std::make_unique<PlatformMessage>(
+            "flutter/benchmark",
+            fml::MallocMapping::Copy(payload->data(), size), nullptr);
+      }
+      shell->GetPlatformView()->DispatchPlatformMessage(std::move(message));
+      // Posted after the message, so the isolate has received it by the time
+      // this runs.
+      ui_task_runner->PostTask([&latch]() { latch.Signal(); });
+    });
+    latch.Wait();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+
+  ShutdownBenchmarkShell(shell, thread_host);
+}
+
+static void BM_PlatformMessageDispatchCopy(benchmark::State& state) {
+  DispatchPlatformMessages(state, /*external_data=*/false);
+}
+
+BENCHMARK(BM_PlatformMessageDispatchCopy)
+    ->RangeMultiplier(4)
+    ->Range(1 << 20, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_PlatformMessageDispatchExternal(benchmark::State& state) {
+  DispatchPlatformMessages(state, /*external_data=*/true);
+}
+
+BENCHMARK(BM_PlatformMessageDispatchExternal)
+    ->RangeMultiplier(4)
+    ->Range(1 << 20, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -1005,12 +1005,12 @@ TEST_F(ShellTest, PushBackdropFilterToVisitedPlatformViews) {
   ASSERT_FALSE(stack_50.is_empty());
 
   auto filter = DlBlurImageFilter(5, 5, DlTileMode::kClamp);
-  auto mutator = *stack_50.Begin();
-  ASSERT_EQ(mutator->GetType(), MutatorType::kBackdropFilter);
-  ASSERT_EQ(mutator->GetFilterMutation().GetFilter(), filter);
+  const auto& mutator = *stack_50.Begin();
+  ASSERT_EQ(mutator.GetType(), MutatorType::kBackdropFilter);
+  ASSERT_EQ(mutator.GetFilterMutation().GetFilter(), filter);
   // Make sure the filterRect is in global coordinates (contains the (1,1)
   // translation).
-  ASSERT_EQ(mutator->GetFilterMutation().GetFilterRect(),
+  ASSERT_EQ(mutator.GetFilterMutation().GetFilterRect(),
             SkRect::MakeLTRB(1, 1, 31, 31));
 
   DestroyShell(std::move(shell));
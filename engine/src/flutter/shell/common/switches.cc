@@ -316,6 +316,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_software_tiled_rendering = command_line.HasOption(
+      FlagForSwitch(Switch::EnableSoftwareTiledRendering));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -325,6 +328,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_serial_gc =
       command_line.HasOption(FlagForSwitch(Switch::EnableSerialGC));
 
+  settings.enable_concurrent_layer_traversal = command_line.HasOption(
+      FlagForSwitch(Switch::EnableConcurrentLayerTraversal));
+
 #if !FLUTTER_RELEASE
   settings.trace_skia = true;
 
@@ -521,6 +527,23 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoull(raster_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheMaxUnusedFrames))) {
+    std::string raster_cache_max_unused_frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheMaxUnusedFrames),
+        &raster_cache_max_unused_frames);
+    settings.raster_cache_max_unused_frames =
+        std::stoull(raster_cache_max_unused_frames);
+  }
+
   settings.enable_platform_isolates =
       command_line.HasOption(FlagForSwitch(Switch::EnablePlatformIsolates));
 
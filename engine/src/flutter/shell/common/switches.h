@@ -133,6 +133,12 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableSoftwareTiledRendering,
+           "enable-software-tiled-rendering",
+           "Render software frames in tiles in parallel on the concurrent "
+           "worker threads, re-rendering only the tiles that changed since "
+           "the last frame. Only supported by the software renderer of the "
+           "embedder API.")
 DEF_SWITCH(Route,
            "route",
            "Start app with an specific route defined on the framework")
@@ -240,6 +246,12 @@ DEF_SWITCH(EnableSerialGC,
            "GC tasks on threads can cause them to contend with the UI thread "
            "which could potentially lead to jank. This option turns off all "
            "concurrent GC activities")
+DEF_SWITCH(EnableConcurrentLayerTraversal,
+           "enable-concurrent-layer-traversal",
+           "Preroll and diff the children of large container layers on the "
+           "concurrent worker threads. The results are identical to a serial "
+           "traversal. Only takes effect for frames that are not raster "
+           "cached.")
 DEF_SWITCH(DisallowInsecureConnections,
            "disallow-insecure-connections",
            "By default, dart:io allows all socket connections. If this switch "
@@ -262,6 +274,14 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The max bytes of images held by the raster cache, or 0 for "
+           "unlimited.")
+DEF_SWITCH(RasterCacheMaxUnusedFrames,
+           "raster-cache-max-unused-frames",
+           "The number of consecutive frames a raster cache image may go "
+           "unused before it is evicted. Defaults to 0.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -13,10 +13,13 @@
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::unique_ptr<DlSkTiledRasterizer> tiled_rasterizer)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tiled_rasterizer_(std::move(tiled_rasterizer)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -59,6 +62,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (tiled_rasterizer_) {
+    return AcquireTiledFrame(backing_store, size);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -92,6 +99,62 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 }
 
 // |Surface|
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    const sk_sp<SkSurface>& backing_store,
+    const SkISize& size) {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  framebuffer_info.supports_partial_repaint = true;
+  // The backing store still holds the last frame if the delegate returned it
+  // again, so only the area that changed since then needs to be rendered.
+  if (backing_store == last_backing_store_) {
+    framebuffer_info.existing_damage = SkIRect::MakeEmpty();
+  }
+  // The backing store can't be trusted to hold this frame until it has been
+  // rendered.
+  last_backing_store_ = nullptr;
+
+  SurfaceFrame::EncodeCallback encode_callback =
+      [self = weak_factory_.GetWeakPtr(), backing_store](
+          SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid()) {
+      return false;
+    }
+
+    sk_sp<DisplayList> display_list = surface_frame.BuildDisplayList();
+    SkPixmap pixmap;
+    if (!display_list || !backing_store->peekPixels(&pixmap)) {
+      return false;
+    }
+
+    const SkIRect dirty_rect =
+        surface_frame.submit_info().buffer_damage.value_or(pixmap.bounds());
+    self->tiled_rasterizer_->Render(display_list, pixmap, dirty_rect);
+    self->last_backing_store_ = backing_store;
+    return true;
+  };
+  SurfaceFrame::SubmitCallback submit_callback =
+      [self = weak_factory_.GetWeakPtr(),
+       backing_store](const SurfaceFrame& surface_frame) {
+        // If the surface itself went away, there is nothing more to do.
+        if (!self || !self->IsValid()) {
+          return false;
+        }
+        return self->delegate_->PresentBackingStore(backing_store);
+      };
+
+  return std::make_unique<SurfaceFrame>(nullptr,           // surface
+                                        framebuffer_info,  // framebuffer info
+                                        encode_callback,   // encode callback
+                                        submit_callback,   // submit callback
+                                        size,              // frame size
+                                        nullptr,           // context result
+                                        true,  // display list fallback
+                                        true   // display list rtree
+  );
+}
+
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
   // return identity.
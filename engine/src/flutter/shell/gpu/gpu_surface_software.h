@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -14,8 +15,14 @@ namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  // If |tiled_rasterizer| is not null, frames are recorded into a display
+  // list and rendered into the backing store in parallel tiles. Only the
+  // tiles that changed since the last frame are rendered if the delegate
+  // returns the same backing store for consecutive frames.
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::unique_ptr<DlSkTiledRasterizer> tiled_rasterizer = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +45,16 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::unique_ptr<DlSkTiledRasterizer> tiled_rasterizer_;
+  // The backing store of the last frame rendered with |tiled_rasterizer_|,
+  // whose contents can be reused by the next frame.
+  sk_sp<SkSurface> last_backing_store_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      const sk_sp<SkSurface>& backing_store,
+      const SkISize& size);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
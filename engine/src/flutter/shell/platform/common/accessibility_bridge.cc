@@ -4,6 +4,7 @@
 
 #include "accessibility_bridge.h"
 
+#include <cmath>
 #include <functional>
 #include <utility>
 
@@ -66,6 +67,11 @@ void AccessibilityBridge::CommitUpdates() {
       assert(false);
       return;
     }
+
+    // The old parents no longer match their committed updates.
+    for (const ui::AXNodeData& node_data : remove_reparented->nodes) {
+      committed_semantics_nodes_.erase(node_data.id);
+    }
   }
 
   // Second, apply the pending node updates. This also moves reparented nodes to
@@ -75,24 +81,39 @@ void AccessibilityBridge::CommitUpdates() {
   // Figure out update order, ui::AXTree only accepts update in tree order,
   // where parent node must come before the child node in
   // ui::AXTreeUpdate.nodes. We start with picking a random node and turn the
-  // entire subtree into a list. We pick another node from the remaining update,
-  // and keep doing so until the update map is empty. We then concatenate the
-  // lists in the reversed order, this guarantees parent updates always come
+  // entire subtree into a list. We pick another node that isn't in any list
+  // yet, and keep doing so until every node is in a list. We then concatenate
+  // the lists in the reversed order, this guarantees parent updates always come
   // before child updates. If the root is in the update, it is guaranteed to
   // be the first node of the last list.
-  std::vector<std::vector<SemanticsNode>> results;
-  while (!pending_semantics_node_updates_.empty()) {
-    auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
-    pending_semantics_node_updates_.erase(begin);
+  std::vector<std::vector<const SemanticsNode*>> results;
+  std::unordered_set<int32_t> visited;
+  for (const auto& [id, node] : pending_semantics_node_updates_) {
+    if (visited.insert(id).second) {
+      results.emplace_back();
+      GetSubTreeList(node, visited, results.back());
+    }
   }
 
+  // Only nodes whose semantics changed need to be converted and go through
+  // the ui::AXTree update. Nodes that were deleted by the first update have
+  // already been removed from |committed_semantics_nodes_|. Custom action
+  // labels aren't part of SemanticsNode, so nodes with custom actions are
+  // always updated.
+  std::vector<const SemanticsNode*> moved_nodes;
   for (size_t i = results.size(); i > 0; i--) {
-    for (const SemanticsNode& node : results[i - 1]) {
-      ConvertFlutterUpdate(node, update);
+    for (const SemanticsNode* node : results[i - 1]) {
+      SetTreeData(*node, update);
+      auto committed = committed_semantics_nodes_.find(node->id);
+      if (committed != committed_semantics_nodes_.end() &&
+          node->custom_accessibility_actions.empty() &&
+          HasSameSemantics(*node, committed->second)) {
+        if (!HasSameBounds(*node, committed->second)) {
+          moved_nodes.push_back(node);
+        }
+        continue;
+      }
+      ConvertFlutterUpdate(*node, update);
     }
   }
 
@@ -102,18 +123,41 @@ void AccessibilityBridge::CommitUpdates() {
   if (!results.empty() && GetRootAsAXNode()->id() == ui::AXNode::kInvalidAXID) {
     FML_DCHECK(!results.back().empty());
 
-    update.root_id = results.back().front().id;
+    update.root_id = results.back().front()->id;
   }
 
   tree_->Unserialize(update);
-  pending_semantics_node_updates_.clear();
   pending_semantics_custom_action_updates_.clear();
 
   std::string error = tree_->error();
   if (!error.empty()) {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+    pending_semantics_node_updates_.clear();
+    // The tree no longer matches the committed updates, so the next updates
+    // can't be compared with them.
+    committed_semantics_nodes_.clear();
     return;
   }
+
+  // Moving a node doesn't change anything that the event generator or the
+  // platform node delegates observe, so it is applied directly.
+  for (const SemanticsNode* node : moved_nodes) {
+    ui::AXNode* ax_node = tree_->GetFromId(node->id);
+    FML_DCHECK(ax_node);
+    ui::AXRelativeBounds relative_bounds;
+    SetBoundsFromFlutterUpdate(relative_bounds, *node);
+    ax_node->SetLocation(ax_node->parent() ? ax_node->parent()->id() : -1,
+                         relative_bounds.bounds,
+                         relative_bounds.transform.get());
+  }
+
+  for (auto& [id, node] : pending_semantics_node_updates_) {
+    if (tree_->GetFromId(id)) {
+      committed_semantics_nodes_[id] = std::move(node);
+    }
+  }
+  pending_semantics_node_updates_.clear();
+
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -189,6 +233,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -267,19 +312,58 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
-                                         std::vector<SemanticsNode>& result) {
-  result.push_back(target);
+void AccessibilityBridge::GetSubTreeList(
+    const SemanticsNode& target,
+    std::unordered_set<int32_t>& visited,
+    std::vector<const SemanticsNode*>& result) {
+  result.push_back(&target);
   for (int32_t child : target.children_in_traversal_order) {
     auto iter = pending_semantics_node_updates_.find(child);
-    if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
-      pending_semantics_node_updates_.erase(iter);
+    if (iter != pending_semantics_node_updates_.end() &&
+        visited.insert(child).second) {
+      GetSubTreeList(iter->second, visited, result);
     }
   }
 }
 
+// Whether two numeric fields of semantics nodes are equal. The framework
+// sends NaN as the scroll position and extents of nodes that don't scroll.
+static bool IsSameValue(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool AccessibilityBridge::HasSameSemantics(const SemanticsNode& a,
+                                           const SemanticsNode& b) {
+  return a.id == b.id && a.flags == b.flags && a.actions == b.actions &&
+         a.text_selection_base == b.text_selection_base &&
+         a.text_selection_extent == b.text_selection_extent &&
+         a.scroll_child_count == b.scroll_child_count &&
+         a.scroll_index == b.scroll_index &&
+         IsSameValue(a.scroll_position, b.scroll_position) &&
+         IsSameValue(a.scroll_extent_max, b.scroll_extent_max) &&
+         IsSameValue(a.scroll_extent_min, b.scroll_extent_min) &&
+         IsSameValue(a.elevation, b.elevation) &&
+         IsSameValue(a.thickness, b.thickness) &&
+         a.text_direction == b.text_direction && a.label == b.label &&
+         a.hint == b.hint && a.value == b.value &&
+         a.increased_value == b.increased_value &&
+         a.decreased_value == b.decreased_value && a.tooltip == b.tooltip &&
+         a.children_in_traversal_order == b.children_in_traversal_order &&
+         a.custom_accessibility_actions == b.custom_accessibility_actions;
+}
+
+bool AccessibilityBridge::HasSameBounds(const SemanticsNode& a,
+                                        const SemanticsNode& b) {
+  const FlutterTransformation& at = a.transform;
+  const FlutterTransformation& bt = b.transform;
+  return a.rect.left == b.rect.left && a.rect.top == b.rect.top &&
+         a.rect.right == b.rect.right && a.rect.bottom == b.rect.bottom &&
+         at.scaleX == bt.scaleX && at.skewX == bt.skewX &&
+         at.transX == bt.transX && at.skewY == bt.skewY &&
+         at.scaleY == bt.scaleY && at.transY == bt.transY &&
+         at.pers0 == bt.pers0 && at.pers1 == bt.pers1 && at.pers2 == bt.pers2;
+}
+
 void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
                                                ui::AXTreeUpdate& tree_update) {
   ui::AXNodeData node_data;
@@ -294,19 +378,11 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
   SetNameFromFlutterUpdate(node_data, node);
   SetValueFromFlutterUpdate(node_data, node);
   SetTooltipFromFlutterUpdate(node_data, node);
-  node_data.relative_bounds.bounds.SetRect(node.rect.left, node.rect.top,
-                                           node.rect.right - node.rect.left,
-                                           node.rect.bottom - node.rect.top);
-  node_data.relative_bounds.transform = std::make_unique<gfx::Transform>(
-      node.transform.scaleX, node.transform.skewX, node.transform.transX, 0,
-      node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
-      node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
-      0, 0);
+  SetBoundsFromFlutterUpdate(node_data.relative_bounds, node);
   for (auto child : node.children_in_traversal_order) {
     node_data.child_ids.push_back(child);
   }
-  SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+  tree_update.nodes.push_back(std::move(node_data));
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -546,6 +622,19 @@ void AccessibilityBridge::SetTooltipFromFlutterUpdate(
   node_data.SetTooltip(node.tooltip);
 }
 
+void AccessibilityBridge::SetBoundsFromFlutterUpdate(
+    ui::AXRelativeBounds& relative_bounds,
+    const SemanticsNode& node) {
+  relative_bounds.bounds.SetRect(node.rect.left, node.rect.top,
+                                 node.rect.right - node.rect.left,
+                                 node.rect.bottom - node.rect.top);
+  relative_bounds.transform = std::make_unique<gfx::Transform>(
+      node.transform.scaleX, node.transform.skewX, node.transform.transX, 0,
+      node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
+      node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
+      0, 0);
+}
+
 void AccessibilityBridge::SetTreeData(const SemanticsNode& node,
                                       ui::AXTreeUpdate& tree_update) {
   FlutterSemanticsFlag flags = node.flags;
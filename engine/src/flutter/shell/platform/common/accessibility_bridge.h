@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_ACCESSIBILITY_BRIDGE_H_
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include "flutter/fml/mapping.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -75,6 +76,12 @@ class AccessibilityBridge
   ///             state. For example if a node reparents from A to B, callers
   ///             should only call this method when both removal from A and
   ///             addition to B are in the pending updates.
+  ///
+  ///             Pending updates are compared with the last committed update
+  ///             of the same node. Nodes that haven't changed are skipped,
+  ///             and nodes whose only change is their bounds are moved in
+  ///             place, so only nodes whose semantics changed go through a
+  ///             ui::AXTree update.
   void CommitUpdates();
 
   //------------------------------------------------------------------------------
@@ -199,6 +206,9 @@ class AccessibilityBridge
   std::unique_ptr<ui::AXTree> tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
+  // The last update committed for each node in |tree_|, which pending updates
+  // are compared with.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
@@ -210,7 +220,12 @@ class AccessibilityBridge
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
   void GetSubTreeList(const SemanticsNode& target,
-                      std::vector<SemanticsNode>& result);
+                      std::unordered_set<int32_t>& visited,
+                      std::vector<const SemanticsNode*>& result);
+  // Whether |a| and |b| convert to the same ui::AXNodeData, ignoring their
+  // bounds.
+  static bool HasSameSemantics(const SemanticsNode& a, const SemanticsNode& b);
+  static bool HasSameBounds(const SemanticsNode& a, const SemanticsNode& b);
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -233,6 +248,8 @@ class AccessibilityBridge
                                  const SemanticsNode& node);
   void SetTooltipFromFlutterUpdate(ui::AXNodeData& node_data,
                                    const SemanticsNode& node);
+  void SetBoundsFromFlutterUpdate(ui::AXRelativeBounds& relative_bounds,
+                                  const SemanticsNode& node);
   void SetTreeData(const SemanticsNode& node, ui::AXTreeUpdate& tree_update);
   SemanticsNode FromFlutterSemanticsNode(
       const FlutterSemanticsNode2& flutter_node);
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+// A root with |count| children laid out in a column, like a long list.
+class SemanticsList {
+ public:
+  explicit SemanticsList(size_t count) : children_(count) {
+    for (size_t i = 0; i < count; ++i) {
+      children_[i] = static_cast<int32_t>(i + 1);
+      labels_.push_back("item " + std::to_string(i));
+    }
+    nodes_.push_back(CreateNode(0, "list"));
+    nodes_[0].rect = {0, 0, 400, 800};
+    nodes_[0].child_count = children_.size();
+    nodes_[0].children_in_traversal_order = children_.data();
+    for (size_t i = 0; i < count; ++i) {
+      nodes_.push_back(CreateNode(children_[i], labels_[i].c_str()));
+    }
+    Scroll(0);
+  }
+
+  // Moves the first |count| children by |offset|.
+  void Scroll(double offset, size_t count = SIZE_MAX) {
+    for (size_t i = 1; i < nodes_.size() && i <= count; ++i) {
+      double top = (i - 1) * 20.0 - offset;
+      nodes_[i].rect = {0, top, 400, top + 20};
+    }
+  }
+
+  void SetLabel(size_t child, const char* label) {
+    nodes_[child + 1].label = label;
+  }
+
+  // Sends the root and the first |count| children to |bridge|.
+  void Send(AccessibilityBridge& bridge, size_t count = SIZE_MAX) const {
+    for (size_t i = 0; i < nodes_.size() && i <= count; ++i) {
+      bridge.AddFlutterSemanticsNodeUpdate(nodes_[i]);
+    }
+  }
+
+ private:
+  static FlutterSemanticsNode2 CreateNode(int32_t id, const char* label) {
+    return {
+        .struct_size = sizeof(FlutterSemanticsNode2),
+        .id = id,
+        .text_selection_base = -1,
+        .text_selection_extent = -1,
+        .label = label,
+        .hint = "",
+        .value = "",
+        .increased_value = "",
+        .decreased_value = "",
+        .transform = {1, 0, 0, 0, 1, 0, 0, 0, 1},
+        .tooltip = "",
+    };
+  }
+
+  std::vector<int32_t> children_;
+  std::vector<std::string> labels_;
+  std::vector<FlutterSemanticsNode2> nodes_;
+};
+
+constexpr size_t kListSize = 10000;
+
+}  // namespace
+
+// The framework sends every node again, although none of them changed.
+static void BM_CommitUnchangedTree(benchmark::State& state) {
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  SemanticsList list(kListSize);
+  list.Send(*bridge);
+  bridge->CommitUpdates();
+
+  for (auto _ : state) {
+    list.Send(*bridge);
+    bridge->CommitUpdates();
+  }
+}
+
+// The first 50 children scroll and one of them changes its label, as when a
+// list scrolls under a ticking clock.
+static void BM_CommitScrolledTree(benchmark::State& state) {
+  constexpr size_t kVisible = 50;
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  SemanticsList list(kListSize);
+  list.Send(*bridge);
+  bridge->CommitUpdates();
+
+  int frame = 0;
+  for (auto _ : state) {
+    ++frame;
+    list.Scroll(frame % 20, kVisible);
+    list.SetLabel(0, frame % 2 ? "tick" : "tock");
+    list.Send(*bridge, kVisible);
+    bridge->CommitUpdates();
+    bridge->accessibility_events.clear();
+  }
+}
+
+BENCHMARK(BM_CommitUnchangedTree)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CommitScrolledTree)->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -4,10 +4,13 @@
 
 #include "accessibility_bridge.h"
 
+#include <cmath>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 #include "flutter/third_party/accessibility/ax/ax_tree_manager_map.h"
+#include "flutter/third_party/accessibility/ax/ax_tree_observer.h"
 #include "test_accessibility_bridge.h"
 
 namespace flutter {
@@ -37,6 +40,25 @@ FlutterSemanticsNode2 CreateSemanticsNode(
   };
 }
 
+// Records the nodes that each update of an AXTree changes.
+class ChangedNodesObserver : public ui::AXTreeObserver {
+ public:
+  explicit ChangedNodesObserver(ui::AXTree* tree) : tree_(tree) {
+    tree_->AddObserver(this);
+  }
+
+  ~ChangedNodesObserver() override { tree_->RemoveObserver(this); }
+
+  void OnNodeChanged(ui::AXTree* tree, ui::AXNode* node) override {
+    changed_nodes.push_back(node->id());
+  }
+
+  std::vector<int32_t> changed_nodes;
+
+ private:
+  ui::AXTree* tree_;
+};
+
 TEST(AccessibilityBridgeTest, BasicTest) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
@@ -572,5 +594,145 @@ TEST(AccessibilityBridgeTest, LineBreakingObjectTest) {
       ax::mojom::BoolAttribute::kIsLineBreakingObject));
 }
 
+// Verify that resending nodes that haven't changed doesn't update them.
+TEST(AccessibilityBridgeTest, SkipsUnchangedNodes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  ChangedNodesObserver observer(bridge->GetTree());
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(observer.changed_nodes.empty());
+  EXPECT_TRUE(bridge->accessibility_events.empty());
+
+  // Only the node whose label changed is updated.
+  child2.label = "new child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  EXPECT_EQ(observer.changed_nodes, std::vector<int32_t>{2});
+
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(child2_node->GetName(), "new child 2");
+  EXPECT_THAT(bridge->accessibility_events,
+              Contains(ui::AXEventGenerator::Event::NAME_CHANGED).Times(1));
+}
+
+// Verify that nodes that don't scroll, whose scroll position and extents are
+// NaN, are not updated when they are resent unchanged.
+TEST(AccessibilityBridgeTest, SkipsUnchangedNodesThatDontScroll) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  for (FlutterSemanticsNode2* node : {&root, &child1}) {
+    node->scroll_position = std::nan("");
+    node->scroll_extent_max = std::nan("");
+    node->scroll_extent_min = std::nan("");
+  }
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  ChangedNodesObserver observer(bridge->GetTree());
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(observer.changed_nodes.empty());
+}
+
+// Verify that nodes whose only change is their position are moved without
+// being updated.
+TEST(AccessibilityBridgeTest, MovesNodesWithoutUpdatingThem) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  root.rect = {0, 0, 100, 100};
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  child1.rect = {0, 0, 100, 10};
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  ChangedNodesObserver observer(bridge->GetTree());
+  child1.rect = {0, 20, 100, 30};
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+  EXPECT_TRUE(observer.changed_nodes.empty());
+
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  const ui::AXRelativeBounds& bounds = child1_node->GetData().relative_bounds;
+  EXPECT_EQ(bounds.offset_container_id, 0);
+  EXPECT_EQ(bounds.bounds.y(), 20);
+  EXPECT_EQ(bounds.bounds.height(), 10);
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+}
+
+// Verify that a node is updated when it is sent again unchanged after a
+// child that was moved away from it is moved back.
+TEST(AccessibilityBridgeTest, CanReparentNodeBackToUnchangedParent) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> root_children{1, 2};
+  std::vector<int32_t> child1_children{3};
+  std::vector<int32_t> no_children;
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &root_children);
+  FlutterSemanticsNode2 child1 =
+      CreateSemanticsNode(1, "child 1", &child1_children);
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+  FlutterSemanticsNode2 leaf = CreateSemanticsNode(3, "leaf");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->AddFlutterSemanticsNodeUpdate(leaf);
+  bridge->CommitUpdates();
+
+  // Move the leaf to child2 without sending child1 again.
+  FlutterSemanticsNode2 new_child2 =
+      CreateSemanticsNode(2, "child 2", &child1_children);
+  bridge->AddFlutterSemanticsNodeUpdate(new_child2);
+  bridge->AddFlutterSemanticsNodeUpdate(leaf);
+  bridge->CommitUpdates();
+
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(child1_node->GetChildCount(), 0);
+  EXPECT_EQ(child2_node->GetChildCount(), 1);
+
+  // Move it back, sending child1 exactly as it was first sent.
+  FlutterSemanticsNode2 old_child2 =
+      CreateSemanticsNode(2, "child 2", &no_children);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(old_child2);
+  bridge->AddFlutterSemanticsNodeUpdate(leaf);
+  bridge->CommitUpdates();
+
+  EXPECT_EQ(child1_node->GetChildCount(), 1);
+  EXPECT_EQ(child1_node->GetData().child_ids[0], 3);
+  EXPECT_EQ(child2_node->GetChildCount(), 0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,360 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
+
+// Streaming access to the standard codec binary representation, for clients
+// that exchange large or frequent messages and want to avoid building an
+// EncodableValue tree for each one.
+//
+// Nothing in this file copies strings or fixed-type lists out of a message;
+// they are exposed as views into the message buffer, which must outlive them.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "encodable_value.h"
+
+namespace flutter {
+
+// A fixed-type list in an encoded message.
+//
+// Elements are aligned relative to the start of the message rather than in
+// memory, so they are read with memcpy unless the caller knows the message
+// buffer is suitably aligned and uses data().
+template <typename T>
+class StandardCodecListView {
+ public:
+  StandardCodecListView() = default;
+
+  // Creates a view of |size| elements starting at |bytes|.
+  StandardCodecListView(const uint8_t* bytes, size_t size)
+      : bytes_(bytes), size_(size) {}
+
+  // Returns the number of elements in the list.
+  size_t size() const { return size_; }
+
+  // Returns true if the list has no elements.
+  bool empty() const { return size_ == 0; }
+
+  // Returns the element at |index|, which must be less than size().
+  T operator[](size_t index) const {
+    T value;
+    std::memcpy(&value, bytes_ + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+  // Returns the elements as an array, or nullptr if they aren't aligned in
+  // memory for T. They are always aligned when the message buffer is.
+  const T* data() const {
+    if (reinterpret_cast<uintptr_t>(bytes_) % alignof(T) != 0) {
+      return nullptr;
+    }
+    return reinterpret_cast<const T*>(bytes_);
+  }
+
+  // Returns the encoded bytes of the elements.
+  const uint8_t* bytes() const { return bytes_; }
+
+  // Returns a copy of the elements.
+  std::vector<T> ToVector() const {
+    std::vector<T> vector(size_);
+    if (size_ > 0) {
+      std::memcpy(vector.data(), bytes_, size_ * sizeof(T));
+    }
+    return vector;
+  }
+
+ private:
+  const uint8_t* bytes_ = nullptr;
+  size_t size_ = 0;
+};
+
+class StandardCodecStreamReader;
+
+// Receives the values of an encoded message from StandardCodecStreamReader,
+// in the order in which they are encoded.
+//
+// The elements of a list are reported between OnListStart and OnListEnd, and
+// the keys and values of a map alternate between OnMapStart and OnMapEnd.
+//
+// Each method returns false to stop reading. All of them continue by default,
+// so subclasses only need to override the values they are interested in.
+class StandardCodecVisitor {
+ public:
+  virtual ~StandardCodecVisitor() = default;
+
+  virtual bool OnNull() { return true; }
+  virtual bool OnBool(bool value) { return true; }
+  virtual bool OnInt32(int32_t value) { return true; }
+  virtual bool OnInt64(int64_t value) { return true; }
+  virtual bool OnDouble(double value) { return true; }
+  virtual bool OnString(std::string_view value) { return true; }
+  virtual bool OnUInt8List(StandardCodecListView<uint8_t> value) {
+    return true;
+  }
+  virtual bool OnInt32List(StandardCodecListView<int32_t> value) {
+    return true;
+  }
+  virtual bool OnInt64List(StandardCodecListView<int64_t> value) {
+    return true;
+  }
+  virtual bool OnFloat32List(StandardCodecListView<float> value) {
+    return true;
+  }
+  virtual bool OnFloat64List(StandardCodecListView<double> value) {
+    return true;
+  }
+  virtual bool OnListStart(size_t size) { return true; }
+  virtual bool OnListEnd() { return true; }
+  virtual bool OnMapStart(size_t size) { return true; }
+  virtual bool OnMapEnd() { return true; }
+
+  // Called for a value whose discrimination byte |type| isn't part of the
+  // standard codec, with |reader| positioned just after that byte.
+  //
+  // Values of extension types can't be skipped without knowing their
+  // encoding, so by default this stops reading. Subclasses that know the
+  // encoding can read the value with the primitives of |reader|.
+  virtual bool OnCustomValue(uint8_t type, StandardCodecStreamReader& reader) {
+    return false;
+  }
+};
+
+// Reads the standard codec binary representation directly from a message
+// buffer, without allocating.
+class StandardCodecStreamReader {
+ public:
+  // Creates a reader for the |size| bytes at |bytes|, which must outlive the
+  // reader and any views it produces.
+  StandardCodecStreamReader(const uint8_t* bytes, size_t size);
+
+  // Reads the next value, including any values nested in it, and reports it
+  // to |visitor|.
+  //
+  // Returns false if the message is malformed or the visitor stopped reading,
+  // in which case the position of the reader is unspecified.
+  bool ReadValue(StandardCodecVisitor& visitor);
+
+  // Returns the offset of the next byte to be read.
+  size_t position() const { return position_; }
+
+  // Returns true if the whole message has been read.
+  bool at_end() const { return position_ == size_; }
+
+  // Primitives for reading extension types. Each returns false, without
+  // advancing, if there aren't enough bytes left in the message.
+
+  // Reads the next byte.
+  bool ReadByte(uint8_t* value);
+
+  // Returns a view of the next |length| bytes and advances past them.
+  bool ReadBytes(size_t length, const uint8_t** bytes);
+
+  // Reads a variable-length size.
+  bool ReadSize(size_t* size);
+
+  // Advances to the next multiple of |alignment| relative to the start of
+  // the message, unless the position is already aligned.
+  bool ReadAlignment(size_t alignment);
+
+ private:
+  // Reads and reports a value whose discrimination byte was |type|.
+  bool ReadValueOfType(uint8_t type, StandardCodecVisitor& visitor);
+
+  // Reads a fixed-type list whose elements are of type T.
+  template <typename T>
+  bool ReadList(StandardCodecListView<T>* list);
+
+  const uint8_t* bytes_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+// Writes the standard codec binary representation directly to a byte
+// buffer, without building EncodableValues.
+//
+// Lists and maps are written as a header followed by their contents: after
+// WriteListStart(n), the next n values written are the elements of the list,
+// and after WriteMapStart(n), the next 2n values are alternating keys and
+// values.
+class StandardCodecStreamWriter {
+ public:
+  // Creates a writer that appends to |buffer|. Alignment is relative to the
+  // start of |buffer|, so it should be empty unless it already holds the
+  // start of the same message.
+  explicit StandardCodecStreamWriter(std::vector<uint8_t>* buffer);
+
+  void WriteNull();
+  void WriteBool(bool value);
+  void WriteInt32(int32_t value);
+  void WriteInt64(int64_t value);
+  void WriteDouble(double value);
+  void WriteString(std::string_view value);
+  void WriteUInt8List(const uint8_t* values, size_t size);
+  void WriteInt32List(const int32_t* values, size_t size);
+  void WriteInt64List(const int64_t* values, size_t size);
+  void WriteFloat32List(const float* values, size_t size);
+  void WriteFloat64List(const double* values, size_t size);
+  void WriteListStart(size_t size);
+  void WriteMapStart(size_t size);
+
+ private:
+  void WriteSize(size_t size);
+
+  void WriteAlignment(size_t alignment);
+
+  void WriteBytes(const void* bytes, size_t length);
+
+  template <typename T>
+  void WriteList(uint8_t type, const T* values, size_t size);
+
+  std::vector<uint8_t>* buffer_;
+};
+
+// The types of value in a StandardCodecDocument.
+enum class StandardCodecValueType {
+  kNull,
+  kBool,
+  kInt32,
+  kInt64,
+  kDouble,
+  kString,
+  kUInt8List,
+  kInt32List,
+  kInt64List,
+  kFloat32List,
+  kFloat64List,
+  kList,
+  kMap,
+};
+
+// A decoded message that stores all of its values in a few arrays owned by
+// the document, rather than allocating each one separately as EncodableValue
+// does, and refers to the strings and fixed-type lists in the message buffer
+// rather than copying them.
+//
+// A document can be reused for any number of messages. Once its arrays have
+// grown to fit the largest message, parsing doesn't allocate at all.
+//
+// Extension types aren't supported.
+class StandardCodecDocument {
+ public:
+  // A value in a document. Values are only valid until the document is
+  // destroyed or parses another message, and while the message buffer is
+  // alive.
+  class Value {
+   public:
+    StandardCodecValueType type() const;
+
+    bool IsNull() const { return type() == StandardCodecValueType::kNull; }
+
+    // Accessors for the contents of the value, which must be of the
+    // corresponding type.
+    bool BoolValue() const;
+    int32_t Int32Value() const;
+    int64_t Int64Value() const;
+    double DoubleValue() const;
+    std::string_view StringValue() const;
+    StandardCodecListView<uint8_t> UInt8ListValue() const;
+    StandardCodecListView<int32_t> Int32ListValue() const;
+    StandardCodecListView<int64_t> Int64ListValue() const;
+    StandardCodecListView<float> Float32ListValue() const;
+    StandardCodecListView<double> Float64ListValue() const;
+
+    // Returns the value of an int32 or an int64, like
+    // EncodableValue::LongValue.
+    int64_t LongValue() const;
+
+    // Returns the number of elements of a list or entries of a map, or 0 for
+    // any other type.
+    size_t size() const;
+
+    // Returns the element at |index| of a list.
+    Value operator[](size_t index) const;
+
+    // Returns the key and value of the entry at |index| of a map, in the
+    // order in which they were encoded.
+    Value MapKeyAt(size_t index) const;
+    Value MapValueAt(size_t index) const;
+
+    // Returns the value of the first entry of a map whose key is the string
+    // |key|, if there is one.
+    std::optional<Value> Find(std::string_view key) const;
+
+    // Returns a copy of the value, and of any values nested in it, as an
+    // EncodableValue.
+    EncodableValue ToEncodableValue() const;
+
+   private:
+    friend class StandardCodecDocument;
+
+    Value(const StandardCodecDocument* document, size_t index)
+        : document_(document), index_(index) {}
+
+    Value ChildAt(size_t child) const;
+
+    const StandardCodecDocument* document_;
+    size_t index_;
+  };
+
+  StandardCodecDocument();
+  ~StandardCodecDocument();
+
+  // Prevent copying.
+  StandardCodecDocument(StandardCodecDocument const&) = delete;
+  StandardCodecDocument& operator=(StandardCodecDocument const&) = delete;
+
+  // Decodes the first value in the |size| bytes at |bytes|, replacing the
+  // previous contents of the document. |bytes| must outlive the values of
+  // the document.
+  //
+  // Returns false if the message is malformed or uses extension types, in
+  // which case the document is empty.
+  bool Parse(const uint8_t* bytes, size_t size);
+
+  // Returns true if the document holds a successfully parsed message.
+  bool has_value() const { return !nodes_.empty(); }
+
+  // Returns the decoded value. Only valid if has_value() is true.
+  Value root() const;
+
+ private:
+  class Builder;
+
+  struct Node {
+    StandardCodecValueType type;
+    // The length of a string, the number of elements of a list, or the
+    // number of entries of a map.
+    size_t size;
+    union {
+      bool bool_value;
+      int32_t int32_value;
+      int64_t int64_value;
+      double double_value;
+      // The contents of a string or a fixed-type list.
+      const uint8_t* bytes;
+      // The index in |children_| of the first child of a list or map.
+      size_t first_child;
+    };
+  };
+
+  // All values, in the order in which they were encoded.
+  std::vector<Node> nodes_;
+  // The indices in |nodes_| of the children of lists and maps. The children
+  // of each list or map are contiguous.
+  std::vector<size_t> children_;
+  // The index in |children_| of the next child of each list or map that is
+  // being parsed, from the outermost to the innermost.
+  std::vector<size_t> open_containers_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_STREAM_H_
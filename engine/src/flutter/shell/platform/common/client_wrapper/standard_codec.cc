@@ -3,19 +3,22 @@
 // found in the LICENSE file.
 
 // This file contains what would normally be standard_codec_serializer.cc,
-// standard_message_codec.cc, and standard_method_codec.cc. They are grouped
-// together to simplify use of the client wrapper, since the common case is
-// that any client that needs one of these files needs all three.
+// standard_codec_stream.cc, standard_message_codec.cc, and
+// standard_method_codec.cc. They are grouped together to simplify use of the
+// client wrapper, since the common case is that any client that needs one of
+// these files needs all of them.
 
 #include <cassert>
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "byte_buffer_streams.h"
 #include "include/flutter/standard_codec_serializer.h"
+#include "include/flutter/standard_codec_stream.h"
 #include "include/flutter/standard_message_codec.h"
 #include "include/flutter/standard_method_codec.h"
 
@@ -287,6 +290,602 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
                      count * type_size);
 }
 
+// ===== standard_codec_stream.h =====
+
+namespace {
+
+// Returns the T at |bytes|, which need not be aligned.
+template <typename T>
+T ReadUnaligned(const uint8_t* bytes) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+StandardCodecStreamReader::StandardCodecStreamReader(const uint8_t* bytes,
+                                                     size_t size)
+    : bytes_(bytes), size_(size) {}
+
+bool StandardCodecStreamReader::ReadValue(StandardCodecVisitor& visitor) {
+  uint8_t type = 0;
+  if (!ReadByte(&type)) {
+    return false;
+  }
+  return ReadValueOfType(type, visitor);
+}
+
+bool StandardCodecStreamReader::ReadByte(uint8_t* value) {
+  if (position_ >= size_) {
+    return false;
+  }
+  *value = bytes_[position_++];
+  return true;
+}
+
+bool StandardCodecStreamReader::ReadBytes(size_t length,
+                                          const uint8_t** bytes) {
+  if (length > size_ - position_) {
+    return false;
+  }
+  *bytes = bytes_ + position_;
+  position_ += length;
+  return true;
+}
+
+bool StandardCodecStreamReader::ReadSize(size_t* size) {
+  size_t start = position_;
+  uint8_t byte = 0;
+  if (!ReadByte(&byte)) {
+    return false;
+  }
+  if (byte < 254) {
+    *size = byte;
+    return true;
+  }
+  const uint8_t* bytes = nullptr;
+  size_t length = byte == 254 ? 2 : 4;
+  if (!ReadBytes(length, &bytes)) {
+    position_ = start;
+    return false;
+  }
+  *size = byte == 254 ? ReadUnaligned<uint16_t>(bytes)
+                      : ReadUnaligned<uint32_t>(bytes);
+  return true;
+}
+
+bool StandardCodecStreamReader::ReadAlignment(size_t alignment) {
+  size_t mod = position_ % alignment;
+  if (mod == 0) {
+    return true;
+  }
+  if (alignment - mod > size_ - position_) {
+    return false;
+  }
+  position_ += alignment - mod;
+  return true;
+}
+
+bool StandardCodecStreamReader::ReadValueOfType(
+    uint8_t type,
+    StandardCodecVisitor& visitor) {
+  const uint8_t* bytes = nullptr;
+  switch (static_cast<EncodedType>(type)) {
+    case EncodedType::kNull:
+      return visitor.OnNull();
+    case EncodedType::kTrue:
+      return visitor.OnBool(true);
+    case EncodedType::kFalse:
+      return visitor.OnBool(false);
+    case EncodedType::kInt32:
+      return ReadBytes(4, &bytes) &&
+             visitor.OnInt32(ReadUnaligned<int32_t>(bytes));
+    case EncodedType::kInt64:
+      return ReadBytes(8, &bytes) &&
+             visitor.OnInt64(ReadUnaligned<int64_t>(bytes));
+    case EncodedType::kFloat64:
+      return ReadAlignment(8) && ReadBytes(8, &bytes) &&
+             visitor.OnDouble(ReadUnaligned<double>(bytes));
+    case EncodedType::kLargeInt:
+    case EncodedType::kString: {
+      size_t size = 0;
+      return ReadSize(&size) && ReadBytes(size, &bytes) &&
+             visitor.OnString(
+                 std::string_view(reinterpret_cast<const char*>(bytes), size));
+    }
+    case EncodedType::kUInt8List: {
+      StandardCodecListView<uint8_t> list;
+      return ReadList(&list) && visitor.OnUInt8List(list);
+    }
+    case EncodedType::kInt32List: {
+      StandardCodecListView<int32_t> list;
+      return ReadList(&list) && visitor.OnInt32List(list);
+    }
+    case EncodedType::kInt64List: {
+      StandardCodecListView<int64_t> list;
+      return ReadList(&list) && visitor.OnInt64List(list);
+    }
+    case EncodedType::kFloat64List: {
+      StandardCodecListView<double> list;
+      return ReadList(&list) && visitor.OnFloat64List(list);
+    }
+    case EncodedType::kList: {
+      size_t size = 0;
+      // Every element takes at least one byte, so a larger size is corrupt.
+      if (!ReadSize(&size) || size > size_ - position_ ||
+          !visitor.OnListStart(size)) {
+        return false;
+      }
+      for (size_t i = 0; i < size; ++i) {
+        if (!ReadValue(visitor)) {
+          return false;
+        }
+      }
+      return visitor.OnListEnd();
+    }
+    case EncodedType::kMap: {
+      size_t size = 0;
+      if (!ReadSize(&size) || size > (size_ - position_) / 2 ||
+          !visitor.OnMapStart(size)) {
+        return false;
+      }
+      for (size_t i = 0; i < size; ++i) {
+        if (!ReadValue(visitor) || !ReadValue(visitor)) {
+          return false;
+        }
+      }
+      return visitor.OnMapEnd();
+    }
+    case EncodedType::kFloat32List: {
+      StandardCodecListView<float> list;
+      return ReadList(&list) && visitor.OnFloat32List(list);
+    }
+  }
+  return visitor.OnCustomValue(type, *this);
+}
+
+template <typename T>
+bool StandardCodecStreamReader::ReadList(StandardCodecListView<T>* list) {
+  size_t size = 0;
+  if (!ReadSize(&size)) {
+    return false;
+  }
+  if (size == 0) {
+    // StandardCodecSerializer doesn't pad empty lists, so the padding may be
+    // missing at the end of a message.
+    if (sizeof(T) > 1) {
+      ReadAlignment(sizeof(T));
+    }
+    *list = StandardCodecListView<T>();
+    return true;
+  }
+  const uint8_t* bytes = nullptr;
+  if ((sizeof(T) > 1 && !ReadAlignment(sizeof(T))) ||
+      size > (size_ - position_) / sizeof(T) ||
+      !ReadBytes(size * sizeof(T), &bytes)) {
+    return false;
+  }
+  *list = StandardCodecListView<T>(bytes, size);
+  return true;
+}
+
+StandardCodecStreamWriter::StandardCodecStreamWriter(
+    std::vector<uint8_t>* buffer)
+    : buffer_(buffer) {
+  assert(buffer);
+}
+
+void StandardCodecStreamWriter::WriteNull() {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kNull));
+}
+
+void StandardCodecStreamWriter::WriteBool(bool value) {
+  buffer_->push_back(static_cast<uint8_t>(value ? EncodedType::kTrue
+                                                : EncodedType::kFalse));
+}
+
+void StandardCodecStreamWriter::WriteInt32(int32_t value) {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kInt32));
+  WriteBytes(&value, sizeof(value));
+}
+
+void StandardCodecStreamWriter::WriteInt64(int64_t value) {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kInt64));
+  WriteBytes(&value, sizeof(value));
+}
+
+void StandardCodecStreamWriter::WriteDouble(double value) {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kFloat64));
+  WriteAlignment(8);
+  WriteBytes(&value, sizeof(value));
+}
+
+void StandardCodecStreamWriter::WriteString(std::string_view value) {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kString));
+  WriteSize(value.size());
+  WriteBytes(value.data(), value.size());
+}
+
+void StandardCodecStreamWriter::WriteUInt8List(const uint8_t* values,
+                                               size_t size) {
+  WriteList(static_cast<uint8_t>(EncodedType::kUInt8List), values, size);
+}
+
+void StandardCodecStreamWriter::WriteInt32List(const int32_t* values,
+                                               size_t size) {
+  WriteList(static_cast<uint8_t>(EncodedType::kInt32List), values, size);
+}
+
+void StandardCodecStreamWriter::WriteInt64List(const int64_t* values,
+                                               size_t size) {
+  WriteList(static_cast<uint8_t>(EncodedType::kInt64List), values, size);
+}
+
+void StandardCodecStreamWriter::WriteFloat32List(const float* values,
+                                                 size_t size) {
+  WriteList(static_cast<uint8_t>(EncodedType::kFloat32List), values, size);
+}
+
+void StandardCodecStreamWriter::WriteFloat64List(const double* values,
+                                                 size_t size) {
+  WriteList(static_cast<uint8_t>(EncodedType::kFloat64List), values, size);
+}
+
+void StandardCodecStreamWriter::WriteListStart(size_t size) {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kList));
+  WriteSize(size);
+}
+
+void StandardCodecStreamWriter::WriteMapStart(size_t size) {
+  buffer_->push_back(static_cast<uint8_t>(EncodedType::kMap));
+  WriteSize(size);
+}
+
+void StandardCodecStreamWriter::WriteSize(size_t size) {
+  if (size < 254) {
+    buffer_->push_back(static_cast<uint8_t>(size));
+  } else if (size <= 0xffff) {
+    buffer_->push_back(254);
+    uint16_t value = static_cast<uint16_t>(size);
+    WriteBytes(&value, sizeof(value));
+  } else {
+    buffer_->push_back(255);
+    uint32_t value = static_cast<uint32_t>(size);
+    WriteBytes(&value, sizeof(value));
+  }
+}
+
+void StandardCodecStreamWriter::WriteAlignment(size_t alignment) {
+  size_t mod = buffer_->size() % alignment;
+  if (mod) {
+    buffer_->insert(buffer_->end(), alignment - mod, 0);
+  }
+}
+
+void StandardCodecStreamWriter::WriteBytes(const void* bytes, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+  buffer_->insert(buffer_->end(), begin, begin + length);
+}
+
+template <typename T>
+void StandardCodecStreamWriter::WriteList(uint8_t type,
+                                          const T* values,
+                                          size_t size) {
+  buffer_->push_back(type);
+  WriteSize(size);
+  // Unlike StandardCodecSerializer, this pads empty lists too, as the Dart
+  // codec does.
+  if (sizeof(T) > 1) {
+    WriteAlignment(sizeof(T));
+  }
+  WriteBytes(values, size * sizeof(T));
+}
+
+// Adds the values reported by a StandardCodecStreamReader to a document.
+class StandardCodecDocument::Builder : public StandardCodecVisitor {
+ public:
+  explicit Builder(StandardCodecDocument* document) : document_(document) {}
+
+  bool OnNull() override {
+    AddNode(StandardCodecValueType::kNull);
+    return true;
+  }
+
+  bool OnBool(bool value) override {
+    AddNode(StandardCodecValueType::kBool).bool_value = value;
+    return true;
+  }
+
+  bool OnInt32(int32_t value) override {
+    AddNode(StandardCodecValueType::kInt32).int32_value = value;
+    return true;
+  }
+
+  bool OnInt64(int64_t value) override {
+    AddNode(StandardCodecValueType::kInt64).int64_value = value;
+    return true;
+  }
+
+  bool OnDouble(double value) override {
+    AddNode(StandardCodecValueType::kDouble).double_value = value;
+    return true;
+  }
+
+  bool OnString(std::string_view value) override {
+    AddNode(StandardCodecValueType::kString, value.size()).bytes =
+        reinterpret_cast<const uint8_t*>(value.data());
+    return true;
+  }
+
+  bool OnUInt8List(StandardCodecListView<uint8_t> value) override {
+    return AddList(StandardCodecValueType::kUInt8List, value);
+  }
+
+  bool OnInt32List(StandardCodecListView<int32_t> value) override {
+    return AddList(StandardCodecValueType::kInt32List, value);
+  }
+
+  bool OnInt64List(StandardCodecListView<int64_t> value) override {
+    return AddList(StandardCodecValueType::kInt64List, value);
+  }
+
+  bool OnFloat32List(StandardCodecListView<float> value) override {
+    return AddList(StandardCodecValueType::kFloat32List, value);
+  }
+
+  bool OnFloat64List(StandardCodecListView<double> value) override {
+    return AddList(StandardCodecValueType::kFloat64List, value);
+  }
+
+  bool OnListStart(size_t size) override {
+    AddContainer(StandardCodecValueType::kList, size, size);
+    return true;
+  }
+
+  bool OnListEnd() override {
+    document_->open_containers_.pop_back();
+    return true;
+  }
+
+  bool OnMapStart(size_t size) override {
+    AddContainer(StandardCodecValueType::kMap, size, size * 2);
+    return true;
+  }
+
+  bool OnMapEnd() override {
+    document_->open_containers_.pop_back();
+    return true;
+  }
+
+ private:
+  Node& AddNode(StandardCodecValueType type, size_t size = 0) {
+    if (!document_->open_containers_.empty()) {
+      size_t child = document_->open_containers_.back()++;
+      document_->children_[child] = document_->nodes_.size();
+    }
+    Node& node = document_->nodes_.emplace_back();
+    node.type = type;
+    node.size = size;
+    return node;
+  }
+
+  template <typename T>
+  bool AddList(StandardCodecValueType type, StandardCodecListView<T> list) {
+    AddNode(type, list.size()).bytes = list.bytes();
+    return true;
+  }
+
+  void AddContainer(StandardCodecValueType type,
+                    size_t size,
+                    size_t child_count) {
+    size_t first_child = document_->children_.size();
+    AddNode(type, size).first_child = first_child;
+    document_->children_.resize(first_child + child_count);
+    document_->open_containers_.push_back(first_child);
+  }
+
+  StandardCodecDocument* document_;
+};
+
+StandardCodecDocument::StandardCodecDocument() = default;
+
+StandardCodecDocument::~StandardCodecDocument() = default;
+
+bool StandardCodecDocument::Parse(const uint8_t* bytes, size_t size) {
+  nodes_.clear();
+  children_.clear();
+  open_containers_.clear();
+  StandardCodecStreamReader reader(bytes, size);
+  Builder builder(this);
+  if (!reader.ReadValue(builder)) {
+    nodes_.clear();
+    children_.clear();
+    open_containers_.clear();
+    return false;
+  }
+  return true;
+}
+
+StandardCodecDocument::Value StandardCodecDocument::root() const {
+  assert(has_value());
+  return Value(this, 0);
+}
+
+StandardCodecValueType StandardCodecDocument::Value::type() const {
+  return document_->nodes_[index_].type;
+}
+
+bool StandardCodecDocument::Value::BoolValue() const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kBool);
+  return node.bool_value;
+}
+
+int32_t StandardCodecDocument::Value::Int32Value() const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kInt32);
+  return node.int32_value;
+}
+
+int64_t StandardCodecDocument::Value::Int64Value() const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kInt64);
+  return node.int64_value;
+}
+
+double StandardCodecDocument::Value::DoubleValue() const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kDouble);
+  return node.double_value;
+}
+
+std::string_view StandardCodecDocument::Value::StringValue() const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kString);
+  return std::string_view(reinterpret_cast<const char*>(node.bytes),
+                          node.size);
+}
+
+StandardCodecListView<uint8_t> StandardCodecDocument::Value::UInt8ListValue()
+    const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kUInt8List);
+  return StandardCodecListView<uint8_t>(node.bytes, node.size);
+}
+
+StandardCodecListView<int32_t> StandardCodecDocument::Value::Int32ListValue()
+    const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kInt32List);
+  return StandardCodecListView<int32_t>(node.bytes, node.size);
+}
+
+StandardCodecListView<int64_t> StandardCodecDocument::Value::Int64ListValue()
+    const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kInt64List);
+  return StandardCodecListView<int64_t>(node.bytes, node.size);
+}
+
+StandardCodecListView<float> StandardCodecDocument::Value::Float32ListValue()
+    const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kFloat32List);
+  return StandardCodecListView<float>(node.bytes, node.size);
+}
+
+StandardCodecListView<double> StandardCodecDocument::Value::Float64ListValue()
+    const {
+  const Node& node = document_->nodes_[index_];
+  assert(node.type == StandardCodecValueType::kFloat64List);
+  return StandardCodecListView<double>(node.bytes, node.size);
+}
+
+int64_t StandardCodecDocument::Value::LongValue() const {
+  if (type() == StandardCodecValueType::kInt32) {
+    return Int32Value();
+  }
+  return Int64Value();
+}
+
+size_t StandardCodecDocument::Value::size() const {
+  const Node& node = document_->nodes_[index_];
+  if (node.type != StandardCodecValueType::kList &&
+      node.type != StandardCodecValueType::kMap) {
+    return 0;
+  }
+  return node.size;
+}
+
+StandardCodecDocument::Value StandardCodecDocument::Value::operator[](
+    size_t index) const {
+  assert(type() == StandardCodecValueType::kList);
+  assert(index < size());
+  return ChildAt(index);
+}
+
+StandardCodecDocument::Value StandardCodecDocument::Value::MapKeyAt(
+    size_t index) const {
+  assert(type() == StandardCodecValueType::kMap);
+  assert(index < size());
+  return ChildAt(index * 2);
+}
+
+StandardCodecDocument::Value StandardCodecDocument::Value::MapValueAt(
+    size_t index) const {
+  assert(type() == StandardCodecValueType::kMap);
+  assert(index < size());
+  return ChildAt(index * 2 + 1);
+}
+
+std::optional<StandardCodecDocument::Value>
+StandardCodecDocument::Value::Find(std::string_view key) const {
+  assert(type() == StandardCodecValueType::kMap);
+  for (size_t i = 0; i < size(); ++i) {
+    Value entry_key = MapKeyAt(i);
+    if (entry_key.type() == StandardCodecValueType::kString &&
+        entry_key.StringValue() == key) {
+      return MapValueAt(i);
+    }
+  }
+  return std::nullopt;
+}
+
+EncodableValue StandardCodecDocument::Value::ToEncodableValue() const {
+  switch (type()) {
+    case StandardCodecValueType::kNull:
+      return EncodableValue();
+    case StandardCodecValueType::kBool:
+      return EncodableValue(BoolValue());
+    case StandardCodecValueType::kInt32:
+      return EncodableValue(Int32Value());
+    case StandardCodecValueType::kInt64:
+      return EncodableValue(Int64Value());
+    case StandardCodecValueType::kDouble:
+      return EncodableValue(DoubleValue());
+    case StandardCodecValueType::kString:
+      return EncodableValue(std::string(StringValue()));
+    case StandardCodecValueType::kUInt8List:
+      return EncodableValue(UInt8ListValue().ToVector());
+    case StandardCodecValueType::kInt32List:
+      return EncodableValue(Int32ListValue().ToVector());
+    case StandardCodecValueType::kInt64List:
+      return EncodableValue(Int64ListValue().ToVector());
+    case StandardCodecValueType::kFloat32List:
+      return EncodableValue(Float32ListValue().ToVector());
+    case StandardCodecValueType::kFloat64List:
+      return EncodableValue(Float64ListValue().ToVector());
+    case StandardCodecValueType::kList: {
+      EncodableList list;
+      list.reserve(size());
+      for (size_t i = 0; i < size(); ++i) {
+        list.push_back((*this)[i].ToEncodableValue());
+      }
+      return EncodableValue(std::move(list));
+    }
+    case StandardCodecValueType::kMap: {
+      EncodableMap map;
+      for (size_t i = 0; i < size(); ++i) {
+        map.emplace(MapKeyAt(i).ToEncodableValue(),
+                    MapValueAt(i).ToEncodableValue());
+      }
+      return EncodableValue(std::move(map));
+    }
+  }
+  assert(false);
+  return EncodableValue();
+}
+
+StandardCodecDocument::Value StandardCodecDocument::Value::ChildAt(
+    size_t child) const {
+  const Node& node = document_->nodes_[index_];
+  return Value(document_, document_->children_[node.first_child + child]);
+}
+
 // ===== standard_message_codec.h =====
 
 // static
@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_stream.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns a list of |count| maps resembling the events a desktop plugin
+// sends to Dart.
+EncodableValue CreateMessage(size_t count) {
+  EncodableList events;
+  for (size_t i = 0; i < count; ++i) {
+    events.push_back(EncodableValue(EncodableMap{
+        {EncodableValue("id"), EncodableValue(static_cast<int32_t>(i))},
+        {EncodableValue("timestamp"),
+         EncodableValue(static_cast<int64_t>(i) << 32)},
+        {EncodableValue("name"), EncodableValue("event " + std::to_string(i))},
+        {EncodableValue("x"), EncodableValue(i * 0.5)},
+        {EncodableValue("y"), EncodableValue(i * 0.25)},
+        {EncodableValue("tags"), EncodableValue(EncodableList{
+                                     EncodableValue("pointer"),
+                                     EncodableValue("mouse"),
+                                 })},
+        {EncodableValue("transform"),
+         EncodableValue(std::vector<double>(16, 1.0))},
+        {EncodableValue("payload"), EncodableValue(std::vector<uint8_t>(64))},
+    }));
+  }
+  return EncodableValue(std::move(events));
+}
+
+std::vector<uint8_t> EncodeMessage(size_t count) {
+  return *StandardMessageCodec::GetInstance().EncodeMessage(
+      CreateMessage(count));
+}
+
+// Touches every value so that no decoder can skip work.
+class SummingVisitor : public StandardCodecVisitor {
+ public:
+  bool OnInt32(int32_t value) override {
+    sum += value;
+    return true;
+  }
+  bool OnInt64(int64_t value) override {
+    sum += value;
+    return true;
+  }
+  bool OnDouble(double value) override {
+    sum += static_cast<int64_t>(value);
+    return true;
+  }
+  bool OnString(std::string_view value) override {
+    sum += value.size();
+    return true;
+  }
+  bool OnUInt8List(StandardCodecListView<uint8_t> value) override {
+    sum += value.size();
+    return true;
+  }
+  bool OnFloat64List(StandardCodecListView<double> value) override {
+    sum += value.size();
+    return true;
+  }
+
+  int64_t sum = 0;
+};
+
+}  // namespace
+
+static void BM_DecodeEncodableValue(benchmark::State& state) {
+  const std::vector<uint8_t> bytes = EncodeMessage(state.range(0));
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  for (auto _ : state) {
+    auto value = codec.DecodeMessage(bytes);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+static void BM_DecodeStreamReader(benchmark::State& state) {
+  const std::vector<uint8_t> bytes = EncodeMessage(state.range(0));
+  for (auto _ : state) {
+    StandardCodecStreamReader reader(bytes.data(), bytes.size());
+    SummingVisitor visitor;
+    reader.ReadValue(visitor);
+    benchmark::DoNotOptimize(visitor.sum);
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+static void BM_DecodeDocument(benchmark::State& state) {
+  const std::vector<uint8_t> bytes = EncodeMessage(state.range(0));
+  StandardCodecDocument document;
+  for (auto _ : state) {
+    document.Parse(bytes.data(), bytes.size());
+    benchmark::DoNotOptimize(document.root().size());
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+static void BM_EncodeEncodableValue(benchmark::State& state) {
+  const EncodableValue value = CreateMessage(state.range(0));
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  for (auto _ : state) {
+    auto bytes = codec.EncodeMessage(value);
+    benchmark::DoNotOptimize(bytes);
+  }
+}
+
+static void BM_EncodeStreamWriter(benchmark::State& state) {
+  const size_t count = state.range(0);
+  const std::vector<double> transform(16, 1.0);
+  const std::vector<uint8_t> payload(64);
+  std::vector<uint8_t> bytes;
+  std::string name;
+  for (auto _ : state) {
+    // Reusing the buffer is what makes writing allocation free.
+    bytes.clear();
+    StandardCodecStreamWriter writer(&bytes);
+    writer.WriteListStart(count);
+    for (size_t i = 0; i < count; ++i) {
+      writer.WriteMapStart(8);
+      writer.WriteString("id");
+      writer.WriteInt32(static_cast<int32_t>(i));
+      writer.WriteString("name");
+      name = "event " + std::to_string(i);
+      writer.WriteString(name);
+      writer.WriteString("payload");
+      writer.WriteUInt8List(payload.data(), payload.size());
+      writer.WriteString("tags");
+      writer.WriteListStart(2);
+      writer.WriteString("pointer");
+      writer.WriteString("mouse");
+      writer.WriteString("timestamp");
+      writer.WriteInt64(static_cast<int64_t>(i) << 32);
+      writer.WriteString("transform");
+      writer.WriteFloat64List(transform.data(), transform.size());
+      writer.WriteString("x");
+      writer.WriteDouble(i * 0.5);
+      writer.WriteString("y");
+      writer.WriteDouble(i * 0.25);
+    }
+    benchmark::DoNotOptimize(bytes.data());
+  }
+}
+
+BENCHMARK(BM_DecodeEncodableValue)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_DecodeStreamReader)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_DecodeDocument)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_EncodeEncodableValue)->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_EncodeStreamWriter)->RangeMultiplier(8)->Range(1, 512);
+
+}  // namespace flutter
@@ -0,0 +1,336 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_stream.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+// Records the values reported by a reader as strings.
+class RecordingVisitor : public StandardCodecVisitor {
+ public:
+  bool OnNull() override { return Record("null"); }
+  bool OnBool(bool value) override {
+    return Record(value ? "true" : "false");
+  }
+  bool OnInt32(int32_t value) override {
+    return Record("int32 " + std::to_string(value));
+  }
+  bool OnInt64(int64_t value) override {
+    return Record("int64 " + std::to_string(value));
+  }
+  bool OnDouble(double value) override {
+    return Record("double " + std::to_string(value));
+  }
+  bool OnString(std::string_view value) override {
+    return Record("string " + std::string(value));
+  }
+  bool OnUInt8List(StandardCodecListView<uint8_t> value) override {
+    return Record("uint8 list " + std::to_string(value.size()));
+  }
+  bool OnInt32List(StandardCodecListView<int32_t> value) override {
+    return Record("int32 list " + std::to_string(value.size()));
+  }
+  bool OnFloat64List(StandardCodecListView<double> value) override {
+    return Record("float64 list " + std::to_string(value.size()));
+  }
+  bool OnListStart(size_t size) override {
+    return Record("list " + std::to_string(size));
+  }
+  bool OnListEnd() override { return Record("end list"); }
+  bool OnMapStart(size_t size) override {
+    return Record("map " + std::to_string(size));
+  }
+  bool OnMapEnd() override { return Record("end map"); }
+
+  std::vector<std::string> events;
+  // The number of values to record before stopping.
+  size_t limit = SIZE_MAX;
+
+ private:
+  bool Record(std::string event) {
+    events.push_back(std::move(event));
+    return events.size() < limit;
+  }
+};
+
+// A value that uses every type of the standard codec.
+EncodableValue CreateTestValue() {
+  return EncodableValue(EncodableMap{
+      {EncodableValue("null"), EncodableValue()},
+      {EncodableValue("bool"), EncodableValue(true)},
+      {EncodableValue("int32"), EncodableValue(-7)},
+      {EncodableValue("int64"), EncodableValue(INT64_C(0x1234567890))},
+      {EncodableValue("double"), EncodableValue(0.5)},
+      {EncodableValue("bytes"), EncodableValue(std::vector<uint8_t>{1, 2, 3})},
+      {EncodableValue("int32s"), EncodableValue(std::vector<int32_t>{4, 5})},
+      {EncodableValue("int64s"), EncodableValue(std::vector<int64_t>{6})},
+      {EncodableValue("float32s"), EncodableValue(std::vector<float>{7.0f})},
+      {EncodableValue("float64s"), EncodableValue(std::vector<double>{8.0})},
+      {EncodableValue("list"), EncodableValue(EncodableList{
+                                   EncodableValue("nested"),
+                                   EncodableValue(EncodableMap{
+                                       {EncodableValue(1), EncodableValue(2)},
+                                   }),
+                               })},
+  });
+}
+
+std::vector<uint8_t> Encode(const EncodableValue& value) {
+  return *StandardMessageCodec::GetInstance().EncodeMessage(value);
+}
+
+}  // namespace
+
+TEST(StandardCodecStreamReader, ReportsValuesInOrder) {
+  std::vector<uint8_t> bytes = Encode(EncodableValue(EncodableList{
+      EncodableValue(),
+      EncodableValue(false),
+      EncodableValue(42),
+      EncodableValue(INT64_C(1) << 40),
+      EncodableValue(1.5),
+      EncodableValue("hello"),
+      EncodableValue(std::vector<uint8_t>{1, 2}),
+      EncodableValue(std::vector<int32_t>{3, 4, 5}),
+      EncodableValue(std::vector<double>{2.5}),
+      EncodableValue(EncodableMap{
+          {EncodableValue("key"), EncodableValue(EncodableList{})},
+      }),
+  }));
+
+  StandardCodecStreamReader reader(bytes.data(), bytes.size());
+  RecordingVisitor visitor;
+  ASSERT_TRUE(reader.ReadValue(visitor));
+  EXPECT_TRUE(reader.at_end());
+  EXPECT_EQ(visitor.events, std::vector<std::string>({
+                                "list 10",
+                                "null",
+                                "false",
+                                "int32 42",
+                                "int64 1099511627776",
+                                "double 1.500000",
+                                "string hello",
+                                "uint8 list 2",
+                                "int32 list 3",
+                                "float64 list 1",
+                                "map 1",
+                                "string key",
+                                "list 0",
+                                "end list",
+                                "end map",
+                                "end list",
+                            }));
+}
+
+TEST(StandardCodecStreamReader, ListViewsReferToTheMessage) {
+  std::vector<uint8_t> bytes =
+      Encode(EncodableValue(std::vector<int32_t>{0x12345678, -1}));
+
+  class Visitor : public StandardCodecVisitor {
+   public:
+    bool OnInt32List(StandardCodecListView<int32_t> value) override {
+      list = value;
+      return true;
+    }
+    StandardCodecListView<int32_t> list;
+  } visitor;
+  StandardCodecStreamReader reader(bytes.data(), bytes.size());
+  ASSERT_TRUE(reader.ReadValue(visitor));
+
+  ASSERT_EQ(visitor.list.size(), 2u);
+  EXPECT_EQ(visitor.list.bytes(), bytes.data() + 4);
+  EXPECT_EQ(visitor.list[0], 0x12345678);
+  EXPECT_EQ(visitor.list[1], -1);
+  // The elements are aligned relative to the start of the message, and the
+  // buffer of a vector is aligned.
+  ASSERT_NE(visitor.list.data(), nullptr);
+  EXPECT_EQ(visitor.list.data()[1], -1);
+  EXPECT_EQ(visitor.list.ToVector(), std::vector<int32_t>({0x12345678, -1}));
+}
+
+TEST(StandardCodecStreamReader, RejectsTruncatedMessages) {
+  std::vector<uint8_t> bytes = Encode(CreateTestValue());
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    StandardCodecStreamReader reader(bytes.data(), size);
+    RecordingVisitor visitor;
+    EXPECT_FALSE(reader.ReadValue(visitor)) << "size " << size;
+  }
+}
+
+TEST(StandardCodecStreamReader, RejectsSizesLargerThanTheMessage) {
+  // A list and a map that claim to have 0xffffffff entries.
+  for (uint8_t type : {0x0c, 0x0d}) {
+    std::vector<uint8_t> bytes = {type, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
+    StandardCodecStreamReader reader(bytes.data(), bytes.size());
+    RecordingVisitor visitor;
+    EXPECT_FALSE(reader.ReadValue(visitor));
+    EXPECT_TRUE(visitor.events.empty());
+  }
+}
+
+TEST(StandardCodecStreamReader, StopsWhenTheVisitorStops) {
+  std::vector<uint8_t> bytes = Encode(EncodableValue(EncodableList{
+      EncodableValue(1),
+      EncodableValue(2),
+      EncodableValue(3),
+  }));
+  StandardCodecStreamReader reader(bytes.data(), bytes.size());
+  RecordingVisitor visitor;
+  visitor.limit = 2;
+  EXPECT_FALSE(reader.ReadValue(visitor));
+  EXPECT_EQ(visitor.events, std::vector<std::string>({"list 3", "int32 1"}));
+}
+
+TEST(StandardCodecStreamReader, CanReadCustomValues) {
+  // A custom type 128 holding a size-prefixed string.
+  std::vector<uint8_t> bytes = {0x0c, 0x02, 0x80, 0x02, 'h', 'i', 0x00};
+
+  class Visitor : public RecordingVisitor {
+   public:
+    bool OnCustomValue(uint8_t type,
+                       StandardCodecStreamReader& reader) override {
+      size_t size = 0;
+      const uint8_t* value = nullptr;
+      if (type != 128 || !reader.ReadSize(&size) ||
+          !reader.ReadBytes(size, &value)) {
+        return false;
+      }
+      events.push_back(
+          "custom " +
+          std::string(reinterpret_cast<const char*>(value), size));
+      return true;
+    }
+  } visitor;
+  StandardCodecStreamReader reader(bytes.data(), bytes.size());
+  ASSERT_TRUE(reader.ReadValue(visitor));
+  EXPECT_EQ(visitor.events, std::vector<std::string>(
+                                {"list 2", "custom hi", "null", "end list"}));
+
+  // Without an override, custom values stop the reader.
+  StandardCodecStreamReader default_reader(bytes.data(), bytes.size());
+  RecordingVisitor default_visitor;
+  EXPECT_FALSE(default_reader.ReadValue(default_visitor));
+}
+
+TEST(StandardCodecStreamWriter, MatchesStandardMessageCodec) {
+  std::vector<uint8_t> bytes;
+  StandardCodecStreamWriter writer(&bytes);
+  const std::vector<uint8_t> uint8s = {1, 2, 3};
+  const std::vector<int32_t> int32s = {4, 5};
+  const std::vector<int64_t> int64s = {6};
+  const std::vector<float> float32s = {7.0f};
+  const std::vector<double> float64s = {8.0};
+  // EncodableMap is ordered by key, so write the entries in that order.
+  writer.WriteMapStart(11);
+  writer.WriteString("bool");
+  writer.WriteBool(true);
+  writer.WriteString("bytes");
+  writer.WriteUInt8List(uint8s.data(), uint8s.size());
+  writer.WriteString("double");
+  writer.WriteDouble(0.5);
+  writer.WriteString("float32s");
+  writer.WriteFloat32List(float32s.data(), float32s.size());
+  writer.WriteString("float64s");
+  writer.WriteFloat64List(float64s.data(), float64s.size());
+  writer.WriteString("int32");
+  writer.WriteInt32(-7);
+  writer.WriteString("int32s");
+  writer.WriteInt32List(int32s.data(), int32s.size());
+  writer.WriteString("int64");
+  writer.WriteInt64(INT64_C(0x1234567890));
+  writer.WriteString("int64s");
+  writer.WriteInt64List(int64s.data(), int64s.size());
+  writer.WriteString("list");
+  writer.WriteListStart(2);
+  writer.WriteString("nested");
+  writer.WriteMapStart(1);
+  writer.WriteInt32(1);
+  writer.WriteInt32(2);
+  writer.WriteString("null");
+  writer.WriteNull();
+
+  EXPECT_EQ(bytes, Encode(CreateTestValue()));
+}
+
+TEST(StandardCodecStreamWriter, PadsEmptyLists) {
+  std::vector<uint8_t> bytes;
+  StandardCodecStreamWriter writer(&bytes);
+  writer.WriteListStart(2);
+  writer.WriteFloat64List(nullptr, 0);
+  writer.WriteInt32(1);
+
+  EXPECT_EQ(bytes,
+            std::vector<uint8_t>({0x0c, 0x02, 0x0b, 0x00, 0x00, 0x00, 0x00,
+                                  0x00, 0x03, 0x01, 0x00, 0x00, 0x00}));
+  EXPECT_EQ(*StandardMessageCodec::GetInstance().DecodeMessage(bytes),
+            EncodableValue(EncodableList{
+                EncodableValue(std::vector<double>{}),
+                EncodableValue(1),
+            }));
+}
+
+TEST(StandardCodecDocument, CanBeConvertedToEncodableValue) {
+  EncodableValue value = CreateTestValue();
+  std::vector<uint8_t> bytes = Encode(value);
+
+  StandardCodecDocument document;
+  ASSERT_TRUE(document.Parse(bytes.data(), bytes.size()));
+  EXPECT_EQ(document.root().ToEncodableValue(), value);
+}
+
+TEST(StandardCodecDocument, CanLookUpValues) {
+  std::vector<uint8_t> bytes = Encode(CreateTestValue());
+  StandardCodecDocument document;
+  ASSERT_TRUE(document.Parse(bytes.data(), bytes.size()));
+
+  StandardCodecDocument::Value root = document.root();
+  ASSERT_EQ(root.type(), StandardCodecValueType::kMap);
+  EXPECT_EQ(root.size(), 11u);
+  EXPECT_TRUE(root.Find("null")->IsNull());
+  EXPECT_TRUE(root.Find("bool")->BoolValue());
+  EXPECT_EQ(root.Find("int32")->LongValue(), -7);
+  EXPECT_EQ(root.Find("int64")->LongValue(), INT64_C(0x1234567890));
+  EXPECT_EQ(root.Find("double")->DoubleValue(), 0.5);
+  EXPECT_EQ(root.Find("float32s")->Float32ListValue()[0], 7.0f);
+  EXPECT_FALSE(root.Find("missing").has_value());
+
+  StandardCodecDocument::Value list = *root.Find("list");
+  ASSERT_EQ(list.size(), 2u);
+  EXPECT_EQ(list[0].StringValue(), "nested");
+  EXPECT_EQ(list[1].MapKeyAt(0).Int32Value(), 1);
+  EXPECT_EQ(list[1].MapValueAt(0).Int32Value(), 2);
+
+  // Strings refer to the message rather than being copied.
+  std::string_view key = root.MapKeyAt(0).StringValue();
+  EXPECT_GE(reinterpret_cast<const uint8_t*>(key.data()), bytes.data());
+  EXPECT_LT(reinterpret_cast<const uint8_t*>(key.data()),
+            bytes.data() + bytes.size());
+}
+
+TEST(StandardCodecDocument, CanBeReused) {
+  std::vector<uint8_t> large = Encode(CreateTestValue());
+  std::vector<uint8_t> small = Encode(EncodableValue(EncodableList{
+      EncodableValue("a"),
+      EncodableValue(EncodableList{EncodableValue(1)}),
+  }));
+  std::vector<uint8_t> malformed(large.begin(), large.end() - 1);
+
+  StandardCodecDocument document;
+  ASSERT_TRUE(document.Parse(large.data(), large.size()));
+  ASSERT_TRUE(document.Parse(small.data(), small.size()));
+  EXPECT_EQ(document.root().ToEncodableValue(),
+            *StandardMessageCodec::GetInstance().DecodeMessage(small));
+
+  EXPECT_FALSE(document.Parse(malformed.data(), malformed.size()));
+  EXPECT_FALSE(document.has_value());
+}
+
+}  // namespace flutter
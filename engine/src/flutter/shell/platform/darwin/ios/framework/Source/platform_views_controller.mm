@@ -431,28 +431,28 @@ void PlatformViewsController::ApplyMutators(const MutatorsStack& mutators_stack,
   CGFloat screenScale = [UIScreen mainScreen].scale;
   auto iter = mutators_stack.Begin();
   while (iter != mutators_stack.End()) {
-    switch ((*iter)->GetType()) {
+    switch (iter->GetType()) {
       case kTransform: {
-        transformMatrix.preConcat((*iter)->GetMatrix());
+        transformMatrix.preConcat(iter->GetMatrix());
         break;
       }
       case kClipRect: {
-        if (ClipRectContainsPlatformViewBoundingRect((*iter)->GetRect(), bounding_rect,
+        if (ClipRectContainsPlatformViewBoundingRect(iter->GetRect(), bounding_rect,
                                                      transformMatrix)) {
           break;
         }
         ClipViewSetMaskView(clipView);
-        [(FlutterClippingMaskView*)clipView.maskView clipRect:(*iter)->GetRect()
+        [(FlutterClippingMaskView*)clipView.maskView clipRect:iter->GetRect()
                                                        matrix:transformMatrix];
         break;
       }
       case kClipRRect: {
-        if (ClipRRectContainsPlatformViewBoundingRect((*iter)->GetRRect(), bounding_rect,
+        if (ClipRRectContainsPlatformViewBoundingRect(iter->GetRRect(), bounding_rect,
                                                       transformMatrix)) {
           break;
         }
         ClipViewSetMaskView(clipView);
-        [(FlutterClippingMaskView*)clipView.maskView clipRRect:(*iter)->GetRRect()
+        [(FlutterClippingMaskView*)clipView.maskView clipRRect:iter->GetRRect()
                                                         matrix:transformMatrix];
         break;
       }
@@ -461,19 +461,19 @@ void PlatformViewsController::ApplyMutators(const MutatorsStack& mutators_stack,
         // rect. See `ClipRRectContainsPlatformViewBoundingRect`.
         // https://github.com/flutter/flutter/issues/118650
         ClipViewSetMaskView(clipView);
-        [(FlutterClippingMaskView*)clipView.maskView clipPath:(*iter)->GetPath()
+        [(FlutterClippingMaskView*)clipView.maskView clipPath:iter->GetPath()
                                                        matrix:transformMatrix];
         break;
       }
       case kOpacity:
-        embedded_view.alpha = (*iter)->GetAlphaFloat() * embedded_view.alpha;
+        embedded_view.alpha = iter->GetAlphaFloat() * embedded_view.alpha;
         break;
       case kBackdropFilter: {
         // Only support DlBlurImageFilter for BackdropFilter.
-        if (!canApplyBlurBackdrop || !(*iter)->GetFilterMutation().GetFilter().asBlur()) {
+        if (!canApplyBlurBackdrop || !iter->GetFilterMutation().GetFilter().asBlur()) {
           break;
         }
-        CGRect filterRect = GetCGRectFromSkRect((*iter)->GetFilterMutation().GetFilterRect());
+        CGRect filterRect = GetCGRectFromSkRect(iter->GetFilterMutation().GetFilterRect());
         // `filterRect` is in global coordinates. We need to convert to local space.
         filterRect = CGRectApplyAffineTransform(
             filterRect, CGAffineTransformMakeScale(1 / screenScale, 1 / screenScale));
@@ -489,7 +489,7 @@ void PlatformViewsController::ApplyMutators(const MutatorsStack& mutators_stack,
         // sigma_x and sigma_y equal to each other. DlBlurImageFilter's Tile Mode
         // is not supported in Quartz's gaussianBlur CAFilter, so it is not used
         // to blur the PlatformView.
-        CGFloat blurRadius = (*iter)->GetFilterMutation().GetFilter().asBlur()->sigma_x();
+        CGFloat blurRadius = iter->GetFilterMutation().GetFilter().asBlur()->sigma_x();
         UIVisualEffectView* visualEffectView = [[UIVisualEffectView alloc]
             initWithEffect:[UIBlurEffect effectWithStyle:UIBlurEffectStyleLight]];
         PlatformViewFilter* filter = [[PlatformViewFilter alloc] initWithFrame:frameInClipView
@@ -723,12 +723,17 @@ InferSoftwarePlatformViewCreationCallback(
       [software_dispatch_table, platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        std::shared_ptr<fml::BasicTaskRunner> tile_task_runner;
+        if (shell.GetSettings().enable_software_tiled_rendering) {
+          tile_task_runner = shell.GetConcurrentWorkerTaskRunner();
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            std::move(tile_task_runner)         // tile task runner
         );
       });
 }
@@ -1467,6 +1472,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
       SAFE_ACCESS(compositor, present_view_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  bool enable_partial_repaint =
+      SAFE_ACCESS(compositor, enable_partial_repaint, false);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback) {
@@ -1522,8 +1529,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor,
   }
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+              avoid_backing_store_cache, enable_partial_repaint,
+              create_render_target_callback, present_callback),
           false};
 }
 
@@ -2072,6 +2079,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
               message->data().GetMapping(),    // message
               message->data().GetSize(),       // message_size
               handle,                          // response_handle
+              nullptr,  // message_release_callback
+              nullptr,  // message_release_user_data
           };
           handle->message = std::move(message);
           return ptr(&incoming_message, user_data);
@@ -2807,22 +2816,38 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
 FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* flutter_message) {
-  if (engine == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
-  }
-
   if (flutter_message == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid message argument.");
   }
 
+  size_t message_size = SAFE_ACCESS(flutter_message, message_size, 0);
+  const uint8_t* message_data = SAFE_ACCESS(flutter_message, message, nullptr);
+
+  // Take ownership of the message data before anything else so that it is
+  // released even if the message can't be sent.
+  VoidCallback release_callback =
+      SAFE_ACCESS(flutter_message, message_release_callback, nullptr);
+  void* release_user_data =
+      SAFE_ACCESS(flutter_message, message_release_user_data, nullptr);
+  std::unique_ptr<fml::Mapping> external_data;
+  if (release_callback != nullptr) {
+    external_data = std::make_unique<fml::NonOwnedMapping>(
+        message_data, message_size,
+        [release_callback, release_user_data](const uint8_t* data,
+                                              size_t size) {
+          release_callback(release_user_data);
+        });
+  }
+
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
   if (SAFE_ACCESS(flutter_message, channel, nullptr) == nullptr) {
     return LOG_EMBEDDER_ERROR(
         kInvalidArguments, "Message argument did not specify a valid channel.");
   }
 
-  size_t message_size = SAFE_ACCESS(flutter_message, message_size, 0);
-  const uint8_t* message_data = SAFE_ACCESS(flutter_message, message, nullptr);
-
   if (message_size != 0 && message_data == nullptr) {
     return LOG_EMBEDDER_ERROR(
         kInvalidArguments,
@@ -2841,6 +2866,9 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   if (message_size == 0) {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel, response);
+  } else if (external_data) {
+    message = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel, std::move(external_data), response);
   } else {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
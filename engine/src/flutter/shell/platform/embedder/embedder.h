@@ -1236,6 +1236,19 @@ typedef struct {
   /// `FlutterEngineSendPlatformMessageResponse` will cause a memory leak. It is
   /// not safe to send multiple responses on a single response object.
   const FlutterPlatformMessageResponseHandle* response_handle;
+  /// An optional callback that hands the ownership of the `message` buffer to
+  /// the engine when the message is sent using
+  /// `FlutterEngineSendPlatformMessage`. The engine then doesn't copy the
+  /// buffer but passes it to the Flutter application as an unmodifiable
+  /// `ByteData`, and invokes this callback with `message_release_user_data`
+  /// once it is no longer referenced. The buffer must not be modified or
+  /// collected until then. The callback may be invoked on any thread and is
+  /// invoked exactly once, even if the message could not be sent.
+  ///
+  /// This is always null for messages received from the engine.
+  VoidCallback message_release_callback;
+  /// The user data passed to `message_release_callback`.
+  void* message_release_user_data;
 } FlutterPlatformMessage;
 
 typedef void (*FlutterPlatformMessageCallback)(
@@ -1883,6 +1896,14 @@ typedef struct {
   /// outside of this area are transparent and the embedder may choose not
   /// to render them. Coordinates are in physical pixels.
   FlutterRegion* paint_region;
+
+  /// The area of the backing store that the engine rendered into for this
+  /// frame. The rest of the backing store has the same contents as the last
+  /// time that it was presented. Null if the engine rendered the whole backing
+  /// store, which it always does unless
+  /// `FlutterCompositor.enable_partial_repaint` is set. Coordinates are in
+  /// physical pixels.
+  FlutterRegion* damage_region;
 } FlutterBackingStorePresentInfo;
 
 typedef struct {
@@ -1999,6 +2020,15 @@ typedef struct {
   ///
   /// The callback should return true if the operation was successful.
   FlutterPresentViewCallback present_view_callback;
+  /// Allow the engine to only render the areas of the backing stores that
+  /// changed since the previous frame. The engine reports the area it rendered
+  /// into each backing store in `FlutterBackingStorePresentInfo.damage_region`,
+  /// and clears `FlutterBackingStore.did_update` for backing stores it did not
+  /// render into at all.
+  ///
+  /// If set, the embedder must preserve the contents of the backing stores
+  /// between frames. Ignored if `avoid_backing_store_cache` is set.
+  bool enable_partial_repaint;
 } FlutterCompositor;
 
 typedef struct {
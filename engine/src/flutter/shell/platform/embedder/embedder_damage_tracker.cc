@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_damage_tracker.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter {
+
+EmbedderDamageTracker::EmbedderDamageTracker() = default;
+
+EmbedderDamageTracker::~EmbedderDamageTracker() = default;
+
+void EmbedderDamageTracker::BeginFrame(
+    const std::optional<SkIRect>& frame_damage,
+    const SkMatrix& surface_transformation) {
+  if (surface_transformation_ == surface_transformation) {
+    frame_damage_ = frame_damage;
+  } else {
+    frame_damage_ = std::nullopt;
+  }
+  surface_transformation_ = surface_transformation;
+  current_contents_.clear();
+}
+
+bool EmbedderDamageTracker::HasContents(
+    const EmbedderRenderTarget* render_target,
+    const LayerContents& contents) const {
+  auto found = previous_contents_.find(render_target);
+  return found != previous_contents_.end() &&
+         std::equal(found->second.begin(), found->second.end(),
+                    contents.begin(), contents.end(),
+                    EmbedderExternalView::ViewIdentifier::Equal());
+}
+
+std::optional<SkIRect> EmbedderDamageTracker::GetDamage(
+    const EmbedderRenderTarget* render_target,
+    const LayerContents& contents) const {
+  if (!HasContents(render_target, contents)) {
+    return std::nullopt;
+  }
+  return frame_damage_;
+}
+
+void EmbedderDamageTracker::SetContents(
+    const EmbedderRenderTarget* render_target,
+    LayerContents contents) {
+  current_contents_[render_target] = std::move(contents);
+}
+
+void EmbedderDamageTracker::EndFrame() {
+  previous_contents_ = std::move(current_contents_);
+  current_contents_.clear();
+}
+
+}  // namespace flutter
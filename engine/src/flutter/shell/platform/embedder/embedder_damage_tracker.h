@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_DAMAGE_TRACKER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_DAMAGE_TRACKER_H_
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/platform/embedder/embedder_external_view.h"
+#include "flutter/shell/platform/embedder/embedder_render_target.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Tracks what was rendered into the render targets of a view, so
+///             that a render target that is reused for the same layer in the
+///             next frame only has to be rendered where that frame was
+///             damaged.
+///
+///             Render targets are only reused from one frame to the next, as
+///             the render target cache releases the ones a frame did not use.
+///             The contents of a layer are identified by the external views
+///             whose slices are rendered into it. All damage is in the
+///             coordinates of the frame, before the root surface
+///             transformation.
+///
+class EmbedderDamageTracker {
+ public:
+  using LayerContents = std::vector<EmbedderExternalView::ViewIdentifier>;
+
+  EmbedderDamageTracker();
+
+  ~EmbedderDamageTracker();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts tracking a new frame.
+  ///
+  /// @param[in]  frame_damage            The area of the frame that changed
+  ///                                     since the previous frame, or
+  ///                                     std::nullopt if it is not known.
+  /// @param[in]  surface_transformation  The root surface transformation of
+  ///                                     the frame. Render targets rendered
+  ///                                     with another transformation are
+  ///                                     rendered in full.
+  ///
+  void BeginFrame(const std::optional<SkIRect>& frame_damage,
+                  const SkMatrix& surface_transformation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the contents of a layer were last rendered into the
+  ///             render target, which makes it the best render target to
+  ///             reuse for that layer.
+  ///
+  bool HasContents(const EmbedderRenderTarget* render_target,
+                   const LayerContents& contents) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the area of the render target that has to be
+  ///             rendered for it to show the contents of a layer in the
+  ///             current frame, or std::nullopt if all of it has to be.
+  ///
+  std::optional<SkIRect> GetDamage(const EmbedderRenderTarget* render_target,
+                                   const LayerContents& contents) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that the contents of a layer were rendered into the
+  ///             render target in the current frame.
+  ///
+  void SetContents(const EmbedderRenderTarget* render_target,
+                   LayerContents contents);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finishes the current frame and forgets the render targets
+  ///             that were not rendered into, since they are released by the
+  ///             next frame.
+  ///
+  void EndFrame();
+
+ private:
+  using RenderedContentsMap =
+      std::unordered_map<const EmbedderRenderTarget*, LayerContents>;
+
+  std::optional<SkMatrix> surface_transformation_;
+  // The damage of the current frame, or std::nullopt if it is not known or
+  // the root surface transformation changed since the previous frame.
+  std::optional<SkIRect> frame_damage_;
+  // What was rendered into the render targets of the previous frame.
+  RenderedContentsMap previous_contents_;
+  // What was rendered into the render targets of the current frame.
+  RenderedContentsMap current_contents_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderDamageTracker);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_DAMAGE_TRACKER_H_
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_damage_tracker.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+class TestRenderTarget : public EmbedderRenderTarget {
+ public:
+  TestRenderTarget() : EmbedderRenderTarget(FlutterBackingStore{}, nullptr) {}
+
+  sk_sp<SkSurface> GetSkiaSurface() const override { return nullptr; }
+
+  impeller::RenderTarget* GetImpellerRenderTarget() const override {
+    return nullptr;
+  }
+
+  std::shared_ptr<impeller::AiksContext> GetAiksContext() const override {
+    return nullptr;
+  }
+
+  SkISize GetRenderTargetSize() const override { return SkISize::Make(0, 0); }
+};
+
+using ViewIdentifier = EmbedderExternalView::ViewIdentifier;
+
+const EmbedderDamageTracker::LayerContents kRootContents = {ViewIdentifier()};
+const EmbedderDamageTracker::LayerContents kOverlayContents = {
+    ViewIdentifier(1), ViewIdentifier(2)};
+
+}  // namespace
+
+TEST(EmbedderDamageTrackerTest, RendersNewRenderTargetsInFull) {
+  EmbedderDamageTracker tracker;
+  TestRenderTarget target;
+  tracker.BeginFrame(SkIRect::MakeWH(10, 10), SkMatrix::I());
+  EXPECT_FALSE(tracker.HasContents(&target, kRootContents));
+  EXPECT_EQ(tracker.GetDamage(&target, kRootContents), std::nullopt);
+}
+
+TEST(EmbedderDamageTrackerTest, RendersDamageOfReusedRenderTargets) {
+  EmbedderDamageTracker tracker;
+  TestRenderTarget root_target;
+  TestRenderTarget overlay_target;
+  tracker.BeginFrame(std::nullopt, SkMatrix::I());
+  tracker.SetContents(&root_target, kRootContents);
+  tracker.SetContents(&overlay_target, kOverlayContents);
+  tracker.EndFrame();
+
+  const SkIRect damage = SkIRect::MakeXYWH(10, 20, 30, 40);
+  tracker.BeginFrame(damage, SkMatrix::I());
+  EXPECT_TRUE(tracker.HasContents(&root_target, kRootContents));
+  EXPECT_EQ(tracker.GetDamage(&root_target, kRootContents), damage);
+  EXPECT_EQ(tracker.GetDamage(&overlay_target, kOverlayContents), damage);
+
+  // Render targets that held the contents of another layer are rendered in
+  // full.
+  EXPECT_FALSE(tracker.HasContents(&root_target, kOverlayContents));
+  EXPECT_EQ(tracker.GetDamage(&root_target, kOverlayContents), std::nullopt);
+}
+
+TEST(EmbedderDamageTrackerTest, ForgetsRenderTargetsNotRenderedInAFrame) {
+  EmbedderDamageTracker tracker;
+  TestRenderTarget target;
+  tracker.BeginFrame(std::nullopt, SkMatrix::I());
+  tracker.SetContents(&target, kRootContents);
+  tracker.EndFrame();
+
+  tracker.BeginFrame(SkIRect::MakeEmpty(), SkMatrix::I());
+  tracker.EndFrame();
+
+  tracker.BeginFrame(SkIRect::MakeEmpty(), SkMatrix::I());
+  EXPECT_EQ(tracker.GetDamage(&target, kRootContents), std::nullopt);
+}
+
+TEST(EmbedderDamageTrackerTest, RendersInFullWhenDamageIsUnknown) {
+  EmbedderDamageTracker tracker;
+  TestRenderTarget target;
+  tracker.BeginFrame(std::nullopt, SkMatrix::I());
+  tracker.SetContents(&target, kRootContents);
+  tracker.EndFrame();
+
+  tracker.BeginFrame(std::nullopt, SkMatrix::I());
+  EXPECT_EQ(tracker.GetDamage(&target, kRootContents), std::nullopt);
+}
+
+TEST(EmbedderDamageTrackerTest, RendersInFullWhenTransformationChanges) {
+  EmbedderDamageTracker tracker;
+  TestRenderTarget target;
+  tracker.BeginFrame(std::nullopt, SkMatrix::I());
+  tracker.SetContents(&target, kRootContents);
+  tracker.EndFrame();
+
+  tracker.BeginFrame(SkIRect::MakeEmpty(), SkMatrix::RotateDeg(90));
+  EXPECT_EQ(tracker.GetDamage(&target, kRootContents), std::nullopt);
+  tracker.SetContents(&target, kRootContents);
+  tracker.EndFrame();
+
+  tracker.BeginFrame(SkIRect::MakeEmpty(), SkMatrix::RotateDeg(90));
+  EXPECT_EQ(tracker.GetDamage(&target, kRootContents), SkIRect::MakeEmpty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -111,7 +111,8 @@ static void InvalidateApiState(SkSurface& skia_surface) {
 #endif
 
 bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target,
-                                  bool clear_surface) {
+                                  bool clear_surface,
+                                  const std::optional<SkIRect>& damage) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
   TryEndRecording();
   FML_DCHECK(HasEngineRenderedContents())
@@ -182,6 +183,9 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target,
   DlSkCanvasAdapter dl_canvas(canvas);
   int restore_count = dl_canvas.GetSaveCount();
   dl_canvas.SetTransform(surface_transformation_);
+  if (damage.has_value()) {
+    dl_canvas.ClipRect(SkRect::Make(damage.value()));
+  }
   if (clear_surface) {
     dl_canvas.Clear(DlColor::kTransparent());
   }
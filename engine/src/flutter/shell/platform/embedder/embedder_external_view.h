@@ -102,8 +102,12 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
+  // Renders the slice into the render target. If |damage| is set, only that
+  // area of the frame is cleared and rendered, and the rest of the render
+  // target is left as it is. It is ignored by Impeller render targets.
   bool Render(const EmbedderRenderTarget& render_target,
-              bool clear_surface = true);
+              bool clear_surface = true,
+              const std::optional<SkIRect>& damage = std::nullopt);
 
   const DlRegion& GetDlRegion() const;
 
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 
 #include <cassert>
+#include <optional>
 #include <utility>
 
 #include "flutter/common/constants.h"
@@ -18,9 +19,11 @@ static const auto kRootViewIdentifier = EmbedderExternalView::ViewIdentifier{};
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    bool enable_partial_repaint,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      enable_partial_repaint_(enable_partial_repaint),
       create_render_target_callback_(create_render_target_callback),
       present_callback_(present_callback) {
   FML_DCHECK(create_render_target_callback_);
@@ -31,6 +34,7 @@ EmbedderExternalViewEmbedder::~EmbedderExternalViewEmbedder() = default;
 
 void EmbedderExternalViewEmbedder::CollectView(int64_t view_id) {
   render_target_caches_.erase(view_id);
+  damage_trackers_.erase(view_id);
 }
 
 void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
@@ -92,6 +96,11 @@ void EmbedderExternalViewEmbedder::PrerollCompositeEmbeddedView(
   composition_order_.push_back(vid);
 }
 
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::SupportsPartialRepaint() {
+  return enable_partial_repaint_ && !avoid_backing_store_cache_;
+}
+
 // |ExternalViewEmbedder|
 DlCanvas* EmbedderExternalViewEmbedder::GetRootCanvas() {
   auto found = pending_views_.find(kRootViewIdentifier);
@@ -150,30 +159,30 @@ struct PlatformView {
     for (auto i = params->mutatorsStack().Begin();
          i != params->mutatorsStack().End(); ++i) {
       const auto& m = *i;
-      switch (m->GetType()) {
+      switch (m.GetType()) {
         case kClipRect: {
-          auto rect = transform.mapRect(m->GetRect());
+          auto rect = transform.mapRect(m.GetRect());
           if (!clipped_frame.intersect(rect)) {
             clipped_frame = SkRect::MakeEmpty();
           }
           break;
         }
         case kClipRRect: {
-          auto rect = transform.mapRect(m->GetRRect().getBounds());
+          auto rect = transform.mapRect(m.GetRRect().getBounds());
           if (!clipped_frame.intersect(rect)) {
             clipped_frame = SkRect::MakeEmpty();
           }
           break;
         }
         case kClipPath: {
-          auto rect = transform.mapRect(m->GetPath().getBounds());
+          auto rect = transform.mapRect(m.GetPath().getBounds());
           if (!clipped_frame.intersect(rect)) {
             clipped_frame = SkRect::MakeEmpty();
           }
           break;
         }
         case kTransform: {
-          transform.preConcat(m->GetMatrix());
+          transform.preConcat(m.GetMatrix());
           break;
         }
         case kOpacity:
@@ -241,10 +250,25 @@ class Layer {
 
   bool has_flutter_contents() const { return !flutter_contents_.empty(); }
 
-  void SetRenderTarget(std::unique_ptr<EmbedderRenderTarget> target) {
+  /// Returns the identifiers of the views whose Flutter contents are in this
+  /// layer, which identify what is rendered into its render target.
+  EmbedderDamageTracker::LayerContents flutter_contents_identifiers() const {
+    EmbedderDamageTracker::LayerContents identifiers;
+    identifiers.reserve(flutter_contents_.size());
+    for (auto c : flutter_contents_) {
+      identifiers.push_back(c->GetViewIdentifier());
+    }
+    return identifiers;
+  }
+
+  /// Sets the render target of this layer. If |damage| is set, the render
+  /// target already holds the contents of this layer outside of it.
+  void SetRenderTarget(std::unique_ptr<EmbedderRenderTarget> target,
+                       std::optional<SkIRect> damage) {
     FML_DCHECK(render_target_ == nullptr);
     FML_DCHECK(has_flutter_contents());
     render_target_ = std::move(target);
+    damage_ = damage;
   }
 
   /// Renders this layer Flutter contents to the render target previously
@@ -252,9 +276,14 @@ class Layer {
   void RenderFlutterContents() {
     FML_DCHECK(has_flutter_contents());
     if (render_target_) {
+      const bool did_update = !damage_.has_value() || !damage_->isEmpty();
+      render_target_->SetDidUpdate(did_update);
+      if (!did_update) {
+        return;
+      }
       bool clear_surface = true;
       for (auto c : flutter_contents_) {
-        c->Render(*render_target_, clear_surface);
+        c->Render(*render_target_, clear_surface, damage_);
         clear_surface = false;
       }
     }
@@ -268,6 +297,10 @@ class Layer {
 
   EmbedderRenderTarget* render_target() { return render_target_.get(); }
 
+  /// The area of the frame that is rendered into the render target, or
+  /// std::nullopt if all of it is.
+  const std::optional<SkIRect>& damage() const { return damage_; }
+
   std::vector<SkIRect> coverage() {
     return flutter_contents_region_.getRects();
   }
@@ -277,6 +310,7 @@ class Layer {
   std::vector<EmbedderExternalView*> flutter_contents_;
   DlRegion flutter_contents_region_;
   std::unique_ptr<EmbedderRenderTarget> render_target_;
+  std::optional<SkIRect> damage_;
   friend class LayerBuilder;
 };
 
@@ -292,7 +326,11 @@ class LayerBuilder {
  public:
   using RenderTargetProvider =
       std::function<std::unique_ptr<EmbedderRenderTarget>(
-          const SkISize& frame_size)>;
+          const SkISize& frame_size,
+          const EmbedderDamageTracker::LayerContents& contents)>;
+  using DamageProvider = std::function<std::optional<SkIRect>(
+      const EmbedderRenderTarget& target,
+      const EmbedderDamageTracker::LayerContents& contents)>;
 
   explicit LayerBuilder(SkISize frame_size) : frame_size_(frame_size) {
     layers_.push_back(Layer());
@@ -314,10 +352,19 @@ class LayerBuilder {
   }
 
   /// Prepares the render targets for all layers that have Flutter contents.
-  void PrepareBackingStore(const RenderTargetProvider& target_provider) {
+  /// If |damage_provider| is set, it returns the area that has to be rendered
+  /// into each of them.
+  void PrepareBackingStore(const RenderTargetProvider& target_provider,
+                           const DamageProvider& damage_provider) {
     for (auto& layer : layers_) {
       if (layer.has_flutter_contents()) {
-        layer.SetRenderTarget(target_provider(frame_size_));
+        auto contents = layer.flutter_contents_identifiers();
+        auto target = target_provider(frame_size_, contents);
+        std::optional<SkIRect> damage;
+        if (target && damage_provider) {
+          damage = damage_provider(*target, contents);
+        }
+        layer.SetRenderTarget(std::move(target), damage);
       }
     }
   }
@@ -343,7 +390,7 @@ class LayerBuilder {
       }
       if (layer.render_target() != nullptr) {
         layers.PushBackingStoreLayer(layer.render_target()->GetBackingStore(),
-                                     layer.coverage());
+                                     layer.coverage(), layer.damage());
       }
     }
   }
@@ -438,18 +485,52 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
     builder.AddExternalView(view.get());
   }
 
-  builder.PrepareBackingStore([&](const SkISize& frame_size) {
-    if (!avoid_backing_store_cache_) {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          render_target_cache.GetRenderTarget(
-              EmbedderExternalView::RenderTargetDescriptor(frame_size));
-      if (target != nullptr) {
-        return target;
+  EmbedderDamageTracker* damage_tracker = nullptr;
+  LayerBuilder::DamageProvider damage_provider;
+  if (SupportsPartialRepaint()) {
+    damage_tracker = &damage_trackers_[flutter_view_id];
+    damage_tracker->BeginFrame(frame->submit_info().frame_damage,
+                               pending_surface_transformation_);
+    damage_provider = [&](const EmbedderRenderTarget& target,
+                          const auto& contents) -> std::optional<SkIRect> {
+      // Impeller render targets are always rendered in full.
+      if (target.GetImpellerRenderTarget() != nullptr) {
+        return std::nullopt;
       }
-    }
-    auto config = MakeBackingStoreConfig(flutter_view_id, frame_size);
-    return create_render_target_callback_(context, aiks_context, config);
-  });
+      auto damage = damage_tracker->GetDamage(&target, contents);
+      damage_tracker->SetContents(&target, contents);
+      if (damage.has_value() &&
+          !damage->intersect(SkIRect::MakeSize(pending_frame_size_))) {
+        damage->setEmpty();
+      }
+      return damage;
+    };
+  }
+
+  builder.PrepareBackingStore(
+      [&](const SkISize& frame_size, const auto& contents) {
+        if (!avoid_backing_store_cache_) {
+          // Prefer the render target that the same contents were rendered
+          // into in the previous frame, which only needs their damage to be
+          // rendered again.
+          EmbedderRenderTargetCache::RenderTargetPredicate preferred;
+          if (damage_tracker) {
+            preferred = [&](const EmbedderRenderTarget& target) {
+              return damage_tracker->HasContents(&target, contents);
+            };
+          }
+          std::unique_ptr<EmbedderRenderTarget> target =
+              render_target_cache.GetRenderTarget(
+                  EmbedderExternalView::RenderTargetDescriptor(frame_size),
+                  preferred);
+          if (target != nullptr) {
+            return target;
+          }
+        }
+        auto config = MakeBackingStoreConfig(flutter_view_id, frame_size);
+        return create_render_target_callback_(context, aiks_context, config);
+      },
+      damage_provider);
 
   // This is where unused render targets will be collected. Control may flow
   // to the embedder. Here, the embedder has the opportunity to trample on the
@@ -513,6 +594,10 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
+  if (damage_tracker) {
+    damage_tracker->EndFrame();
+  }
+
   auto render_targets = builder.ClearAndCollectRenderTargets();
   for (auto& render_target : render_targets) {
     if (!avoid_backing_store_cache_) {
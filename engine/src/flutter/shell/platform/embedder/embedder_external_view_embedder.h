@@ -12,6 +12,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
+#include "flutter/shell/platform/embedder/embedder_damage_tracker.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
@@ -47,6 +48,10 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
+  /// @param[in]  enable_partial_repaint   If set and backing stores are
+  ///                                      cached, only the areas of reused
+  ///                                      render targets that changed since
+  ///                                      the previous frame are rendered.
   ///
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
@@ -58,6 +63,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      bool enable_partial_repaint,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -111,8 +117,12 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   DlCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  bool SupportsPartialRepaint() override;
+
  private:
   const bool avoid_backing_store_cache_;
+  const bool enable_partial_repaint_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
@@ -123,6 +133,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   // The render target caches for views. Each key is a view ID.
   std::unordered_map<int64_t, EmbedderRenderTargetCache> render_target_caches_;
+  // The damage trackers for the render targets of views, if partial repaint
+  // is supported. Each key is a view ID.
+  std::unordered_map<int64_t, EmbedderDamageTracker> damage_trackers_;
 
   void Reset();
 
@@ -21,7 +21,8 @@ EmbedderLayers::~EmbedderLayers() = default;
 
 void EmbedderLayers::PushBackingStoreLayer(
     const FlutterBackingStore* store,
-    const std::vector<SkIRect>& paint_region_vec) {
+    const std::vector<SkIRect>& paint_region_vec,
+    const std::optional<SkIRect>& damage) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
@@ -39,13 +40,32 @@ void EmbedderLayers::PushBackingStoreLayer(
   layer.size.width = transformed_layer_bounds.width();
   layer.size.height = transformed_layer_bounds.height();
 
-  auto paint_region_rects = std::make_unique<std::vector<FlutterRect>>();
-  paint_region_rects->reserve(paint_region_vec.size());
+  auto present_info = std::make_unique<FlutterBackingStorePresentInfo>();
+  present_info->struct_size = sizeof(FlutterBackingStorePresentInfo);
+  present_info->paint_region = MakeRegion(paint_region_vec);
+  if (damage.has_value()) {
+    // An empty damage is reported as a region without rectangles.
+    std::vector<SkIRect> damage_rects;
+    if (!damage->isEmpty()) {
+      damage_rects.push_back(damage.value());
+    }
+    present_info->damage_region = MakeRegion(damage_rects);
+  }
+  layer.backing_store_present_info = present_info.get();
+  layer.presentation_time = presentation_time_;
+
+  present_info_referenced_.push_back(std::move(present_info));
+  presented_layers_.push_back(layer);
+}
 
-  for (const auto& rect : paint_region_vec) {
+FlutterRegion* EmbedderLayers::MakeRegion(const std::vector<SkIRect>& rects) {
+  auto region_rects = std::make_unique<std::vector<FlutterRect>>();
+  region_rects->reserve(rects.size());
+
+  for (const auto& rect : rects) {
     auto transformed_rect =
         root_surface_transformation_.mapRect(SkRect::Make(rect));
-    paint_region_rects->push_back(FlutterRect{
+    region_rects->push_back(FlutterRect{
         transformed_rect.x(),
         transformed_rect.y(),
         transformed_rect.right(),
@@ -53,21 +73,13 @@ void EmbedderLayers::PushBackingStoreLayer(
     });
   }
 
-  auto paint_region = std::make_unique<FlutterRegion>();
-  paint_region->struct_size = sizeof(FlutterRegion);
-  paint_region->rects = paint_region_rects->data();
-  paint_region->rects_count = paint_region_rects->size();
-  rects_referenced_.push_back(std::move(paint_region_rects));
-
-  auto present_info = std::make_unique<FlutterBackingStorePresentInfo>();
-  present_info->struct_size = sizeof(FlutterBackingStorePresentInfo);
-  present_info->paint_region = paint_region.get();
-  regions_referenced_.push_back(std::move(paint_region));
-  layer.backing_store_present_info = present_info.get();
-  layer.presentation_time = presentation_time_;
-
-  present_info_referenced_.push_back(std::move(present_info));
-  presented_layers_.push_back(layer);
+  auto region = std::make_unique<FlutterRegion>();
+  region->struct_size = sizeof(FlutterRegion);
+  region->rects = region_rects->data();
+  region->rects_count = region_rects->size();
+  rects_referenced_.push_back(std::move(region_rects));
+  regions_referenced_.push_back(std::move(region));
+  return regions_referenced_.back().get();
 }
 
 static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
@@ -146,24 +158,24 @@ void EmbedderLayers::PushPlatformViewLayer(
 
     for (auto i = mutators.Bottom(); i != mutators.Top(); ++i) {
       const auto& mutator = *i;
-      switch (mutator->GetType()) {
+      switch (mutator.GetType()) {
         case MutatorType::kClipRect: {
           mutations_array.push_back(
               mutations_referenced_
-                  .emplace_back(ConvertMutation(mutator->GetRect()))
+                  .emplace_back(ConvertMutation(mutator.GetRect()))
                   .get());
         } break;
         case MutatorType::kClipRRect: {
           mutations_array.push_back(
               mutations_referenced_
-                  .emplace_back(ConvertMutation(mutator->GetRRect()))
+                  .emplace_back(ConvertMutation(mutator.GetRRect()))
                   .get());
         } break;
         case MutatorType::kClipPath: {
           // Unsupported mutation.
         } break;
         case MutatorType::kTransform: {
-          const auto& matrix = mutator->GetMatrix();
+          const auto& matrix = mutator.GetMatrix();
           if (!matrix.isIdentity()) {
             mutations_array.push_back(
                 mutations_referenced_.emplace_back(ConvertMutation(matrix))
@@ -172,7 +184,7 @@ void EmbedderLayers::PushPlatformViewLayer(
         } break;
         case MutatorType::kOpacity: {
           const double opacity =
-              std::clamp(mutator->GetAlphaFloat(), 0.0f, 1.0f);
+              std::clamp(mutator.GetAlphaFloat(), 0.0f, 1.0f);
           if (opacity < 1.0) {
             mutations_array.push_back(
                 mutations_referenced_.emplace_back(ConvertMutation(opacity))
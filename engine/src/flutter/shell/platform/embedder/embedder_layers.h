@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_LAYERS_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/embedded_views.h"
@@ -25,8 +26,11 @@ class EmbedderLayers {
 
   ~EmbedderLayers();
 
+  // |damage| is the area of the frame that was rendered into the backing
+  // store, or std::nullopt if all of it was.
   void PushBackingStoreLayer(const FlutterBackingStore* store,
-                             const std::vector<SkIRect>& drawn_region);
+                             const std::vector<SkIRect>& drawn_region,
+                             const std::optional<SkIRect>& damage);
 
   void PushPlatformViewLayer(FlutterPlatformViewIdentifier identifier,
                              const EmbeddedViewParams& params);
@@ -53,6 +57,10 @@ class EmbedderLayers {
   std::vector<FlutterLayer> presented_layers_;
   uint64_t presentation_time_;
 
+  // Returns a region of the rectangles, in frame coordinates, transformed by
+  // the root surface transformation. It lives as long as this object.
+  FlutterRegion* MakeRegion(const std::vector<SkIRect>& rects);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderLayers);
 };
 
@@ -91,6 +91,15 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the backing store was updated since the last
+  ///             time it was presented, which is reported to the embedder in
+  ///             `FlutterBackingStore.did_update`.
+  ///
+  /// @param[in]  did_update  Whether the backing store was updated.
+  ///
+  void SetDidUpdate(bool did_update);
+
   //----------------------------------------------------------------------------
   /// @brief      Make the render target current.
   ///
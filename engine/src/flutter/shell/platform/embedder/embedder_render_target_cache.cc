@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
 EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
@@ -12,11 +14,21 @@ EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
 std::unique_ptr<EmbedderRenderTarget>
 EmbedderRenderTargetCache::GetRenderTarget(
-    const EmbedderExternalView::RenderTargetDescriptor& descriptor) {
-  auto compatible_target = cached_render_targets_.find(descriptor);
-  if (compatible_target == cached_render_targets_.end()) {
+    const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+    const RenderTargetPredicate& preferred) {
+  auto [begin, end] = cached_render_targets_.equal_range(descriptor);
+  if (begin == end) {
     return nullptr;
   }
+  auto compatible_target = begin;
+  if (preferred) {
+    auto found = std::find_if(begin, end, [&preferred](const auto& entry) {
+      return preferred(*entry.second);
+    });
+    if (found != end) {
+      compatible_target = found;
+    }
+  }
   auto target = std::move(compatible_target->second);
   cached_render_targets_.erase(compatible_target);
   return target;
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <functional>
 #include <set>
 #include <stack>
 #include <tuple>
@@ -29,8 +30,22 @@ class EmbedderRenderTargetCache {
 
   ~EmbedderRenderTargetCache();
 
+  using RenderTargetPredicate =
+      std::function<bool(const EmbedderRenderTarget& render_target)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a cached render target that matches the descriptor
+  ///             from the cache and returns it.
+  ///
+  /// @param[in]  descriptor  The descriptor of the render target.
+  /// @param[in]  preferred   If set, a render target for which it returns true
+  ///                         is returned if there is one.
+  ///
+  /// @return     The render target, or null if none matches the descriptor.
+  ///
   std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
-      const EmbedderExternalView::RenderTargetDescriptor& descriptor);
+      const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+      const RenderTargetPredicate& preferred = nullptr);
 
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_surface_software.h"
 
+#include <thread>
 #include <utility>
 
 #include "flutter/fml/trace_event.h"
@@ -17,9 +18,11 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    std::shared_ptr<fml::BasicTaskRunner> tile_task_runner)
     : software_dispatch_table_(std::move(software_dispatch_table)),
-      external_view_embedder_(std::move(external_view_embedder)) {
+      external_view_embedder_(std::move(external_view_embedder)),
+      tile_task_runner_(std::move(tile_task_runner)) {
   if (!software_dispatch_table_.software_present_backing_store) {
     return;
   }
@@ -39,7 +42,13 @@ std::unique_ptr<Surface> EmbedderSurfaceSoftware::CreateGPUSurface() {
     return nullptr;
   }
   const bool render_to_surface = !external_view_embedder_;
-  auto surface = std::make_unique<GPUSurfaceSoftware>(this, render_to_surface);
+  std::unique_ptr<DlSkTiledRasterizer> tiled_rasterizer;
+  if (tile_task_runner_ && render_to_surface) {
+    tiled_rasterizer = std::make_unique<DlSkTiledRasterizer>(
+        tile_task_runner_, std::thread::hardware_concurrency());
+  }
+  auto surface = std::make_unique<GPUSurfaceSoftware>(
+      this, render_to_surface, std::move(tiled_rasterizer));
 
   if (!surface->IsValid()) {
     return nullptr;
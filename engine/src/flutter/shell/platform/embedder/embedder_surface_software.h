@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 #include "flutter/shell/platform/embedder/embedder_surface.h"
@@ -22,9 +23,12 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
         software_present_backing_store;  // required
   };
 
+  // If |tile_task_runner| is not null, frames are rendered in tiles on the
+  // tasks it runs. See |GPUSurfaceSoftware|.
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<fml::BasicTaskRunner> tile_task_runner = nullptr);
 
   ~EmbedderSurfaceSoftware() override;
 
@@ -33,6 +37,7 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<fml::BasicTaskRunner> tile_task_runner_;
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -4,6 +4,7 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -505,6 +506,62 @@ TEST_F(EmbedderTest, NullPlatformMessagesCanBeSent) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that a platform message whose buffer is handed over to the engine
+/// reaches the isolate and that the buffer is released exactly once.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopying) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  const std::string message_data = "Hello without a copy.";
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  std::atomic<int> release_count = 0;
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message =
+      reinterpret_cast<const uint8_t*>(message_data.data());
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;  // No response needed.
+  platform_message.message_release_callback = [](void* user_data) {
+    reinterpret_cast<std::atomic<int>*>(user_data)->fetch_add(1);
+  };
+  platform_message.message_release_user_data = &release_count;
+
+  auto result =
+      FlutterEngineSendPlatformMessage(engine.get(), &platform_message);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+
+  // The buffer is released once the isolate no longer references it, which
+  // is at the latest when it shuts down.
+  engine.reset();
+  EXPECT_EQ(release_count, 1);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message cannot be send if the message_size
 /// isn't equals to 0.
@@ -2200,6 +2257,32 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
       ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
 }
 
+TEST_F(EmbedderTest, CanRenderGradientWithTiledSoftwareRendering) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetDartEntrypoint("render_gradient");
+  builder.AddCommandLineArgument("--enable-software-tiled-rendering");
+
+  auto rendered_scene = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  // The tiles must be stitched into the same image as an untiled frame.
+  ASSERT_TRUE(ImageMatchesFixture("gradient.png", rendered_scene));
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
 
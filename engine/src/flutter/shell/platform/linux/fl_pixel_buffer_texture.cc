@@ -7,11 +7,80 @@
 #include <epoxy/gl.h>
 #include <gmodule.h>
 
+#include <cstring>
+
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 
+// Number of buffers frames of a streaming texture are written into. One can
+// be written by the producer while one is being uploaded and another one has
+// been published.
+static constexpr int kStreamBufferCount = 3;
+
+static constexpr size_t kBytesPerPixel = 4;
+
+// How long to wait for the GPU to finish uploading from a buffer when no
+// buffer is free, in nanoseconds.
+static constexpr GLuint64 kStreamBufferWaitTimeout = 1000000000;
+
+typedef enum {
+  // Owned by the render thread, either because it has not been mapped yet or
+  // because it is being uploaded.
+  STREAM_BUFFER_IN_USE,
+  // Mapped and ready to be written.
+  STREAM_BUFFER_FREE,
+  // Being written by the producer.
+  STREAM_BUFFER_WRITING,
+  // Written by the producer and waiting to be uploaded.
+  STREAM_BUFFER_PUBLISHED,
+} StreamBufferState;
+
+typedef struct {
+  StreamBufferState state;
+
+  // Pixel buffer object the frame is written into, or 0 if pixel buffer
+  // objects are not supported and the frame is written into memory.
+  GLuint pbo;
+
+  // Fence that signals when the upload from the pixel buffer object has
+  // finished and it can be mapped again.
+  GLsync fence;
+
+  // Position of the upload the fence was inserted after among all uploads
+  // of the texture.
+  uint64_t upload_index;
+
+  // Mapped contents of the buffer.
+  uint8_t* data;
+
+  // Region of the frame written by the producer.
+  uint32_t x;
+  uint32_t y;
+  uint32_t width;
+  uint32_t height;
+} StreamBuffer;
+
 typedef struct {
   int64_t id;
   GLuint texture_id;
+
+  // Size of the frames of a streaming texture, or 0 if the texture gets its
+  // frames from copy_pixels.
+  uint32_t stream_width;
+  uint32_t stream_height;
+
+  // Buffers frames of a streaming texture are written into. Their state and
+  // the queue of published buffers are protected by the mutex, everything
+  // else is only used on the render thread.
+  GMutex stream_mutex;
+  StreamBuffer stream_buffers[kStreamBufferCount];
+  GQueue published_buffers;
+  gboolean stream_buffers_allocated;
+  uint64_t stream_upload_count;
+
+  // Memory the written region of a frame is copied into before it is
+  // uploaded, if frames are written into memory and GL_UNPACK_ROW_LENGTH is
+  // not supported.
+  uint8_t* stream_upload_scratch;
 } FlPixelBufferTexturePrivate;
 
 static void fl_pixel_buffer_texture_iface_init(FlTextureInterface* iface);
@@ -58,6 +127,27 @@ static void fl_pixel_buffer_texture_dispose(GObject* object) {
     priv->texture_id = 0;
   }
 
+  g_mutex_lock(&priv->stream_mutex);
+  if (priv->stream_buffers_allocated) {
+    for (int i = 0; i < kStreamBufferCount; i++) {
+      StreamBuffer* buffer = &priv->stream_buffers[i];
+      if (buffer->fence != nullptr) {
+        glDeleteSync(buffer->fence);
+      }
+      if (buffer->pbo != 0) {
+        // Deleting a buffer also unmaps it.
+        glDeleteBuffers(1, &buffer->pbo);
+      } else {
+        g_free(buffer->data);
+      }
+      *buffer = {};
+    }
+    priv->stream_buffers_allocated = FALSE;
+  }
+  g_queue_clear(&priv->published_buffers);
+  g_mutex_unlock(&priv->stream_mutex);
+  g_clear_pointer(&priv->stream_upload_scratch, g_free);
+
   G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->dispose(object);
 }
 
@@ -68,6 +158,233 @@ static void check_gl_error(int line) {
   }
 }
 
+// Creates the texture if it does not exist yet and binds it. Returns TRUE if
+// the texture was created.
+static gboolean bind_texture(FlPixelBufferTexturePrivate* priv) {
+  if (priv->texture_id != 0) {
+    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+    check_gl_error(__LINE__);
+    return FALSE;
+  }
+
+  glGenTextures(1, &priv->texture_id);
+  check_gl_error(__LINE__);
+  glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+  check_gl_error(__LINE__);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+  check_gl_error(__LINE__);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+  check_gl_error(__LINE__);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  check_gl_error(__LINE__);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  check_gl_error(__LINE__);
+  return TRUE;
+}
+
+static size_t get_stream_buffer_size(FlPixelBufferTexturePrivate* priv) {
+  return static_cast<size_t>(priv->stream_width) * priv->stream_height *
+         kBytesPerPixel;
+}
+
+static gboolean uses_pbos(FlPixelBufferTexturePrivate* priv) {
+  return priv->stream_buffers[0].pbo != 0;
+}
+
+// Maps the pixel buffer object of a stream buffer so the producer can write
+// into it.
+static void map_stream_buffer(FlPixelBufferTexturePrivate* priv,
+                              StreamBuffer* buffer) {
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->pbo);
+  check_gl_error(__LINE__);
+  // The previous contents are not needed as the buffer is only uploaded where
+  // the producer wrote it, which lets the driver avoid waiting for them.
+  buffer->data = static_cast<uint8_t*>(glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER, 0, get_stream_buffer_size(priv),
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  check_gl_error(__LINE__);
+}
+
+// Creates the texture and the buffers of a streaming texture.
+static void allocate_stream(FlPixelBufferTexturePrivate* priv) {
+  // Clear the texture so it is transparent until the first frame arrives.
+  g_autofree uint8_t* pixels =
+      static_cast<uint8_t*>(g_malloc0(get_stream_buffer_size(priv)));
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, priv->stream_width,
+               priv->stream_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+  check_gl_error(__LINE__);
+
+  // Streaming through pixel buffer objects needs glMapBufferRange and fences.
+  gboolean use_pbos = epoxy_is_desktop_gl() ? epoxy_gl_version() >= 32
+                                            : epoxy_gl_version() >= 30;
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    StreamBuffer* buffer = &priv->stream_buffers[i];
+    if (use_pbos) {
+      glGenBuffers(1, &buffer->pbo);
+      check_gl_error(__LINE__);
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->pbo);
+      check_gl_error(__LINE__);
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, get_stream_buffer_size(priv),
+                   nullptr, GL_STREAM_DRAW);
+      check_gl_error(__LINE__);
+      map_stream_buffer(priv, buffer);
+    } else {
+      buffer->data =
+          static_cast<uint8_t*>(g_malloc(get_stream_buffer_size(priv)));
+    }
+  }
+  if (use_pbos) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  } else if (!epoxy_is_desktop_gl()) {
+    // OpenGL ES 2.0 has no GL_UNPACK_ROW_LENGTH.
+    priv->stream_upload_scratch =
+        static_cast<uint8_t*>(g_malloc(get_stream_buffer_size(priv)));
+  }
+
+  g_mutex_lock(&priv->stream_mutex);
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    if (priv->stream_buffers[i].data != nullptr) {
+      priv->stream_buffers[i].state = STREAM_BUFFER_FREE;
+    }
+  }
+  priv->stream_buffers_allocated = TRUE;
+  g_mutex_unlock(&priv->stream_mutex);
+}
+
+// Uploads the published frames of a streaming texture into the bound texture
+// in the order they were published.
+static void upload_stream_buffers(FlPixelBufferTexturePrivate* priv) {
+  g_mutex_lock(&priv->stream_mutex);
+  GQueue published = priv->published_buffers;
+  g_queue_init(&priv->published_buffers);
+  g_mutex_unlock(&priv->stream_mutex);
+
+  for (GList* link = published.head; link != nullptr; link = link->next) {
+    StreamBuffer* buffer = static_cast<StreamBuffer*>(link->data);
+    if (buffer->pbo != 0) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer->pbo);
+      check_gl_error(__LINE__);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+      check_gl_error(__LINE__);
+      buffer->data = nullptr;
+
+      // The upload is queued on the GPU, the fence tells when the buffer can
+      // be written again.
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, priv->stream_width);
+      size_t offset =
+          (static_cast<size_t>(buffer->y) * priv->stream_width + buffer->x) *
+          kBytesPerPixel;
+      glTexSubImage2D(GL_TEXTURE_2D, 0, buffer->x, buffer->y, buffer->width,
+                      buffer->height, GL_RGBA, GL_UNSIGNED_BYTE,
+                      reinterpret_cast<const void*>(offset));
+      check_gl_error(__LINE__);
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+      buffer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      check_gl_error(__LINE__);
+      buffer->upload_index = priv->stream_upload_count++;
+    } else {
+      size_t stride = priv->stream_width * kBytesPerPixel;
+      const uint8_t* pixels = buffer->data +
+                              static_cast<size_t>(buffer->y) * stride +
+                              buffer->x * kBytesPerPixel;
+      if (priv->stream_upload_scratch == nullptr) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, priv->stream_width);
+      } else if (buffer->width != priv->stream_width) {
+        // Other rows of the buffer hold pixels of earlier frames, so the
+        // region is copied to be uploaded on its own.
+        size_t row_size = buffer->width * kBytesPerPixel;
+        for (uint32_t row = 0; row < buffer->height; row++) {
+          memcpy(priv->stream_upload_scratch + row * row_size,
+                 pixels + row * stride, row_size);
+        }
+        pixels = priv->stream_upload_scratch;
+      }
+      glTexSubImage2D(GL_TEXTURE_2D, 0, buffer->x, buffer->y, buffer->width,
+                      buffer->height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+      check_gl_error(__LINE__);
+      if (priv->stream_upload_scratch == nullptr) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+      }
+    }
+  }
+  if (uses_pbos(priv)) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+
+  // Memory is copied by glTexSubImage2D so can be written again straight
+  // away.
+  g_mutex_lock(&priv->stream_mutex);
+  for (GList* link = published.head; link != nullptr; link = link->next) {
+    StreamBuffer* buffer = static_cast<StreamBuffer*>(link->data);
+    buffer->state =
+        buffer->pbo != 0 ? STREAM_BUFFER_IN_USE : STREAM_BUFFER_FREE;
+  }
+  g_mutex_unlock(&priv->stream_mutex);
+  g_queue_clear(&published);
+}
+
+// Maps the pixel buffer object of a stream buffer again if the GPU has
+// finished uploading from it within |timeout| nanoseconds.
+static void recycle_stream_buffer(FlPixelBufferTexturePrivate* priv,
+                                  StreamBuffer* buffer,
+                                  GLuint64 timeout) {
+  GLenum result = glClientWaitSync(
+      buffer->fence, timeout != 0 ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+  if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+    return;
+  }
+  glDeleteSync(buffer->fence);
+  buffer->fence = nullptr;
+  map_stream_buffer(priv, buffer);
+  if (buffer->data == nullptr) {
+    g_warning("Failed to map pixel buffer object");
+    return;
+  }
+
+  g_mutex_lock(&priv->stream_mutex);
+  buffer->state = STREAM_BUFFER_FREE;
+  g_mutex_unlock(&priv->stream_mutex);
+}
+
+// Maps the pixel buffer objects of a streaming texture that the GPU has
+// finished uploading from, without waiting for the others.
+//
+// If that leaves no buffer free it waits for the oldest upload instead. The
+// texture is only drawn again once a new frame is available, which a
+// producer can't write without a free buffer.
+static void recycle_stream_buffers(FlPixelBufferTexturePrivate* priv) {
+  if (!uses_pbos(priv)) {
+    return;
+  }
+
+  StreamBuffer* oldest_buffer = nullptr;
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    StreamBuffer* buffer = &priv->stream_buffers[i];
+    if (buffer->fence == nullptr) {
+      continue;
+    }
+    recycle_stream_buffer(priv, buffer, 0);
+    if (buffer->fence != nullptr &&
+        (oldest_buffer == nullptr ||
+         buffer->upload_index < oldest_buffer->upload_index)) {
+      oldest_buffer = buffer;
+    }
+  }
+
+  gboolean has_free_buffer = FALSE;
+  g_mutex_lock(&priv->stream_mutex);
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    if (priv->stream_buffers[i].state == STREAM_BUFFER_FREE) {
+      has_free_buffer = TRUE;
+    }
+  }
+  g_mutex_unlock(&priv->stream_mutex);
+  if (!has_free_buffer && oldest_buffer != nullptr) {
+    recycle_stream_buffer(priv, oldest_buffer, kStreamBufferWaitTimeout);
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
 gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
                                           uint32_t width,
                                           uint32_t height,
@@ -78,32 +395,26 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
       reinterpret_cast<FlPixelBufferTexturePrivate*>(
           fl_pixel_buffer_texture_get_instance_private(self));
 
-  const uint8_t* buffer = nullptr;
-  if (!FL_PIXEL_BUFFER_TEXTURE_GET_CLASS(self)->copy_pixels(
-          self, &buffer, &width, &height, error)) {
-    return FALSE;
-  }
-
-  if (priv->texture_id == 0) {
-    glGenTextures(1, &priv->texture_id);
-    check_gl_error(__LINE__);
-    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
-    check_gl_error(__LINE__);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    check_gl_error(__LINE__);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    check_gl_error(__LINE__);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    check_gl_error(__LINE__);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    check_gl_error(__LINE__);
+  if (priv->stream_width != 0) {
+    if (bind_texture(priv)) {
+      allocate_stream(priv);
+    }
+    upload_stream_buffers(priv);
+    recycle_stream_buffers(priv);
+    width = priv->stream_width;
+    height = priv->stream_height;
   } else {
-    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+    const uint8_t* buffer = nullptr;
+    if (!FL_PIXEL_BUFFER_TEXTURE_GET_CLASS(self)->copy_pixels(
+            self, &buffer, &width, &height, error)) {
+      return FALSE;
+    }
+
+    bind_texture(priv);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, buffer);
     check_gl_error(__LINE__);
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, buffer);
-  check_gl_error(__LINE__);
 
   opengl_texture->target = GL_TEXTURE_2D;
   opengl_texture->name = priv->texture_id;
@@ -116,9 +427,115 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
   return TRUE;
 }
 
+static void fl_pixel_buffer_texture_finalize(GObject* object) {
+  FlPixelBufferTexture* self = FL_PIXEL_BUFFER_TEXTURE(object);
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+
+  g_mutex_clear(&priv->stream_mutex);
+
+  G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->finalize(object);
+}
+
 static void fl_pixel_buffer_texture_class_init(
     FlPixelBufferTextureClass* klass) {
   G_OBJECT_CLASS(klass)->dispose = fl_pixel_buffer_texture_dispose;
+  G_OBJECT_CLASS(klass)->finalize = fl_pixel_buffer_texture_finalize;
+}
+
+static void fl_pixel_buffer_texture_init(FlPixelBufferTexture* self) {
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+
+  g_mutex_init(&priv->stream_mutex);
+  g_queue_init(&priv->published_buffers);
 }
 
-static void fl_pixel_buffer_texture_init(FlPixelBufferTexture* self) {}
+G_MODULE_EXPORT FlPixelBufferTexture* fl_pixel_buffer_texture_new_streaming(
+    uint32_t width,
+    uint32_t height) {
+  g_return_val_if_fail(width > 0 && height > 0, nullptr);
+
+  FlPixelBufferTexture* self = FL_PIXEL_BUFFER_TEXTURE(
+      g_object_new(fl_pixel_buffer_texture_get_type(), nullptr));
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+  priv->stream_width = width;
+  priv->stream_height = height;
+  return self;
+}
+
+G_MODULE_EXPORT uint8_t* fl_pixel_buffer_texture_begin_update(
+    FlPixelBufferTexture* texture,
+    size_t* stride) {
+  g_return_val_if_fail(FL_IS_PIXEL_BUFFER_TEXTURE(texture), nullptr);
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(texture));
+  g_return_val_if_fail(priv->stream_width != 0, nullptr);
+
+  uint8_t* data = nullptr;
+  g_mutex_lock(&priv->stream_mutex);
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    if (priv->stream_buffers[i].state == STREAM_BUFFER_WRITING) {
+      g_warning("A frame of the texture is already being written");
+      g_mutex_unlock(&priv->stream_mutex);
+      return nullptr;
+    }
+  }
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    StreamBuffer* buffer = &priv->stream_buffers[i];
+    if (buffer->state == STREAM_BUFFER_FREE) {
+      buffer->state = STREAM_BUFFER_WRITING;
+      data = buffer->data;
+      break;
+    }
+  }
+  g_mutex_unlock(&priv->stream_mutex);
+
+  if (stride != nullptr) {
+    *stride = priv->stream_width * kBytesPerPixel;
+  }
+  return data;
+}
+
+G_MODULE_EXPORT void fl_pixel_buffer_texture_end_update(
+    FlPixelBufferTexture* texture,
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height) {
+  g_return_if_fail(FL_IS_PIXEL_BUFFER_TEXTURE(texture));
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(texture));
+  g_return_if_fail(x <= priv->stream_width &&
+                   width <= priv->stream_width - x);
+  g_return_if_fail(y <= priv->stream_height &&
+                   height <= priv->stream_height - y);
+
+  g_mutex_lock(&priv->stream_mutex);
+  StreamBuffer* buffer = nullptr;
+  for (int i = 0; i < kStreamBufferCount; i++) {
+    if (priv->stream_buffers[i].state == STREAM_BUFFER_WRITING) {
+      buffer = &priv->stream_buffers[i];
+      break;
+    }
+  }
+  if (buffer == nullptr) {
+    g_warning("No frame of the texture is being written");
+  } else if (width == 0 || height == 0) {
+    buffer->state = STREAM_BUFFER_FREE;
+  } else {
+    buffer->state = STREAM_BUFFER_PUBLISHED;
+    buffer->x = x;
+    buffer->y = y;
+    buffer->width = width;
+    buffer->height = height;
+    g_queue_push_tail(&priv->published_buffers, buffer);
+  }
+  g_mutex_unlock(&priv->stream_mutex);
+}
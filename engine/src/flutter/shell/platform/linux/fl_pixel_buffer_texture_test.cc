@@ -8,10 +8,14 @@
 #include "flutter/shell/platform/linux/fl_texture_registrar_private.h"
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "flutter/shell/platform/linux/testing/mock_epoxy.h"
 #include "gtest/gtest.h"
 
 #include <epoxy/gl.h>
 
+#include <atomic>
+#include <cstring>
+
 static constexpr uint32_t kBufferWidth = 4u;
 static constexpr uint32_t kBufferHeight = 4u;
 static constexpr uint32_t kRealBufferWidth = 2u;
@@ -66,6 +70,55 @@ static FlTestPixelBufferTexture* fl_test_pixel_buffer_texture_new() {
       g_object_new(fl_test_pixel_buffer_texture_get_type(), nullptr));
 }
 
+using ::testing::Return;
+
+static constexpr uint32_t kStreamWidth = 16u;
+static constexpr uint32_t kStreamHeight = 8u;
+
+// Makes the mock GL support pixel buffer objects and fences, with fences that
+// are signaled as soon as they are checked.
+static void use_pixel_buffer_objects(flutter::testing::MockEpoxy& epoxy) {
+  ON_CALL(epoxy, epoxy_is_desktop_gl).WillByDefault(Return(false));
+  ON_CALL(epoxy, epoxy_gl_version).WillByDefault(Return(30));
+  ON_CALL(epoxy, glClientWaitSync).WillByDefault(Return(GL_ALREADY_SIGNALED));
+}
+
+static void populate(FlPixelBufferTexture* texture) {
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      texture, kBufferWidth, kBufferHeight, &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+}
+
+// Writes frames of a synthetic video into a streaming texture.
+typedef struct {
+  FlPixelBufferTexture* texture;
+  uint32_t width;
+  uint32_t height;
+  int frame_count;
+  std::atomic<bool> cancelled;
+} VideoSource;
+
+static gpointer write_video_frames(gpointer user_data) {
+  VideoSource* source = static_cast<VideoSource*>(user_data);
+  for (int frame = 0; frame < source->frame_count && !source->cancelled;) {
+    size_t stride = 0;
+    uint8_t* data =
+        fl_pixel_buffer_texture_begin_update(source->texture, &stride);
+    if (data == nullptr) {
+      // No buffer is free, try again when the next frame is due.
+      g_usleep(1000);
+      continue;
+    }
+    memset(data, frame, stride * source->height);
+    fl_pixel_buffer_texture_end_update(source->texture, 0, 0, source->width,
+                                       source->height);
+    frame++;
+  }
+  return nullptr;
+}
+
 // Test that getting the texture ID works.
 TEST(FlPixelBufferTextureTest, TextureID) {
   g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_pixel_buffer_texture_new());
@@ -85,3 +138,211 @@ TEST(FlPixelBufferTextureTest, PopulateTexture) {
   EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
   EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
 }
+
+// Test that a streaming texture is shown before any frame is written.
+TEST(FlPixelBufferTextureTest, PopulateStreamingTexture) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  use_pixel_buffer_objects(epoxy);
+
+  g_autoptr(FlPixelBufferTexture) texture =
+      fl_pixel_buffer_texture_new_streaming(kStreamWidth, kStreamHeight);
+  EXPECT_EQ(fl_pixel_buffer_texture_begin_update(texture, nullptr), nullptr);
+
+  EXPECT_CALL(epoxy, glTexSubImage2D).Times(0);
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      texture, kBufferWidth, kBufferHeight, &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.target, static_cast<uint32_t>(GL_TEXTURE_2D));
+  EXPECT_EQ(opengl_texture.width, kStreamWidth);
+  EXPECT_EQ(opengl_texture.height, kStreamHeight);
+}
+
+// Test that only the written region of a frame is uploaded.
+TEST(FlPixelBufferTextureTest, StreamingTextureUploadsWrittenRegion) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  use_pixel_buffer_objects(epoxy);
+
+  g_autoptr(FlPixelBufferTexture) texture =
+      fl_pixel_buffer_texture_new_streaming(kStreamWidth, kStreamHeight);
+  populate(texture);
+
+  size_t stride = 0;
+  uint8_t* data = fl_pixel_buffer_texture_begin_update(texture, &stride);
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(stride, kStreamWidth * 4);
+  memset(data, 0xff, stride * kStreamHeight);
+  fl_pixel_buffer_texture_end_update(texture, 1, 2, 3, 4);
+
+  // The region is uploaded from the pixel buffer object, at its offset.
+  const void* offset =
+      reinterpret_cast<const void*>((2 * kStreamWidth + 1) * 4);
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 1, 2, 3, 4, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, offset));
+  populate(texture);
+}
+
+// Test that frames are dropped while all buffers are being uploaded.
+TEST(FlPixelBufferTextureTest, StreamingTextureReusesBuffersAfterUpload) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  use_pixel_buffer_objects(epoxy);
+  ON_CALL(epoxy, glClientWaitSync).WillByDefault(Return(GL_TIMEOUT_EXPIRED));
+
+  g_autoptr(FlPixelBufferTexture) texture =
+      fl_pixel_buffer_texture_new_streaming(kStreamWidth, kStreamHeight);
+  populate(texture);
+
+  int frame_count = 0;
+  while (fl_pixel_buffer_texture_begin_update(texture, nullptr) != nullptr) {
+    fl_pixel_buffer_texture_end_update(texture, 0, 0, kStreamWidth,
+                                       kStreamHeight);
+    frame_count++;
+  }
+  EXPECT_GT(frame_count, 1);
+
+  // All frames are uploaded in one go, but the buffers can't be written until
+  // the GPU has finished with them.
+  EXPECT_CALL(epoxy, glTexSubImage2D).Times(frame_count);
+  populate(texture);
+  EXPECT_EQ(fl_pixel_buffer_texture_begin_update(texture, nullptr), nullptr);
+
+  ON_CALL(epoxy, glClientWaitSync).WillByDefault(Return(GL_ALREADY_SIGNALED));
+  populate(texture);
+  EXPECT_NE(fl_pixel_buffer_texture_begin_update(texture, nullptr), nullptr);
+}
+
+// Test that frames are uploaded from memory if pixel buffer objects are not
+// supported.
+TEST(FlPixelBufferTextureTest, StreamingTextureWithoutPixelBufferObjects) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  ON_CALL(epoxy, epoxy_is_desktop_gl).WillByDefault(Return(true));
+  ON_CALL(epoxy, epoxy_gl_version).WillByDefault(Return(21));
+
+  g_autoptr(FlPixelBufferTexture) texture =
+      fl_pixel_buffer_texture_new_streaming(kStreamWidth, kStreamHeight);
+  populate(texture);
+
+  size_t stride = 0;
+  uint8_t* data = fl_pixel_buffer_texture_begin_update(texture, &stride);
+  ASSERT_NE(data, nullptr);
+  fl_pixel_buffer_texture_end_update(texture, 1, 2, 3, 4);
+
+  // Only the region is uploaded, using the stride of the buffer.
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 1, 2, 3, 4, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, data + 2 * stride + 4));
+  populate(texture);
+
+  // The memory can be written again straight away.
+  EXPECT_EQ(fl_pixel_buffer_texture_begin_update(texture, nullptr), data);
+}
+
+// Test that only the written region of a frame is uploaded from memory if
+// GL_UNPACK_ROW_LENGTH is not supported either.
+TEST(FlPixelBufferTextureTest, StreamingTextureWithoutUnpackRowLength) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  ON_CALL(epoxy, epoxy_is_desktop_gl).WillByDefault(Return(false));
+  ON_CALL(epoxy, epoxy_gl_version).WillByDefault(Return(20));
+
+  g_autoptr(FlPixelBufferTexture) texture =
+      fl_pixel_buffer_texture_new_streaming(kStreamWidth, kStreamHeight);
+  populate(texture);
+
+  size_t stride = 0;
+  uint8_t* data = fl_pixel_buffer_texture_begin_update(texture, &stride);
+  ASSERT_NE(data, nullptr);
+  memset(data, 0, stride * kStreamHeight);
+  for (size_t row = 2; row < 6; row++) {
+    memset(data + row * stride + 4, 0xff, 3 * 4);
+  }
+  fl_pixel_buffer_texture_end_update(texture, 1, 2, 3, 4);
+
+  EXPECT_CALL(epoxy, glTexSubImage2D(GL_TEXTURE_2D, 0, 1, 2, 3, 4, GL_RGBA,
+                                     GL_UNSIGNED_BYTE, ::testing::_))
+      .WillOnce([](GLenum target, GLint level, GLint x, GLint y,
+                   GLsizei width, GLsizei height, GLenum format, GLenum type,
+                   const void* pixels) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(pixels);
+        for (size_t i = 0; i < 3 * 4 * 4; i++) {
+          EXPECT_EQ(bytes[i], 0xff);
+        }
+      });
+  populate(texture);
+}
+
+// Test that a producer that fills every buffer before the texture is drawn,
+// and drops frames without marking them available while no buffer is free,
+// keeps streaming.
+TEST(FlPixelBufferTextureTest, StreamingTextureKeepsABufferFree) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  use_pixel_buffer_objects(epoxy);
+  // The GPU is still uploading when the fences are first checked, and only
+  // finishes when waited for.
+  ON_CALL(epoxy, glClientWaitSync)
+      .WillByDefault([](GLsync sync, GLbitfield flags, GLuint64 timeout) {
+        return timeout == 0 ? GL_TIMEOUT_EXPIRED : GL_CONDITION_SATISFIED;
+      });
+
+  g_autoptr(FlPixelBufferTexture) texture =
+      fl_pixel_buffer_texture_new_streaming(kStreamWidth, kStreamHeight);
+  populate(texture);
+
+  for (int i = 0; i < 10; i++) {
+    bool frame_available = false;
+    while (fl_pixel_buffer_texture_begin_update(texture, nullptr) != nullptr) {
+      fl_pixel_buffer_texture_end_update(texture, 0, 0, kStreamWidth,
+                                         kStreamHeight);
+      frame_available = true;
+    }
+
+    // The engine only draws the texture again once a frame is available.
+    ASSERT_TRUE(frame_available);
+    populate(texture);
+  }
+}
+
+// Test streaming one second of 4K 60fps video written on another thread,
+// recording how long the render thread takes to populate the texture.
+TEST(FlPixelBufferTextureTest, StreamingTextureFromBackgroundThread) {
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
+  use_pixel_buffer_objects(epoxy);
+  std::atomic<int> uploaded_frame_count = 0;
+  ON_CALL(epoxy, glTexSubImage2D)
+      .WillByDefault([&uploaded_frame_count](
+                         GLenum target, GLint level, GLint x, GLint y,
+                         GLsizei width, GLsizei height, GLenum format,
+                         GLenum type, const void* pixels) {
+        EXPECT_EQ(width, 3840);
+        EXPECT_EQ(height, 2160);
+        uploaded_frame_count++;
+      });
+
+  VideoSource source = {};
+  source.width = 3840;
+  source.height = 2160;
+  source.frame_count = 60;
+  source.texture =
+      fl_pixel_buffer_texture_new_streaming(source.width, source.height);
+  populate(source.texture);
+  GThread* thread = g_thread_new("video", write_video_frames, &source);
+
+  int populate_count = 0;
+  gint64 populate_time = 0;
+  gint64 start = g_get_monotonic_time();
+  while (uploaded_frame_count < source.frame_count &&
+         g_get_monotonic_time() - start < 10 * G_USEC_PER_SEC) {
+    gint64 populate_start = g_get_monotonic_time();
+    populate(source.texture);
+    populate_time += g_get_monotonic_time() - populate_start;
+    populate_count++;
+    g_usleep(G_USEC_PER_SEC / 60);
+  }
+  source.cancelled = true;
+  g_thread_join(thread);
+  g_object_unref(source.texture);
+
+  EXPECT_EQ(uploaded_frame_count, source.frame_count);
+  ::testing::Test::RecordProperty(
+      "render_thread_us_per_frame",
+      static_cast<int>(populate_time / populate_count));
+}
@@ -81,6 +81,11 @@ G_DECLARE_DERIVABLE_TYPE(FlPixelBufferTexture,
  *
  *   static void my_texture_init(MyTexture* self) {}
  * ]|
+ *
+ * Textures that show a stream of frames, such as video, can instead be
+ * created with fl_pixel_buffer_texture_new_streaming(). Frames are then
+ * written from any thread into buffers owned by the texture, which are
+ * uploaded without the render thread having to copy them.
  */
 
 struct _FlPixelBufferTextureClass {
@@ -110,6 +115,65 @@ struct _FlPixelBufferTextureClass {
                           GError** error);
 };
 
+/**
+ * fl_pixel_buffer_texture_new_streaming:
+ * @width: width of the frames in pixels.
+ * @height: height of the frames in pixels.
+ *
+ * Creates a texture that shows a stream of RGBA frames of a fixed size.
+ * Frames are written with fl_pixel_buffer_texture_begin_update() and
+ * fl_pixel_buffer_texture_end_update(), after which
+ * fl_texture_registrar_mark_texture_frame_available() has to be called. If the
+ * size of the frames changes a new texture has to be created.
+ *
+ * The buffers frames are written into are allocated the first time the
+ * texture is shown, so no buffer is available before then.
+ *
+ * Returns: a new #FlPixelBufferTexture.
+ */
+FlPixelBufferTexture* fl_pixel_buffer_texture_new_streaming(uint32_t width,
+                                                            uint32_t height);
+
+/**
+ * fl_pixel_buffer_texture_begin_update:
+ * @texture: an #FlPixelBufferTexture created with
+ * fl_pixel_buffer_texture_new_streaming().
+ * @stride: (out): location to write the number of bytes in a row of the
+ * buffer.
+ *
+ * Starts writing a frame. This can be called from any thread, but only one
+ * frame can be written at a time.
+ *
+ * The buffer holds a whole frame, but buffers are reused so it contains the
+ * contents of an earlier frame. Only the region passed to
+ * fl_pixel_buffer_texture_end_update() is shown, so at least that region has
+ * to be written.
+ *
+ * Returns: (transfer none): a buffer to write RGBA pixels into, or %NULL if
+ * no buffer is available. Producers should drop the frame in that case.
+ */
+uint8_t* fl_pixel_buffer_texture_begin_update(FlPixelBufferTexture* texture,
+                                              size_t* stride);
+
+/**
+ * fl_pixel_buffer_texture_end_update:
+ * @texture: an #FlPixelBufferTexture.
+ * @x: the left of the region that was written in pixels.
+ * @y: the top of the region that was written in pixels.
+ * @width: the width of the region that was written in pixels.
+ * @height: the height of the region that was written in pixels.
+ *
+ * Finishes writing the frame started with
+ * fl_pixel_buffer_texture_begin_update(). The written region is shown the
+ * next time the texture is drawn, the rest of the texture is not changed. If
+ * the region is empty the frame is dropped.
+ */
+void fl_pixel_buffer_texture_end_update(FlPixelBufferTexture* texture,
+                                        uint32_t x,
+                                        uint32_t y,
+                                        uint32_t width,
+                                        uint32_t height);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_PIXEL_BUFFER_TEXTURE_H_
@@ -5,6 +5,9 @@
 
 #include "flutter/shell/platform/linux/testing/mock_epoxy.h"
 
+#include <map>
+#include <vector>
+
 using namespace flutter::testing;
 
 typedef struct {
@@ -351,11 +354,21 @@ EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
 }
 
 static GLuint bound_texture_2d;
+static GLuint bound_pixel_unpack_buffer;
+static GLuint next_buffer = 1;
+static std::map<GLuint, std::vector<uint8_t>> buffer_data;
+static int next_sync = 1;
 
 void _glAttachShader(GLuint program, GLuint shader) {}
 
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
+static void _glBindBuffer(GLenum target, GLuint buffer) {
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    bound_pixel_unpack_buffer = buffer;
+  }
+}
+
 static void _glBindTexture(GLenum target, GLuint texture) {
   if (target == GL_TEXTURE_2D) {
     bound_texture_2d = texture;
@@ -376,6 +389,21 @@ static void _glBlitFramebuffer(GLint srcX0,
                           dstY1, mask, filter);
 }
 
+static void _glBufferData(GLenum target,
+                          GLsizeiptr size,
+                          const void* data,
+                          GLenum usage) {
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    buffer_data[bound_pixel_unpack_buffer].resize(size);
+  }
+}
+
+static GLenum _glClientWaitSync(GLsync sync,
+                                GLbitfield flags,
+                                GLuint64 timeout) {
+  return mock->glClientWaitSync(sync, flags, timeout);
+}
+
 GLuint _glCreateProgram() {
   return 0;
 }
@@ -390,18 +418,36 @@ GLuint _glCreateShader(GLenum shaderType) {
   return 0;
 }
 
+static void _glDeleteBuffers(GLsizei n, const GLuint* buffers) {
+  for (GLsizei i = 0; i < n; i++) {
+    buffer_data.erase(buffers[i]);
+  }
+}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteShader(GLuint shader) {}
 
+static void _glDeleteSync(GLsync sync) {}
+
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
 
+static GLsync _glFenceSync(GLenum condition, GLbitfield flags) {
+  return reinterpret_cast<GLsync>(static_cast<intptr_t>(next_sync++));
+}
+
 static void _glFramebufferTexture2D(GLenum target,
                                     GLenum attachment,
                                     GLenum textarget,
                                     GLuint texture,
                                     GLint level) {}
 
+static void _glGenBuffers(GLsizei n, GLuint* buffers) {
+  for (GLsizei i = 0; i < n; i++) {
+    buffers[i] = next_buffer++;
+  }
+}
+
 static void _glGenTextures(GLsizei n, GLuint* textures) {
   for (GLsizei i = 0; i < n; i++) {
     textures[i] = 0;
@@ -446,6 +492,18 @@ static const GLubyte* _glGetString(GLenum pname) {
   return mock->glGetString(pname);
 }
 
+static void* _glMapBufferRange(GLenum target,
+                               GLintptr offset,
+                               GLsizeiptr length,
+                               GLbitfield access) {
+  if (target != GL_PIXEL_UNPACK_BUFFER) {
+    return nullptr;
+  }
+  return buffer_data[bound_pixel_unpack_buffer].data() + offset;
+}
+
+static void _glPixelStorei(GLenum pname, GLint param) {}
+
 static void _glTexParameterf(GLenum target, GLenum pname, GLfloat param) {}
 
 static void _glTexParameteri(GLenum target, GLenum pname, GLint param) {}
@@ -460,6 +518,23 @@ static void _glTexImage2D(GLenum target,
                           GLenum type,
                           const void* pixels) {}
 
+static void _glTexSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* pixels) {
+  mock->glTexSubImage2D(target, level, xoffset, yoffset, width, height, format,
+                        type, pixels);
+}
+
+static GLboolean _glUnmapBuffer(GLenum target) {
+  return GL_TRUE;
+}
+
 static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
@@ -595,16 +670,23 @@ static void library_init() {
 
   epoxy_glAttachShader = _glAttachShader;
   epoxy_glBindFramebuffer = _glBindFramebuffer;
+  epoxy_glBindBuffer = _glBindBuffer;
   epoxy_glBindTexture = _glBindTexture;
   epoxy_glBlitFramebuffer = _glBlitFramebuffer;
   epoxy_glCompileShader = _glCompileShader;
+  epoxy_glBufferData = _glBufferData;
   epoxy_glClearColor = _glClearColor;
+  epoxy_glClientWaitSync = _glClientWaitSync;
   epoxy_glCreateProgram = _glCreateProgram;
   epoxy_glCreateShader = _glCreateShader;
+  epoxy_glDeleteBuffers = _glDeleteBuffers;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteShader = _glDeleteShader;
+  epoxy_glDeleteSync = _glDeleteSync;
   epoxy_glDeleteTextures = _glDeleteTextures;
+  epoxy_glFenceSync = _glFenceSync;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
+  epoxy_glGenBuffers = _glGenBuffers;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
   epoxy_glGetIntegerv = _glGetIntegerv;
@@ -614,9 +696,13 @@ static void library_init() {
   epoxy_glGetShaderInfoLog = _glGetShaderInfoLog;
   epoxy_glGetString = _glGetString;
   epoxy_glLinkProgram = _glLinkProgram;
+  epoxy_glMapBufferRange = _glMapBufferRange;
+  epoxy_glPixelStorei = _glPixelStorei;
   epoxy_glShaderSource = _glShaderSource;
   epoxy_glTexParameterf = _glTexParameterf;
   epoxy_glTexParameteri = _glTexParameteri;
   epoxy_glTexImage2D = _glTexImage2D;
+  epoxy_glTexSubImage2D = _glTexSubImage2D;
+  epoxy_glUnmapBuffer = _glUnmapBuffer;
   epoxy_glGetError = _glGetError;
 }
@@ -34,6 +34,20 @@ class MockEpoxy {
                GLbitfield mask,
                GLenum filter));
   MOCK_METHOD(const GLubyte*, glGetString, (GLenum pname));
+  MOCK_METHOD(void,
+              glTexSubImage2D,
+              (GLenum target,
+               GLint level,
+               GLint xoffset,
+               GLint yoffset,
+               GLsizei width,
+               GLsizei height,
+               GLenum format,
+               GLenum type,
+               const void* pixels));
+  MOCK_METHOD(GLenum,
+              glClientWaitSync,
+              (GLsync sync, GLbitfield flags, GLuint64 timeout));
 };
 
 }  // namespace testing
@@ -588,11 +588,26 @@ def run_engine_benchmarks(build_dir, executable_filter):
 
   run_engine_executable(build_dir, 'display_list_builder_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(
+      build_dir, 'display_list_tiled_rasterizer_benchmarks', executable_filter, icu_flags
+  )
+
+  run_engine_executable(build_dir, 'flow_benchmarks', executable_filter, icu_flags)
+
   run_engine_executable(build_dir, 'geometry_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(build_dir, 'vulkan_benchmarks', executable_filter, icu_flags)
+
+  run_engine_executable(build_dir, 'client_wrapper_benchmarks', executable_filter, icu_flags)
+
   if is_linux():
     run_engine_executable(build_dir, 'txt_benchmarks', executable_filter, icu_flags)
 
+  if is_mac():
+    run_engine_executable(
+        build_dir, 'accessibility_bridge_benchmarks', executable_filter, icu_flags
+    )
+
 
 class FlutterTesterOptions():
 
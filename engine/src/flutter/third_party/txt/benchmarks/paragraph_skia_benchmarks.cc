@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/runtime/test_font_data.h"
+#include "skia/paragraph_builder_skia.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+#include "txt/asset_font_manager.h"
+#include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
+
+namespace txt {
+
+namespace {
+
+std::shared_ptr<FontCollection> MakeFontCollection() {
+  auto font_provider = std::make_unique<TypefaceFontAssetProvider>();
+  for (auto& font : flutter::testing::GetTestFontData()) {
+    font_provider->RegisterTypeface(font);
+  }
+  auto font_collection = std::make_shared<FontCollection>();
+  font_collection->SetAssetFontManager(
+      sk_make_sp<AssetFontManager>(std::move(font_provider)));
+  return font_collection;
+}
+
+std::u16string MakeRowLabel(int row) {
+  std::string digits = std::to_string(row);
+  return u"List item " + std::u16string(digits.begin(), digits.end()) +
+         u" with a subtitle that wraps";
+}
+
+}  // namespace
+
+// Paints 1000 paragraphs that have already been laid out, as a frame of a
+// scrolling list of text repaints them. The argument is whether the
+// paragraphs are painted for Impeller, which converts their text blobs to
+// text frames.
+static void BM_PaintLaidOutParagraphs(benchmark::State& state) {
+  const bool impeller_enabled = state.range(0) != 0;
+  auto font_collection = MakeFontCollection();
+  TextStyle text_style;
+  text_style.font_families = {"FlutterTest"};
+  text_style.font_size = 14;
+  text_style.color = SK_ColorBLACK;
+
+  std::vector<std::unique_ptr<Paragraph>> paragraphs;
+  for (int i = 0; i < 1000; i++) {
+    ParagraphBuilderSkia builder(ParagraphStyle(), font_collection,
+                                 impeller_enabled);
+    builder.PushStyle(text_style);
+    builder.AddText(u"The quick brown fox jumps over the lazy dog");
+    builder.Pop();
+    paragraphs.push_back(builder.Build());
+    paragraphs.back()->Layout(300);
+  }
+
+  for (auto _ : state) {
+    flutter::DisplayListBuilder builder;
+    for (size_t i = 0; i < paragraphs.size(); i++) {
+      paragraphs[i]->Paint(&builder, 0, i * 20);
+    }
+    benchmark::DoNotOptimize(builder.Build());
+  }
+}
+BENCHMARK(BM_PaintLaidOutParagraphs)
+    ->Arg(false)
+    ->Arg(true)
+    ->Unit(benchmark::kMicrosecond);
+
+// Builds and lays out the paragraphs of 10000 list rows, as a list that is
+// scrolled through builds them again for the rows that come into view. The
+// rows cycle through 1000 labels, which fit in the default capacity of the
+// paragraph layout cache. The argument is whether the cache is enabled.
+static void BM_LayoutListRows(benchmark::State& state) {
+  auto font_collection = MakeFontCollection();
+  if (state.range(0) == 0) {
+    font_collection->SetParagraphLayoutCacheCapacity(0);
+  }
+  TextStyle text_style;
+  text_style.font_families = {"FlutterTest"};
+  text_style.font_size = 14;
+  text_style.color = SK_ColorBLACK;
+
+  std::vector<std::u16string> labels;
+  for (int i = 0; i < 1000; i++) {
+    labels.push_back(MakeRowLabel(i));
+  }
+
+  for (auto _ : state) {
+    for (int i = 0; i < 10000; i++) {
+      ParagraphBuilderSkia builder(ParagraphStyle(), font_collection, false);
+      builder.PushStyle(text_style);
+      builder.AddText(labels[i % labels.size()]);
+      builder.Pop();
+      auto paragraph = builder.Build();
+      paragraph->Layout(200);
+      benchmark::DoNotOptimize(paragraph->GetHeight());
+    }
+  }
+}
+BENCHMARK(BM_LayoutListRows)
+    ->Arg(false)
+    ->Arg(true)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace txt
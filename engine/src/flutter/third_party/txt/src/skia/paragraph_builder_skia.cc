@@ -17,6 +17,8 @@
 #include "paragraph_builder_skia.h"
 #include "paragraph_skia.h"
 
+#include <type_traits>
+
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "third_party/skia/modules/skunicode/include/SkUnicode_icu.h"
@@ -43,28 +45,133 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
                                            : SkFontStyle::Slant::kItalic_Slant);
 }
 
+// Appends the bytes of |value| to a paragraph layout cache key.
+template <typename T>
+void AppendToKey(const T& value, std::string* key) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename CharT>
+void AppendToKey(const std::basic_string<CharT>& value, std::string* key) {
+  AppendToKey(value.size(), key);
+  key->append(reinterpret_cast<const char*>(value.data()),
+              value.size() * sizeof(CharT));
+}
+
+void AppendToKey(const std::vector<std::string>& values, std::string* key) {
+  AppendToKey(values.size(), key);
+  for (const std::string& value : values) {
+    AppendToKey(value, key);
+  }
+}
+
+// Appends every property of |style| that is passed to skparagraph. The paints
+// are only identified by their indices, which depend on whether they are set.
+void AppendToKey(const TextStyle& style, std::string* key) {
+  AppendToKey(style.color, key);
+  AppendToKey(style.decoration, key);
+  AppendToKey(style.decoration_color, key);
+  AppendToKey(style.decoration_style, key);
+  AppendToKey(style.decoration_thickness_multiplier, key);
+  AppendToKey(style.font_weight, key);
+  AppendToKey(style.font_style, key);
+  AppendToKey(style.text_baseline, key);
+  AppendToKey(style.half_leading, key);
+  AppendToKey(style.font_families, key);
+  AppendToKey(style.font_size, key);
+  AppendToKey(style.letter_spacing, key);
+  AppendToKey(style.word_spacing, key);
+  AppendToKey(style.height, key);
+  AppendToKey(style.has_height_override, key);
+  AppendToKey(style.locale, key);
+  AppendToKey(style.background.has_value(), key);
+  AppendToKey(style.foreground.has_value(), key);
+  AppendToKey(style.text_shadows.size(), key);
+  for (const TextShadow& shadow : style.text_shadows) {
+    AppendToKey(shadow.color, key);
+    AppendToKey(shadow.offset, key);
+    AppendToKey(shadow.blur_sigma, key);
+  }
+  AppendToKey(style.font_features.GetFontFeatures().size(), key);
+  for (const auto& [feature, value] : style.font_features.GetFontFeatures()) {
+    AppendToKey(feature, key);
+    AppendToKey(value, key);
+  }
+  AppendToKey(style.font_variations.GetAxisValues().size(), key);
+  for (const auto& [axis, value] : style.font_variations.GetAxisValues()) {
+    AppendToKey(axis, key);
+    AppendToKey(value, key);
+  }
+}
+
+void AppendToKey(const ParagraphStyle& style, std::string* key) {
+  AppendToKey(style.font_weight, key);
+  AppendToKey(style.font_style, key);
+  AppendToKey(style.font_family, key);
+  AppendToKey(style.font_size, key);
+  AppendToKey(style.height, key);
+  AppendToKey(style.has_height_override, key);
+  AppendToKey(style.text_height_behavior, key);
+  AppendToKey(style.strut_enabled, key);
+  AppendToKey(style.strut_font_weight, key);
+  AppendToKey(style.strut_font_style, key);
+  AppendToKey(style.strut_font_families, key);
+  AppendToKey(style.strut_font_size, key);
+  AppendToKey(style.strut_height, key);
+  AppendToKey(style.strut_has_height_override, key);
+  AppendToKey(style.strut_half_leading, key);
+  AppendToKey(style.strut_leading, key);
+  AppendToKey(style.force_strut_height, key);
+  AppendToKey(style.text_align, key);
+  AppendToKey(style.text_direction, key);
+  AppendToKey(style.max_lines, key);
+  AppendToKey(style.ellipsis, key);
+  AppendToKey(style.locale, key);
+}
+
 }  // anonymous namespace
 
 ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
     const bool impeller_enabled)
-    : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
+    : base_style_(style.GetTextStyle()),
+      impeller_enabled_(impeller_enabled),
+      layout_cache_(font_collection->GetParagraphLayoutCache()) {
+  skia_paragraph_style_ = TxtToSkia(style);
+  skia_font_collection_ = font_collection->CreateSktFontCollection();
   builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection(),
-      SkUnicodes::ICU::Make());
+      skia_paragraph_style_, skia_font_collection_, SkUnicodes::ICU::Make());
+  if (layout_cache_) {
+    AppendToKey(font_collection->GetGeneration(), &layout_cache_key_);
+    AppendToKey(style, &layout_cache_key_);
+  }
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  skt::TextStyle skia_style = TxtToSkia(style);
+  builder_->pushStyle(skia_style);
   txt_style_stack_.push(style);
+  if (layout_cache_) {
+    layout_cache_key_.push_back('S');
+    AppendToKey(style, &layout_cache_key_);
+    build_steps_.push_back([skia_style](skt::ParagraphBuilder* builder) {
+      builder->pushStyle(skia_style);
+    });
+  }
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
   txt_style_stack_.pop();
+  if (layout_cache_) {
+    layout_cache_key_.push_back('P');
+    build_steps_.push_back(
+        [](skt::ParagraphBuilder* builder) { builder->pop(); });
+  }
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -73,11 +180,26 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  if (layout_cache_) {
+    layout_cache_key_.push_back('T');
+    AppendToKey(text, &layout_cache_key_);
+    build_steps_.push_back([text](skt::ParagraphBuilder* builder) {
+      builder->addText(text);
+    });
+  }
 }
 
 void ParagraphBuilderSkia::AddText(const uint8_t* utf8_data,
                                    size_t byte_length) {
   builder_->addText(reinterpret_cast<const char*>(utf8_data), byte_length);
+  if (layout_cache_) {
+    std::string text(reinterpret_cast<const char*>(utf8_data), byte_length);
+    layout_cache_key_.push_back('U');
+    AppendToKey(text, &layout_cache_key_);
+    build_steps_.push_back([text](skt::ParagraphBuilder* builder) {
+      builder->addText(text.data(), text.size());
+    });
+  }
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -90,11 +212,39 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  if (layout_cache_) {
+    layout_cache_key_.push_back('H');
+    AppendToKey(span.width, &layout_cache_key_);
+    AppendToKey(span.height, &layout_cache_key_);
+    AppendToKey(span.alignment, &layout_cache_key_);
+    AppendToKey(span.baseline, &layout_cache_key_);
+    AppendToKey(span.baseline_offset, &layout_cache_key_);
+    build_steps_.push_back([placeholder_style](skt::ParagraphBuilder* builder) {
+      builder->addPlaceholder(placeholder_style);
+    });
+  }
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
-  return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+  ParagraphSkia::SharedLayout shared_layout;
+  if (layout_cache_) {
+    shared_layout.cache = layout_cache_;
+    shared_layout.key = std::move(layout_cache_key_);
+    shared_layout.rebuild = [style = skia_paragraph_style_,
+                             font_collection = skia_font_collection_,
+                             steps = std::move(build_steps_)]() {
+      auto builder = skt::ParagraphBuilder::make(style, font_collection,
+                                                 SkUnicodes::ICU::Make());
+      for (const BuildStep& step : steps) {
+        step(builder.get());
+      }
+      return builder->Build();
+    };
+  }
+  return std::make_unique<ParagraphSkia>(builder_->Build(),
+                                         std::move(dl_paints_),
+                                         impeller_enabled_,
+                                         std::move(shared_layout));
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
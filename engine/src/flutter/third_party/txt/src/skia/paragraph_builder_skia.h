@@ -19,8 +19,13 @@
 
 #include "txt/paragraph_builder.h"
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "flutter/display_list/dl_paint.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
+#include "txt/paragraph_layout_cache.h"
 
 namespace txt {
 
@@ -48,6 +53,8 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
  private:
   friend class SkiaParagraphBuilderTests_ParagraphStrutStyle_Test;
 
+  using BuildStep = std::function<void(skia::textlayout::ParagraphBuilder*)>;
+
   skia::textlayout::ParagraphPainter::PaintID CreatePaintID(
       const flutter::DlPaint& dl_paint);
   skia::textlayout::ParagraphStyle TxtToSkia(const ParagraphStyle& txt);
@@ -65,6 +72,18 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   const bool impeller_enabled_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+
+  // The state with which the built paragraph shares its layout with equal
+  // paragraphs. |layout_cache_| is null if the font collection has no
+  // paragraph layout cache, in which case nothing else is recorded.
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  std::string layout_cache_key_;
+  skia::textlayout::ParagraphStyle skia_paragraph_style_;
+  sk_sp<skia::textlayout::FontCollection> skia_font_collection_;
+  // The calls made to |builder_|, which build the paragraph again. The built
+  // paragraph drops them once it is laid out, unless it is the first to share
+  // a cached layout.
+  std::vector<BuildStep> build_steps_;
 };
 
 }  // namespace txt
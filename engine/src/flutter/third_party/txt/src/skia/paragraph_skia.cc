@@ -58,6 +58,8 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   /// @param[in]  draw_path_effect  If true, draw path effects directly by
   ///                               drawing multiple lines instead of providing
   //                                a path effect to the paint.
+  /// @param      text_blob_cache  The conversions of the text blobs of the
+  ///                              paragraph that are drawn with Impeller.
   ///
   /// @note       Impeller does not (and will not) support path effects, but the
   ///             Skia backend does. That means that if we want to draw dashed
@@ -69,10 +71,12 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   ///             decision (i.e. with `#ifdef`) instead of a runtime option.
   DisplayListParagraphPainter(DisplayListBuilder* builder,
                               const std::vector<DlPaint>& dl_paints,
-                              bool impeller_enabled)
+                              bool impeller_enabled,
+                              TextBlobConversionCache* text_blob_cache)
       : builder_(builder),
         dl_paints_(dl_paints),
-        impeller_enabled_(impeller_enabled) {}
+        impeller_enabled_(impeller_enabled),
+        text_blob_cache_(text_blob_cache) {}
 
   void drawTextBlob(const sk_sp<SkTextBlob>& blob,
                     SkScalar x,
@@ -88,12 +92,12 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
     if (impeller_enabled_) {
       SkTextBlobRunIterator run(blob.get());
       if (ShouldRenderAsPath(dl_paints_[paint_id])) {
-        auto path = skia::textlayout::Paragraph::GetPath(blob.get());
+        const SkPath& path = text_blob_cache_->GetPath(blob);
         // If there is no path, this is an emoji and should be drawn as is,
         // ignoring the color source.
         if (path.isEmpty()) {
-          builder_->DrawTextFrame(impeller::MakeTextFrameFromTextBlobSkia(blob),
-                                  x, y, dl_paints_[paint_id]);
+          builder_->DrawTextFrame(text_blob_cache_->GetTextFrame(blob), x, y,
+                                  dl_paints_[paint_id]);
 
           return;
         }
@@ -103,8 +107,8 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
         builder_->DrawPath(transformed, dl_paints_[paint_id]);
         return;
       }
-      builder_->DrawTextFrame(impeller::MakeTextFrameFromTextBlobSkia(blob), x,
-                              y, dl_paints_[paint_id]);
+      builder_->DrawTextFrame(text_blob_cache_->GetTextFrame(blob), x, y,
+                              dl_paints_[paint_id]);
       return;
     }
 #endif  // IMPELLER_SUPPORTS_RENDERING
@@ -126,8 +130,8 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
       paint.setMaskFilter(&filter);
     }
     if (impeller_enabled_) {
-      builder_->DrawTextFrame(impeller::MakeTextFrameFromTextBlobSkia(blob), x,
-                              y, paint);
+      builder_->DrawTextFrame(text_blob_cache_->GetTextFrame(blob), x, y,
+                              paint);
       return;
     }
     builder_->DrawTextBlob(blob, x, y, paint);
@@ -209,16 +213,58 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   DisplayListBuilder* builder_;
   const std::vector<DlPaint>& dl_paints_;
   const bool impeller_enabled_;
+  TextBlobConversionCache* text_blob_cache_;
 };
 
 }  // anonymous namespace
 
+const std::shared_ptr<impeller::TextFrame>&
+TextBlobConversionCache::GetTextFrame(const sk_sp<SkTextBlob>& blob) {
+  Entry& entry = GetEntry(blob);
+  if (!entry.text_frame) {
+    entry.text_frame = impeller::MakeTextFrameFromTextBlobSkia(blob);
+  }
+  return entry.text_frame;
+}
+
+const SkPath& TextBlobConversionCache::GetPath(const sk_sp<SkTextBlob>& blob) {
+  Entry& entry = GetEntry(blob);
+  if (!entry.path.has_value()) {
+    entry.path = skia::textlayout::Paragraph::GetPath(blob.get());
+  }
+  return entry.path.value();
+}
+
+void TextBlobConversionCache::EndPaint() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.used) {
+      it->second.used = false;
+      ++it;
+    } else {
+      it = entries_.erase(it);
+    }
+  }
+}
+
+void TextBlobConversionCache::Clear() {
+  entries_.clear();
+}
+
+TextBlobConversionCache::Entry& TextBlobConversionCache::GetEntry(
+    const sk_sp<SkTextBlob>& blob) {
+  Entry& entry = entries_[blob->uniqueID()];
+  entry.used = true;
+  return entry;
+}
+
 ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
                              std::vector<flutter::DlPaint>&& dl_paints,
-                             bool impeller_enabled)
+                             bool impeller_enabled,
+                             SharedLayout shared_layout)
     : paragraph_(std::move(paragraph)),
       dl_paints_(dl_paints),
-      impeller_enabled_(impeller_enabled) {}
+      impeller_enabled_(impeller_enabled),
+      shared_layout_(std::move(shared_layout)) {}
 
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
@@ -299,12 +345,57 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  text_blob_cache_.Clear();
+  const std::shared_ptr<ParagraphLayoutCache>& cache = shared_layout_.cache;
+  if (!cache) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  // A cached layout is only shared along with a way to build its paragraph
+  // again, which the first paragraph to share it provides. A paragraph that
+  // has already dropped its own lays out its paragraph instead.
+  ParagraphLayoutCache::Layout cached = cache->Get(shared_layout_.key, width);
+  if (cached.paragraph == paragraph_ && layout_width_.has_value()) {
+    // The paragraph is already laid out at |width|.
+    layout_width_ = width;
+    return;
+  }
+  if (cached.paragraph && !*cached.rebuild) {
+    std::swap(*cached.rebuild, shared_layout_.rebuild);
+  }
+  shared_layout_.rebuild = nullptr;
+  if (cached.paragraph && *cached.rebuild) {
+    paragraph_ = std::move(cached.paragraph);
+    shared_rebuild_ = std::move(cached.rebuild);
+    layout_width_ = width;
+    return;
+  }
+  cached = {};
+  // A paragraph whose layout is shared must not be laid out again. It is
+  // taken back from the cache if no other paragraph shares it, and built
+  // again otherwise. Only paragraphs that share a layout hold a way to build
+  // it again, so one without it lays out its own paragraph.
+  if (layout_width_.has_value()) {
+    if (paragraph_.use_count() == 2) {
+      cache->Remove(shared_layout_.key, layout_width_.value(),
+                    paragraph_.get());
+    }
+    if (paragraph_.use_count() > 1 && *shared_rebuild_) {
+      paragraph_ = (*shared_rebuild_)();
+    }
+  }
   paragraph_->layout(width);
+  layout_width_ = width;
+  shared_rebuild_ = std::make_shared<ParagraphLayoutCache::Rebuild>();
+  cache->Put(shared_layout_.key, width, {paragraph_, shared_rebuild_});
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
-  DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_);
+  DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_,
+                                      &text_blob_cache_);
   paragraph_->paint(&painter, x, y);
+  text_blob_cache_.EndPaint();
   return true;
 }
 
@@ -17,20 +17,78 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
 
 #include "txt/paragraph.h"
+#include "txt/paragraph_layout_cache.h"
 
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
+namespace impeller {
+class TextFrame;
+}  // namespace impeller
+
 namespace txt {
 
+// Caches the forms in which the text blobs of a paragraph are drawn with
+// Impeller, keyed by the unique ID of each blob.
+//
+// skparagraph keeps the text blobs of a paragraph until it is laid out again,
+// so a paragraph that is painted on every frame only converts its blobs on
+// the first one.
+class TextBlobConversionCache {
+ public:
+  // Returns the text frame of |blob|.
+  const std::shared_ptr<impeller::TextFrame>& GetTextFrame(
+      const sk_sp<SkTextBlob>& blob);
+
+  // Returns the outlines of the glyphs of |blob|, as returned by
+  // skia::textlayout::Paragraph::GetPath.
+  const SkPath& GetPath(const sk_sp<SkTextBlob>& blob);
+
+  // Drops the conversions of the blobs that haven't been used since the
+  // previous call, which skparagraph no longer paints.
+  void EndPaint();
+
+  void Clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<impeller::TextFrame> text_frame;
+    std::optional<SkPath> path;
+    bool used = true;
+  };
+
+  Entry& GetEntry(const sk_sp<SkTextBlob>& blob);
+
+  std::unordered_map<uint32_t, Entry> entries_;
+};
+
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // How a paragraph shares its layout with equal paragraphs that are laid out
+  // at the same width on the same thread.
+  struct SharedLayout {
+    // The cache of the font collection, or null if layouts are not shared.
+    std::shared_ptr<ParagraphLayoutCache> cache;
+    // Identifies the text, styles and fonts of the paragraph.
+    std::string key;
+    // Builds an equal paragraph that has not been laid out. It is only kept
+    // until the first layout, which hands it to the cached layout if it finds
+    // one that no other paragraph shares yet, and drops it otherwise.
+    ParagraphLayoutCache::Rebuild rebuild;
+  };
+
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
                 std::vector<flutter::DlPaint>&& dl_paints,
-                bool impeller_enabled);
+                bool impeller_enabled,
+                SharedLayout shared_layout = {});
 
   virtual ~ParagraphSkia() = default;
 
@@ -89,11 +147,18 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  // Shared with the layout cache and the equal paragraphs that found it there
+  // once laid out.
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
   const bool impeller_enabled_;
+  TextBlobConversionCache text_blob_cache_;
+  SharedLayout shared_layout_;
+  // How the paragraphs that share |paragraph_| build it again, once laid out.
+  std::shared_ptr<ParagraphLayoutCache::Rebuild> shared_rebuild_;
+  std::optional<double> layout_width_;
 };
 
 }  // namespace txt
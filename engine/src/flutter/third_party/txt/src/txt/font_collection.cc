@@ -31,7 +31,9 @@
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      paragraph_layout_cache_(std::make_shared<ParagraphLayoutCache>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -47,26 +49,31 @@ void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
   default_font_manager_ = GetDefaultFontManager(font_initialization_data);
   skt_collection_.reset();
+  generation_++;
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
   skt_collection_.reset();
+  generation_++;
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
   skt_collection_.reset();
+  generation_++;
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
   skt_collection_.reset();
+  generation_++;
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
   skt_collection_.reset();
+  generation_++;
 }
 
 // Return the available font managers in the order they should be queried.
@@ -88,12 +95,17 @@ void FontCollection::DisableFontFallback() {
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  generation_++;
 }
 
 void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  if (paragraph_layout_cache_) {
+    paragraph_layout_cache_->Clear();
+  }
+  generation_++;
 }
 
 sk_sp<skia::textlayout::FontCollection>
@@ -118,4 +130,17 @@ FontCollection::CreateSktFontCollection() {
   return skt_collection_;
 }
 
+std::shared_ptr<ParagraphLayoutCache> FontCollection::GetParagraphLayoutCache()
+    const {
+  return paragraph_layout_cache_;
+}
+
+void FontCollection::SetParagraphLayoutCacheCapacity(size_t capacity) {
+  if (capacity == 0) {
+    paragraph_layout_cache_.reset();
+  } else {
+    paragraph_layout_cache_ = std::make_shared<ParagraphLayoutCache>(capacity);
+  }
+}
+
 }  // namespace txt
@@ -28,6 +28,7 @@
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
 #include "txt/asset_font_manager.h"
+#include "txt/paragraph_layout_cache.h"
 #include "txt/text_style.h"
 
 namespace txt {
@@ -50,18 +51,33 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // missing from the requested font family.
   void DisableFontFallback();
 
-  // Remove all entries in the font family cache.
+  // Remove all entries in the font family cache and the paragraph layout
+  // cache.
   void ClearFontFamilyCache();
 
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // The cache of the layouts of the paragraphs built with this collection, or
+  // null if it is disabled.
+  std::shared_ptr<ParagraphLayoutCache> GetParagraphLayoutCache() const;
+
+  // Replace the paragraph layout cache with an empty cache of |capacity|
+  // paragraphs, or disable it if |capacity| is zero.
+  void SetParagraphLayoutCacheCapacity(size_t capacity);
+
+  // A number that changes whenever the fonts of this collection change, so
+  // that layouts computed with different fonts are not shared.
+  uint64_t GetGeneration() const { return generation_; }
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
   bool enable_font_fallback_;
+  uint64_t generation_ = 0;
+  std::shared_ptr<ParagraphLayoutCache> paragraph_layout_cache_;
 
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
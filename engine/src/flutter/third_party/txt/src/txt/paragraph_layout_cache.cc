@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/paragraph_layout_cache.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t capacity)
+    : capacity_(capacity) {}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+ParagraphLayoutCache::Layout ParagraphLayoutCache::Get(const std::string& key,
+                                                      double width) {
+  const std::string entry_key = MakeEntryKey(key, width);
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(entry_key);
+  if (found == index_.end() ||
+      found->second->thread_id != std::this_thread::get_id()) {
+    miss_count_++;
+    TraceStatsToTimeline();
+    return {};
+  }
+  hit_count_++;
+  TraceStatsToTimeline();
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->layout;
+}
+
+void ParagraphLayoutCache::Put(const std::string& key,
+                               double width,
+                               Layout layout) {
+  if (capacity_ == 0) {
+    return;
+  }
+  std::string entry_key = MakeEntryKey(key, width);
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(entry_key);
+  if (found != index_.end()) {
+    found->second->thread_id = std::this_thread::get_id();
+    found->second->layout = std::move(layout);
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return;
+  }
+  if (entries_.size() >= capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    eviction_count_++;
+  }
+  entries_.push_front({std::move(entry_key), std::this_thread::get_id(),
+                       std::move(layout)});
+  index_[entries_.front().key] = entries_.begin();
+}
+
+void ParagraphLayoutCache::Remove(
+    const std::string& key,
+    double width,
+    const skia::textlayout::Paragraph* paragraph) {
+  const std::string entry_key = MakeEntryKey(key, width);
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(entry_key);
+  if (found == index_.end() ||
+      found->second->layout.paragraph.get() != paragraph) {
+    return;
+  }
+  auto entry = found->second;
+  index_.erase(found);
+  entries_.erase(entry);
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+size_t ParagraphLayoutCache::GetCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+std::string ParagraphLayoutCache::MakeEntryKey(const std::string& key,
+                                               double width) {
+  // skparagraph lays out paragraphs at single precision widths.
+  const float layout_width = static_cast<float>(width);
+  std::string entry_key;
+  entry_key.reserve(key.size() + sizeof(layout_width));
+  entry_key.append(key);
+  entry_key.append(reinterpret_cast<const char*>(&layout_width),
+                   sizeof(layout_width));
+  return entry_key;
+}
+
+void ParagraphLayoutCache::TraceStatsToTimeline() const {
+#if !FLUTTER_RELEASE
+  const int64_t lookup_count = hit_count_ + miss_count_;
+  FML_TRACE_COUNTER("flutter",                                          //
+                    "ParagraphLayoutCache",                             //
+                    reinterpret_cast<int64_t>(this),                    //
+                    "Hits", hit_count_,                                 //
+                    "Misses", miss_count_,                              //
+                    "Evictions", eviction_count_,                       //
+                    "HitRatePercent", hit_count_ * 100 / lookup_count,  //
+                    "Count", static_cast<int64_t>(entries_.size()));
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace txt
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"  // nogncheck
+
+namespace txt {
+
+// A bounded cache of laid out paragraphs, so that a paragraph with the same
+// text and styles as one that was recently laid out at the same width, such
+// as a list item that scrolls out of view and back in, can share its layout
+// instead of shaping and breaking its text again.
+//
+// The keys identify the text, the style runs and the generation of the font
+// collection of a paragraph, and are built by the paragraph builder. A cached
+// paragraph must not be laid out again, and is only returned to the thread
+// that added it, since skparagraph lazily updates some of its state when it
+// is painted or queried. Layouts are therefore only shared between paragraphs
+// laid out on the same thread, which in practice is the UI thread.
+class ParagraphLayoutCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  // Builds a paragraph equal to a cached one that has not been laid out.
+  using Rebuild = std::function<std::unique_ptr<skia::textlayout::Paragraph>()>;
+
+  struct Layout {
+    // Null if there is no cached paragraph.
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+    // Held by every paragraph that shares |paragraph|, which lays out an
+    // equal paragraph instead when it needs another width. It is empty until
+    // the layout is first shared, so that paragraphs whose layouts are not
+    // shared don't keep a copy of their text and styles, and is only accessed
+    // on the thread that added the layout.
+    std::shared_ptr<Rebuild> rebuild;
+  };
+
+  explicit ParagraphLayoutCache(size_t capacity = kDefaultCapacity);
+
+  ~ParagraphLayoutCache();
+
+  // Returns the layout at |width| that was added with |key| on this thread,
+  // or an empty layout if there is none.
+  Layout Get(const std::string& key, double width);
+
+  // Adds |layout|, whose paragraph has been laid out at |width|, evicting the
+  // least recently used layout if the cache is full.
+  void Put(const std::string& key, double width, Layout layout);
+
+  // Removes the entry for |key| and |width| if it holds |paragraph|, so that
+  // a paragraph that no longer shares its layout can be laid out again.
+  void Remove(const std::string& key,
+              double width,
+              const skia::textlayout::Paragraph* paragraph);
+
+  void Clear();
+
+  size_t GetCount() const;
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::thread::id thread_id;
+    Layout layout;
+  };
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // Ordered from the most to the least recently used.
+  std::list<Entry> entries_;
+  // Indexes |entries_| by their keys, which the views point into.
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+  int64_t hit_count_ = 0;
+  int64_t miss_count_ = 0;
+  int64_t eviction_count_ = 0;
+
+  // Appends |width| to |key| so that a paragraph is cached once per width.
+  static std::string MakeEntryKey(const std::string& key, double width);
+
+  void TraceStatsToTimeline() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
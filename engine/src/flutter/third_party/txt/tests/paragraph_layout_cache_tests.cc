@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include "runtime/test_font_data.h"
+#include "skia/paragraph_builder_skia.h"
+#include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
+
+namespace txt {
+namespace testing {
+
+class ParagraphLayoutCacheTests : public ::testing::Test {
+ public:
+  ParagraphLayoutCacheTests() {
+    auto font_provider = std::make_unique<TypefaceFontAssetProvider>();
+    for (auto& font : flutter::testing::GetTestFontData()) {
+      font_provider->RegisterTypeface(font);
+    }
+    font_collection_ = std::make_shared<FontCollection>();
+    font_collection_->SetAssetFontManager(
+        sk_make_sp<AssetFontManager>(std::move(font_provider)));
+  }
+
+ protected:
+  std::unique_ptr<Paragraph> MakeParagraph(const std::u16string& text,
+                                           double font_size = 14) {
+    TextStyle style;
+    style.font_families = {"ahem"};
+    style.font_size = font_size;
+    ParagraphBuilderSkia builder(ParagraphStyle(), font_collection_, false);
+    builder.PushStyle(style);
+    builder.AddText(text);
+    builder.Pop();
+    return builder.Build();
+  }
+
+  size_t GetCacheCount() const {
+    return font_collection_->GetParagraphLayoutCache()->GetCount();
+  }
+
+  std::shared_ptr<FontCollection> font_collection_;
+};
+
+TEST_F(ParagraphLayoutCacheTests, SharesLayoutOfEqualParagraphs) {
+  auto first = MakeParagraph(u"Hello World!");
+  first->Layout(1000);
+  EXPECT_EQ(GetCacheCount(), 1u);
+
+  auto second = MakeParagraph(u"Hello World!");
+  second->Layout(1000);
+  EXPECT_EQ(GetCacheCount(), 1u);
+  EXPECT_EQ(second->GetNumberOfLines(), 1u);
+  EXPECT_EQ(second->GetHeight(), first->GetHeight());
+  EXPECT_EQ(second->GetMaxIntrinsicWidth(), first->GetMaxIntrinsicWidth());
+
+  second->Layout(500);
+  EXPECT_EQ(GetCacheCount(), 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, DoesNotShareLayoutOfDifferentParagraphs) {
+  MakeParagraph(u"Hello World!")->Layout(1000);
+  MakeParagraph(u"Hello World?")->Layout(1000);
+  MakeParagraph(u"Hello World!", 20)->Layout(1000);
+  EXPECT_EQ(GetCacheCount(), 3u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, LaysOutSharedParagraphAgain) {
+  auto first = MakeParagraph(u"Hello World!");
+  first->Layout(1000);
+  auto second = MakeParagraph(u"Hello World!");
+  second->Layout(1000);
+
+  // Each glyph of Ahem is as wide as the font size.
+  first->Layout(14 * 6);
+  EXPECT_EQ(first->GetNumberOfLines(), 2u);
+  EXPECT_EQ(second->GetNumberOfLines(), 1u);
+
+  second->Layout(14 * 6);
+  EXPECT_EQ(second->GetNumberOfLines(), 2u);
+  first->Layout(1000);
+  EXPECT_EQ(first->GetNumberOfLines(), 1u);
+  EXPECT_EQ(second->GetNumberOfLines(), 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, LaysOutTwiceAtTheSameWidth) {
+  auto paragraph = MakeParagraph(u"Hello World!");
+  paragraph->Layout(14 * 6);
+  paragraph->Layout(14 * 6);
+  EXPECT_EQ(GetCacheCount(), 1u);
+  EXPECT_EQ(paragraph->GetNumberOfLines(), 2u);
+
+  auto shared = MakeParagraph(u"Hello World!");
+  shared->Layout(14 * 6);
+  shared->Layout(14 * 6);
+  paragraph->Layout(14 * 6);
+  EXPECT_EQ(GetCacheCount(), 1u);
+  EXPECT_EQ(shared->GetNumberOfLines(), 2u);
+
+  paragraph->Layout(1000);
+  EXPECT_EQ(paragraph->GetNumberOfLines(), 1u);
+  EXPECT_EQ(shared->GetNumberOfLines(), 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, LaysOutParagraphsThatCannotShareLayouts) {
+  auto first = MakeParagraph(u"Hello World!");
+  first->Layout(1000);
+  first->Layout(14 * 6);
+  ASSERT_EQ(GetCacheCount(), 1u);
+  auto second = MakeParagraph(u"Hello World!");
+  second->Layout(1000);
+  ASSERT_EQ(GetCacheCount(), 2u);
+
+  // Neither paragraph kept a way to build its paragraph again after it was
+  // first laid out, so the first one replaces the layout of the second one
+  // instead of sharing it.
+  first->Layout(1000);
+  EXPECT_EQ(GetCacheCount(), 1u);
+  EXPECT_EQ(first->GetNumberOfLines(), 1u);
+  second->Layout(14 * 6);
+  EXPECT_EQ(GetCacheCount(), 2u);
+  EXPECT_EQ(first->GetNumberOfLines(), 1u);
+  EXPECT_EQ(second->GetNumberOfLines(), 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, EvictsLeastRecentlyUsedParagraphs) {
+  font_collection_->SetParagraphLayoutCacheCapacity(2);
+  MakeParagraph(u"one")->Layout(1000);
+  MakeParagraph(u"two")->Layout(1000);
+  MakeParagraph(u"three")->Layout(1000);
+  EXPECT_EQ(GetCacheCount(), 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, ClearFontFamilyCacheClearsLayouts) {
+  auto paragraph = MakeParagraph(u"Hello World!");
+  paragraph->Layout(1000);
+  ASSERT_EQ(GetCacheCount(), 1u);
+
+  font_collection_->ClearFontFamilyCache();
+  EXPECT_EQ(GetCacheCount(), 0u);
+
+  // Paragraphs built with the previous fonts keep working, but are not shared
+  // with paragraphs built with the new ones.
+  paragraph->Layout(500);
+  MakeParagraph(u"Hello World!")->Layout(500);
+  EXPECT_EQ(GetCacheCount(), 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, CanBeDisabled) {
+  font_collection_->SetParagraphLayoutCacheCapacity(0);
+  ASSERT_EQ(font_collection_->GetParagraphLayoutCache(), nullptr);
+
+  auto paragraph = MakeParagraph(u"Hello World!");
+  paragraph->Layout(14 * 6);
+  EXPECT_EQ(paragraph->GetNumberOfLines(), 2u);
+  paragraph->Layout(1000);
+  EXPECT_EQ(paragraph->GetNumberOfLines(), 1u);
+}
+
+}  // namespace testing
+}  // namespace txt
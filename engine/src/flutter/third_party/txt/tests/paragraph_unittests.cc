@@ -49,6 +49,10 @@ class DlOpRecorder final : public virtual DlOpReceiver,
   int textFrameCount() const { return text_frames_.size(); }
   int blobCount() const { return blobs_.size(); }
 
+  const std::vector<std::shared_ptr<impeller::TextFrame>>& textFrames() const {
+    return text_frames_;
+  }
+
  private:
   void drawLine(const DlPoint& p0, const DlPoint& p1) override {
     lines_.emplace_back(p0, p1);
@@ -137,6 +141,17 @@ class PainterTestBase : public CanvasTestBase<T> {
     return builder.Build();
   }
 
+  std::unique_ptr<txt::Paragraph> makeParagraph(txt::TextStyle style) const {
+    auto pb_skia = makeParagraphBuilder();
+    pb_skia.PushStyle(style);
+    pb_skia.AddText(u"Hello World!");
+    pb_skia.Pop();
+
+    auto paragraph = pb_skia.Build();
+    paragraph->Layout(10000);
+    return paragraph;
+  }
+
   sk_sp<DisplayList> draw(txt::TextStyle style) const {
     auto pb_skia = makeParagraphBuilder();
     pb_skia.PushStyle(style);
@@ -327,6 +342,44 @@ TEST_F(PainterTest, DrawTextBlobNoImpeller) {
   EXPECT_EQ(recorder.textFrameCount(), 0);
   EXPECT_EQ(recorder.blobCount(), 1);
 }
+TEST_F(PainterTest, ReusesTextFramesAcrossPaintsImpeller) {
+  PretendImpellerIsEnabled(true);
+
+  auto paragraph = makeParagraph(makeStyle());
+  auto first_builder = DisplayListBuilder();
+  paragraph->Paint(&first_builder, 0, 0);
+  auto second_builder = DisplayListBuilder();
+  paragraph->Paint(&second_builder, 10, 10);
+
+  auto first = DlOpRecorder();
+  first_builder.Build()->Dispatch(first);
+  auto second = DlOpRecorder();
+  second_builder.Build()->Dispatch(second);
+
+  ASSERT_EQ(first.textFrameCount(), 1);
+  ASSERT_EQ(second.textFrameCount(), 1);
+  EXPECT_EQ(first.textFrames()[0], second.textFrames()[0]);
+}
+
+TEST_F(PainterTest, ConvertsTextFramesAgainAfterLayoutImpeller) {
+  PretendImpellerIsEnabled(true);
+
+  auto paragraph = makeParagraph(makeStyle());
+  auto first_builder = DisplayListBuilder();
+  paragraph->Paint(&first_builder, 0, 0);
+  paragraph->Layout(5000);
+  auto second_builder = DisplayListBuilder();
+  paragraph->Paint(&second_builder, 0, 0);
+
+  auto first = DlOpRecorder();
+  first_builder.Build()->Dispatch(first);
+  auto second = DlOpRecorder();
+  second_builder.Build()->Dispatch(second);
+
+  ASSERT_EQ(first.textFrameCount(), 1);
+  ASSERT_EQ(second.textFrameCount(), 1);
+  EXPECT_NE(first.textFrames()[0], second.textFrames()[0]);
+}
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
 }  // namespace testing